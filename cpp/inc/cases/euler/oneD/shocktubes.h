@@ -137,8 +137,8 @@
       for( size_t i=nx/2; i<nx;   ++i ){ q.interior({i}) = qr; }
 
       for( EulerBCs& bc : q.bcTypes ){ bc=EulerBCs::Riemann; }
-      par::fill( q.boundary[0], ql );
-      par::fill( q.boundary[1], qr );
+      par::fill( q.reference[0], ql );
+      par::fill( q.reference[1], qr );
 
       return q;
   }
@@ -31,19 +31,13 @@
    template<floating_point Real>
    struct SteadyTimeControls
   {
-   // total number of timesteps
+   // maximum number of iterations
       size_t nTimesteps;
 
    // cfl number
       Real cfl;
 
-   // residual drop convergence criteria
+   // residual drop convergence criteria, the ratio (less than one) of the final to the initial residual norm
       Real residual_drop;
-
-   // residual smoothing?
-      bool use_residual_smoothing;
-
-   // residual smoothing cfl factor
-      Real smoothing_factor;
   };
 
@@ -1,6 +1,8 @@
 
 # pragma once
 
+# include <utils/concepts.h>
+
 namespace geom
 {
 // ----------------- forward declarations ----------------- 
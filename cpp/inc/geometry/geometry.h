@@ -192,7 +192,7 @@ namespace geom
  * Normalise direction to unit length
  */
    template<int nDim, floating_point Real>
-   Direction<nDim,Real> norm( const Direction<nDim,Real>& d )
+   Direction<nDim,Real> norm( const Direction<nDim,Real>& d );
 
 /*
  * Cross products of two directions
@@ -42,6 +42,8 @@ namespace geom
      }
 
    // area of quadrilateral
+      // the jacobian determinant is linear over the standard quad, so the area is its value at the centre times the area of the
+      // standard quad, which is 4
       std::array<Direction2<Real>,2> tangent{};
       for( size_t i=0; i<2; ++i )
      {
@@ -54,8 +56,8 @@ namespace geom
         }
      }
 
-      const Real vol = std::fabs( cross( tangent[0],
-                                         tangent[1] ) );
+      const Real vol = 4.*std::fabs( cross( tangent[0],
+                                            tangent[1] ) );
 
       assert( vol>0. );
       assert( !std::isnan(vol) );
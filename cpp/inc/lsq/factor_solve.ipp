@@ -35,7 +35,6 @@ namespace lsq
                              const geom::Direction1<Real>& dir )
   {
       using VarDel = vardelta_t<VarSet>;
-      const auto d = geom::norm( dir );
       VarDel dq;
       for( unsigned int i=0; i<VarDel::N; ++i )
      {
@@ -55,7 +54,6 @@ namespace lsq
                              const geom::Direction2<Real>& dir )
   {
       using VarDel = vardelta_t<VarSet>;
-      const auto d = geom::norm( dir
 
       VarDel dq;
    // xf*qf is gradient (vector quantity)
@@ -68,6 +66,42 @@ namespace lsq
       return dq;
   }
 
+/*
+ * product of factored X*X^T metric (symmetric, upper triangle stored row by row) with a direction
+ */
+   template<int            nDim,
+            floating_point Real>
+   geom::Direction<nDim,Real> product( const XMetricFactor<nDim,Real>&  xf,
+                                       const geom::Direction<nDim,Real>& dx )
+  {
+      geom::Direction<nDim,Real> p;
+
+      for( unsigned int i=0; i<nDim; ++i )
+     {
+         p[i]=0.;
+     }
+
+      unsigned int k=0;
+      for( unsigned int i=0; i<nDim; ++i )
+     {
+         p[i]+=xf(k)*dx[i];
+         ++k;
+         for( unsigned int j=i+1; j<nDim; ++j )
+        {
+            p[i]+=xf(k)*dx[j];
+            p[j]+=xf(k)*dx[i];
+            ++k;
+        }
+     }
+      return p;
+  }
+
+/*
+ * solve for the gradient in a given direction, with the contribution of one neighbour (dx,dq) removed from the metrics
+ *    the biased X*X^T metric is a rank-1 downdate of the full metric, so its inverse follows from the factor of the full
+ *    metric (Sherman-Morrison), and the biased metric never has to be formed or factored:
+ *       w = xf*dx,  a = xf*dir,  dq_dir = a.qm + (dir.w)*(w.qm - dq)/(1 - dx.w)
+ */
    template<ImplementedVarSet VarSet,
             int                 nDim,
             floating_point      Real>
@@ -75,27 +109,65 @@ namespace lsq
                                nDim,
                                Real,
                                VarSet>
-   std::pair<VarDel,VarDel> bias_solves( const geom::Direction<nDim,Real>& dx_c,
-                                         const VarDel&                     dq_c,
-                                         const XMetric<nDim,Real>&        dxm_l,
-                                         const XMetric<nDim,Real>&        dxm_r,
-                                         const QMetric<VarSet>&           dqm_l,
-                                         const QMetric<VarSet>&           dqm_r,
-                                         const geom::Direction<nDim,Real>&  dir )
+   vardelta_t<VarSet> bias_solve( const XMetricFactor<nDim,Real>&   xf,
+                                  const QMetric<VarSet>&            qm,
+                                  const geom::Direction<nDim,Real>& dx,
+                                  const vardelta_t<VarSet>&         dq,
+                                  const geom::Direction<nDim,Real>& dir )
   {
-      // biased left/right spatial metrics
-         const auto dxm_c  = lsq::xmetric(dx_c);
-         const auto dxmb_l = dxm_l - dxm_c;
-         const auto dxmb_r = dxm_r - dxm_c;
+      using VarDel = vardelta_t<VarSet>;
+
+      const geom::Direction<nDim,Real> w = product( xf, dx  );
+      const geom::Direction<nDim,Real> a = product( xf, dir );
+
+      Real dxw=0.;
+      Real dirw=0.;
+      for( unsigned int j=0; j<nDim; ++j )
+     {
+         dxw +=  dx[j]*w[j];
+         dirw+= dir[j]*w[j];
+     }
+      const Real s = dirw/(1.-dxw);
 
-      // biased left/right solution metrics
-         const auto dqm_c  = lsq::qmetric(dx_c, dq_c);
-         const auto dqmb_l = dqm_l - dqm_c;
-         const auto dqmb_r = dqm_r - dqm_c;
+      VarDel dqb;
+      for( unsigned int i=0; i<VarDel::N; ++i )
+     {
+         Real aq=0.;
+         Real wq=0.;
+         for( unsigned int j=0; j<nDim; ++j )
+        {
+            aq+=a[j]*qm(i,j);
+            wq+=w[j]*qm(i,j);
+        }
+         dqb[i] = aq + s*( wq - dq[i] );
+     }
+      return dqb;
+  }
 
+/*
+ * left/right biased gradients in a given direction across the face between two cells
+ *    xf_l/xf_r are the factored metrics of the left/right cells, precomputed once by xmetric_factors,
+ *    and the central contribution (dx_c,dq_c) is removed from both cells' metrics
+ */
+   template<ImplementedVarSet VarSet,
+            int                 nDim,
+            floating_point      Real>
+      requires ConsistentTypes<law_of_v<VarSet>,
+                               nDim,
+                               Real,
+                               VarSet>
+   std::pair<vardelta_t<VarSet>,
+             vardelta_t<VarSet>> bias_solves( const geom::Direction<nDim,Real>& dx_c,
+                                              const vardelta_t<VarSet>&         dq_c,
+                                              const XMetricFactor<nDim,Real>&   xf_l,
+                                              const XMetricFactor<nDim,Real>&   xf_r,
+                                              const QMetric<VarSet>&           dqm_l,
+                                              const QMetric<VarSet>&           dqm_r,
+                                              const geom::Direction<nDim,Real>&  dir )
+  {
       // l/r biased gradients
       //    long 1-liner to make use of RVO
-         return {solve( dxmb_l, dqmb_l, dir ),
-                 solve( dxmb_r, dqmb_r, dir )};
+         return {bias_solve( xf_l, dqm_l, dx_c, dq_c, dir ),
+                 bias_solve( xf_r, dqm_r, dx_c, dq_c, dir )};
   }
 }
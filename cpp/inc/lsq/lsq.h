@@ -22,10 +22,10 @@ namespace lsq
             floating_point Real>
    struct XMetric
   {
-      std::array<utils::triangular_number(nDim),Real> x;
+      std::array<Real,utils::triangular_number(nDim)> x;
 
-      const Real& operator( const int i ) const { return x[i]; }
-            Real& operator( const int i )       { return x[i]; }
+      const Real& operator()( const int i ) const { return x[i]; }
+            Real& operator()( const int i )       { return x[i]; }
 
       XMetric& operator+=( const XMetric& other );
       XMetric& operator-=( const XMetric& other );
@@ -43,15 +43,16 @@ namespace lsq
 
 /*
  *  factorised X*X^T metric for least squares calculation
+ *     the metric depends only on the mesh, so it is factored once at setup (see xmetric_factors)
  */
    template<int            nDim,
             floating_point Real>
    struct XMetricFactor
   {
-      std::array<utils::triangular_number(nDim),Real> x;
+      std::array<Real,utils::triangular_number(nDim)> x;
 
-      const Real& operator( const int i ) const { return x[i]; }
-            Real& operator( const int i )       { return x[i]; }
+      const Real& operator()( const int i ) const { return x[i]; }
+            Real& operator()( const int i )       { return x[i]; }
   };
 
 /*
@@ -62,28 +63,27 @@ namespace lsq
   {
       static constexpr LawType Law = law_of_v<VarSet>;
       static constexpr int nDim=dim_of_v<VarSet>;
-      static constexpr int nVar=nVar<Law,ndim>;
-      using VarSet = varset_t<  VarSet>;
+      static constexpr int nVar=::nVar<Law,nDim>;
       using VarDel = vardelta_t<VarSet>;
       using Real = fptype_of_t< VarSet>;
 
-      std::array<nDim*nVar,Real> q;
+      std::array<Real,nDim*nVar> q;
 
-      int idx( const int i, const int j ){ return nVar*i+j; }
+      static int idx( const int i, const int j ){ return nDim*i+j; }
 
-      const Real& operator( const int i, const int j ) const { return q[idx(i,j)]; }
-            Real& operator( const int i, const int j )       { return q[idx(i,j)]; }
+      const Real& operator()( const int i, const int j ) const { return q[idx(i,j)]; }
+            Real& operator()( const int i, const int j )       { return q[idx(i,j)]; }
 
       QMetric& operator+=( const QMetric& other );
       QMetric& operator-=( const QMetric& other );
   };
 
    template<ImplementedVarSet VarSet>
-   QMetric<VarT> operator+( const QMetric<VarSet>& lhs,
+   QMetric<VarSet> operator+( const QMetric<VarSet>& lhs,
                             const QMetric<VarSet>& rhs );
 
    template<ImplementedVarSet VarSet>
-   QMetric<VarT> operator-( const QMetric<VarSet>& lhs,
+   QMetric<VarSet> operator-( const QMetric<VarSet>& lhs,
                             const QMetric<VarSet>& rhs );
 
 /*
@@ -112,6 +112,10 @@ namespace lsq
 /*
  *  calculation of X*X^T metric for least squares calculation
  */
+   template<int            nDim,
+            floating_point Real>
+   XMetric<nDim,Real> xmetric( const geom::Direction<nDim,Real>& dx );
+
    template<int            nDim,
             floating_point Real>
    XMetric<nDim,Real> xmetric( const geom::Point<nDim,Real>& x0,
@@ -119,10 +123,6 @@ namespace lsq
   {
       return xmetric( x1-x0 );
   }
-
-   template<int            nDim,
-            floating_point Real>
-   XMetric<nDim,Real> xmetric( const geom::Direction<nDim,Real>& dx );
                                                     
 // template<floating_point Real>
 // XMetric1<Real> xmetric( const geom::Direction1<Real>& dx );
@@ -149,6 +149,16 @@ namespace lsq
 /*
  *  calculation of Q*X^T metric for least squares calculation
  */
+   template<int                   nDim,
+            ImplementedVarDelta VarDel,
+            floating_point        Real>
+      requires ConsistentTypes<law_of_v<VarDel>,
+                               nDim,
+                               Real,
+                               VarDel>
+   QMetric<varset_t<VarDel>> qmetric( const geom::Direction<nDim,Real>& dx,
+                                      const VarDel&                     dq );
+
    template<int                 nDim,
             ImplementedVarSet VarSet,
             floating_point      Real>
@@ -165,16 +175,6 @@ namespace lsq
                       q1-q0 );
   }
 
-   template<int                   nDim,
-            ImplementedVarDelta VarDel,
-            floating_point        Real>
-      requires ConsistentTypes<law_of_v<VarDel>,
-                               nDim,
-                               Real,
-                               VarDel>
-   QMetric<varset_t<VarDel>> qmetric( const geom::Direction<nDim,Real>& dx,
-                                      const VarDel&                     dq );
-
 // template<ImplementedVarDelta VarDel,
 //          floating_point        Real>
 //    requires ConsistentTypes<law_of_v<VarDel>,
@@ -242,6 +242,31 @@ namespace lsq
                              const QMetric<VarSet>&         qm,
                              const geom::Direction2<Real>& dir );
 
+/*
+ * product of factored X*X^T metric with a direction
+ */
+   template<int            nDim,
+            floating_point Real>
+   geom::Direction<nDim,Real> product( const XMetricFactor<nDim,Real>&  xf,
+                                       const geom::Direction<nDim,Real>& dx );
+
+/*
+ * solve for the gradient in a given direction with one neighbour's contribution removed from the metrics,
+ * from the factor of the full metric
+ */
+   template<ImplementedVarSet VarSet,
+            int                 nDim,
+            floating_point      Real>
+      requires ConsistentTypes<law_of_v<VarSet>,
+                               nDim,
+                               Real,
+                               VarSet>
+   vardelta_t<VarSet> bias_solve( const XMetricFactor<nDim,Real>&   xf,
+                                  const QMetric<VarSet>&            qm,
+                                  const geom::Direction<nDim,Real>& dx,
+                                  const vardelta_t<VarSet>&         dq,
+                                  const geom::Direction<nDim,Real>& dir );
+
 }
 
 # include <lsq/xmetric.ipp>
@@ -0,0 +1,54 @@
+
+/*
+ * serial face calculation
+ */
+   template<int nDim, floating_point Real>
+   void dualFaces( const MeshNodeArray<nDim,Real>& nodes,
+                         MeshFaceArray<nDim,Real>& faces,
+                   const int                         dim )
+  {
+      dualFaces( par::execution::seq, nodes, faces, dim );
+      return;
+  }
+
+/*
+ * face calculation in any dimension, each face from its nodes in a single pass
+ *    nodes are ordered so that the face normal points towards increasing index in dimension dim, see par::face_stencil
+ */
+   template<par::execution_policy Policy, int nDim, floating_point Real>
+   void dualFaces( const Policy                    policy,
+                   const MeshNodeArray<nDim,Real>&  nodes,
+                         MeshFaceArray<nDim,Real>&  faces,
+                   const int                          dim )
+  {
+      par::faces_from_nodes( policy, dim,
+                             []( const auto&... corners ){ return geom::surface( corners... ); },
+                             faces, nodes );
+      return;
+  }
+
+/*
+ * serial geometry calculation
+ */
+   template<int nDim, floating_point Real>
+   void updateGeometry( Mesh<nDim,Real>& mesh )
+  {
+      updateGeometry( par::execution::seq, mesh );
+      return;
+  }
+
+/*
+ * cell volumes and the faces normal to each dimension, from the nodes
+ */
+   template<par::execution_policy Policy, int nDim, floating_point Real>
+   void updateGeometry( const Policy           policy,
+                              Mesh<nDim,Real>&   mesh )
+  {
+      dual( policy, mesh.nodes, mesh.cells );
+
+      for( int dim=0; dim<nDim; ++dim )
+     {
+         dualFaces( policy, mesh.nodes, mesh.faces[dim], dim );
+     }
+      return;
+  }
@@ -30,7 +30,7 @@
                        );
 */
 
-      mesh.cells = dual( mesh.nodes );
+      updateGeometry( mesh );
 
       return mesh;
   }
@@ -33,8 +33,8 @@
                         { return Pt{lox+i[0]*dx,loy+i[1]*dy}; }
                        );
 
-   // initialise cell array
-      mesh.cells = dual( mesh.nodes );
+   // initialise cell and face geometry
+      updateGeometry( mesh );
 
       return mesh;
   }
@@ -124,8 +124,8 @@
         }
      }
 
-   // initialise cell array
-      mesh.cells = dual( mesh.nodes );
+   // initialise cell and face geometry
+      updateGeometry( mesh );
 
       return mesh;
   }
@@ -172,8 +172,8 @@
       par::generate_idx( mesh.nodes,
                          cyl_node );
 
-   // initialise cell array
-      mesh.cells = dual( mesh.nodes );
+   // initialise cell and face geometry
+      updateGeometry( mesh );
 
       return mesh;
   }
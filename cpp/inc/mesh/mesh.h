@@ -4,6 +4,10 @@
 # include <geometry/geometry.h>
 
 # include <parallalg/array.h>
+# include <parallalg/grid_algorithm.h>
+
+# include <array>
+# include <utility>
 
    template<int            nDim,
             floating_point Real>
@@ -13,8 +17,14 @@
             floating_point Real>
    using MeshCellArray = par::DualArray<geom::Volume<nDim,Real>,nDim>;
 
+   template<int            nDim,
+            floating_point Real>
+   using MeshFaceArray = par::PrimalArray<geom::Surface<nDim,Real>,nDim>;
+
 /*
- * data structure holding the cell Volumes and node Points for a structured mesh
+ * data structure holding the cell Volumes, face Surfaces and node Points for a structured mesh
+ *    faces[d] holds the faces normal to dimension d, face idx lies between cells idx-1 and idx (see par::faceShape)
+ *    the mesh is static, so the face geometry is computed once by updateGeometry and not rebuilt for each flux evaluation
  */
    template<int            nDim,
             floating_point Real>
@@ -26,6 +36,7 @@
 
       using NodeArray = par::PrimalArray<Node,nDim>;
       using CellArray = par::DualArray<  Cell,nDim>;
+      using FaceArray = par::PrimalArray<Face,nDim>;
 
       using NodeShape = par::PrimalShape<nDim>;
       using CellShape = par::DualShape<  nDim>;
@@ -36,6 +47,8 @@
       NodeArray nodes;
       CellArray cells;
 
+      std::array<FaceArray,nDim> faces;
+
    // par::Array only supports move construction, so same must be for Mesh
       Mesh() = delete;
       Mesh( const Mesh&  ) = delete;
@@ -48,12 +61,22 @@
       Mesh( const NodeShape& s ) : node_shape(s),
                                    cell_shape(par::dualShape(s)),
                                    nodes(node_shape),
-                                   cells(cell_shape) {}
+                                   cells(cell_shape),
+                                   faces(faceArrays(cell_shape,std::make_index_sequence<nDim>{})) {}
 
       Mesh( const CellShape& s ) : node_shape(par::primalShape(s)),
                                    cell_shape(s),
                                    nodes(node_shape),
-                                   cells(cell_shape) {}
+                                   cells(cell_shape),
+                                   faces(faceArrays(cell_shape,std::make_index_sequence<nDim>{})) {}
+
+   private:
+   // one face array for each dimension
+      template<size_t... D>
+      static std::array<FaceArray,nDim> faceArrays( const CellShape& s, std::index_sequence<D...> )
+     {
+         return {FaceArray(par::faceShape(s,D))...};
+     }
   };
 
 // ----------------- operations on the dual mesh ----------------- 
@@ -66,14 +89,40 @@
    template<int nDim, floating_point Real>
    MeshCellArray<nDim,Real> dual( const MeshNodeArray<nDim,Real>& nodes );
 
-   template<floating_point Real>
-   void dual( const MeshNodeArray<1,Real>& nodes,
-                    MeshCellArray<1,Real>& cells );
+   template<int nDim, floating_point Real>
+   void dual( const MeshNodeArray<nDim,Real>& nodes,
+                    MeshCellArray<nDim,Real>& cells );
+
+   template<par::execution_policy Policy, int nDim, floating_point Real>
+   void dual( const Policy                    policy,
+              const MeshNodeArray<nDim,Real>&  nodes,
+                    MeshCellArray<nDim,Real>&  cells );
+
+/*
+ * Create the faces normal to dimension dim from the primal mesh (assumes mesh is structured)
+ */
+   template<int nDim, floating_point Real>
+   void dualFaces( const MeshNodeArray<nDim,Real>& nodes,
+                         MeshFaceArray<nDim,Real>& faces,
+                   const int                         dim );
+
+   template<par::execution_policy Policy, int nDim, floating_point Real>
+   void dualFaces( const Policy                    policy,
+                   const MeshNodeArray<nDim,Real>&  nodes,
+                         MeshFaceArray<nDim,Real>&  faces,
+                   const int                          dim );
+
+/*
+ * Compute the cell and face geometry of the mesh from its nodes
+ */
+   template<int nDim, floating_point Real>
+   void updateGeometry( Mesh<nDim,Real>& mesh );
 
-   template<floating_point Real>
-   void dual( const MeshNodeArray<2,Real>& nodes,
-                    MeshCellArray<2,Real>& cells );
+   template<par::execution_policy Policy, int nDim, floating_point Real>
+   void updateGeometry( const Policy           policy,
+                              Mesh<nDim,Real>&   mesh );
 
 
 # include <mesh/dual.ipp>
+# include <mesh/faces.ipp>
 
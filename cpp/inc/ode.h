@@ -5,6 +5,8 @@
 
 # include <array>
 
+# include <cassert>
+
 namespace ODE
 {
    namespace Implicit
@@ -195,6 +197,202 @@ namespace ODE
 
          return rk;
      }
+
+   /*
+    * Low-storage explicit Runge-Kutta schemes
+    *    every stage s updates at most two registers in place, whatever the number of stages:
+    *       dU := a[s]*dU + R(U)
+    *        U := (1-gamma[s])*U + gamma[s]*U^n + b[s]*dt*dU
+    *    Williamson (2N) schemes only use the increment register dU (gamma=0), and Ketcheson (2S*) schemes only
+    *    use the register holding the solution at the start of the timestep, U^n (a=0), so dU is the stage residual
+    */
+      namespace LowStorage
+     {
+         template<floating_point Real>
+         struct RungeKutta
+        {
+         // order of accuracy
+            unsigned int order;
+
+         // number of stages
+            unsigned int nstages;
+
+         // maximum allowable cfl
+            Real maxCFL;
+
+         // coefficients
+         // a[s] is coefficient of the previous increment at stage s
+            std::array<Real,6> a;
+
+         // b[s] is the size of the timestep of stage s
+            std::array<Real,6> b;
+
+         // gamma[s] is coefficient of the solution at the start of the timestep at stage s
+            std::array<Real,6> gamma;
+        };
+
+      /*
+       * true if the scheme uses the increment register, or the solution at the start of the timestep
+       */
+         template<floating_point Real>
+         bool usesIncrement( const RungeKutta<Real>& rk )
+        {
+            for( unsigned int s=0; s<rk.nstages; ++s ){ if( rk.a[s]!=0 ){ return true; } }
+            return false;
+        }
+
+         template<floating_point Real>
+         bool usesInitial( const RungeKutta<Real>& rk )
+        {
+            for( unsigned int s=0; s<rk.nstages; ++s ){ if( rk.gamma[s]!=0 ){ return true; } }
+            return false;
+        }
+
+      /*
+       * Ketcheson 2S* forms of the SSP schemes above (identical updates)
+       */
+         template<floating_point Real>
+         RungeKutta<Real> ssp11()
+        {
+            RungeKutta<Real> rk{};
+
+            rk.order  =1;
+            rk.nstages=1;
+            rk.maxCFL =1.;
+
+            rk.b[0]=1.0;
+
+            return rk;
+        }
+
+         template<floating_point Real>
+         RungeKutta<Real> ssp22()
+        {
+            RungeKutta<Real> rk{};
+
+            rk.order=2;
+            rk.nstages=2;
+            rk.maxCFL=1.;
+
+            rk.b[0]=1.0;
+            rk.b[1]=0.5;
+
+            rk.gamma[1]=0.5;
+
+            return rk;
+        }
+
+         template<floating_point Real>
+         RungeKutta<Real> ssp33()
+        {
+            RungeKutta<Real> rk{};
+
+            rk.order=3;
+            rk.nstages=3;
+            rk.maxCFL=1.;
+
+            rk.b[0]=1.0;
+            rk.b[1]=0.25;
+            rk.b[2]=2./3.;
+
+            rk.gamma[1]=0.75;
+            rk.gamma[2]=1./3.;
+
+            return rk;
+        }
+
+         template<floating_point Real>
+         RungeKutta<Real> ssp34()
+        {
+            RungeKutta<Real> rk{};
+
+            rk.order=3;
+            rk.nstages=4;
+            rk.maxCFL=2.;
+
+            rk.b[0]=0.5;
+            rk.b[1]=0.5;
+            rk.b[2]=1./6.;
+            rk.b[3]=0.5;
+
+            rk.gamma[2]=2./3.;
+
+            return rk;
+        }
+
+      /*
+       * Ketcheson's optimal second order SSP schemes with nstages stages, SSP coefficient nstages-1
+       */
+         template<floating_point Real>
+         RungeKutta<Real> sspS2( const unsigned int nstages )
+        {
+            assert( nstages>=2 && nstages<=6 );
+
+            RungeKutta<Real> rk{};
+
+            rk.order=2;
+            rk.nstages=nstages;
+            rk.maxCFL=nstages-1;
+
+            for( unsigned int s=0; s<nstages-1; ++s )
+           {
+               rk.b[s]=1./(nstages-1);
+           }
+            rk.b[nstages-1]=1./nstages;
+
+            rk.gamma[nstages-1]=1./nstages;
+
+            return rk;
+        }
+
+      /*
+       * Williamson's third order 2N scheme
+       */
+         template<floating_point Real>
+         RungeKutta<Real> williamson3()
+        {
+            RungeKutta<Real> rk{};
+
+            rk.order=3;
+            rk.nstages=3;
+            rk.maxCFL=1.;
+
+            rk.a[1]=-5./9.;
+            rk.a[2]=-153./128.;
+
+            rk.b[0]=1./3.;
+            rk.b[1]=15./16.;
+            rk.b[2]=8./15.;
+
+            return rk;
+        }
+
+      /*
+       * Carpenter and Kennedy's fourth order, five stage 2N scheme
+       */
+         template<floating_point Real>
+         RungeKutta<Real> carpenterKennedy4()
+        {
+            RungeKutta<Real> rk{};
+
+            rk.order=4;
+            rk.nstages=5;
+            rk.maxCFL=1.;
+
+            rk.a[1]= -567301805773./1357537059087.;
+            rk.a[2]=-2404267990393./2016746695238.;
+            rk.a[3]=-3550918686646./2091501179385.;
+            rk.a[4]=-1275806237668./842570457699.;
+
+            rk.b[0]=1432997174477./9575080441755.;
+            rk.b[1]=5161836677717./13612068292357.;
+            rk.b[2]=1720146321549./2090206949498.;
+            rk.b[3]=3134564353537./4481467310338.;
+            rk.b[4]=2277821191437./14882151754819.;
+
+            return rk;
+        }
+     }
   }
 }
 
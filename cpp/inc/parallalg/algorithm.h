@@ -3,6 +3,10 @@
 
 # include <parallalg/array.h>
 # include <parallalg/parallalg.h>
+# include <parallalg/tiling.h>
+# include <parallalg/reduction.h>
+# include <parallalg/schedule.h>
+# include <parallalg/view.h>
 
 # include <type_traits>
 
@@ -14,6 +18,230 @@
 namespace par
 {
 
+/*
+ * ------------------------- par::same_storage ------------------------
+ *
+ * true if the elements of every array are stored at the same flattened indices, i.e. the arrays have the same padding and halo
+ *    algorithms traverse arrays with the same storage by flattened index, and other arrays (including views) by index
+ */
+   template<typename    ElemT0,
+            typename... ElemTs,
+            int           NDIM,
+            GridType        GT,
+            ArraySizing    AS0,
+            ArraySizing... ASs>
+   bool same_storage( const Array<ElemT0,NDIM,GT,AS0>&    array0,
+                      const Array<ElemTs,NDIM,GT,ASs>&... arrays )
+  {
+      if constexpr( any_view_v<AS0,ASs...> ){ return false; }
+      else
+     {
+         return ( (   array0.stride()      == arrays.stride()
+                   && array0.flat_origin() == arrays.flat_origin() ) && ... );
+     }
+  }
+
+/*
+ * ------------------------- par::for_each_flat_index ------------------------
+ *
+ * Call func(i) for the flattened index i of every element of an array, skipping any padding and halo
+ *    contiguous arrays are traversed with a single loop over the flattened array
+ *    padded arrays and arrays with a halo are traversed row by row along the fastest-varying dimension
+ *    other arrays traversed with the same flattened index must have the same strides
+ *    parallel loops use a static schedule, the same as the first touch of Arrays constructed with a parallel policy, and only honour the thread count of the policy
+ */
+
+/*
+ * Serial execution
+ */
+   template<typename FuncObj,
+            typename   ElemT,
+            int         NDIM,
+            GridType      GT,
+            ArraySizing   AS>
+   void for_each_flat_index(       execution::serial_policy,
+                             const Array<ElemT,NDIM,GT,AS>&    array,
+                                   FuncObj                      func ) _PAR_ALWAYS_INLINE_
+  {
+      if( array.is_contiguous() )
+     {
+         const size_t len = array.flattened_length();
+
+         for( size_t i=0; i<len; ++i ){ func(i); }
+     }
+      else
+     {
+         const size_t nj    = array.shape(NDIM-1);
+         const size_t nrows = nj>0 ? length(array.shape())/nj : 0;
+
+         for( size_t r=0; r<nrows; ++r )
+        {
+            const size_t row = flat_row( array, r );
+            for( size_t j=0; j<nj; ++j ){ func( row+j ); }
+        }
+     }
+      return;
+  }
+
+/*
+ * OpenMP execution
+ */
+   template<typename FuncObj,
+            typename   ElemT,
+            int         NDIM,
+            GridType      GT,
+            ArraySizing   AS>
+   void for_each_flat_index( const execution::openmp_policy&  policy,
+                             const Array<ElemT,NDIM,GT,AS>&    array,
+                                   FuncObj                      func ) _PAR_ALWAYS_INLINE_
+  {
+      const int nthreads = openmp_num_threads( policy );
+
+      if( array.is_contiguous() )
+     {
+         const size_t len = array.flattened_length();
+
+# ifdef _OPENMP
+   # pragma omp parallel for schedule(static) num_threads(nthreads)
+# endif
+         for( size_t i=0; i<len; ++i ){ func(i); }
+     }
+      else
+     {
+         const size_t nj    = array.shape(NDIM-1);
+         const size_t nrows = nj>0 ? length(array.shape())/nj : 0;
+
+# ifdef _OPENMP
+   # pragma omp parallel for collapse(2) schedule(static) num_threads(nthreads)
+# endif
+         for( size_t r=0; r<nrows; ++r )
+        {
+            for( size_t j=0; j<nj; ++j ){ func( flat_row(array,r)+j ); }
+        }
+     }
+      return;
+  }
+
+/*
+ * Vectorised serial execution
+ */
+   template<typename FuncObj,
+            typename   ElemT,
+            int         NDIM,
+            GridType      GT,
+            ArraySizing   AS>
+   void for_each_flat_index(       execution::simd_policy,
+                             const Array<ElemT,NDIM,GT,AS>&    array,
+                                   FuncObj                      func ) _PAR_ALWAYS_INLINE_
+  {
+      if( array.is_contiguous() )
+     {
+         const size_t len = array.flattened_length();
+
+# ifdef _OPENMP
+   # pragma omp simd
+# endif
+         for( size_t i=0; i<len; ++i ){ func(i); }
+     }
+      else
+     {
+         const size_t nj    = array.shape(NDIM-1);
+         const size_t nrows = nj>0 ? length(array.shape())/nj : 0;
+
+         for( size_t r=0; r<nrows; ++r )
+        {
+            const size_t row = flat_row( array, r );
+# ifdef _OPENMP
+   # pragma omp simd
+# endif
+            for( size_t j=0; j<nj; ++j ){ func( row+j ); }
+        }
+     }
+      return;
+  }
+
+/*
+ * Vectorised OpenMP execution
+ *    padded arrays are split between threads by row, so that every thread vectorises whole rows
+ */
+   template<typename FuncObj,
+            typename   ElemT,
+            int         NDIM,
+            GridType      GT,
+            ArraySizing   AS>
+   void for_each_flat_index( const execution::openmp_simd_policy&  policy,
+                             const Array<ElemT,NDIM,GT,AS>&    array,
+                                   FuncObj                      func ) _PAR_ALWAYS_INLINE_
+  {
+      const int nthreads = openmp_num_threads( policy );
+
+      if( array.is_contiguous() )
+     {
+         const size_t len = array.flattened_length();
+
+# ifdef _OPENMP
+   # pragma omp parallel for simd schedule(static) num_threads(nthreads)
+# endif
+         for( size_t i=0; i<len; ++i ){ func(i); }
+     }
+      else
+     {
+         const size_t nj    = array.shape(NDIM-1);
+         const size_t nrows = nj>0 ? length(array.shape())/nj : 0;
+
+# ifdef _OPENMP
+   # pragma omp parallel for schedule(static) num_threads(nthreads)
+# endif
+         for( size_t r=0; r<nrows; ++r )
+        {
+            const size_t row = flat_row( array, r );
+# ifdef _OPENMP
+   # pragma omp simd
+# endif
+            for( size_t j=0; j<nj; ++j ){ func( row+j ); }
+        }
+     }
+      return;
+  }
+
+/*
+ * Thread pool execution
+ */
+   template<typename FuncObj,
+            typename   ElemT,
+            int         NDIM,
+            GridType      GT,
+            ArraySizing   AS>
+   void for_each_flat_index(       execution::thread_pool_policy,
+                             const Array<ElemT,NDIM,GT,AS>&    array,
+                                   FuncObj                      func ) _PAR_ALWAYS_INLINE_
+  {
+      if( array.is_contiguous() )
+     {
+         default_thread_pool().parallel_for( array.flattened_length(),
+                                             [&]( const size_t begin, const size_t end )
+                                            {
+                                                for( size_t i=begin; i<end; ++i ){ func(i); }
+                                            } );
+     }
+      else
+     {
+         const size_t nj    = array.shape(NDIM-1);
+         const size_t nrows = nj>0 ? length(array.shape())/nj : 0;
+
+         default_thread_pool().parallel_for( nrows,
+                                             [&]( const size_t begin, const size_t end )
+                                            {
+                                                for( size_t r=begin; r<end; ++r )
+                                               {
+                                                   const size_t row = flat_row( array, r );
+                                                   for( size_t j=0; j<nj; ++j ){ func( row+j ); }
+                                               }
+                                            } );
+     }
+      return;
+  }
+
 /*
  * ------------------------- par::copy ------------------------
  */
@@ -21,13 +249,14 @@ namespace par
 /*
  * if no policy provided, use sequential
  */
-   template<typename  ElemT,
+   template<typename ElemT0,
+            typename ElemT1,
             int        NDIM,
             GridType     GT,
             ArraySizing AS0,
             ArraySizing AS1>
-   void copy(       Array<ElemT,NDIM,GT,AS0>& dst,
-              const Array<ElemT,NDIM,GT,AS1>& src )
+   void copy(       Array<ElemT0,NDIM,GT,AS0>& dst,
+              const Array<ElemT1,NDIM,GT,AS1>& src )
   {
       copy( execution::seq, dst, src );
   }
@@ -44,6 +273,8 @@ namespace par
       return copy( execution::seq, src );
   }
 
+// a copy of an owning array has the same storage, so the flat copy writes all of its memory (including any padding and halo)
+// dst is then not initialised before the copy, so its memory is first touched according to policy
    template<execution_policy Policy,
             typename          ElemT,
             int                NDIM,
@@ -52,32 +283,69 @@ namespace par
    auto copy(       Policy policy,
               const Array<ElemT,NDIM,GT,AS>& src )
   {
-      Array<ElemT,NDIM,GT,AS> dst(src.shape());
-      copy( policy, dst, src );
-      return dst;
+      using ArrayT = Array<std::remove_const_t<ElemT>,NDIM,GT,owning_sizing_v<AS>>;
+
+      if constexpr( AS==ViewSizing )
+     {
+         ArrayT dst(src.shape(),src.layout());
+         copy( policy, dst, src );
+         return dst;
+     }
+      else
+     {
+         ArrayT dst(uninitialised,src.shape(),src.layout());
+         copy( policy, dst, src );
+         return dst;
+     }
   }
 
 /*
- * memcopy overload for trivial types
- *    horrible const cast to use memcpy if ElemT is trivially copyable
+ * copy the elements of src into dst by index, according to policy
+ *    used when dst and src do not share flattened indices. Only the elements of the arrays are copied, not any padding or halo
  */
    template<execution_policy Policy,
-            typename          ElemT,
+            typename         ElemT0,
+            typename         ElemT1,
+            int                NDIM,
+            GridType             GT,
+            ArraySizing         AS0,
+            ArraySizing         AS1>
+   void copy_idx( const Policy                     policy,
+                        Array<ElemT0,NDIM,GT,AS0>&    dst,
+                  const Array<ElemT1,NDIM,GT,AS1>&    src )
+  {
+      for_each_index( policy, Idx<NDIM,GT>{}, Idx<NDIM,GT>{dst.shape().shape},
+                      [&]( const Idx<NDIM,GT>& idx ){ dst(idx) = src(idx); } );
+      return;
+  }
+
+/*
+ * serial memcopy overload for trivial types
+ *    horrible const cast to use memcpy if ElemT is trivially copyable
+ *    length is taken from the underlying memory, which is not the number of elements for Structure-of-Arrays layouts
+ */
+   template<typename          ElemT,
             int                NDIM,
             GridType             GT,
             ArraySizing         AS0,
             ArraySizing         AS1>
-      requires std::is_trivially_copyable_v<ElemT>
-   void copy(       Policy,
+      requires std::is_trivially_copyable_v<ElemT> && !(any_view_v<AS0,AS1>)
+   void copy(       execution::serial_policy,
                     Array<ElemT,NDIM,GT,AS0>& dst,
               const Array<ElemT,NDIM,GT,AS1>& src )
   {
       assert( (dst.shape() == src.shape()) && "par::copy - arrays must be the same shape");
 
-      const size_t len = sizeof(ElemT)*dst.flattened_length();
+   // arrays with different padding or halo do not share flattened indices
+      if( !same_storage( dst, src ) ){ copy_idx( execution::seq, dst, src ); return; }
+
+      const auto& dst_mem = dst.flatten();
+      const auto& src_mem = src.flatten();
 
-      memcpy( const_cast<ElemT*>(dst.flatten().data()),
-                                 src.flatten().data(), len );
+      const size_t len = sizeof(src_mem[0])*src_mem.size();
+
+      memcpy( const_cast<void*>(static_cast<const void*>(dst_mem.data())),
+                                                         src_mem.data(), len );
       return;
   }
 
@@ -90,13 +358,16 @@ namespace par
             GridType     GT,
             ArraySizing AS0,
             ArraySizing AS1>
-      requires !(std::is_trivially_copyable_v<ElemT>)
+      requires !(std::is_trivially_copyable_v<ElemT>) && !(any_view_v<AS0,AS1>)
    void copy(       execution::serial_policy,
                     Array<ElemT,NDIM,GT,AS0>& dst,
               const Array<ElemT,NDIM,GT,AS1>& src )
   {
       assert( (dst.shape() == src.shape()) && "par::copy - arrays must be the same shape");
 
+   // arrays with different padding or halo do not share flattened indices
+      if( !same_storage( dst, src ) ){ copy_idx( execution::seq, dst, src ); return; }
+
       const size_t len = dst.flattened_length();
 
       for( size_t i=0; i<len; ++i ){ dst.flatten(i) = src.flatten(i); }
@@ -107,23 +378,28 @@ namespace par
 
 /*
  * OpenMP execution
+ *    static schedule, so that copying into an uninitialised array first touches its memory from the threads which will use it
  */
    template<typename  ElemT,
             int        NDIM,
             GridType     GT,
             ArraySizing AS0,
             ArraySizing AS1>
-      requires !(std::is_trivially_copyable_v<ElemT>)
-   void copy(       execution::openmp_policy,
+      requires !(any_view_v<AS0,AS1>)
+   void copy( const execution::openmp_policy&  policy,
                     Array<ElemT,NDIM,GT,AS0>& dst,
               const Array<ElemT,NDIM,GT,AS1>& src )
   {
       assert( (dst.shape() == src.shape()) && "par::copy - arrays must be the same shape");
 
+   // arrays with different padding or halo do not share flattened indices
+      if( !same_storage( dst, src ) ){ copy_idx( policy, dst, src ); return; }
+
       const size_t len = dst.flattened_length();
+      const int nthreads = openmp_num_threads( policy );
 
 # ifdef _OPENMP
-   # pragma omp parallel for
+   # pragma omp parallel for schedule(static) num_threads(nthreads)
 # endif
       for( size_t i=0; i<len; ++i ){ dst.flatten(i) = src.flatten(i); }
 
@@ -131,20 +407,71 @@ namespace par
   }
 
 
+/*
+ * Thread pool execution
+ */
+   template<typename  ElemT,
+            int        NDIM,
+            GridType     GT,
+            ArraySizing AS0,
+            ArraySizing AS1>
+      requires !(any_view_v<AS0,AS1>)
+   void copy(       execution::thread_pool_policy,
+                    Array<ElemT,NDIM,GT,AS0>& dst,
+              const Array<ElemT,NDIM,GT,AS1>& src )
+  {
+      assert( (dst.shape() == src.shape()) && "par::copy - arrays must be the same shape");
+
+   // arrays with different padding or halo do not share flattened indices
+      if( !same_storage( dst, src ) ){ copy_idx( execution::pool, dst, src ); return; }
+
+      default_thread_pool().parallel_for( dst.flattened_length(),
+                                          [&]( const size_t begin, const size_t end )
+                                         {
+                                             for( size_t i=begin; i<end; ++i ){ dst.flatten(i) = src.flatten(i); }
+                                         } );
+      return;
+  }
+
+
+/*
+ * Views, any execution policy
+ *    elements are copied by index, so dst and src may have different strides
+ */
+   template<execution_policy Policy,
+            typename         ElemT0,
+            typename         ElemT1,
+            int                NDIM,
+            GridType             GT,
+            ArraySizing         AS0,
+            ArraySizing         AS1>
+      requires any_view_v<AS0,AS1>
+   void copy( const Policy                     policy,
+                    Array<ElemT0,NDIM,GT,AS0>&    dst,
+              const Array<ElemT1,NDIM,GT,AS1>&    src )
+  {
+      assert( (dst.shape() == src.shape()) && "par::copy - arrays must be the same shape");
+
+      copy_idx( policy, dst, src );
+      return;
+  }
+
+
 /*
  * ------------------------- par::fill ------------------------
  */
 
 /*
  * Fill an array with a given value
+ *    value is the element type of the array, which is not the same as the template argument for Structure-of-Arrays layouts
  */
    template<typename ElemT,
             int       NDIM,
             GridType    GT,
             ArraySizing AS>
       requires std::is_copy_assignable_v<ElemT>
-   void fill(       Array<ElemT,NDIM,GT,AS>& dst,
-              const ElemT&                 value )
+   void fill(       Array<ElemT,NDIM,GT,AS>&                          dst,
+              const typename Array<ElemT,NDIM,GT,AS>::ElemType& value )
   {
       fill( execution::seq, dst, value );
       return;
@@ -157,10 +484,10 @@ namespace par
             int       NDIM,
             GridType    GT,
             ArraySizing AS>
-      requires std::is_copy_assignable_v<ElemT>
+      requires std::is_copy_assignable_v<ElemT> && (AS!=ViewSizing)
    void fill(       execution::serial_policy,
-                    Array<ElemT,NDIM,GT,AS>& dst,
-              const ElemT&                 value )
+                    Array<ElemT,NDIM,GT,AS>&                          dst,
+              const typename Array<ElemT,NDIM,GT,AS>::ElemType& value )
   {
       const size_t len = dst.flattened_length();
 
@@ -171,20 +498,22 @@ namespace par
 
 /*
  * OpenMP execution
+ *    static schedule, so that filling an uninitialised array first touches its memory from the threads which will use it
  */
    template<typename ElemT,
             int       NDIM,
             GridType    GT,
             ArraySizing AS>
-      requires std::is_copy_assignable_v<ElemT>
-   void fill(       execution::openmp_policy,
-                    Array<ElemT,NDIM,GT,AS>& dst,
-              const ElemT&                 value )
+      requires std::is_copy_assignable_v<ElemT> && (AS!=ViewSizing)
+   void fill( const execution::openmp_policy&                         policy,
+                    Array<ElemT,NDIM,GT,AS>&                          dst,
+              const typename Array<ElemT,NDIM,GT,AS>::ElemType& value )
   {
       const size_t len = dst.flattened_length();
+      const int nthreads = openmp_num_threads( policy );
 
 # ifdef _OPENMP
-   # pragma omp parallel for
+   # pragma omp parallel for schedule(static) num_threads(nthreads)
 # endif
       for( size_t i=0; i<len; ++i ){ dst.flatten(i) = value; }
 
@@ -192,6 +521,45 @@ namespace par
   }
 
 
+/*
+ * Thread pool execution
+ */
+   template<typename ElemT,
+            int       NDIM,
+            GridType    GT,
+            ArraySizing AS>
+      requires std::is_copy_assignable_v<ElemT> && (AS!=ViewSizing)
+   void fill(       execution::thread_pool_policy,
+                    Array<ElemT,NDIM,GT,AS>&                          dst,
+              const typename Array<ElemT,NDIM,GT,AS>::ElemType& value )
+  {
+      default_thread_pool().parallel_for( dst.flattened_length(),
+                                          [&]( const size_t begin, const size_t end )
+                                         {
+                                             for( size_t i=begin; i<end; ++i ){ dst.flatten(i) = value; }
+                                         } );
+      return;
+  }
+
+/*
+ * Views, any execution policy
+ *    only the elements of the view are filled, not the elements between them
+ */
+   template<execution_policy Policy,
+            typename          ElemT,
+            int                NDIM,
+            GridType             GT>
+      requires std::is_copy_assignable_v<ElemT>
+   void fill( const Policy                                                 policy,
+                    Array<ElemT,NDIM,GT,ViewSizing>&                          dst,
+              const typename Array<ElemT,NDIM,GT,ViewSizing>::ElemType& value )
+  {
+      for_each_index( policy, Idx<NDIM,GT>{}, Idx<NDIM,GT>{dst.shape().shape},
+                      [&]( const Idx<NDIM,GT>& idx ){ dst(idx) = value; } );
+      return;
+  }
+
+
 /*
  * ------------------------- par::generate ------------------------
  */
@@ -220,37 +588,69 @@ namespace par
             GridType    GT,
             ArraySizing AS,
             typename Generator>
+      requires (AS!=ViewSizing)
    void generate( execution::serial_policy,
                   Array<ElemT,NDIM,GT,AS>& dst,
                   Generator          generator )
   {
-      const size_t len = dst.flattened_length();
+      for_each_flat_index( execution::seq, dst,
+                           [&]( const size_t i ){ dst.flatten(i) = generator(); } );
+      return;
+  }
 
-      for( size_t i=0; i<len; ++i ){ dst.flatten(i) = generator(); }
 
+/*
+ * OpenMP execution
+ */
+   template<typename ElemT,
+            int       NDIM,
+            GridType    GT,
+            ArraySizing AS,
+            typename Generator>
+      requires (AS!=ViewSizing)
+   void generate( const execution::openmp_policy& policy,
+                        Array<ElemT,NDIM,GT,AS>&     dst,
+                        Generator              generator )
+  {
+      for_each_flat_index( policy, dst,
+                           [&]( const size_t i ){ dst.flatten(i) = generator(); } );
       return;
   }
 
 
 /*
- * OpenMP execution
+ * Thread pool execution
  */
    template<typename ElemT,
             int       NDIM,
             GridType    GT,
             ArraySizing AS,
             typename Generator>
-   void generate( execution::openmp_policy,
+      requires (AS!=ViewSizing)
+   void generate( execution::thread_pool_policy,
                   Array<ElemT,NDIM,GT,AS>& dst,
                   Generator          generator )
   {
-      const size_t len = dst.flattened_length();
+      for_each_flat_index( execution::pool, dst,
+                           [&]( const size_t i ){ dst.flatten(i) = generator(); } );
+      return;
+  }
 
-# ifdef _OPENMP
-   # pragma omp parallel for
-# endif
-      for( size_t i=0; i<len; ++i ){ dst.flatten(i) = generator(); }
 
+/*
+ * Views, any execution policy
+ */
+   template<execution_policy Policy,
+            typename          ElemT,
+            int                NDIM,
+            GridType             GT,
+            typename      Generator>
+   void generate( const Policy                          policy,
+                        Array<ElemT,NDIM,GT,ViewSizing>&   dst,
+                        Generator                    generator )
+  {
+      for_each_index( policy, Idx<NDIM,GT>{}, Idx<NDIM,GT>{dst.shape().shape},
+                      [&]( const Idx<NDIM,GT>& idx ){ dst(idx) = generator(); } );
       return;
   }
 
@@ -289,26 +689,6 @@ namespace par
       return;
   }
 
-/*
- * 1D OpenMP execution
- */
-   template<typename     ElemT,
-            GridType        GT,
-            ArraySizing     AS,
-            typename Generator>
-   void generate_idx( execution::openmp_policy,
-                      Array1<ElemT,GT,AS>& dst,
-                      Generator      generator )
-  {
-      const size_t n = dst.shape(0);
-
-# ifdef _OPENMP
-   # pragma omp parallel for
-# endif
-      for( size_t i=0; i<n; ++i ){ dst({i}) = generator( Idx1<GT>{i} ); }
-      return;
-  }
-
 /*
  * 2D serial execution
  */
@@ -334,34 +714,6 @@ namespace par
       return;
   }
 
-/*
- * 2D OpenMP execution
- */
-   template<typename     ElemT,
-            GridType        GT,
-            ArraySizing     AS,
-            typename Generator>
-   void generate_idx( execution::openmp_policy,
-                      Array2<ElemT,GT,AS>& dst,
-                      Generator      generator )
-  {
-      const size_t ni = dst.shape(0);
-      const size_t nj = dst.shape(1);
-
-# ifdef _OPENMP
-   # pragma omp parallel for
-# endif
-      for( size_t i=0; i<ni; ++i )
-     {
-         for( size_t j=0; j<nj; ++j )
-        {
-            const Idx2<GT> idx{i,j};
-            dst(idx) = generator(idx);
-        }
-     }
-      return;
-  }
-
 /*
  * 3D serial execution
  */
@@ -392,34 +744,43 @@ namespace par
   }
 
 /*
- * 3D OpenMP execution
+ * OpenMP execution, any dimension
+ *    the schedule, collapse depth and thread count of the policy are honoured
  */
    template<typename     ElemT,
+            int           NDIM,
             GridType        GT,
             ArraySizing     AS,
             typename Generator>
-   void generate_idx( execution::openmp_policy,
-                      Array3<ElemT,GT,AS>& dst,
-                      Generator      generator )
+   void generate_idx( const execution::openmp_policy& policy,
+                            Array<ElemT,NDIM,GT,AS>&     dst,
+                            Generator              generator )
   {
-      const size_t ni = dst.shape(0);
-      const size_t nj = dst.shape(1);
-      const size_t nk = dst.shape(2);
+      for_each_index( policy, Idx<NDIM,GT>{}, Idx<NDIM,GT>{dst.shape().shape},
+                      [&]( const Idx<NDIM,GT>& idx ){ dst(idx) = generator(idx); } );
+      return;
+  }
 
-# ifdef _OPENMP
-   # pragma omp parallel for
-# endif
-      for( size_t i=0; i<ni; ++i )
-     {
-         for( size_t j=0; j<nj; ++j )
-        {
-            for( size_t k=0; k<nk; ++k )
-           {
-               const Idx3<GT> idx{i,j,k};
-               dst(idx) = generator(idx);
-           }
-        }
-     }
+/*
+ * Thread pool execution, any dimension
+ *    the outermost dimension is split between the threads
+ */
+   template<typename     ElemT,
+            int           NDIM,
+            GridType        GT,
+            ArraySizing     AS,
+            typename Generator>
+   void generate_idx( execution::thread_pool_policy,
+                      Array<ElemT,NDIM,GT,AS>& dst,
+                      Generator          generator )
+  {
+      default_thread_pool().parallel_for( dst.shape(0),
+                                          [&]( const size_t begin, const size_t end )
+                                         {
+                                             for_each_in_tile( outer_slab_first<NDIM,GT>( begin ),
+                                                               outer_slab_last(  dst.shape(), end ),
+                                                               [&]( const Idx<NDIM,GT>& idx ){ dst(idx) = generator(idx); } );
+                                         } );
       return;
   }
 
@@ -447,61 +808,42 @@ namespace par
   }
 
 /*
- * Serial execution
- */
-   template<typename   FuncObj,
-            int           NDIM,
-            typename    ElemT0,
-            typename... ElemTs,
-            GridType        GT,
-            ArraySizing    AS0,
-            ArraySizing... ASs>
-   void for_each( execution::serial_policy,
-                  FuncObj                         func,
-                  Array<ElemT0,NDIM,GT,AS0>&    array0,
-                  Array<ElemTs,NDIM,GT,ASs>&... arrays )
-  {
-      (( assert(   (array0.shape() == arrays.shape())
-                && "par::for_each - arrays must be the same shape" ) ),... );
-
-      const size_t len = array0.flattened_length();
-
-      for( size_t i=0; i<len; ++i )
-     {
-         func( array0.flatten(i),
-               arrays.flatten(i)... );
-     }
-      return;
-  }
-
-/*
- * OpenMP execution
+ * Serial, OpenMP and vectorised execution
  */
-   template<typename   FuncObj,
-            int           NDIM,
-            typename    ElemT0,
-            typename... ElemTs,
-            GridType        GT,
-            ArraySizing    AS0,
-            ArraySizing... ASs>
-   void for_each( execution::openmp_policy,
+   template<execution_policy Policy,
+            typename        FuncObj,
+            int                NDIM,
+            typename         ElemT0,
+            typename...      ElemTs,
+            GridType             GT,
+            ArraySizing         AS0,
+            ArraySizing...      ASs>
+   void for_each( const Policy                    policy,
                   FuncObj                         func,
                   Array<ElemT0,NDIM,GT,AS0>&    array0,
                   Array<ElemTs,NDIM,GT,ASs>&... arrays )
   {
       (( assert(   (array0.shape() == arrays.shape())
                 && "par::for_each - arrays must be the same shape" ) ),... );
-
-      const size_t len = array0.flattened_length();
-
-# ifdef _OPENMP
-   # pragma omp parallel for
-# endif
-      for( size_t i=0; i<len; ++i )
+
+   // views, and arrays with different padding or halo, do not share flattened indices
+      if( !same_storage( array0, arrays... ) )
      {
-         func( array0.flatten(i),
-               arrays.flatten(i)... );
+         for_each_index( policy, Idx<NDIM,GT>{}, Idx<NDIM,GT>{array0.shape().shape},
+                         [&]( const Idx<NDIM,GT>& idx )
+                        {
+                            func( array0(idx),
+                                  arrays(idx)... );
+                        } );
+         return;
      }
+
+      for_each_flat_index( policy, array0,
+                           [&]( const size_t i )
+                          {
+                              func( array0.flatten(i),
+                                    arrays.flatten(i)... );
+                          } );
       return;
   }
 
@@ -721,198 +1063,246 @@ namespace par
 
 
 /*
- * OpenMP execution overloads
+ * OpenMP execution overloads, any dimension
+ *    the schedule, collapse depth and thread count of the policy are honoured
  */
    template<typename   FuncObj,
+            int           NDIM,
             typename    ElemT0,
             typename... ElemTs,
             GridType        GT,
             ArraySizing    AS0,
             ArraySizing... ASs>
-   void for_each_idx( execution::openmp_policy,
-                      FuncObj                     func,
-                      Array1<ElemT0,GT,AS0>&    array0,
-                      Array1<ElemTs,GT,ASs>&... arrays )
+   void for_each_idx( const execution::openmp_policy&  policy,
+                            FuncObj                     func,
+                            Array<ElemT0,NDIM,GT,AS0>&    array0,
+                            Array<ElemTs,NDIM,GT,ASs>&... arrays )
   {
       (( assert(   (array0.shape() == arrays.shape())
                 && "par::for_each - arrays must be the same shape" ) ),... );
 
-      const size_t n = array0.shape(0);
-
-# ifdef _OPENMP
-   # pragma omp parallel for
-# endif
-      for( size_t i=0; i<n; ++i )
-     {
-         const Idx1<GT> idx{i};
-         func( idx, array0(idx),
-                    arrays(idx)... );
-     }
+      for_each_index( policy, Idx<NDIM,GT>{}, Idx<NDIM,GT>{array0.shape().shape},
+                      [&]( const Idx<NDIM,GT>& idx )
+                     {
+                         func( idx, array0(idx),
+                                    arrays(idx)... );
+                     } );
       return;
   }
 
    template<typename   FuncObj,
+            int           NDIM,
             typename    ElemT0,
             typename... ElemTs,
             GridType        GT,
             ArraySizing    AS0,
             ArraySizing... ASs>
-   void for_each_idx( execution::openmp_policy,
-                      FuncObj                     func,
-                      Array2<ElemT0,GT,AS0>&    array0,
-                      Array2<ElemTs,GT,ASs>&... arrays )
+   void for_each_idx( const execution::openmp_policy&        policy,
+                            FuncObj                           func,
+                      const Array<ElemT0,NDIM,GT,AS0>&      array0,
+                      const Array<ElemTs,NDIM,GT,ASs>&... arrays )
   {
       (( assert(   (array0.shape() == arrays.shape())
                 && "par::for_each - arrays must be the same shape" ) ),... );
 
-      const size_t ni = array0.shape(0);
-      const size_t nj = array0.shape(1);
-
-# ifdef _OPENMP
-   # pragma omp parallel for
-# endif
-      for( size_t i=0; i<ni; ++i )
-     {
-         for( size_t j=0; j<nj; ++j )
-        {
-            const Idx2<GT> idx{i,j};
-            func( idx, array0(idx),
-                       arrays(idx)... );
-        }
-     }
+      for_each_index( policy, Idx<NDIM,GT>{}, Idx<NDIM,GT>{array0.shape().shape},
+                      [&]( const Idx<NDIM,GT>& idx )
+                     {
+                         func( idx, array0(idx),
+                                    arrays(idx)... );
+                     } );
       return;
   }
 
+
+/*
+ * Thread pool execution overloads, any dimension
+ *    the outermost dimension is split between the threads
+ */
    template<typename   FuncObj,
+            int           NDIM,
             typename    ElemT0,
             typename... ElemTs,
             GridType        GT,
             ArraySizing    AS0,
             ArraySizing... ASs>
-   void for_each_idx( execution::openmp_policy,
-                      FuncObj                     func,
-                      Array3<ElemT0,GT,AS0>&    array0,
-                      Array3<ElemTs,GT,ASs>&... arrays )
+   void for_each_idx( execution::thread_pool_policy,
+                      FuncObj                         func,
+                      Array<ElemT0,NDIM,GT,AS0>&    array0,
+                      Array<ElemTs,NDIM,GT,ASs>&... arrays )
   {
       (( assert(   (array0.shape() == arrays.shape())
                 && "par::for_each - arrays must be the same shape" ) ),... );
 
-      const size_t ni = array0.shape(0);
-      const size_t nj = array0.shape(1);
-      const size_t nk = array0.shape(2);
-
-# ifdef _OPENMP
-   # pragma omp parallel for
-# endif
-      for( size_t i=0; i<ni; ++i )
-     {
-         for( size_t j=0; j<nj; ++j )
-        {
-            for( size_t k=0; k<nk; ++k )
-           {
-               const Idx3<GT> idx{i,j,k};
-               func( idx, array0(idx),
-                          arrays(idx)... );
-           }
-        }
-     }
+      default_thread_pool().parallel_for( array0.shape(0),
+                                          [&]( const size_t begin, const size_t end )
+                                         {
+                                             for_each_in_tile( outer_slab_first<NDIM,GT>( begin ),
+                                                               outer_slab_last(  array0.shape(), end ),
+                                                               [&]( const Idx<NDIM,GT>& idx )
+                                                              {
+                                                                  func( idx, array0(idx),
+                                                                             arrays(idx)... );
+                                                              } );
+                                         } );
       return;
   }
 
-
    template<typename   FuncObj,
+            int           NDIM,
             typename    ElemT0,
             typename... ElemTs,
             GridType        GT,
             ArraySizing    AS0,
             ArraySizing... ASs>
-   void for_each_idx(       execution::openmp_policy,
-                            FuncObj                     func,
-                      const Array1<ElemT0,GT,AS0>&    array0,
-                      const Array1<ElemTs,GT,ASs>&... arrays )
+   void for_each_idx(       execution::thread_pool_policy,
+                            FuncObj                         func,
+                      const Array<ElemT0,NDIM,GT,AS0>&    array0,
+                      const Array<ElemTs,NDIM,GT,ASs>&... arrays )
   {
       (( assert(   (array0.shape() == arrays.shape())
                 && "par::for_each - arrays must be the same shape" ) ),... );
 
-      const size_t n = array0.shape(0);
+      default_thread_pool().parallel_for( array0.shape(0),
+                                          [&]( const size_t begin, const size_t end )
+                                         {
+                                             for_each_in_tile( outer_slab_first<NDIM,GT>( begin ),
+                                                               outer_slab_last(  array0.shape(), end ),
+                                                               [&]( const Idx<NDIM,GT>& idx )
+                                                              {
+                                                                  func( idx, array0(idx),
+                                                                             arrays(idx)... );
+                                                              } );
+                                         } );
+      return;
+  }
 
-# ifdef _OPENMP
-   # pragma omp parallel for
-# endif
-      for( size_t i=0; i<n; ++i )
+
+/*
+ * Cache-blocked execution overloads: elements are visited tile by tile, and tiles are processed in parallel if the policy allows
+ */
+   template<execution_policy  Policy,
+            typename         FuncObj,
+            int                 NDIM,
+            typename          ElemT0,
+            typename...       ElemTs,
+            GridType              GT,
+            ArraySizing          AS0,
+            ArraySizing...       ASs>
+   void for_each_idx( const Policy                      policy,
+                      const Tiling<NDIM>&               tiling,
+                            FuncObj                       func,
+                            Array<ElemT0,NDIM,GT,AS0>&    array0,
+                            Array<ElemTs,NDIM,GT,ASs>&... arrays )
+  {
+      (( assert(   (array0.shape() == arrays.shape())
+                && "par::for_each - arrays must be the same shape" ) ),... );
+
+      const auto tile_func = [&]( const Idx<NDIM,GT>& first,
+                                  const Idx<NDIM,GT>&  last )
      {
-         const Idx1<GT> idx{i};
-         func( idx, array0(idx),
-                    arrays(idx)... );
-     }
+         for_each_in_tile( first, last,
+                           [&]( const Idx<NDIM,GT>& idx )
+                          {
+                              func( idx, array0(idx),
+                                         arrays(idx)... );
+                          } );
+     };
+
+      for_each_tile( policy, tiling, array0.shape(), tile_func );
       return;
   }
 
-   template<typename   FuncObj,
-            typename    ElemT0,
-            typename... ElemTs,
-            GridType        GT,
-            ArraySizing    AS0,
-            ArraySizing... ASs>
-   void for_each_idx(       execution::openmp_policy,
-                            FuncObj                     func,
-                      const Array2<ElemT0,GT,AS0>&    array0,
-                      const Array2<ElemTs,GT,ASs>&... arrays )
+   template<execution_policy  Policy,
+            typename         FuncObj,
+            int                 NDIM,
+            typename          ElemT0,
+            typename...       ElemTs,
+            GridType              GT,
+            ArraySizing          AS0,
+            ArraySizing...       ASs>
+   void for_each_idx( const Policy                            policy,
+                      const Tiling<NDIM>&                     tiling,
+                            FuncObj                             func,
+                      const Array<ElemT0,NDIM,GT,AS0>&        array0,
+                      const Array<ElemTs,NDIM,GT,ASs>&...     arrays )
   {
       (( assert(   (array0.shape() == arrays.shape())
                 && "par::for_each - arrays must be the same shape" ) ),... );
 
-      const size_t ni = array0.shape(0);
-      const size_t nj = array0.shape(1);
-
-# ifdef _OPENMP
-   # pragma omp parallel for
-# endif
-      for( size_t i=0; i<ni; ++i )
+      const auto tile_func = [&]( const Idx<NDIM,GT>& first,
+                                  const Idx<NDIM,GT>&  last )
      {
-         for( size_t j=0; j<nj; ++j )
-        {
-            const Idx2<GT> idx{i,j};
-            func( idx, array0(idx),
-                       arrays(idx)... );
-        }
-     }
+         for_each_in_tile( first, last,
+                           [&]( const Idx<NDIM,GT>& idx )
+                          {
+                              func( idx, array0(idx),
+                                         arrays(idx)... );
+                          } );
+     };
+
+      for_each_tile( policy, tiling, array0.shape(), tile_func );
       return;
   }
 
-   template<typename   FuncObj,
-            typename    ElemT0,
-            typename... ElemTs,
-            GridType        GT,
-            ArraySizing    AS0,
-            ArraySizing... ASs>
-   void for_each_idx(       execution::openmp_policy,
-                            FuncObj                     func,
-                      const Array3<ElemT0,GT,AS0>&    array0,
-                      const Array3<ElemTs,GT,ASs>&... arrays )
+
+/*
+ * Bounding-box overloads: only the elements with indices in box are visited, in parallel if the policy allows
+ *    func is passed the index of each element in the whole array
+ */
+   template<execution_policy  Policy,
+            typename         FuncObj,
+            int                 NDIM,
+            typename          ElemT0,
+            typename...       ElemTs,
+            GridType              GT,
+            ArraySizing          AS0,
+            ArraySizing...       ASs>
+   void for_each_idx( const Policy                      policy,
+                      const Box<NDIM,GT>&                  box,
+                            FuncObj                       func,
+                            Array<ElemT0,NDIM,GT,AS0>&    array0,
+                            Array<ElemTs,NDIM,GT,ASs>&... arrays )
   {
       (( assert(   (array0.shape() == arrays.shape())
                 && "par::for_each - arrays must be the same shape" ) ),... );
 
-      const size_t ni = array0.shape(0);
-      const size_t nj = array0.shape(1);
-      const size_t nk = array0.shape(2);
+      assert( box_within( box, array0.shape() ) && "par::for_each - box must lie within the arrays" );
 
-# ifdef _OPENMP
-   # pragma omp parallel for
-# endif
-      for( size_t i=0; i<ni; ++i )
-     {
-         for( size_t j=0; j<nj; ++j )
-        {
-            for( size_t k=0; k<nk; ++k )
-           {
-               const Idx3<GT> idx{i,j,k};
-               func( idx, array0(idx),
-                          arrays(idx)... );
-           }
-        }
-     }
+      for_each_index( policy, box.first, box.last,
+                      [&]( const Idx<NDIM,GT>& idx )
+                     {
+                         func( idx, array0(idx),
+                                    arrays(idx)... );
+                     } );
+      return;
+  }
+
+   template<execution_policy  Policy,
+            typename         FuncObj,
+            int                 NDIM,
+            typename          ElemT0,
+            typename...       ElemTs,
+            GridType              GT,
+            ArraySizing          AS0,
+            ArraySizing...       ASs>
+   void for_each_idx( const Policy                            policy,
+                      const Box<NDIM,GT>&                        box,
+                            FuncObj                             func,
+                      const Array<ElemT0,NDIM,GT,AS0>&        array0,
+                      const Array<ElemTs,NDIM,GT,ASs>&...     arrays )
+  {
+      (( assert(   (array0.shape() == arrays.shape())
+                && "par::for_each - arrays must be the same shape" ) ),... );
+
+      assert( box_within( box, array0.shape() ) && "par::for_each - box must lie within the arrays" );
+
+      for_each_index( policy, box.first, box.last,
+                      [&]( const Idx<NDIM,GT>& idx )
+                     {
+                         func( idx, array0(idx),
+                                    arrays(idx)... );
+                     } );
       return;
   }
 
@@ -952,9 +1342,9 @@ namespace par
             GridType        GT,
             ArraySizing    AS0,
             ArraySizing... ASs>
-   Array<ElemT0,NDIM,GT,AS0> transform( const FuncObj&                      func,
-                                        const Array<ElemT0,NDIM,GT,AS0>&    src0,
-                                        const Array<ElemTs,NDIM,GT,ASs>&... srcs )
+   auto transform( const FuncObj&                      func,
+                   const Array<ElemT0,NDIM,GT,AS0>&    src0,
+                   const Array<ElemTs,NDIM,GT,ASs>&... srcs )
   {
       return transform( execution::seq, func, src0, srcs... );
   }
@@ -967,29 +1357,31 @@ namespace par
             GridType             GT,
             ArraySizing         AS0,
             ArraySizing...      ASs>
-   Array<ElemT0,NDIM,GT,AS0> transform(       Policy                      policy,
-                                        const FuncObj&                      func,
-                                        const Array<ElemT0,NDIM,GT,AS0>&    src0,
-                                        const Array<ElemTs,NDIM,GT,ASs>&... srcs )
+   auto transform(       Policy                      policy,
+                   const FuncObj&                      func,
+                   const Array<ElemT0,NDIM,GT,AS0>&    src0,
+                   const Array<ElemTs,NDIM,GT,ASs>&... srcs )
   {
-      Array<ElemT0,NDIM,GT,AS0> dst(src0.shape());
+   // the result of transforming a view owns its elements
+      Array<std::remove_const_t<ElemT0>,NDIM,GT,owning_sizing_v<AS0>> dst(src0.shape(),src0.layout());
       transform( policy, func, dst, src0, srcs... );
       return dst;
   }
 
 /*
- * Serial execution
+ * Serial, OpenMP and vectorised execution
  */
-   template<typename   FuncObj,
-            int           NDIM,
-            typename    ElemTd,
-            typename    ElemT0,
-            typename... ElemTs,
-            GridType        GT,
-            ArraySizing    ASd,
-            ArraySizing    AS0,
-            ArraySizing... ASs>
-   void transform(       execution::serial_policy,
+   template<execution_policy Policy,
+            typename        FuncObj,
+            int                NDIM,
+            typename         ElemTd,
+            typename         ElemT0,
+            typename...      ElemTs,
+            GridType             GT,
+            ArraySizing         ASd,
+            ArraySizing         AS0,
+            ArraySizing...      ASs>
+   void transform( const Policy                        policy,
                    const FuncObj&                      func,
                          Array<ElemTd,NDIM,GT,ASd>&     dst,
                    const Array<ElemT0,NDIM,GT,AS0>&    src0,
@@ -1001,29 +1393,42 @@ namespace par
       (( assert(   (dst.shape() == srcs.shape())
                 && "par::transform - arrays must be the same shape" ) ),... );
 
-      const size_t len = dst.flattened_length();
-   
-      for( size_t i=0; i<len; ++i )
+   // views, and arrays with different padding or halo, do not share flattened indices
+      if( !same_storage( dst, src0, srcs... ) )
      {
-         dst.flatten(i) = func( src0.flatten(i),
-                                srcs.flatten(i)... );
+         for_each_index( policy, Idx<NDIM,GT>{}, Idx<NDIM,GT>{dst.shape().shape},
+                         [&]( const Idx<NDIM,GT>& idx )
+                        {
+                            dst(idx) = func( src0(idx),
+                                             srcs(idx)... );
+                        } );
+         return;
      }
+
+      for_each_flat_index( policy, dst,
+                           [&]( const size_t i )
+                          {
+                              dst.flatten(i) = func( src0.flatten(i),
+                                                     srcs.flatten(i)... );
+                          } );
       return;
   }
 
 /*
- * OpenMP execution
+ * Bounding-box overload: only the elements with indices in box are transformed, the rest of dst is unchanged
  */
-   template<typename   FuncObj,
-            int           NDIM,
-            typename    ElemTd,
-            typename    ElemT0,
-            typename... ElemTs,
-            GridType        GT,
-            ArraySizing    ASd,
-            ArraySizing    AS0,
-            ArraySizing... ASs>
-   void transform(       execution::openmp_policy,
+   template<execution_policy Policy,
+            typename        FuncObj,
+            int                NDIM,
+            typename         ElemTd,
+            typename         ElemT0,
+            typename...      ElemTs,
+            GridType             GT,
+            ArraySizing         ASd,
+            ArraySizing         AS0,
+            ArraySizing...      ASs>
+   void transform( const Policy                        policy,
+                   const Box<NDIM,GT>&                    box,
                    const FuncObj&                      func,
                          Array<ElemTd,NDIM,GT,ASd>&     dst,
                    const Array<ElemT0,NDIM,GT,AS0>&    src0,
@@ -1035,19 +1440,18 @@ namespace par
       (( assert(   (dst.shape() == srcs.shape())
                 && "par::transform - arrays must be the same shape" ) ),... );
 
-      const size_t len = dst.flattened_length();
-   
-# ifdef _OPENMP
-   # pragma omp parallel for
-# endif
-      for( size_t i=0; i<len; ++i )
-     {
-         dst.flatten(i) = func( src0.flatten(i),
-                                srcs.flatten(i)... );
-     }
+      assert( box_within( box, dst.shape() ) && "par::transform - box must lie within the arrays" );
+
+      for_each_index( policy, box.first, box.last,
+                      [&]( const Idx<NDIM,GT>& idx )
+                     {
+                         dst(idx) = func( src0(idx),
+                                          srcs(idx)... );
+                     } );
       return;
   }
 
+
 /*
  * ------------------------- par::transform_reduce ------------------------
  */
@@ -1074,18 +1478,26 @@ namespace par
   }
 
 /*
- * Serial execution
+ * Serial, OpenMP and vectorised execution
+ *    elements are reduced in fixed chunks which are then combined in a fixed order (see par::reduce_chunks),
+ *    so the result is bitwise identical for serial or OpenMP execution with any number of threads
+ *    vectorised policies reduce each chunk into independent lanes (see par::reduce_lanes). Their results are also identical for any
+ *    number of threads, but can differ in the last bits from the unvectorised policies for non-associative reductions
+ *    init is combined exactly once, and the result of tfunc must be convertible to ReductionType
+ *    packs containing a view, or arrays with different padding or halo, are reduced in the same chunks,
+ *    but each chunk is reduced in order by index even with vectorised policies
  */
-   template<int                  NDIM,
-            typename TransformFuncObj,
-            typename    ReduceFuncObj,
-            typename    ReductionType,
-            typename           ElemT0,
-            typename...        ElemTs,
-            GridType               GT,
-            ArraySizing           AS0,
-            ArraySizing...        ASs>
-   ReductionType transform_reduce(       execution::serial_policy,
+   template<execution_policy       Policy,
+            int                      NDIM,
+            typename     TransformFuncObj,
+            typename        ReduceFuncObj,
+            typename        ReductionType,
+            typename               ElemT0,
+            typename...            ElemTs,
+            GridType                   GT,
+            ArraySizing               AS0,
+            ArraySizing...            ASs>
+   ReductionType transform_reduce( const Policy                       policy,
                                    const TransformFuncObj&            tfunc,
                                    const    ReduceFuncObj&            rfunc,
                                          ReductionType                 init,
@@ -1095,30 +1507,79 @@ namespace par
       (( assert(   (src0.shape() == srcs.shape())
                 && "par::transform_reduce - arrays must be the same shape" ) ),... );
 
-      const size_t len = src0.flattened_length();
+   // views, and arrays with different padding or halo, do not share flattened indices
+      const bool by_index = !same_storage( src0, srcs... );
 
-      for( size_t i=0; i<len; ++i )
+   // reduction of elements [nbegin,nend), in order or in independent vector lanes
+      const auto chunk_func = [&]( const size_t nbegin,
+                                   const size_t   nend ) -> ReductionType
      {
-         init = rfunc( std::move(init),
-                       tfunc( src0.flatten(i),
-                              srcs.flatten(i)... ) );
-     }
-      return init;
+         if( by_index )
+        {
+            Idx<NDIM,GT> idx = unflatten_index( src0.shape(), nbegin );
+
+            ReductionType partial( tfunc( src0(idx),
+                                          srcs(idx)... ) );
+
+            for( size_t n=nbegin+1; n<nend; ++n )
+           {
+               next_index( src0.shape(), idx );
+               partial = rfunc( std::move(partial),
+                                tfunc( src0(idx),
+                                       srcs(idx)... ) );
+           }
+            return partial;
+        }
+
+         if constexpr( is_simd_policy_v<Policy> )
+        {
+            const auto value_func = [&]( const size_t n )
+           {
+               const size_t i = flat_index( src0, n );
+               return tfunc( src0.flatten(i),
+                             srcs.flatten(i)... );
+           };
+
+            return reduce_lanes<ReductionType>( nbegin, nend, value_func, rfunc );
+        }
+         else
+        {
+            const size_t i0 = flat_index( src0, nbegin );
+
+            ReductionType partial( tfunc( src0.flatten(i0),
+                                          srcs.flatten(i0)... ) );
+
+            for_each_flat_index_in_range( src0, nbegin+1, nend,
+                                          [&]( const size_t i )
+                                         {
+                                             partial = rfunc( std::move(partial),
+                                                              tfunc( src0.flatten(i),
+                                                                     srcs.flatten(i)... ) );
+                                         } );
+            return partial;
+        }
+     };
+
+      return reduce_chunks( policy, length(src0.shape()),
+                            chunk_func, rfunc, std::move(init) );
   }
 
 /*
- * OpenMP execution
+ * Bounding-box overload: only the elements with indices in box are reduced
+ *    the elements are reduced by index in the same fixed chunks as a view of the box, so results do not depend on the number of threads
  */
-   template<int                  NDIM,
-            typename TransformFuncObj,
-            typename    ReduceFuncObj,
-            typename    ReductionType,
-            typename           ElemT0,
-            typename...        ElemTs,
-            GridType               GT,
-            ArraySizing           AS0,
-            ArraySizing...        ASs>
-   ReductionType transform_reduce(       execution::openmp_policy,
+   template<execution_policy       Policy,
+            int                      NDIM,
+            typename     TransformFuncObj,
+            typename        ReduceFuncObj,
+            typename        ReductionType,
+            typename               ElemT0,
+            typename...            ElemTs,
+            GridType                   GT,
+            ArraySizing               AS0,
+            ArraySizing...            ASs>
+   ReductionType transform_reduce( const Policy                       policy,
+                                   const Box<NDIM,GT>&                   box,
                                    const TransformFuncObj&            tfunc,
                                    const    ReduceFuncObj&            rfunc,
                                          ReductionType                 init,
@@ -1128,36 +1589,82 @@ namespace par
       (( assert(   (src0.shape() == srcs.shape())
                 && "par::transform_reduce - arrays must be the same shape" ) ),... );
 
-      const size_t len = src0.flattened_length();
+      return transform_reduce( policy, tfunc, rfunc, std::move(init),
+                               subview( src0, box ),
+                               subview( srcs, box )... );
+  }
 
-# ifdef _OPENMP
-      const int nthreads = omp_get_max_threads();
-# else
-      const int nthreads = 1;
-# endif
 
-   // each thread reduces into thread_local_init[thread_num]
-      std::vector<ReductionType> thread_local_init(nthreads,init);
+/*
+ * ------------------------- par::for_each_idx_reduce ------------------------
+ */
 
-   // reduce values for each threads share of elements
-# ifdef _OPENMP
-   # pragma omp parallel for
-# endif
-      for( size_t i=0; i<len; ++i )
-     {
-         const int thread_num = omp_get_thread_num();
+/*
+ * Applies func( idx, dst element, src elements... ) to each element pack, and reduces the values it returns with the given binary functor
+ *    func may modify the element of dst (e.g. update a solution), so a pass which writes one array and reduces a value from the
+ *    same elements (e.g. the maximum stable timestep) is made in a single sweep. The source arrays are read only
+ *    elements are reduced by index in the same fixed chunks as par::transform_reduce, so the result does not depend on the number of threads
+ */
+   template<typename          FuncObj,
+            typename    ReduceFuncObj,
+            typename    ReductionType,
+            int                  NDIM,
+            typename           ElemTd,
+            typename...        ElemTs,
+            GridType               GT,
+            ArraySizing           ASd,
+            ArraySizing...        ASs>
+   ReductionType for_each_idx_reduce( const FuncObj&                      func,
+                                      const ReduceFuncObj&               rfunc,
+                                            ReductionType                 init,
+                                            Array<ElemTd,NDIM,GT,ASd>&     dst,
+                                      const Array<ElemTs,NDIM,GT,ASs>&... srcs )
+  {
+      return for_each_idx_reduce( execution::seq, func, rfunc, init, dst, srcs... );
+  }
 
-         thread_local_init[thread_num] = rfunc( std::move(thread_local_init[thread_num]),
-                                                tfunc( src0.flatten(i),
-                                                       srcs.flatten(i)... ) );
-     }
+   template<execution_policy       Policy,
+            typename              FuncObj,
+            typename        ReduceFuncObj,
+            typename        ReductionType,
+            int                      NDIM,
+            typename               ElemTd,
+            typename...            ElemTs,
+            GridType                   GT,
+            ArraySizing               ASd,
+            ArraySizing...            ASs>
+   ReductionType for_each_idx_reduce( const Policy                       policy,
+                                      const FuncObj&                      func,
+                                      const ReduceFuncObj&               rfunc,
+                                            ReductionType                 init,
+                                            Array<ElemTd,NDIM,GT,ASd>&     dst,
+                                      const Array<ElemTs,NDIM,GT,ASs>&... srcs )
+  {
+      (( assert(   (dst.shape() == srcs.shape())
+                && "par::for_each_idx_reduce - arrays must be the same shape" ) ),... );
 
-   // reduce values from each thread
-      for( const ReductionType& tli : thread_local_init )
+   // in order reduction of elements [nbegin,nend)
+      const auto chunk_func = [&]( const size_t nbegin,
+                                   const size_t   nend ) -> ReductionType
      {
-         init = rfunc( std::move(init), tli );
-     }
+         Idx<NDIM,GT> idx = unflatten_index( dst.shape(), nbegin );
+
+         ReductionType partial( func( idx,
+                                      dst(idx),
+                                      srcs(idx)... ) );
+
+         for( size_t n=nbegin+1; n<nend; ++n )
+        {
+            next_index( dst.shape(), idx );
+            partial = rfunc( std::move(partial),
+                             func( idx,
+                                   dst(idx),
+                                   srcs(idx)... ) );
+        }
+         return partial;
+     };
 
-      return init;
+      return reduce_chunks( policy, length(dst.shape()),
+                            chunk_func, rfunc, std::move(init) );
   }
 }
@@ -0,0 +1,123 @@
+
+# pragma once
+
+# include <parallalg/parallalg.h>
+
+# include <algorithm>
+# include <cassert>
+# include <cstdlib>
+# include <cstddef>
+# include <new>
+# include <type_traits>
+# include <utility>
+
+# ifdef __linux__
+   # include <sys/mman.h>
+# endif
+
+namespace par
+{
+
+/*
+ * size in bytes of a cache line. Array memory is aligned to (at least) this
+ */
+   inline constexpr size_t cache_line_size = 64;
+
+/*
+ * size in bytes of a transparent huge page on x86-64 linux
+ */
+   inline constexpr size_t huge_page_size = 2*1024*1024;
+
+/*
+ * a value padded out to a whole number of cache lines, so that values written by different threads never share a cache line
+ */
+   template<typename T>
+   struct alignas(cache_line_size) CacheLinePadded
+  {
+      T value;
+  };
+
+/*
+ * Allocator returning memory aligned to a cache line, used for the underlying memory of Array
+ *    if huge_pages is set, allocations of at least one huge page are aligned to a huge page and the kernel is advised to back them with
+ *    transparent huge pages (madvise(MADV_HUGEPAGE)). This is only a hint, and is ignored on systems without transparent huge pages
+ *    all memory is released with std::free, so any two aligned_allocators are interchangeable
+ *    elements are value-initialised when no value is given, unless default_init is set. Default-initialised memory of trivially
+ *    default constructible types is not written (and therefore not placed on a NUMA node) until it is first used, so default_init
+ *    is only for containers which are filled straight after construction (see par::uninitialised)
+ */
+   template<typename T>
+   struct aligned_allocator
+  {
+      using value_type = T;
+
+      using propagate_on_container_copy_assignment = std::true_type;
+      using propagate_on_container_move_assignment = std::true_type;
+      using propagate_on_container_swap            = std::true_type;
+      using is_always_equal                        = std::true_type;
+
+      bool huge_pages=false;
+      bool default_init=false;
+
+      aligned_allocator() = default;
+      aligned_allocator( const bool use_huge_pages, const bool use_default_init=false )
+                       : huge_pages(use_huge_pages), default_init(use_default_init) {}
+
+      template<typename U>
+      aligned_allocator( const aligned_allocator<U>& other ) : huge_pages(other.huge_pages), default_init(other.default_init) {}
+
+      T* allocate( const size_t n )
+     {
+      // std::aligned_alloc may return null for a zero size, which would look like a failed allocation
+         if( n==0 ){ return nullptr; }
+
+         const size_t bytes = n*sizeof(T);
+
+         const bool use_huge_pages = huge_pages && (bytes>=huge_page_size);
+
+         const size_t alignment = use_huge_pages ? huge_page_size
+                                                 : std::max( cache_line_size, alignof(T) );
+
+      // std::aligned_alloc requires the size to be a multiple of the alignment
+         const size_t padded_bytes = alignment*( (bytes+alignment-1)/alignment );
+
+      // the project is built without exceptions, so running out of memory is fatal
+         void* p = std::aligned_alloc( alignment, padded_bytes );
+         assert( p && "par::aligned_allocator - allocation failed" );
+         if( !p ){ std::abort(); }
+
+# ifdef __linux__
+   # ifdef MADV_HUGEPAGE
+         if( use_huge_pages ){ madvise( p, padded_bytes, MADV_HUGEPAGE ); }
+   # endif
+# endif
+
+         return static_cast<T*>(p);
+     }
+
+      void deallocate( T* p, const size_t ) noexcept
+     {
+         std::free(p);
+     }
+
+   // value-initialise, or default-initialise if default_init is set
+      template<typename U>
+      void construct( U* p ) noexcept( std::is_nothrow_default_constructible_v<U> )
+     {
+         if( default_init ){ ::new(static_cast<void*>(p)) U;   }
+         else              { ::new(static_cast<void*>(p)) U(); }
+     }
+
+      template<typename U, typename... Args>
+      void construct( U* p, Args&&... args )
+     {
+         ::new(static_cast<void*>(p)) U( std::forward<Args>(args)... );
+     }
+  };
+
+   template<typename T, typename U>
+   bool operator==( const aligned_allocator<T>&, const aligned_allocator<U>& ){ return true; }
+
+   template<typename T, typename U>
+   bool operator!=( const aligned_allocator<T>&, const aligned_allocator<U>& ){ return false; }
+}
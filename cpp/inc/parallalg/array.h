@@ -2,6 +2,9 @@
 # pragma once
 
 # include <parallalg/parallalg.h>
+# include <parallalg/allocator.h>
+# include <parallalg/schedule.h>
+# include <parallalg/thread_pool.h>
 
 # include <utils/type-traits.h>
 
@@ -37,9 +40,22 @@ namespace par
       const size_t& operator[]( const unsigned int i ) const { return shape[i]; }
   };
 
+/*
+ * Half-open box of indices [first,last) in an NDIM-dimensional array, e.g. a boundary strip, a refined region or a tile
+ *    algorithms taking a Box only visit the elements inside it
+ */
+   template<int          NDIM,
+            GridType GRIDTYPE= Primal>
+   struct Box
+  {
+      Idx<NDIM,GRIDTYPE> first;
+      Idx<NDIM,GRIDTYPE>  last;
+  };
+
 /*
  * The strides in memory needed to flatten an NDIM-dimensional array with no padding
  *    last index changes fastest (row-major)
+ *    strides of padded arrays are constructed from the padded shape
  *
  *    eg in 3D, the element in memory corresponding to index {i,j,k} is: stride[0]*i + stride[1]*j + stride[2]*k
  */
@@ -55,6 +71,9 @@ namespace par
          for( int i=NDIM-2; i>=0; i-- ){ strides[i]=strides[i+1]*shape[i+1]; }
      }
 
+   // arbitrary strides, e.g. for views into another array
+      explicit Stride( const std::array<size_t,NDIM>& s ) : strides(s) {}
+
       const size_t& operator[]( const unsigned int i ) const { return strides[i]; }
   };
 
@@ -177,6 +196,19 @@ namespace par
       return isSame;
   }
 
+/*
+ * check if two Strides are equal (strides in all dimensions are equal)
+ */
+   template<int          NDIM,
+            GridType GRIDTYPE>
+   bool operator==( const Stride<NDIM,GRIDTYPE>& lhs,
+                    const Stride<NDIM,GRIDTYPE>& rhs )
+  {
+      bool isSame=true;
+      for( unsigned int i=0; i<NDIM; i++ ){ isSame = isSame && (lhs[i]==rhs[i]); }
+      return isSame;
+  }
+
 /*
  * calculate the index in the flattened array corresponding to the n-dimensional index 'idx', in an n-dimensional array with shape 'stride'
  */
@@ -225,6 +257,19 @@ namespace par
       return dual_shape;
   }
 
+/*
+ * return Shape of the array of faces normal to dimension dim, given Shape of dual array
+ *    face idx lies between dual elements idx-1 and idx in dimension dim, so faces are primal in dimension dim
+ */
+   template<int NDIM>
+   PrimalShape<NDIM> faceShape( const DualShape<NDIM>& dual_shape, const int dim )
+  {
+      PrimalShape<NDIM> face_shape;
+      for( unsigned int i=0; i<NDIM; i++ ){ face_shape.shape[i]=dual_shape[i]; }
+      face_shape.shape[dim]+=1;
+      return face_shape;
+  }
+
 /*
  * return length of flattened array corresponding to NDIM-dimensional array with given shape
  */
@@ -237,6 +282,76 @@ namespace par
       return l;
   }
 
+/*
+ * return the Shape of the indices in a Box
+ */
+   template<int          NDIM,
+            GridType GRIDTYPE>
+   Shape<NDIM,GRIDTYPE> box_shape( const Box<NDIM,GRIDTYPE>& box )
+  {
+      Shape<NDIM,GRIDTYPE> s;
+      for( unsigned int i=0; i<NDIM; i++ ){ s.shape[i] = box.last[i]>box.first[i] ? box.last[i]-box.first[i] : 0; }
+      return s;
+  }
+
+/*
+ * return the Box of all indices of an array with given shape
+ */
+   template<int          NDIM,
+            GridType GRIDTYPE>
+   Box<NDIM,GRIDTYPE> whole_box( const Shape<NDIM,GRIDTYPE>& shape )
+  {
+      return Box<NDIM,GRIDTYPE>{ Idx<NDIM,GRIDTYPE>{}, Idx<NDIM,GRIDTYPE>{shape.shape} };
+  }
+
+/*
+ * check if every index of a Box lies inside an array with given shape
+ */
+   template<int          NDIM,
+            GridType GRIDTYPE>
+   bool box_within( const Box<NDIM,GRIDTYPE>&     box,
+                    const Shape<NDIM,GRIDTYPE>& shape )
+  {
+      for( unsigned int i=0; i<NDIM; i++ )
+     {
+         if( box.first[i]>box.last[i] || box.last[i]>shape[i] ){ return false; }
+     }
+      return true;
+  }
+
+/*
+ * return the index of the n-th element of an array with given shape, counting in row-major order
+ */
+   template<int          NDIM,
+            GridType GRIDTYPE>
+   Idx<NDIM,GRIDTYPE> unflatten_index( const Shape<NDIM,GRIDTYPE>& shape,
+                                             size_t                   n )
+  {
+      Idx<NDIM,GRIDTYPE> idx;
+      for( int i=NDIM-1; i>=0; i-- )
+     {
+         idx.idxs[i] = n%shape[i];
+         n/=shape[i];
+     }
+      return idx;
+  }
+
+/*
+ * advance idx to the next index of an array with given shape, in row-major order
+ */
+   template<int          NDIM,
+            GridType GRIDTYPE>
+   void next_index( const Shape<NDIM,GRIDTYPE>& shape,
+                          Idx<NDIM,GRIDTYPE>&     idx )
+  {
+      for( int i=NDIM-1; i>0; i-- )
+     {
+         if( ++idx.idxs[i]<shape[i] ){ return; }
+         idx.idxs[i]=0;
+     }
+      ++idx.idxs[0];
+  }
+
 
 /*
  * ---------------- Memory handling types  -----------------------------------------
@@ -244,10 +359,142 @@ namespace par
 
 /*
  * Flag to set whether an array has fixed size from initialisation, or can be dynamically resized
+ *    View arrays do not own their elements, and refer to (part of) the memory of another array (see parallalg/view.h)
  */
-   enum struct ArraySizing { Fixed, Dynamic };
+   enum struct ArraySizing { Fixed, Dynamic, View };
    constexpr ArraySizing   FixedSize = ArraySizing::Fixed;
    constexpr ArraySizing DynamicSize = ArraySizing::Dynamic;
+   constexpr ArraySizing  ViewSizing = ArraySizing::View;
+
+/*
+ * true if any of the array sizings is a view
+ *    algorithms traverse packs of arrays containing a view by index rather than by flattened index, because views need not share strides
+ */
+   template<ArraySizing... ASs>
+   inline constexpr bool any_view_v = ((ASs==ViewSizing)||...);
+
+/*
+ * sizing of a new array holding a copy of an array with the given sizing: copies of views own their elements
+ */
+   template<ArraySizing AS>
+   inline constexpr ArraySizing owning_sizing_v = AS==ViewSizing ? FixedSize : AS;
+
+/*
+ * true for lazy whole-array expressions (see parallalg/expression.h), which can be assigned to an array
+ */
+   template<typename T>
+   struct is_array_expression : std::false_type {};
+
+   template<typename T>
+   inline constexpr bool is_array_expression_v = is_array_expression<T>::value;
+
+/*
+ * Options for the layout of the underlying memory of an array. Memory is always aligned to a cache line
+ *    pad:        pad the fastest-varying dimension (NDIM>1 only) so that every row starts on a cache line,
+ *                and the distance between rows is not a multiple of the cache-set aliasing stride
+ *    huge_pages: request that large arrays are backed by transparent huge pages
+ *    halo:       width of a layer of extra elements stored around the array in every dimension, e.g. for ghost cells
+ */
+   struct MemoryLayout
+  {
+      bool pad=false;
+      bool huge_pages=false;
+      size_t halo=0;
+  };
+
+   inline constexpr MemoryLayout    padded{true, false};
+   inline constexpr MemoryLayout hugepaged{false,true};
+
+/*
+ * layout with a halo of given width, and otherwise the same options as layout e.g.:
+ *    Array<double,2> q( Shape<2>{ni,nj}, halo_layout(1,padded) );
+ */
+   constexpr MemoryLayout halo_layout( const size_t     width,
+                                             MemoryLayout layout={} )
+  {
+      layout.halo=width;
+      return layout;
+  }
+
+/*
+ * tag requesting that an array is constructed without initialising its elements, e.g.:
+ *    Array<double,2> q( uninitialised, Shape<2>{ni,nj} );
+ *    the memory of trivially default constructible types is then not written until it is first used, e.g. by a parallel par::fill or
+ *    par::copy, which places each page on the NUMA node of the thread which writes it. The elements (and any padding or halo) hold
+ *    indeterminate values until then, so this is only for arrays which are completely written straight after construction
+ */
+   struct uninitialised_t { explicit uninitialised_t() = default; };
+
+   inline constexpr uninitialised_t uninitialised{};
+
+/*
+ * distance in bytes between rows which map to the same cache sets (L1 set count * cache line size)
+ *    rows separated by a multiple of this conflict with each other in cache
+ */
+   inline constexpr size_t cache_alias_stride = 4096;
+
+/*
+ * return the shape of the memory needed to store an array of ElemT with given shape and layout
+ *    the fastest-varying dimension is extended until the row length is a whole number of cache lines (if possible within one cache line)
+ *    and then by a further cache line if the row length is a multiple of cache_alias_stride
+ */
+   template<typename      ElemT,
+            int            NDIM,
+            GridType   GRIDTYPE>
+   Shape<NDIM,GRIDTYPE> paddedShape( const Shape<NDIM,GRIDTYPE>& shape,
+                                     const MemoryLayout         layout )
+  {
+      Shape<NDIM,GRIDTYPE> padded_shape(shape);
+
+      if( !layout.pad || NDIM==1 ){ return padded_shape; }
+
+      size_t& nj = padded_shape.shape[NDIM-1];
+
+      constexpr size_t elem_size = sizeof(ElemT);
+      constexpr size_t line_elems = cache_line_size/elem_size;
+
+   // round row length up to whole cache lines if ElemT packs into cache lines
+      if( cache_line_size%elem_size == 0 )
+     {
+         nj = line_elems*( (nj+line_elems-1)/line_elems );
+     }
+
+   // avoid rows mapping onto the same cache sets
+      if( (nj*elem_size)%cache_alias_stride == 0 )
+     {
+         nj+= std::max( line_elems, size_t(1) );
+     }
+
+      return padded_shape;
+  }
+
+/*
+ * return the shape of the memory needed to store an array of ElemT with given shape and layout, including the halo and any padding
+ */
+   template<typename      ElemT,
+            int            NDIM,
+            GridType   GRIDTYPE>
+   Shape<NDIM,GRIDTYPE> storageShape( const Shape<NDIM,GRIDTYPE>& shape,
+                                      const MemoryLayout         layout )
+  {
+      Shape<NDIM,GRIDTYPE> halo_shape(shape);
+      for( int i=0; i<NDIM; ++i ){ halo_shape.shape[i]+= 2*layout.halo; }
+
+      return paddedShape<ElemT>( halo_shape, layout );
+  }
+
+/*
+ * flattened index of the first element of an array (index {0,0,...}) in memory with given strides, after a halo of given width
+ */
+   template<int          NDIM,
+            GridType GRIDTYPE>
+   size_t haloOrigin( const Stride<NDIM,GRIDTYPE>& stride,
+                      const size_t                   halo )
+  {
+      size_t i=0;
+      for( int m=0; m<NDIM; ++m ){ i+= stride[m]*halo; }
+      return i;
+  }
 
 /*
  * NDIM-dimensional array type. Last index changes fastest (row-major)
@@ -263,6 +510,15 @@ namespace par
  *    ArraySizing defines whether the array extents can be changed after construction
  *       Fixed by default.
  *       resize method only available if Dynamic
+ *    MemoryLayout can be passed at construction to pad the rows of the array, or use huge pages e.g.:
+ *       Array<double,2> myArray( Shape<2>{1024,1024}, padded );
+ *       flattened_length() and flatten() then include the padding elements, which are not part of the array
+ *    MemoryLayout can also add a halo of extra elements around the array, which are addressed with indices just outside the shape of the array.
+ *    Indices into the halo are made by adding a negative (or past-the-end) Offset to an index of the array e.g.:
+ *       Array<double,2> q( Shape<2>{ni,nj}, halo_layout(1) );
+ *       q( Idx<2>{0,j} + Offset<2>{-1,0} ) = qghost;   // halo element to the left of element {0,j}
+ *       index arithmetic wraps modulo 2^64, so the flattened index of a halo element is exact
+ *    Flat algorithms skip the halo elements (like padding), except copy and fill which copy/fill the whole memory
  */
    template<typename       ElemT,
             int             NDIM,
@@ -282,16 +538,24 @@ namespace par
       using ShapeType  = Shape< NDIM,GRIDTYPE>;
       using StrideType = Stride<NDIM,GRIDTYPE>;
 
+      using StorageType = std::vector<ElemT,aligned_allocator<ElemT>>;
+
    private: /* invariant members and underlying memory */
 
    // shape of multi-dimensional array
       ShapeType   shape_array;
 
+   // memory layout options
+      MemoryLayout layout_array;
+
    // place-values for flattening a multi-dimensional index to a 1D index
       StrideType stride_array;
 
+   // flattened index of element {0,0,...}, after the halo
+      size_t origin_array;
+
    // the flattened 1D array in memory
-      std::vector<ElemT> elems_array;
+      StorageType elems_array;
 
    public:
 
@@ -304,31 +568,86 @@ namespace par
       Array& operator=( const Array&  ) = delete;
       Array& operator=(       Array&& ) = default;
 
+   // evaluate a lazy array expression into the elements of the array in one serial pass (par::assign evaluates in parallel)
+      template<typename ExprT>
+         requires is_array_expression_v<ExprT>
+      Array& operator=( const ExprT& expr ){ assign( execution::seq, *this, expr ); return *this; }
+
    // construct with specified dimensions, calculate place-value strides, and initialise flattened array to correct size
       template<typename... Ints>
          requires   (sizeof...(Ints)==NDIM)
                  && (is_integer_v<Ints>&&...)
-      Array( const Ints... Is ) : shape_array{Is...}, stride_array({Is...}), elems_array( (Is*...) ) {}
-
-   // constructor array with shape s, and no initialisation of array elements
-      Array( const ShapeType& s ) : shape_array(s), stride_array(s), elems_array( length(s) ) {}
+      Array( const Ints... Is ) : Array( ShapeType{{static_cast<size_t>(Is)...}} ) {}
+
+   // constructor array with shape s, and value-initialise array elements (and halo)
+      Array( const ShapeType& s, const MemoryLayout layout=MemoryLayout{} )
+         : shape_array(s),
+           layout_array(layout),
+           stride_array( storageShape<ElemT>(s,layout) ),
+           origin_array( haloOrigin(stride_array,layout.halo) ),
+           elems_array( length(storageShape<ElemT>(s,layout)),
+                        aligned_allocator<ElemT>(layout.huge_pages) ) {}
+
+   // constructor array with shape s, and no initialisation of array elements (see par::uninitialised)
+      Array( uninitialised_t, const ShapeType& s, const MemoryLayout layout=MemoryLayout{} )
+         : shape_array(s),
+           layout_array(layout),
+           stride_array( storageShape<ElemT>(s,layout) ),
+           origin_array( haloOrigin(stride_array,layout.halo) ),
+           elems_array( length(storageShape<ElemT>(s,layout)),
+                        aligned_allocator<ElemT>(layout.huge_pages,true) ) {}
+
+   // constructor array with shape s, and initialise array elements (and halo) to val
+      Array( const ShapeType& s, const ElemT& val, const MemoryLayout layout=MemoryLayout{} )
+         : shape_array(s),
+           layout_array(layout),
+           stride_array( storageShape<ElemT>(s,layout) ),
+           origin_array( haloOrigin(stride_array,layout.halo) ),
+           elems_array( length(storageShape<ElemT>(s,layout)), val,
+                        aligned_allocator<ElemT>(layout.huge_pages) ) {}
+
+   // constructor array with shape s, and value-initialise (or initialise to val) the array elements according to policy
+      // with a parallel policy, each page is first touched by the thread which accesses it in flat algorithms with the same policy,
+      // so the memory is placed on that thread's NUMA node
+      template<execution_policy Policy>
+      Array( const Policy policy, const ShapeType& s, const MemoryLayout layout=MemoryLayout{} ) : Array(uninitialised,s,layout)
+     {
+         first_touch( policy, ElemT{} );
+     }
 
-   // constructor array with shape s, and initialise array elements to val
-      Array( const ShapeType& s, const ElemT& val ) : shape_array(s), stride_array(s), elems_array( length(s), val ) {}
+      template<execution_policy Policy>
+      Array( const Policy policy, const ShapeType& s, const ElemT& val, const MemoryLayout layout=MemoryLayout{} )
+         : Array(uninitialised,s,layout)
+     {
+         first_touch( policy, val );
+     }
 
-   // flattened length of array
+   // flattened length of array, including any padding and halo
       size_t flattened_length() const { return elems_array.size(); }
 
+   // true if there is no padding or halo between the elements of the array
+      bool is_contiguous() const { return elems_array.size()==length(shape_array); }
+
+   // flattened index of the first element of the array, after the halo
+      size_t flat_origin() const { return origin_array; }
+
+   // width of the halo around the array
+      size_t halo() const { return layout_array.halo; }
+
    // accessors
-      // elements of array
-      const ElemT& operator()( const IdxType& idx ) const { return elems_array[ stride_array*idx ]; }
-            ElemT& operator()( const IdxType& idx )       { return elems_array[ stride_array*idx ]; }
+      // elements of array, or of the halo for indices outside the shape of the array
+      const ElemT& operator()( const IdxType& idx ) const { return elems_array[ origin_array + stride_array*idx ]; }
+            ElemT& operator()( const IdxType& idx )       { return elems_array[ origin_array + stride_array*idx ]; }
 
       // flattened elements of array
       const ElemT& flatten( const size_t i ) const { return elems_array[i]; }
             ElemT& flatten( const size_t i )       { return elems_array[i]; }
 
-      const std::vector<ElemT>& flatten() const { return elems_array; }
+      const StorageType& flatten() const { return elems_array; }
+
+      // first element of the array in memory, after the halo
+      const ElemT* data() const { return elems_array.data()+origin_array; }
+            ElemT* data()       { return elems_array.data()+origin_array; }
 
       // array properties
       const size_t& shape(  const unsigned int i ) const { return  shape_array[i]; }
@@ -337,14 +656,49 @@ namespace par
       const ShapeType&   shape() const { return  shape_array; }
       const StrideType& stride() const { return stride_array; }
 
+      const MemoryLayout& layout() const { return layout_array; }
+
    /*
     * Can resize array (same dimensions, different shape) if originally declared as dynamic
+    *    the memory layout, including the halo width, is preserved
+    *    new elements are value-initialised, even if the array was constructed uninitialised
     */
       void resize( const ShapeType& s ) requires (SIZING==DynamicSize)
      {
          shape_array  =  ShapeType(s);
-         stride_array = StrideType(s);
-         elems_array.resize(length(s));
+         stride_array = StrideType( storageShape<ElemT>(s,layout_array) );
+         origin_array = haloOrigin( stride_array, layout_array.halo );
+         elems_array.resize( length(storageShape<ElemT>(s,layout_array)), ElemT{} );
+     }
+
+   private:
+
+   // initialise every element of the memory, including padding and halo, to val
+      void first_touch( execution::serial_policy, const ElemT& val )
+     {
+         const size_t len = elems_array.size();
+
+         for( size_t i=0; i<len; ++i ){ elems_array[i] = val; }
+     }
+
+      void first_touch( const execution::openmp_policy& policy, const ElemT& val )
+     {
+         const size_t len = elems_array.size();
+         const int nthreads = openmp_num_threads( policy );
+
+# ifdef _OPENMP
+   # pragma omp parallel for schedule(static) num_threads(nthreads)
+# endif
+         for( size_t i=0; i<len; ++i ){ elems_array[i] = val; }
+     }
+
+      void first_touch( execution::thread_pool_policy, const ElemT& val )
+     {
+         default_thread_pool().parallel_for( elems_array.size(),
+                                             [&]( const size_t begin, const size_t end )
+                                            {
+                                                for( size_t i=begin; i<end; ++i ){ elems_array[i] = val; }
+                                            } );
      }
   };
 
@@ -356,13 +710,38 @@ namespace par
             int           NDIM,
             GridType    GRIDTYPE= Primal,
             ArraySizing   SIZING= FixedSize>
-   auto vec_of_Arrays( const size_t             narrays,
-                       const Shape<NDIM,GRIDTYPE> shape )
+   auto vec_of_Arrays( const size_t               narrays,
+                       const Shape<NDIM,GRIDTYPE>   shape,
+                       const MemoryLayout    layout={} )
+  {
+      std::vector<Array<ElemT,NDIM,GRIDTYPE,SIZING>> vec;
+      vec.reserve(narrays);
+      for( size_t i=0; i<narrays; i++ )
+     {
+         vec.emplace_back(shape,layout);
+     }
+      return vec;
+  }
+
+/*
+ * returns a vector of arrays with given element type, dimensionality, sizing and shape
+ *    each array is value-initialised according to policy, so that its memory is first touched by the threads which will use it
+ */
+   template<typename       ElemT,
+            int           NDIM,
+            GridType    GRIDTYPE= Primal,
+            ArraySizing   SIZING= FixedSize,
+            execution_policy     Policy>
+   auto vec_of_Arrays( const Policy                policy,
+                       const size_t               narrays,
+                       const Shape<NDIM,GRIDTYPE>   shape,
+                       const MemoryLayout    layout={} )
   {
       std::vector<Array<ElemT,NDIM,GRIDTYPE,SIZING>> vec;
+      vec.reserve(narrays);
       for( size_t i=0; i<narrays; i++ )
      {
-         vec.emplace_back(shape);
+         vec.emplace_back(policy,shape,layout);
      }
       return vec;
   }
@@ -0,0 +1,329 @@
+
+# pragma once
+
+# include <parallalg/algorithm.h>
+# include <parallalg/array.h>
+# include <parallalg/parallalg.h>
+# include <parallalg/schedule.h>
+
+# include <functional>
+# include <tuple>
+# include <type_traits>
+# include <utility>
+
+# include <cassert>
+
+namespace par
+{
+
+/*
+ * ---------------- Lazy whole-array expressions -----------------------------------------
+ *
+ * Arithmetic on Arrays builds an expression tree instead of a new Array, e.g.:
+ *    q1 = q0 + dt*r/vol;                                      // serial
+ *    par::assign( execution::omp, q1, q0 + dt*r/vol );        // parallel
+ * The tree is evaluated element by element in one pass when it is assigned, so chained operations need no temporary arrays
+ *    operands are Arrays, views, other expressions, and scalars (any other type), which are combined with every element
+ *    par::lazy_transform( func, operands... ) applies an arbitrary element function lazily
+ *    expressions hold owning arrays by reference, so temporary owning arrays cannot be operands. Views are held by value
+ *    the destination may also be an operand, because each element is only read at the index it is written to
+ */
+
+/*
+ * operand of an expression referring to the elements of an array
+ */
+   template<typename ArrayT>
+   struct ArrayLeaf
+  {
+      using IdxType   = typename ArrayT::IdxType;
+      using ShapeType = typename ArrayT::ShapeType;
+      constexpr static int      nDim     = ArrayT::nDim;
+      constexpr static GridType gridType = ArrayT::gridType;
+
+   // owning arrays are held by reference, views by value
+      std::conditional_t<ArrayT::arraySizing==ViewSizing, ArrayT, const ArrayT&> array;
+
+      decltype(auto) operator()( const IdxType& idx ) const { return array(idx); }
+      decltype(auto) flatten(    const size_t     i ) const { return array.flatten(i); }
+
+      const ShapeType& shape() const { return array.shape(); }
+      MemoryLayout    layout() const { return array.layout(); }
+
+      template<typename DstArrayT>
+      bool same_storage_as( const DstArrayT& dst ) const { return same_storage( dst, array ); }
+  };
+
+/*
+ * operand of an expression with the same value for every element
+ */
+   template<typename T>
+   struct ScalarLeaf
+  {
+      T value;
+
+      template<typename IdxT>
+      const T& operator()( const IdxT&      ) const { return value; }
+      const T& flatten(    const size_t     ) const { return value; }
+
+      template<typename DstArrayT>
+      bool same_storage_as( const DstArrayT& ) const { return true; }
+  };
+
+/*
+ * first operand of an expression which is not a scalar, whose shape and memory layout are those of the expression
+ */
+   template<typename... Operands>
+   struct first_shaped_operand;
+
+   template<typename T, typename... Operands>
+   struct first_shaped_operand<ScalarLeaf<T>,Operands...> : first_shaped_operand<Operands...> {};
+
+   template<typename Operand, typename... Operands>
+   struct first_shaped_operand<Operand,Operands...> { using type = Operand; };
+
+   template<typename... Operands>
+   using first_shaped_operand_t = typename first_shaped_operand<Operands...>::type;
+
+   template<typename Operand, typename... Operands>
+   const auto& first_shaped( const Operand& operand, const Operands&... operands )
+  {
+      if constexpr( std::is_same_v<Operand,first_shaped_operand_t<Operand,Operands...>> ){ return operand; }
+      else                                                                                 { return first_shaped( operands... ); }
+  }
+
+/*
+ * true if an operand has the given shape, scalars match any shape
+ */
+   template<typename Operand,
+            typename  ShapeT>
+   bool shape_matches( const Operand& operand, const ShapeT& s ){ return operand.shape()==s; }
+
+   template<typename      T,
+            typename ShapeT>
+   bool shape_matches( const ScalarLeaf<T>&, const ShapeT& ){ return true; }
+
+/*
+ * node of an expression applying func to the elements of its operands
+ */
+   template<typename FuncObj,
+            typename... Operands>
+   struct ArrayExpression
+  {
+      using IdxType   = typename first_shaped_operand_t<Operands...>::IdxType;
+      using ShapeType = typename first_shaped_operand_t<Operands...>::ShapeType;
+      constexpr static int      nDim     = first_shaped_operand_t<Operands...>::nDim;
+      constexpr static GridType gridType = first_shaped_operand_t<Operands...>::gridType;
+
+      FuncObj                 func;
+      std::tuple<Operands...> operands;
+
+   // shape and memory layout of the first array in the expression
+      ShapeType    shape_expr;
+      MemoryLayout layout_expr;
+
+      ArrayExpression( const FuncObj& f, const Operands&... ops )
+         : func(f),
+           operands(ops...),
+           shape_expr(  first_shaped( ops... ).shape()  ),
+           layout_expr( first_shaped( ops... ).layout() )
+     {
+         assert( (shape_matches( ops, shape_expr ) && ...)
+                 && "par::ArrayExpression - arrays must be the same shape" );
+     }
+
+   // value of the expression at an index, or at a flattened index of arrays which share storage
+      auto operator()( const IdxType& idx ) const
+     {
+         return std::apply( [&]( const Operands&... ops ){ return func( ops(idx)... ); }, operands );
+     }
+
+      auto flatten( const size_t i ) const
+     {
+         return std::apply( [&]( const Operands&... ops ){ return func( ops.flatten(i)... ); }, operands );
+     }
+
+      const ShapeType& shape() const { return  shape_expr; }
+      MemoryLayout    layout() const { return layout_expr; }
+
+   // true if every array in the expression can be traversed with the flattened indices of dst
+      template<typename DstArrayT>
+      bool same_storage_as( const DstArrayT& dst ) const
+     {
+         return std::apply( [&]( const Operands&... ops ){ return (ops.same_storage_as( dst ) && ...); }, operands );
+     }
+  };
+
+   template<typename FuncObj, typename... Operands>
+   struct is_array_expression<ArrayExpression<FuncObj,Operands...>> : std::true_type {};
+
+/*
+ * true for Arrays and views
+ */
+   template<typename T>
+   struct is_array_operand : std::false_type {};
+
+   template<typename ElemT, int NDIM, GridType GT, ArraySizing AS>
+   struct is_array_operand<Array<ElemT,NDIM,GT,AS>> : std::true_type {};
+
+   template<typename T>
+   inline constexpr bool is_array_operand_v = is_array_operand<T>::value;
+
+/*
+ * types which make an arithmetic operation lazy: arrays, views and expressions
+ */
+   template<typename T>
+   concept bool ExpressionOperand = is_array_operand_v<std::decay_t<T>> || is_array_expression_v<std::decay_t<T>>;
+
+/*
+ * ------------------------- par::expression_operand ------------------------
+ *
+ * wrap an argument of an arithmetic operation as an operand of an expression
+ */
+   template<typename   ElemT,
+            int         NDIM,
+            GridType      GT,
+            ArraySizing   AS>
+   ArrayLeaf<Array<ElemT,NDIM,GT,AS>> expression_operand( const Array<ElemT,NDIM,GT,AS>& array )
+  {
+      return ArrayLeaf<Array<ElemT,NDIM,GT,AS>>{ array };
+  }
+
+   // the expression would refer to the elements of a destroyed array
+   template<typename   ElemT,
+            int         NDIM,
+            GridType      GT,
+            ArraySizing   AS>
+      requires (AS!=ViewSizing)
+   void expression_operand( const Array<ElemT,NDIM,GT,AS>&& array ) = delete;
+
+   template<typename    FuncObj,
+            typename... Operands>
+   const ArrayExpression<FuncObj,Operands...>& expression_operand( const ArrayExpression<FuncObj,Operands...>& expr )
+  {
+      return expr;
+  }
+
+   template<typename T>
+      requires !(ExpressionOperand<T>)
+   ScalarLeaf<T> expression_operand( const T& value )
+  {
+      return ScalarLeaf<T>{ value };
+  }
+
+   template<typename T>
+   using expression_operand_t = std::decay_t<decltype( expression_operand( std::declval<T>() ) )>;
+
+/*
+ * ------------------------- par::lazy_transform ------------------------
+ *
+ * Expression applying func to the elements of its operands, evaluated when assigned (like par::transform)
+ */
+   template<typename    FuncObj,
+            typename... Ts>
+      requires (ExpressionOperand<Ts> || ...)
+   auto lazy_transform( const FuncObj& func, Ts&&... operands )
+  {
+      return ArrayExpression<FuncObj,expression_operand_t<Ts>...>( func, expression_operand( std::forward<Ts>(operands) )... );
+  }
+
+/*
+ * ------------------------- Arithmetic operators ------------------------
+ *
+ * element-wise arithmetic on arrays and expressions, with scalars applied to every element
+ */
+   template<typename L, typename R>
+      requires ExpressionOperand<L> || ExpressionOperand<R>
+   auto operator+( L&& lhs, R&& rhs ){ return lazy_transform( std::plus<>{},       std::forward<L>(lhs), std::forward<R>(rhs) ); }
+
+   template<typename L, typename R>
+      requires ExpressionOperand<L> || ExpressionOperand<R>
+   auto operator-( L&& lhs, R&& rhs ){ return lazy_transform( std::minus<>{},      std::forward<L>(lhs), std::forward<R>(rhs) ); }
+
+   template<typename L, typename R>
+      requires ExpressionOperand<L> || ExpressionOperand<R>
+   auto operator*( L&& lhs, R&& rhs ){ return lazy_transform( std::multiplies<>{}, std::forward<L>(lhs), std::forward<R>(rhs) ); }
+
+   template<typename L, typename R>
+      requires ExpressionOperand<L> || ExpressionOperand<R>
+   auto operator/( L&& lhs, R&& rhs ){ return lazy_transform( std::divides<>{},    std::forward<L>(lhs), std::forward<R>(rhs) ); }
+
+   template<typename T>
+      requires ExpressionOperand<T>
+   auto operator-( T&& operand ){ return lazy_transform( std::negate<>{}, std::forward<T>(operand) ); }
+
+/*
+ * ------------------------- par::assign ------------------------
+ *
+ * Evaluate an expression into the elements of an array in one pass
+ *    arrays which share storage with dst are traversed by flattened index (vectorised with the simd policies),
+ *    expressions containing views, or arrays with different padding or halo, are traversed by index
+ */
+   template<typename   ElemT,
+            int         NDIM,
+            GridType      GT,
+            ArraySizing   AS,
+            typename    ExprT>
+      requires is_array_expression_v<ExprT>
+   void assign(       Array<ElemT,NDIM,GT,AS>& dst,
+                const ExprT&                  expr )
+  {
+      assign( execution::seq, dst, expr );
+      return;
+  }
+
+   template<execution_policy Policy,
+            typename          ElemT,
+            int                NDIM,
+            GridType             GT,
+            ArraySizing          AS,
+            typename          ExprT>
+      requires is_array_expression_v<ExprT>
+   void assign( const Policy                  policy,
+                      Array<ElemT,NDIM,GT,AS>& dst,
+                const ExprT&                  expr )
+  {
+      assert( (dst.shape() == expr.shape()) && "par::assign - arrays must be the same shape" );
+
+      if( !expr.same_storage_as( dst ) )
+     {
+         for_each_index( policy, Idx<NDIM,GT>{}, Idx<NDIM,GT>{dst.shape().shape},
+                         [&]( const Idx<NDIM,GT>& idx )
+                        {
+                            dst(idx) = expr(idx);
+                        } );
+         return;
+     }
+
+      for_each_flat_index( policy, dst,
+                           [&]( const size_t i )
+                          {
+                              dst.flatten(i) = expr.flatten(i);
+                          } );
+      return;
+  }
+
+/*
+ * ------------------------- par::evaluate ------------------------
+ *
+ * Evaluate an expression into a new array, with the shape and memory layout of the first array in the expression
+ */
+   template<typename ExprT>
+      requires is_array_expression_v<ExprT>
+   auto evaluate( const ExprT& expr )
+  {
+      return evaluate( execution::seq, expr );
+  }
+
+   template<execution_policy Policy,
+            typename          ExprT>
+      requires is_array_expression_v<ExprT>
+   auto evaluate( const Policy policy,
+                  const ExprT&  expr )
+  {
+      using ElemT = std::decay_t<decltype( expr.flatten(0) )>;
+
+      Array<ElemT,ExprT::nDim,ExprT::gridType> dst( expr.shape(), expr.layout() );
+      assign( policy, dst, expr );
+      return dst;
+  }
+}
@@ -0,0 +1,164 @@
+
+# pragma once
+
+# include <parallalg/array.h>
+# include <parallalg/parallalg.h>
+# include <parallalg/stencil.h>
+
+# include <cassert>
+
+namespace par
+{
+
+/*
+ * ---------------- Mixed primal/dual grid algorithms -----------------------------------------
+ *
+ * Algorithms whose destination is on a different grid from their sources, e.g. cells from their nodes:
+ *    par::cells_from_nodes( execution::omp, []( auto... nodes ){ return geom::volume( nodes... ); }, mesh.cells, mesh.nodes );
+ * The shapes of the two grids are checked against each other, and every destination element is computed
+ * in a single parallel pass over the sources (see par::stencil), so no temporary arrays are needed
+ */
+
+/*
+ * ------------------------- par::cells_from_nodes ------------------------
+ *
+ * For each dual cell, store func( nodes0 corners..., nodes1 corners..., ... ) with the 2^NDIM corner nodes of the cell
+ * in the order of par::stencils::cell_nodes (dimension 0 changing fastest)
+ */
+   template<typename    FuncObj,
+            typename     ElemTc,
+            int            NDIM,
+            ArraySizing     ASc,
+            typename     ElemT0,
+            typename...  ElemTs,
+            ArraySizing     AS0,
+            ArraySizing...  ASs>
+   void cells_from_nodes( const FuncObj&                          func,
+                                Array<ElemTc,NDIM,Dual,ASc>&     cells,
+                          const Array<ElemT0,NDIM,Primal,AS0>&  nodes0,
+                          const Array<ElemTs,NDIM,Primal,ASs>&... nodes )
+  {
+      cells_from_nodes( execution::seq, func, cells, nodes0, nodes... );
+      return;
+  }
+
+   template<execution_policy Policy,
+            typename        FuncObj,
+            typename         ElemTc,
+            int                NDIM,
+            ArraySizing         ASc,
+            typename         ElemT0,
+            typename...      ElemTs,
+            ArraySizing         AS0,
+            ArraySizing...      ASs>
+   void cells_from_nodes( const Policy                            policy,
+                          const FuncObj&                          func,
+                                Array<ElemTc,NDIM,Dual,ASc>&     cells,
+                          const Array<ElemT0,NDIM,Primal,AS0>&  nodes0,
+                          const Array<ElemTs,NDIM,Primal,ASs>&... nodes )
+  {
+      assert(   (cells.shape() == dualShape( nodes0.shape() ))
+             && "par::cells_from_nodes - cell array must be the dual of the node arrays" );
+
+      stencil( policy, stencils::cell_nodes<NDIM>, func, cells, nodes0, nodes... );
+      return;
+  }
+
+/*
+ * ------------------------- par::nodes_from_cells ------------------------
+ *
+ * For each primal node, store func( cells0 around node..., cells1 around node..., ... ) with the 2^NDIM cells around the node
+ * in the order of par::stencils::node_cells (dimension 0 changing fastest), e.g. for node-averaged output
+ *    only nodes with every surrounding cell inside the cell arrays or their halos are visited, so with no halo the
+ *    boundary nodes are left unchanged, and with a halo of width 1 (e.g. SolutionField ghost cells) every node is visited
+ */
+   template<typename    FuncObj,
+            typename     ElemTn,
+            int            NDIM,
+            ArraySizing     ASn,
+            typename     ElemT0,
+            typename...  ElemTs,
+            ArraySizing     AS0,
+            ArraySizing...  ASs>
+   void nodes_from_cells( const FuncObj&                        func,
+                                Array<ElemTn,NDIM,Primal,ASn>& nodes,
+                          const Array<ElemT0,NDIM,Dual,AS0>&  cells0,
+                          const Array<ElemTs,NDIM,Dual,ASs>&... cells )
+  {
+      nodes_from_cells( execution::seq, func, nodes, cells0, cells... );
+      return;
+  }
+
+   template<execution_policy Policy,
+            typename        FuncObj,
+            typename         ElemTn,
+            int                NDIM,
+            ArraySizing         ASn,
+            typename         ElemT0,
+            typename...      ElemTs,
+            ArraySizing         AS0,
+            ArraySizing...      ASs>
+   void nodes_from_cells( const Policy                          policy,
+                          const FuncObj&                        func,
+                                Array<ElemTn,NDIM,Primal,ASn>& nodes,
+                          const Array<ElemT0,NDIM,Dual,AS0>&  cells0,
+                          const Array<ElemTs,NDIM,Dual,ASs>&... cells )
+  {
+      assert(   (nodes.shape() == primalShape( cells0.shape() ))
+             && "par::nodes_from_cells - node array must be the primal of the cell arrays" );
+
+      stencil( policy, stencils::node_cells<NDIM>, func, nodes, cells0, cells... );
+      return;
+  }
+
+/*
+ * ------------------------- par::faces_from_nodes ------------------------
+ *
+ * For each face normal to dimension dim, store func( nodes0 of face..., nodes1 of face..., ... ) with the 2^(NDIM-1) nodes
+ * of the face in the order of par::face_stencil, e.g. the face geometry:
+ *    par::faces_from_nodes( policy, 0, []( auto... nodes ){ return geom::surface( nodes... ); }, ifaces, mesh.nodes );
+ *    faces has par::faceShape( dualShape( nodes.shape() ), dim ), so face idx lies between cells idx-1 and idx in dimension dim
+ */
+   template<typename    FuncObj,
+            typename     ElemTf,
+            int            NDIM,
+            ArraySizing     ASf,
+            typename     ElemT0,
+            typename...  ElemTs,
+            ArraySizing     AS0,
+            ArraySizing...  ASs>
+   void faces_from_nodes( const int                                dim,
+                          const FuncObj&                          func,
+                                Array<ElemTf,NDIM,Primal,ASf>&   faces,
+                          const Array<ElemT0,NDIM,Primal,AS0>&  nodes0,
+                          const Array<ElemTs,NDIM,Primal,ASs>&... nodes )
+  {
+      faces_from_nodes( execution::seq, dim, func, faces, nodes0, nodes... );
+      return;
+  }
+
+   template<execution_policy Policy,
+            typename        FuncObj,
+            typename         ElemTf,
+            int                NDIM,
+            ArraySizing         ASf,
+            typename         ElemT0,
+            typename...      ElemTs,
+            ArraySizing         AS0,
+            ArraySizing...      ASs>
+   void faces_from_nodes( const Policy                            policy,
+                          const int                                  dim,
+                          const FuncObj&                            func,
+                                Array<ElemTf,NDIM,Primal,ASf>&     faces,
+                          const Array<ElemT0,NDIM,Primal,AS0>&    nodes0,
+                          const Array<ElemTs,NDIM,Primal,ASs>&... nodes )
+  {
+      assert( (dim>=0 && dim<NDIM) && "par::faces_from_nodes - invalid face dimension" );
+
+      assert(   (faces.shape() == faceShape( dualShape( nodes0.shape() ), dim ))
+             && "par::faces_from_nodes - face array must be the faces of the dual of the node arrays" );
+
+      stencil( policy, face_stencil<NDIM>( dim ), func, faces, nodes0, nodes... );
+      return;
+  }
+}
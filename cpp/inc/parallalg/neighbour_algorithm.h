@@ -3,40 +3,1151 @@
 
 # include <parallalg/array.h>
 # include <parallalg/parallalg.h>
+# include <parallalg/tiling.h>
+# include <parallalg/schedule.h>
+# include <parallalg/view.h>
+
+# include <algorithm>
+# include <type_traits>
+# include <utility>
+
+# include <cassert>
 
 # include <omp.h>
 
-namespace par
-{
+namespace par
+{
+/*
+ * ------------------------- par::for_each_face ------------------------
+ *
+ * Call face_func( idxl, idxr, dim ) for every pair of neighbouring indices idxl, idxr in an array of the given shape
+ *    idxl and idxr differ by one in dimension dim, so a shape with a zero extent has no faces
+ *    face_func is responsible for any accumulation into the elements either side of the face, so parallel execution
+ *    only supports accumulation schemes which guarantee that no two faces sharing an element are visited concurrently
+ *    (face colouring and tiling, see face_accumulation_policy)
+ */
+
+/*
+ * run in serial if no policy provided
+ */
+   template<typename FuncObj,
+            int         NDIM,
+            GridType      GT>
+   void for_each_face(       FuncObj             face_func,
+                       const Shape<NDIM,GT>&         shape )
+  {
+      for_each_face( execution::seq, face_func, shape );
+  }
+
+/*
+ * serial execution visits faces in order regardless of accumulation scheme
+ */
+   template<typename FuncObj,
+            int         NDIM,
+            GridType      GT>
+   void for_each_face(       execution::serial_policy,
+                             accumulation::colouring_policy,
+                             FuncObj                  face_func,
+                       const Shape<NDIM,GT>&              shape )
+  {
+      for_each_face( execution::seq, face_func, shape );
+  }
+
+/*
+ * openmp execution uses face colouring if no accumulation scheme provided
+ */
+   template<typename FuncObj,
+            int         NDIM,
+            GridType      GT>
+   void for_each_face( const execution::openmp_policy&    policy,
+                             FuncObj                  face_func,
+                       const Shape<NDIM,GT>&              shape )
+  {
+      for_each_face( policy, accumulation::colour, face_func, shape );
+  }
+
+/*
+ * vectorised and thread pool execution use face colouring if no accumulation scheme provided
+ */
+   template<typename FuncObj,
+            int         NDIM,
+            GridType      GT>
+   void for_each_face(       execution::simd_policy,
+                             FuncObj                  face_func,
+                       const Shape<NDIM,GT>&              shape )
+  {
+      for_each_face( execution::simd, accumulation::colour, face_func, shape );
+  }
+
+   template<typename FuncObj,
+            int         NDIM,
+            GridType      GT>
+   void for_each_face( const execution::openmp_simd_policy&    policy,
+                             FuncObj                  face_func,
+                       const Shape<NDIM,GT>&              shape )
+  {
+      for_each_face( policy, accumulation::colour, face_func, shape );
+  }
+
+   template<typename FuncObj,
+            int         NDIM,
+            GridType      GT>
+   void for_each_face(       execution::thread_pool_policy,
+                             FuncObj                  face_func,
+                       const Shape<NDIM,GT>&              shape )
+  {
+      for_each_face( execution::pool, accumulation::colour, face_func, shape );
+  }
+
+/*
+ * 1D - serial execution
+ */
+   template<typename FuncObj,
+            GridType      GT>
+   void for_each_face(       execution::serial_policy,
+                             FuncObj                 face_func,
+                       const Shape1<GT>&                 shape )
+  {
+      const size_t ni = shape[0];
+
+      if( length(shape)==0 ){ return; }
+
+      for( size_t i=0; i<ni-1; ++i )
+     {
+         face_func( Idx1<GT>{i}, Idx1<GT>{i+1}, 0 );
+     }
+  }
+
+/*
+ * 2D - serial execution
+ */
+   template<typename FuncObj,
+            GridType      GT>
+   void for_each_face(       execution::serial_policy,
+                             FuncObj                 face_func,
+                       const Shape2<GT>&                 shape )
+  {
+      const size_t ni = shape[0];
+      const size_t nj = shape[1];
+
+      if( length(shape)==0 ){ return; }
+
+   // faces between neighbours in dimension 0
+      for( size_t j=0; j<nj; ++j )
+     {
+         for( size_t i=0; i<ni-1; ++i )
+        {
+            face_func( Idx2<GT>{i,j}, Idx2<GT>{i+1,j}, 0 );
+        }
+     }
+
+   // faces between neighbours in dimension 1
+      for( size_t i=0; i<ni; ++i )
+     {
+         for( size_t j=0; j<nj-1; ++j )
+        {
+            face_func( Idx2<GT>{i,j}, Idx2<GT>{i,j+1}, 1 );
+        }
+     }
+  }
+
+/*
+ * 3D - serial execution
+ */
+   template<typename FuncObj,
+            GridType      GT>
+   void for_each_face(       execution::serial_policy,
+                             FuncObj                 face_func,
+                       const Shape3<GT>&                 shape )
+  {
+      const size_t ni = shape[0];
+      const size_t nj = shape[1];
+      const size_t nk = shape[2];
+
+      if( length(shape)==0 ){ return; }
+
+   // faces between neighbours in dimension 0
+      for( size_t i=0; i<ni-1; ++i )
+     {
+         for( size_t j=0; j<nj; ++j )
+        {
+            for( size_t k=0; k<nk; ++k )
+           {
+               face_func( Idx3<GT>{i,j,k}, Idx3<GT>{i+1,j,k}, 0 );
+           }
+        }
+     }
+
+   // faces between neighbours in dimension 1
+      for( size_t i=0; i<ni; ++i )
+     {
+         for( size_t j=0; j<nj-1; ++j )
+        {
+            for( size_t k=0; k<nk; ++k )
+           {
+               face_func( Idx3<GT>{i,j,k}, Idx3<GT>{i,j+1,k}, 1 );
+           }
+        }
+     }
+
+   // faces between neighbours in dimension 2
+      for( size_t i=0; i<ni; ++i )
+     {
+         for( size_t j=0; j<nj; ++j )
+        {
+            for( size_t k=0; k<nk-1; ++k )
+           {
+               face_func( Idx3<GT>{i,j,k}, Idx3<GT>{i,j,k+1}, 2 );
+           }
+        }
+     }
+  }
+
+/*
+ * OpenMP execution with face colouring, any dimension
+ *    faces in each dimension are coloured by the parity of their index in that dimension, faces of one colour do not share any elements
+ *    all faces of one colour are processed in a single parallel loop, honouring the schedule, collapse depth and thread count of the policy
+ */
+   template<typename FuncObj,
+            int         NDIM,
+            GridType      GT>
+   void for_each_face( const execution::openmp_policy&      policy,
+                             accumulation::colouring_policy,
+                             FuncObj                     face_func,
+                       const Shape<NDIM,GT>&                 shape )
+  {
+      for( int dim=0; dim<NDIM; ++dim )
+     {
+         for( size_t colour=0; colour<2; ++colour )
+        {
+         // face k of this colour is between elements colour+2k and colour+2k+1 in dimension dim
+            Idx<NDIM,GT> nfaces{shape.shape};
+            nfaces.idxs[dim] = shape[dim]>colour ? (shape[dim]-colour)/2 : 0;
+
+            for_each_index( policy, Idx<NDIM,GT>{}, nfaces,
+                            [&]( const Idx<NDIM,GT>& face )
+                           {
+                               Idx<NDIM,GT> idxl=face;
+                               idxl.idxs[dim] = colour+2*face[dim];
+
+                               Idx<NDIM,GT> idxr=idxl;
+                               ++idxr.idxs[dim];
+
+                               face_func( idxl, idxr, dim );
+                           } );
+        }
+     }
+  }
+
+/*
+ * 1D - vectorised serial execution with face colouring
+ *    faces of one colour are independent, so each colour is a single vectorised loop
+ */
+   template<typename FuncObj,
+            GridType      GT>
+   void for_each_face(       execution::simd_policy,
+                             accumulation::colouring_policy,
+                             FuncObj                 face_func,
+                       const Shape1<GT>&                 shape )
+  {
+      const size_t ni = shape[0];
+
+      if( length(shape)==0 ){ return; }
+
+      for( size_t colour=0; colour<2; ++colour )
+     {
+# ifdef _OPENMP
+   # pragma omp simd
+# endif
+         for( size_t i=colour; i<ni-1; i+=2 )
+        {
+            face_func( Idx1<GT>{i}, Idx1<GT>{i+1}, 0 );
+        }
+     }
+  }
+
+/*
+ * 2D - vectorised serial execution with face colouring
+ *    faces normal to dimension 0 are independent along dimension 1 and are vectorised across the row,
+ *    faces normal to dimension 1 are vectorised along each row one colour at a time
+ */
+   template<typename FuncObj,
+            GridType      GT>
+   void for_each_face(       execution::simd_policy,
+                             accumulation::colouring_policy,
+                             FuncObj                 face_func,
+                       const Shape2<GT>&                 shape )
+  {
+      const size_t ni = shape[0];
+      const size_t nj = shape[1];
+
+      if( length(shape)==0 ){ return; }
+
+   // faces between neighbours in dimension 0
+      for( size_t i=0; i<ni-1; ++i )
+     {
+# ifdef _OPENMP
+   # pragma omp simd
+# endif
+         for( size_t j=0; j<nj; ++j )
+        {
+            face_func( Idx2<GT>{i,j}, Idx2<GT>{i+1,j}, 0 );
+        }
+     }
+
+   // faces between neighbours in dimension 1
+      for( size_t i=0; i<ni; ++i )
+     {
+         for( size_t colour=0; colour<2; ++colour )
+        {
+# ifdef _OPENMP
+   # pragma omp simd
+# endif
+            for( size_t j=colour; j<nj-1; j+=2 )
+           {
+               face_func( Idx2<GT>{i,j}, Idx2<GT>{i,j+1}, 1 );
+           }
+        }
+     }
+  }
+
+/*
+ * 3D - vectorised serial execution with face colouring
+ *    faces normal to dimensions 0 and 1 are independent along dimension 2 and are vectorised across each row,
+ *    faces normal to dimension 2 are vectorised along each row one colour at a time
+ */
+   template<typename FuncObj,
+            GridType      GT>
+   void for_each_face(       execution::simd_policy,
+                             accumulation::colouring_policy,
+                             FuncObj                 face_func,
+                       const Shape3<GT>&                 shape )
+  {
+      const size_t ni = shape[0];
+      const size_t nj = shape[1];
+      const size_t nk = shape[2];
+
+      if( length(shape)==0 ){ return; }
+
+   // faces between neighbours in dimension 0
+      for( size_t i=0; i<ni-1; ++i )
+     {
+         for( size_t j=0; j<nj; ++j )
+        {
+# ifdef _OPENMP
+   # pragma omp simd
+# endif
+            for( size_t k=0; k<nk; ++k )
+           {
+               face_func( Idx3<GT>{i,j,k}, Idx3<GT>{i+1,j,k}, 0 );
+           }
+        }
+     }
+
+   // faces between neighbours in dimension 1
+      for( size_t i=0; i<ni; ++i )
+     {
+         for( size_t j=0; j<nj-1; ++j )
+        {
+# ifdef _OPENMP
+   # pragma omp simd
+# endif
+            for( size_t k=0; k<nk; ++k )
+           {
+               face_func( Idx3<GT>{i,j,k}, Idx3<GT>{i,j+1,k}, 1 );
+           }
+        }
+     }
+
+   // faces between neighbours in dimension 2
+      for( size_t i=0; i<ni; ++i )
+     {
+         for( size_t j=0; j<nj; ++j )
+        {
+            for( size_t colour=0; colour<2; ++colour )
+           {
+# ifdef _OPENMP
+   # pragma omp simd
+# endif
+               for( size_t k=colour; k<nk-1; k+=2 )
+              {
+                  face_func( Idx3<GT>{i,j,k}, Idx3<GT>{i,j,k+1}, 2 );
+              }
+           }
+        }
+     }
+  }
+
+/*
+ * 1D - vectorised OpenMP execution with face colouring
+ */
+   template<typename FuncObj,
+            GridType      GT>
+   void for_each_face( const execution::openmp_simd_policy& policy,
+                             accumulation::colouring_policy,
+                             FuncObj                 face_func,
+                       const Shape1<GT>&                 shape )
+  {
+      const size_t ni = shape[0];
+
+      if( length(shape)==0 ){ return; }
+
+      const int nthreads = openmp_num_threads( policy );
+      const openmp_schedule_scope schedule( policy );
+
+      for( size_t colour=0; colour<2; ++colour )
+     {
+# ifdef _OPENMP
+   # pragma omp parallel for simd schedule(runtime) num_threads(nthreads)
+# endif
+         for( size_t i=colour; i<ni-1; i+=2 )
+        {
+            face_func( Idx1<GT>{i}, Idx1<GT>{i+1}, 0 );
+        }
+     }
+  }
+
+/*
+ * 2D - vectorised OpenMP execution with face colouring
+ *    all faces of one colour are independent, so are processed in a single collapsed parallel vectorised loop
+ *    the schedule and thread count of the policy are honoured, both dimensions are always collapsed
+ */
+   template<typename FuncObj,
+            GridType      GT>
+   void for_each_face( const execution::openmp_simd_policy& policy,
+                             accumulation::colouring_policy,
+                             FuncObj                 face_func,
+                       const Shape2<GT>&                 shape )
+  {
+      const size_t ni = shape[0];
+      const size_t nj = shape[1];
+
+      if( length(shape)==0 ){ return; }
+
+      const int nthreads = openmp_num_threads( policy );
+      const openmp_schedule_scope schedule( policy );
+
+   // faces between neighbours in dimension 0
+      for( size_t colour=0; colour<2; ++colour )
+     {
+# ifdef _OPENMP
+   # pragma omp parallel for simd collapse(2) schedule(runtime) num_threads(nthreads)
+# endif
+         for( size_t i=colour; i<ni-1; i+=2 )
+        {
+            for( size_t j=0; j<nj; ++j )
+           {
+               face_func( Idx2<GT>{i,j}, Idx2<GT>{i+1,j}, 0 );
+           }
+        }
+     }
+
+   // faces between neighbours in dimension 1
+      for( size_t colour=0; colour<2; ++colour )
+     {
+# ifdef _OPENMP
+   # pragma omp parallel for simd collapse(2) schedule(runtime) num_threads(nthreads)
+# endif
+         for( size_t i=0; i<ni; ++i )
+        {
+            for( size_t j=colour; j<nj-1; j+=2 )
+           {
+               face_func( Idx2<GT>{i,j}, Idx2<GT>{i,j+1}, 1 );
+           }
+        }
+     }
+  }
+
+/*
+ * 3D - vectorised OpenMP execution with face colouring
+ *    each colour of each face direction is one parallel loop collapsed over dimensions 0 and 1, vectorised along dimension 2
+ *    the schedule and thread count of the policy are honoured
+ */
+   template<typename FuncObj,
+            GridType      GT>
+   void for_each_face( const execution::openmp_simd_policy& policy,
+                             accumulation::colouring_policy,
+                             FuncObj                 face_func,
+                       const Shape3<GT>&                 shape )
+  {
+      const size_t ni = shape[0];
+      const size_t nj = shape[1];
+      const size_t nk = shape[2];
+
+      if( length(shape)==0 ){ return; }
+
+      const int nthreads = openmp_num_threads( policy );
+      const openmp_schedule_scope schedule( policy );
+
+   // faces between neighbours in dimension 0
+      for( size_t colour=0; colour<2; ++colour )
+     {
+# ifdef _OPENMP
+   # pragma omp parallel for collapse(2) schedule(runtime) num_threads(nthreads)
+# endif
+         for( size_t i=colour; i<ni-1; i+=2 )
+        {
+            for( size_t j=0; j<nj; ++j )
+           {
+# ifdef _OPENMP
+   # pragma omp simd
+# endif
+               for( size_t k=0; k<nk; ++k )
+              {
+                  face_func( Idx3<GT>{i,j,k}, Idx3<GT>{i+1,j,k}, 0 );
+              }
+           }
+        }
+     }
+
+   // faces between neighbours in dimension 1
+      for( size_t colour=0; colour<2; ++colour )
+     {
+# ifdef _OPENMP
+   # pragma omp parallel for collapse(2) schedule(runtime) num_threads(nthreads)
+# endif
+         for( size_t i=0; i<ni; ++i )
+        {
+            for( size_t j=colour; j<nj-1; j+=2 )
+           {
+# ifdef _OPENMP
+   # pragma omp simd
+# endif
+               for( size_t k=0; k<nk; ++k )
+              {
+                  face_func( Idx3<GT>{i,j,k}, Idx3<GT>{i,j+1,k}, 1 );
+              }
+           }
+        }
+     }
+
+   // faces between neighbours in dimension 2
+      for( size_t colour=0; colour<2; ++colour )
+     {
+# ifdef _OPENMP
+   # pragma omp parallel for collapse(2) schedule(runtime) num_threads(nthreads)
+# endif
+         for( size_t i=0; i<ni; ++i )
+        {
+            for( size_t j=0; j<nj; ++j )
+           {
+# ifdef _OPENMP
+   # pragma omp simd
+# endif
+               for( size_t k=colour; k<nk-1; k+=2 )
+              {
+                  face_func( Idx3<GT>{i,j,k}, Idx3<GT>{i,j,k+1}, 2 );
+              }
+           }
+        }
+     }
+  }
+
+/*
+ * 1D - thread pool execution with face colouring
+ */
+   template<typename FuncObj,
+            GridType      GT>
+   void for_each_face(       execution::thread_pool_policy,
+                             accumulation::colouring_policy,
+                             FuncObj                 face_func,
+                       const Shape1<GT>&                 shape )
+  {
+      const size_t ni = shape[0];
+
+      if( length(shape)==0 ){ return; }
+
+      for( size_t colour=0; colour<2; ++colour )
+     {
+      // faces colour, colour+2, ...
+         const size_t nfaces = (ni-colour)/2;
+
+         default_thread_pool().parallel_for( nfaces,
+                                             [&]( const size_t begin, const size_t end )
+                                            {
+                                                for( size_t f=begin; f<end; ++f )
+                                               {
+                                                   const size_t i = colour+2*f;
+                                                   face_func( Idx1<GT>{i}, Idx1<GT>{i+1}, 0 );
+                                               }
+                                            } );
+     }
+  }
+
+/*
+ * 2D - thread pool execution with face colouring
+ *    faces normal to dimension 0 are coloured by row, faces normal to dimension 1 in different rows never share an element
+ */
+   template<typename FuncObj,
+            GridType      GT>
+   void for_each_face(       execution::thread_pool_policy,
+                             accumulation::colouring_policy,
+                             FuncObj                 face_func,
+                       const Shape2<GT>&                 shape )
+  {
+      const size_t ni = shape[0];
+      const size_t nj = shape[1];
+
+      if( length(shape)==0 ){ return; }
+
+   // faces between neighbours in dimension 0
+      for( size_t colour=0; colour<2; ++colour )
+     {
+         const size_t nrows = (ni-colour)/2;
+
+         default_thread_pool().parallel_for( nrows,
+                                             [&]( const size_t begin, const size_t end )
+                                            {
+                                                for( size_t r=begin; r<end; ++r )
+                                               {
+                                                   const size_t i = colour+2*r;
+                                                   for( size_t j=0; j<nj; ++j )
+                                                  {
+                                                      face_func( Idx2<GT>{i,j}, Idx2<GT>{i+1,j}, 0 );
+                                                  }
+                                               }
+                                            } );
+     }
+
+   // faces between neighbours in dimension 1, every row is independent
+      default_thread_pool().parallel_for( ni,
+                                          [&]( const size_t begin, const size_t end )
+                                         {
+                                             for( size_t i=begin; i<end; ++i )
+                                            {
+                                                for( size_t j=0; j<nj-1; ++j )
+                                               {
+                                                   face_func( Idx2<GT>{i,j}, Idx2<GT>{i,j+1}, 1 );
+                                               }
+                                            }
+                                         } );
+  }
+
+/*
+ * 3D - thread pool execution with face colouring
+ *    faces normal to dimension 0 are coloured by plane, faces normal to dimensions 1 and 2 in different planes never share an element
+ */
+   template<typename FuncObj,
+            GridType      GT>
+   void for_each_face(       execution::thread_pool_policy,
+                             accumulation::colouring_policy,
+                             FuncObj                 face_func,
+                       const Shape3<GT>&                 shape )
+  {
+      const size_t ni = shape[0];
+      const size_t nj = shape[1];
+      const size_t nk = shape[2];
+
+      if( length(shape)==0 ){ return; }
+
+   // faces between neighbours in dimension 0
+      for( size_t colour=0; colour<2; ++colour )
+     {
+         const size_t nplanes = (ni-colour)/2;
+
+         default_thread_pool().parallel_for( nplanes,
+                                             [&]( const size_t begin, const size_t end )
+                                            {
+                                                for( size_t r=begin; r<end; ++r )
+                                               {
+                                                   const size_t i = colour+2*r;
+                                                   for( size_t j=0; j<nj; ++j )
+                                                  {
+                                                      for( size_t k=0; k<nk; ++k )
+                                                     {
+                                                         face_func( Idx3<GT>{i,j,k}, Idx3<GT>{i+1,j,k}, 0 );
+                                                     }
+                                                  }
+                                               }
+                                            } );
+     }
+
+   // faces between neighbours in dimensions 1 and 2, every plane is independent
+      default_thread_pool().parallel_for( ni,
+                                          [&]( const size_t begin, const size_t end )
+                                         {
+                                             for( size_t i=begin; i<end; ++i )
+                                            {
+                                                for( size_t j=0; j<nj-1; ++j )
+                                               {
+                                                   for( size_t k=0; k<nk; ++k )
+                                                  {
+                                                      face_func( Idx3<GT>{i,j,k}, Idx3<GT>{i,j+1,k}, 1 );
+                                                  }
+                                               }
+                                                for( size_t j=0; j<nj; ++j )
+                                               {
+                                                   for( size_t k=0; k<nk-1; ++k )
+                                                  {
+                                                      face_func( Idx3<GT>{i,j,k}, Idx3<GT>{i,j,k+1}, 2 );
+                                                  }
+                                               }
+                                            }
+                                         } );
+  }
+
+/*
+ * 1D - cache-blocked execution
+ *    each tile owns the faces to the right of its elements
+ */
+   template<execution_policy  Policy,
+            typename         FuncObj,
+            GridType              GT>
+   void for_each_face( const Policy                  policy,
+                       const Tiling<1>&              tiling,
+                             FuncObj              face_func,
+                       const Shape1<GT>&              shape )
+  {
+      const size_t ni = shape[0];
+
+      const auto tile_func = [&]( const Idx1<GT>& first,
+                                  const Idx1<GT>&  last )
+     {
+         for( size_t i=first[0]; i<std::min(last[0],ni-1); ++i )
+        {
+            face_func( Idx1<GT>{i}, Idx1<GT>{i+1}, 0 );
+        }
+     };
+
+      for_each_tile_coloured( policy, tiling, shape, tile_func );
+  }
+
+/*
+ * 2D - cache-blocked execution
+ *    each tile owns the faces to the right of its elements in each dimension, so both face directions are visited while the tile is in cache
+ */
+   template<execution_policy  Policy,
+            typename         FuncObj,
+            GridType              GT>
+   void for_each_face( const Policy                  policy,
+                       const Tiling<2>&              tiling,
+                             FuncObj              face_func,
+                       const Shape2<GT>&              shape )
+  {
+      const size_t ni = shape[0];
+      const size_t nj = shape[1];
+
+      const auto tile_func = [&]( const Idx2<GT>& first,
+                                  const Idx2<GT>&  last )
+     {
+         for( size_t i=first[0]; i<last[0]; ++i )
+        {
+            for( size_t j=first[1]; j<last[1]; ++j )
+           {
+               const Idx2<GT> ij{i,j};
+
+               if( i<ni-1 ){ face_func( ij, Idx2<GT>{i+1,j}, 0 ); }
+               if( j<nj-1 ){ face_func( ij, Idx2<GT>{i,j+1}, 1 ); }
+           }
+        }
+     };
+
+      for_each_tile_coloured( policy, tiling, shape, tile_func );
+  }
+
+/*
+ * 3D - cache-blocked execution
+ *    each tile owns the faces to the right of its elements in each dimension, so all three face directions are visited while the tile is in cache
+ */
+   template<execution_policy  Policy,
+            typename         FuncObj,
+            GridType              GT>
+   void for_each_face( const Policy                  policy,
+                       const Tiling<3>&              tiling,
+                             FuncObj              face_func,
+                       const Shape3<GT>&              shape )
+  {
+      const size_t ni = shape[0];
+      const size_t nj = shape[1];
+      const size_t nk = shape[2];
+
+      const auto tile_func = [&]( const Idx3<GT>& first,
+                                  const Idx3<GT>&  last )
+     {
+         for( size_t i=first[0]; i<last[0]; ++i )
+        {
+            for( size_t j=first[1]; j<last[1]; ++j )
+           {
+               for( size_t k=first[2]; k<last[2]; ++k )
+              {
+                  const Idx3<GT> ijk{i,j,k};
+
+                  if( i<ni-1 ){ face_func( ijk, Idx3<GT>{i+1,j,k}, 0 ); }
+                  if( j<nj-1 ){ face_func( ijk, Idx3<GT>{i,j+1,k}, 1 ); }
+                  if( k<nk-1 ){ face_func( ijk, Idx3<GT>{i,j,k+1}, 2 ); }
+              }
+           }
+        }
+     };
+
+      for_each_tile_coloured( policy, tiling, shape, tile_func );
+  }
+
+/*
+ * ------------------------- par::for_each_face_lagged ------------------------
+ *
+ * Call first_func( idxl, idxr, dim ) and second_func( idxl, idxr, dim ) for every pair of neighbouring indices idxl, idxr
+ * in an array of the given shape, in a single sweep
+ *    second_func is only called for a face after first_func has been called for every face of the elements either side of it,
+ *    so second_func can use what first_func accumulated into those elements, e.g. the least squares metrics used by the fluxes
+ *    the sweep runs along dimension 0 one plane of elements at a time, and second_func lags one plane behind first_func,
+ *    so each plane is still in cache when second_func reaches it and the sources are read from memory about once
+ *    as in for_each_face, both functions are responsible for their own accumulation, and parallel execution never visits
+ *    two faces sharing an element concurrently
+ *
+ * boundary_func( idx, dim, high ) is optionally called once for every face on the boundary of the array, where idx is the element
+ * inside the face, dim the normal dimension of the face and high whether it is on the high side of the array in dim
+ *    faces normal to dimensions 1.. are visited with the plane of their element, once first_func has visited every face of every
+ *    element in the plane, and faces normal to dimension 0 at the end of the sweep, once first_func has visited every face,
+ *    so boundary_func can use what first_func accumulated into the element at the other end of the array in dim (e.g. a periodic
+ *    neighbour). boundary_func must only write to element idx
+ */
+
+/*
+ * faces between neighbours in the plane with index i in dimension 0
+ */
+   template<typename FuncObj,
+            int         NDIM,
+            GridType      GT>
+   void for_each_plane_face(       FuncObj          face_func,
+                             const Shape<NDIM,GT>&      shape,
+                             const size_t                   i )
+  {
+      for( int dim=1; dim<NDIM; ++dim )
+     {
+         Idx<NDIM,GT> first{};
+         Idx<NDIM,GT> last{shape.shape};
+         first.idxs[0] = i;
+         last.idxs[0]  = i+1;
+         last.idxs[dim]= shape[dim]>0 ? shape[dim]-1 : 0;
+
+         for_each_index( execution::seq, first, last,
+                         [&]( const Idx<NDIM,GT>& idxl )
+                        {
+                            Idx<NDIM,GT> idxr=idxl;
+                            ++idxr.idxs[dim];
+
+                            face_func( idxl, idxr, dim );
+                        } );
+     }
+  }
+
+/*
+ * faces between neighbours in dimension 0 in the planes with indices i-1 and i
+ */
+   template<typename FuncObj,
+            int         NDIM,
+            GridType      GT>
+   void for_each_interplane_face(       FuncObj          face_func,
+                                  const Shape<NDIM,GT>&      shape,
+                                  const size_t                   i )
+  {
+      Idx<NDIM,GT> first{};
+      Idx<NDIM,GT> last{shape.shape};
+      first.idxs[0] = i;
+      last.idxs[0]  = i+1;
+
+      for_each_index( execution::seq, first, last,
+                      [&]( const Idx<NDIM,GT>& idxr )
+                     {
+                         Idx<NDIM,GT> idxl=idxr;
+                         --idxl.idxs[0];
+
+                         face_func( idxl, idxr, 0 );
+                     } );
+  }
+
+/*
+ * boundary faces normal to dimensions 1.. of the elements in the plane with index i in dimension 0
+ */
+   template<typename FuncObj,
+            int         NDIM,
+            GridType      GT>
+   void for_each_plane_boundary_face(       FuncObj      boundary_func,
+                                      const Shape<NDIM,GT>&      shape,
+                                      const size_t                   i )
+  {
+      for( int dim=1; dim<NDIM; ++dim )
+     {
+         if( shape[dim]==0 ){ continue; }
+
+         for( const bool high : {false,true} )
+        {
+            Idx<NDIM,GT> first{};
+            Idx<NDIM,GT> last{shape.shape};
+            first.idxs[0]  = i;
+            last.idxs[0]   = i+1;
+            first.idxs[dim]= high ? shape[dim]-1 : 0;
+            last.idxs[dim] = first.idxs[dim]+1;
+
+            for_each_index( execution::seq, first, last,
+                            [&]( const Idx<NDIM,GT>& idx ){ boundary_func( idx, dim, high ); } );
+        }
+     }
+  }
+
+/*
+ * boundary faces normal to dimension 0 of the elements in the first (high=false) or last (high=true) plane
+ */
+   template<typename FuncObj,
+            int         NDIM,
+            GridType      GT>
+   void for_each_end_face(       FuncObj      boundary_func,
+                           const Shape<NDIM,GT>&      shape,
+                           const bool                  high )
+  {
+      if( shape[0]==0 ){ return; }
+
+      Idx<NDIM,GT> first{};
+      Idx<NDIM,GT> last{shape.shape};
+      first.idxs[0] = high ? shape[0]-1 : 0;
+      last.idxs[0]  = first.idxs[0]+1;
+
+      for_each_index( execution::seq, first, last,
+                      [&]( const Idx<NDIM,GT>& idx ){ boundary_func( idx, 0, high ); } );
+  }
+
+/*
+ * boundary function for sweeps which only visit interior faces
+ */
+   struct no_boundary_face
+  {
+      template<typename IdxT>
+      void operator()( const IdxT&, const int, const bool ) const {}
+  };
+
+/*
+ * lagged sweep over the faces between elements in planes [begin,end) of dimension 0, and the boundary faces normal to dimensions 1..
+ * of those planes
+ *    first_func must already have been called for the faces between planes end-1 and end, if end is inside the array
+ */
+   template<typename    FirstFuncObj,
+            typename   SecondFuncObj,
+            typename BoundaryFuncObj,
+            int                 NDIM,
+            GridType              GT>
+   void for_each_face_lagged_slab(       FirstFuncObj       first_func,
+                                         SecondFuncObj     second_func,
+                                         BoundaryFuncObj boundary_func,
+                                   const Shape<NDIM,GT>&         shape,
+                                   const size_t                  begin,
+                                   const size_t                    end )
+  {
+      for( size_t i=begin; i<=end; ++i )
+     {
+      // plane i
+         if( i<end )
+        {
+            for_each_plane_face( first_func, shape, i );
+            if( i>begin ){ for_each_interplane_face( first_func, shape, i ); }
+        }
+
+      // plane i-1 has all its faces visited by first_func
+         if( i>begin )
+        {
+            for_each_plane_face( second_func, shape, i-1 );
+            if( i-1>begin ){ for_each_interplane_face( second_func, shape, i-1 ); }
+            for_each_plane_boundary_face( boundary_func, shape, i-1 );
+        }
+     }
+  }
+
 /*
  * run in serial if no policy provided
  */
-   template<typename       EdgeFuncObj,
-            typename    AccLeftFuncObj,
-            typename   AccRightFuncObj,
-            typename            ElemTd,
-            typename            ElemT0,
-            typename...         ElemTs,
-            int                   NDIM,
-            GridType               GTd,
-            GridType               GT0,
-            GridType...            GTs,
-            ArraySizing            ASd,
-            ArraySizing            AS0,
-            ArraySizing...         ASs>
-   void neighbour_accumulation(       EdgeFuncObj                 edge_func,
-                                      AccLeftFuncObj              accl_func,
-                                      AccRightFuncObj             accr_func,
-                                      Array<ElemTd,NDIM,GTd,ASd>&       dst,
-                                const Array<ElemT0,NDIM,GT0,AS0>&      src0,
-                                const Array<ElemTs,NDIM,GTs,ASs>&...   srcs )
+   template<typename  FirstFuncObj,
+            typename SecondFuncObj,
+            int               NDIM,
+            GridType            GT>
+   void for_each_face_lagged(       FirstFuncObj    first_func,
+                                    SecondFuncObj  second_func,
+                              const Shape<NDIM,GT>&      shape )
   {
-      neighbour_accumulation( execution::seq,
-                              edge_func, accl_func, accr_func,
-                              dst, src0, srcs... );
-      return;
+      for_each_face_lagged( execution::seq, first_func, second_func, shape );
+  }
+
+/*
+ * serial execution
+ */
+   template<typename  FirstFuncObj,
+            typename SecondFuncObj,
+            int               NDIM,
+            GridType            GT>
+   void for_each_face_lagged(       execution::serial_policy,
+                                    FirstFuncObj                first_func,
+                                    SecondFuncObj              second_func,
+                              const Shape<NDIM,GT>&                  shape )
+  {
+      for_each_face_lagged( execution::seq, first_func, second_func, no_boundary_face{}, shape );
+  }
+
+   template<typename    FirstFuncObj,
+            typename   SecondFuncObj,
+            typename BoundaryFuncObj,
+            int                 NDIM,
+            GridType              GT>
+   void for_each_face_lagged(       execution::serial_policy,
+                                    FirstFuncObj                first_func,
+                                    SecondFuncObj              second_func,
+                                    BoundaryFuncObj          boundary_func,
+                              const Shape<NDIM,GT>&                  shape )
+  {
+      for_each_face_lagged_slab( first_func, second_func, boundary_func, shape, 0, shape[0] );
+
+      for_each_end_face( boundary_func, shape, false );
+      for_each_end_face( boundary_func, shape, true  );
+  }
+
+/*
+ * OpenMP execution
+ *    each thread sweeps its own slab of at least two planes, so only the faces between slabs are shared:
+ *    first_func visits them before the slabs are swept, and second_func after
+ *    the three loops over slabs are statically scheduled the same way, so each slab stays with one thread
+ *    the boundary faces normal to dimension 0 are visited with the faces between slabs, by the threads of the first and last slabs
+ */
+   template<typename  FirstFuncObj,
+            typename SecondFuncObj,
+            int               NDIM,
+            GridType            GT>
+   void for_each_face_lagged( const execution::openmp_policy&   policy,
+                                    FirstFuncObj                first_func,
+                                    SecondFuncObj              second_func,
+                              const Shape<NDIM,GT>&                  shape )
+  {
+      for_each_face_lagged( policy, first_func, second_func, no_boundary_face{}, shape );
+  }
+
+   template<typename    FirstFuncObj,
+            typename   SecondFuncObj,
+            typename BoundaryFuncObj,
+            int                 NDIM,
+            GridType              GT>
+   void for_each_face_lagged( const execution::openmp_policy&   policy,
+                                    FirstFuncObj                first_func,
+                                    SecondFuncObj              second_func,
+                                    BoundaryFuncObj          boundary_func,
+                              const Shape<NDIM,GT>&                  shape )
+  {
+      const size_t ni = shape[0];
+
+      const int    nthreads = openmp_num_threads( policy );
+      const size_t nslabs   = std::min( size_t(nthreads), ni/2 );
+
+      if( nslabs<2 )
+     {
+         for_each_face_lagged( execution::seq, first_func, second_func, boundary_func, shape );
+         return;
+     }
+
+      const auto slab_begin = [&]( const size_t s ){ return (s*ni)/nslabs; };
+
+# ifdef _OPENMP
+   # pragma omp parallel num_threads(nthreads)
+# endif
+     {
+# ifdef _OPENMP
+   # pragma omp for schedule(static)
+# endif
+         for( size_t s=0; s<nslabs; ++s )
+        {
+            if( s>0 ){ for_each_interplane_face( first_func, shape, slab_begin(s) ); }
+        }
+
+# ifdef _OPENMP
+   # pragma omp for schedule(static)
+# endif
+         for( size_t s=0; s<nslabs; ++s )
+        {
+            for_each_face_lagged_slab( first_func, second_func, boundary_func, shape, slab_begin(s), slab_begin(s+1) );
+        }
+
+# ifdef _OPENMP
+   # pragma omp for schedule(static)
+# endif
+         for( size_t s=0; s<nslabs; ++s )
+        {
+            if( s>0 ){ for_each_interplane_face( second_func, shape, slab_begin(s) ); }
+
+            if( s==0        ){ for_each_end_face( boundary_func, shape, false ); }
+            if( s==nslabs-1 ){ for_each_end_face( boundary_func, shape, true  ); }
+        }
+     }
+  }
+
+/*
+ * thread pool execution
+ *    as OpenMP execution, with one slab per pool thread
+ */
+   template<typename  FirstFuncObj,
+            typename SecondFuncObj,
+            int               NDIM,
+            GridType            GT>
+   void for_each_face_lagged(       execution::thread_pool_policy     policy,
+                                    FirstFuncObj                first_func,
+                                    SecondFuncObj              second_func,
+                              const Shape<NDIM,GT>&                  shape )
+  {
+      for_each_face_lagged( policy, first_func, second_func, no_boundary_face{}, shape );
+  }
+
+   template<typename    FirstFuncObj,
+            typename   SecondFuncObj,
+            typename BoundaryFuncObj,
+            int                 NDIM,
+            GridType              GT>
+   void for_each_face_lagged(       execution::thread_pool_policy,
+                                    FirstFuncObj                first_func,
+                                    SecondFuncObj              second_func,
+                                    BoundaryFuncObj          boundary_func,
+                              const Shape<NDIM,GT>&                  shape )
+  {
+      const size_t ni = shape[0];
+
+      const size_t nslabs = std::min( size_t(default_thread_pool().size()), ni/2 );
+
+      if( nslabs<2 )
+     {
+         for_each_face_lagged( execution::seq, first_func, second_func, boundary_func, shape );
+         return;
+     }
+
+      const auto slab_begin = [&]( const size_t s ){ return (s*ni)/nslabs; };
+
+      default_thread_pool().parallel_for( nslabs,
+                                          [&]( const size_t begin, const size_t end )
+                                         {
+                                             for( size_t s=std::max(begin,size_t(1)); s<end; ++s )
+                                            {
+                                                for_each_interplane_face( first_func, shape, slab_begin(s) );
+                                            }
+                                         } );
+
+      default_thread_pool().parallel_for( nslabs,
+                                          [&]( const size_t begin, const size_t end )
+                                         {
+                                             for( size_t s=begin; s<end; ++s )
+                                            {
+                                                for_each_face_lagged_slab( first_func, second_func, boundary_func, shape, slab_begin(s), slab_begin(s+1) );
+                                            }
+                                         } );
+
+      default_thread_pool().parallel_for( nslabs,
+                                          [&]( const size_t begin, const size_t end )
+                                         {
+                                             for( size_t s=begin; s<end; ++s )
+                                            {
+                                                if( s>0 ){ for_each_interplane_face( second_func, shape, slab_begin(s) ); }
+
+                                                if( s==0        ){ for_each_end_face( boundary_func, shape, false ); }
+                                                if( s==nslabs-1 ){ for_each_end_face( boundary_func, shape, true  ); }
+                                            }
+                                         } );
   }
 
+/*
+ * ------------------------- par::apply_stencil2 ------------------------
+ */
+
 /*
  * apply a function to a 2-element stencil from a list of arrays
  */
@@ -50,7 +1161,7 @@ namespace par
                         const Idx<NDIM,GT>&             idxl,
                         const Idx<NDIM,GT>&             idxr,
                         const Array<ElemT,NDIM,GT,AS>&  src0,
-                        const ArraysAndArguments...     args ) _PAR_ALWAYS_INLINE_
+                        const ArraysAndArguments&...    args ) _PAR_ALWAYS_INLINE_
   {
       return apply_stencil2( stencil2_func,
                              idxl, idxr,
@@ -65,13 +1176,49 @@ namespace par
    auto apply_stencil2(       FuncObj   stencil2_func,
                         const Idx<NDIM,GT>&      idxl,
                         const Idx<NDIM,GT>&      idxr,
-                        const Arguments...       args ) _PAR_ALWAYS_INLINE_
+                        const Arguments&...      args ) _PAR_ALWAYS_INLINE_
   {
       return stencil2_func( args... );
   }
 
 /*
- * 1D all arrays are same grid type - serial execution
+ * apply a function to a 2-element stencil from a list of arrays, also passing the stencil indices to the function
+ */
+   template<typename    FuncObj,
+            int            NDIM,
+            GridType         GT,
+            typename... Arrays>
+   auto apply_stencil2_idx(       FuncObj   stencil2_func,
+                            const Idx<NDIM,GT>&      idxl,
+                            const Idx<NDIM,GT>&      idxr,
+                            const Arrays&...       arrays ) _PAR_ALWAYS_INLINE_
+  {
+      const auto with_idx = [&]( const auto&... args )
+     {
+         return stencil2_func( idxl, idxr, args... );
+     };
+
+      return apply_stencil2( with_idx,
+                             idxl, idxr,
+                             arrays... );
+  }
+
+/*
+ * ------------------------- par::neighbour_accumulation_idx ------------------------
+ *
+ * For every face between neighbouring elements idxl, idxr:
+ *    acc_v = edge_func( idxl,idxr, src0(idxl),src0(idxr), srcs(idxl),srcs(idxr)... )
+ *    dst(idxl) = accl_func( dst(idxl), acc_v )
+ *    dst(idxr) = accr_func( dst(idxr), acc_v )
+ *
+ * Parallel execution avoids concurrent writes to the same element of dst using one of the accumulation schemes:
+ *    accumulation::colour - faces are processed in colours which do not share any elements (default)
+ *    accumulation::gather - all face values are stored in temporary face arrays before being gathered into each element
+ *    Tiling<NDIM>         - all faces of each tile are visited together, and tiles are processed in colours
+ */
+
+/*
+ * run in serial if no policy provided
  */
    template<typename       EdgeFuncObj,
             typename    AccLeftFuncObj,
@@ -79,17 +1226,80 @@ namespace par
             typename            ElemTd,
             typename            ElemT0,
             typename...         ElemTs,
-            GridType                GT,
+            int                   NDIM,
+            GridType               GTd,
+            GridType               GT0,
+            GridType...            GTs,
             ArraySizing            ASd,
             ArraySizing            AS0,
             ArraySizing...         ASs>
-   void neighbour_accumulation(       execution::serial_policy,
-                                      EdgeFuncObj             edge_func,
-                                      AccLeftFuncObj          accl_func,
-                                      AccRightFuncObj         accr_func,
-                                      Array1<ElemTd,GT,ASd>&        dst,
-                                const Array1<ElemT0,GT,AS0>&       src0,
-                                const Array1<ElemTs,GT,ASs>&...    srcs )
+   void neighbour_accumulation_idx(       EdgeFuncObj                 edge_func,
+                                          AccLeftFuncObj              accl_func,
+                                          AccRightFuncObj             accr_func,
+                                          Array<ElemTd,NDIM,GTd,ASd>&       dst,
+                                    const Array<ElemT0,NDIM,GT0,AS0>&      src0,
+                                    const Array<ElemTs,NDIM,GTs,ASs>&...   srcs )
+  {
+      neighbour_accumulation_idx( execution::seq,
+                                  edge_func, accl_func, accr_func,
+                                  dst, src0, srcs... );
+  }
+
+/*
+ * use face colouring if no accumulation scheme provided
+ */
+   template<execution_policy          Policy,
+            typename           EdgeFuncObj,
+            typename        AccLeftFuncObj,
+            typename       AccRightFuncObj,
+            typename                ElemTd,
+            typename                ElemT0,
+            typename...             ElemTs,
+            int                       NDIM,
+            GridType                    GT,
+            ArraySizing                ASd,
+            ArraySizing                AS0,
+            ArraySizing...             ASs>
+   void neighbour_accumulation_idx( const Policy                              policy,
+                                          EdgeFuncObj                      edge_func,
+                                          AccLeftFuncObj                   accl_func,
+                                          AccRightFuncObj                  accr_func,
+                                          Array<ElemTd,NDIM,GT,ASd>&             dst,
+                                    const Array<ElemT0,NDIM,GT,AS0>&            src0,
+                                    const Array<ElemTs,NDIM,GT,ASs>&...         srcs )
+  {
+      neighbour_accumulation_idx( policy, accumulation::colour,
+                                  edge_func, accl_func, accr_func,
+                                  dst, src0, srcs... );
+  }
+
+/*
+ * serial execution, and OpenMP execution with face colouring or tiling, all arrays are same grid type
+ *    each face is accumulated directly into dst as it is visited
+ *    face gather is implemented separately below, and vectorised policies use the unvectorised face gather
+ */
+   template<execution_policy          Policy,
+            accumulation_policy       Scheme,
+            typename           EdgeFuncObj,
+            typename        AccLeftFuncObj,
+            typename       AccRightFuncObj,
+            typename                ElemTd,
+            typename                ElemT0,
+            typename...             ElemTs,
+            int                       NDIM,
+            GridType                    GT,
+            ArraySizing                ASd,
+            ArraySizing                AS0,
+            ArraySizing...             ASs>
+      requires !(std::is_same_v<Scheme,accumulation::face_gather_policy>)
+   void neighbour_accumulation_idx( const Policy                              policy,
+                                    const Scheme                              scheme,
+                                          EdgeFuncObj                      edge_func,
+                                          AccLeftFuncObj                   accl_func,
+                                          AccRightFuncObj                  accr_func,
+                                          Array<ElemTd,NDIM,GT,ASd>&             dst,
+                                    const Array<ElemT0,NDIM,GT,AS0>&            src0,
+                                    const Array<ElemTs,NDIM,GT,ASs>&...         srcs )
   {
          assert(   (dst.shape() == src0.shape())
                 && "par::neighbour_accumulation - arrays must be the same shape" );
@@ -97,27 +1307,54 @@ namespace par
       (( assert(   (dst.shape() == srcs.shape())
                 && "par::neighbour_accumulation - arrays must be the same shape" ) ),... );
 
-      const size_t ni = dst.shape(0);
-
-      for( size_t i=0; i<ni-1; ++i )
+      const auto face_func = [&]( const Idx<NDIM,GT>& idxl,
+                                  const Idx<NDIM,GT>& idxr,
+                                  const int ) -> void
      {
-         const Idx1<GT> il{i  };
-         const Idx1<GT> ir{i+1};
+         const auto acc_v = apply_stencil2_idx( edge_func,
+                                                idxl,idxr,
+                                                src0, srcs... );
 
-         const auto acc_v = apply_stencil2( edge_func,
-                                            il,ir,
-                                            src0, srcs... );
+         dst(idxl) = accl_func( std::move(dst(idxl)),
+                                acc_v );
 
-         dst(il) = accl_func( std::move(dst(il)),
-                              acc_v );
+         dst(idxr) = accr_func( std::move(dst(idxr)),
+                                acc_v );
+     };
 
-         dst(ir) = accr_func( std::move(dst(ir)),
-                              acc_v );
-     }
+      for_each_face( policy, scheme, face_func, dst.shape() );
+  }
+
+/*
+ * serial execution of face gather is the same as serial face colouring
+ */
+   template<typename           EdgeFuncObj,
+            typename        AccLeftFuncObj,
+            typename       AccRightFuncObj,
+            typename                ElemTd,
+            typename                ElemT0,
+            typename...             ElemTs,
+            int                       NDIM,
+            GridType                    GT,
+            ArraySizing                ASd,
+            ArraySizing                AS0,
+            ArraySizing...             ASs>
+   void neighbour_accumulation_idx(       execution::serial_policy            policy,
+                                          accumulation::face_gather_policy,
+                                          EdgeFuncObj                      edge_func,
+                                          AccLeftFuncObj                   accl_func,
+                                          AccRightFuncObj                  accr_func,
+                                          Array<ElemTd,NDIM,GT,ASd>&             dst,
+                                    const Array<ElemT0,NDIM,GT,AS0>&            src0,
+                                    const Array<ElemTs,NDIM,GT,ASs>&...         srcs )
+  {
+      neighbour_accumulation_idx( policy, accumulation::colour,
+                                  edge_func, accl_func, accr_func,
+                                  dst, src0, srcs... );
   }
 
 /*
- * 1D all arrays are same grid type - OpenMP execution
+ * 1D all arrays are same grid type - OpenMP execution with face gather
  */
    template<typename       EdgeFuncObj,
             typename    AccLeftFuncObj,
@@ -129,13 +1366,14 @@ namespace par
             ArraySizing            ASd,
             ArraySizing            AS0,
             ArraySizing...         ASs>
-   void neighbour_accumulation(       execution::openmp_policy,
-                                      EdgeFuncObj             edge_func,
-                                      AccLeftFuncObj          accl_func,
-                                      AccRightFuncObj         accr_func,
-                                      Array1<ElemTd,GT,ASd>&        dst,
-                                const Array1<ElemT0,GT,AS0>&       src0,
-                                const Array1<ElemTs,GT,ASs>&...    srcs )
+   void neighbour_accumulation_idx( const execution::openmp_policy&     policy,
+                                          accumulation::face_gather_policy,
+                                          EdgeFuncObj             edge_func,
+                                          AccLeftFuncObj          accl_func,
+                                          AccRightFuncObj         accr_func,
+                                          Array1<ElemTd,GT,ASd>&        dst,
+                                    const Array1<ElemT0,GT,AS0>&       src0,
+                                    const Array1<ElemTs,GT,ASs>&...    srcs )
   {
          assert(   (dst.shape() == src0.shape())
                 && "par::neighbour_accumulation - arrays must be the same shape" );
@@ -145,28 +1383,46 @@ namespace par
 
       const size_t ni = dst.shape(0);
 
-# ifdef _OPENMP
-   # pragma omp parallel for
-# endif
-      for( size_t i=0; i<ni-1; ++i )
-     {
-         const Idx1<GT> il{i  };
-         const Idx1<GT> ir{i+1};
+      if( length(dst.shape())==0 ){ return; }
 
-         const auto acc_v = apply_stencil2( edge_func,
-                                            il,ir,
-                                            src0, srcs... );
+      using FaceT = std::decay_t<decltype( apply_stencil2_idx( edge_func,
+                                                               Idx1<GT>{}, Idx1<GT>{},
+                                                               src0, srcs... ) )>;
 
-         dst(il) = accl_func( std::move(dst(il)),
-                              acc_v );
+   // face i is between elements i and i+1
+      Array1<FaceT,GT> faces( Shape1<GT>{ni-1} );
 
-         dst(ir) = accr_func( std::move(dst(ir)),
-                              acc_v );
-     }
+      for_each_index( policy, Idx1<GT>{0}, Idx1<GT>{ni-1},
+                      [&]( const Idx1<GT>& il )
+                     {
+                         const Idx1<GT> ir{il[0]+1};
+
+                         faces(il) = apply_stencil2_idx( edge_func,
+                                                         il,ir,
+                                                         src0, srcs... );
+                     } );
+
+   // gather in the same order as serial execution: left face then right face
+      for_each_index( policy, Idx1<GT>{0}, Idx1<GT>{ni},
+                      [&]( const Idx1<GT>& ic )
+                     {
+                         const size_t i = ic[0];
+
+                         if( i>0 )
+                        {
+                            dst(ic) = accr_func( std::move(dst(ic)),
+                                                 faces(Idx1<GT>{i-1}) );
+                        }
+                         if( i<ni-1 )
+                        {
+                            dst(ic) = accl_func( std::move(dst(ic)),
+                                                 faces(ic) );
+                        }
+                     } );
   }
 
 /*
- * 2D all arrays are same grid type - serial execution
+ * 2D all arrays are same grid type - OpenMP execution with face gather
  */
    template<typename       EdgeFuncObj,
             typename    AccLeftFuncObj,
@@ -178,13 +1434,14 @@ namespace par
             ArraySizing            ASd,
             ArraySizing            AS0,
             ArraySizing...         ASs>
-   void neighbour_accumulation(       execution::serial_policy,
-                                      EdgeFuncObj             edge_func,
-                                      AccLeftFuncObj          accl_func,
-                                      AccRightFuncObj         accr_func,
-                                      Array2<ElemTd,GT,ASd>&        dst,
-                                const Array2<ElemT0,GT,AS0>&       src0,
-                                const Array2<ElemTs,GT,ASs>&...    srcs )
+   void neighbour_accumulation_idx( const execution::openmp_policy&     policy,
+                                          accumulation::face_gather_policy,
+                                          EdgeFuncObj             edge_func,
+                                          AccLeftFuncObj          accl_func,
+                                          AccRightFuncObj         accr_func,
+                                          Array2<ElemTd,GT,ASd>&        dst,
+                                    const Array2<ElemT0,GT,AS0>&       src0,
+                                    const Array2<ElemTs,GT,ASs>&...    srcs )
   {
          assert(   (dst.shape() == src0.shape())
                 && "par::neighbour_accumulation - arrays must be the same shape" );
@@ -195,50 +1452,70 @@ namespace par
       const size_t ni = dst.shape(0);
       const size_t nj = dst.shape(1);
 
-      for( size_t j=0; j<nj; ++j )
-     {
-         for( size_t i=0; i<ni-1; ++i )
-        {
-            const Idx2<GT> ijl{i  ,j};
-            const Idx2<GT> ijr{i+1,j};
+      if( length(dst.shape())==0 ){ return; }
 
-            const auto acc_v = apply_stencil2( edge_func,
-                                               ijl,ijr,
-                                               src0, srcs... );
+      using FaceT = std::decay_t<decltype( apply_stencil2_idx( edge_func,
+                                                               Idx2<GT>{}, Idx2<GT>{},
+                                                               src0, srcs... ) )>;
 
-            dst(ijl) = accl_func( std::move(dst(ijl)),
-                                  acc_v );
+   // face {i,j} in faces0 is between elements {i,j} and {i+1,j}
+   // face {i,j} in faces1 is between elements {i,j} and {i,j+1}
+      Array2<FaceT,GT> faces0( Shape2<GT>{ni-1,nj  } );
+      Array2<FaceT,GT> faces1( Shape2<GT>{ni,  nj-1} );
 
-            dst(ijr) = accr_func( std::move(dst(ijr)),
-                                  acc_v );
-        }
-     }
+      for_each_index( policy, Idx2<GT>{0,0}, Idx2<GT>{ni-1,nj},
+                      [&]( const Idx2<GT>& ijl )
+                     {
+                         const Idx2<GT> ijr{ijl[0]+1,ijl[1]};
 
-   // derivatives over i-normal faces
-      for( size_t i=0; i<ni; ++i )
-     {
-         for( size_t j=0; j<nj-1; ++j )
-        {
-            const Idx2<GT> ijl{i,j  };
-            const Idx2<GT> ijr{i,j+1};
+                         faces0(ijl) = apply_stencil2_idx( edge_func,
+                                                           ijl,ijr,
+                                                           src0, srcs... );
+                     } );
 
-            const auto acc_v = apply_stencil2( edge_func,
-                                               ijl,ijr,
-                                               src0, srcs... );
+      for_each_index( policy, Idx2<GT>{0,0}, Idx2<GT>{ni,nj-1},
+                      [&]( const Idx2<GT>& ijl )
+                     {
+                         const Idx2<GT> ijr{ijl[0],ijl[1]+1};
 
-            dst(ijl) = accl_func( std::move(dst(ijl)),
-                                  acc_v );
+                         faces1(ijl) = apply_stencil2_idx( edge_func,
+                                                           ijl,ijr,
+                                                           src0, srcs... );
+                     } );
 
-            dst(ijr) = accr_func( std::move(dst(ijr)),
-                                  acc_v );
-        }
-     }
+   // gather in the same order as serial execution: all dimension 0 faces before all dimension 1 faces, left face before right face
+      for_each_index( policy, Idx2<GT>{0,0}, Idx2<GT>{ni,nj},
+                      [&]( const Idx2<GT>& ij )
+                     {
+                         const size_t i = ij[0];
+                         const size_t j = ij[1];
 
-      return;
+                         if( i>0 )
+                        {
+                            dst(ij) = accr_func( std::move(dst(ij)),
+                                                 faces0(Idx2<GT>{i-1,j}) );
+                        }
+                         if( i<ni-1 )
+                        {
+                            dst(ij) = accl_func( std::move(dst(ij)),
+                                                 faces0(ij) );
+                        }
+
+                         if( j>0 )
+                        {
+                            dst(ij) = accr_func( std::move(dst(ij)),
+                                                 faces1(Idx2<GT>{i,j-1}) );
+                        }
+                         if( j<nj-1 )
+                        {
+                            dst(ij) = accl_func( std::move(dst(ij)),
+                                                 faces1(ij) );
+                        }
+                     } );
   }
 
 /*
- * 2D all arrays are same grid type - OpenMP execution
+ * 3D all arrays are same grid type - OpenMP execution with face gather
  */
    template<typename       EdgeFuncObj,
             typename    AccLeftFuncObj,
@@ -250,13 +1527,14 @@ namespace par
             ArraySizing            ASd,
             ArraySizing            AS0,
             ArraySizing...         ASs>
-   void neighbour_accumulation(       execution::openmp_policy,
-                                      EdgeFuncObj             edge_func,
-                                      AccLeftFuncObj          accl_func,
-                                      AccRightFuncObj         accr_func,
-                                      Array2<ElemTd,GT,ASd>&        dst,
-                                const Array2<ElemT0,GT,AS0>&       src0,
-                                const Array2<ElemTs,GT,ASs>&...    srcs )
+   void neighbour_accumulation_idx( const execution::openmp_policy&     policy,
+                                          accumulation::face_gather_policy,
+                                          EdgeFuncObj             edge_func,
+                                          AccLeftFuncObj          accl_func,
+                                          AccRightFuncObj         accr_func,
+                                          Array3<ElemTd,GT,ASd>&        dst,
+                                    const Array3<ElemT0,GT,AS0>&       src0,
+                                    const Array3<ElemTs,GT,ASs>&...    srcs )
   {
          assert(   (dst.shape() == src0.shape())
                 && "par::neighbour_accumulation - arrays must be the same shape" );
@@ -266,53 +1544,337 @@ namespace par
 
       const size_t ni = dst.shape(0);
       const size_t nj = dst.shape(1);
+      const size_t nk = dst.shape(2);
 
-# ifdef _OPENMP
-   # pragma omp parallel for
-# endif
-   // j-normal faces
-      for( size_t j=0; j<nj; ++j )
-     {
-         for( size_t i=0; i<ni-1; ++i )
-        {
-            const Idx2<GT> ijl{i  ,j};
-            const Idx2<GT> ijr{i+1,j};
+      if( length(dst.shape())==0 ){ return; }
 
-            const auto acc_v = apply_stencil2( edge_func,
-                                               ijl,ijr,
-                                               src0, srcs... );
+      using FaceT = std::decay_t<decltype( apply_stencil2_idx( edge_func,
+                                                               Idx3<GT>{}, Idx3<GT>{},
+                                                               src0, srcs... ) )>;
 
-            dst(ijl) = accl_func( std::move(dst(ijl)),
-                                  acc_v );
+   // face {i,j,k} in faces0 is between elements {i,j,k} and {i+1,j,k}
+   // face {i,j,k} in faces1 is between elements {i,j,k} and {i,j+1,k}
+   // face {i,j,k} in faces2 is between elements {i,j,k} and {i,j,k+1}
+      Array3<FaceT,GT> faces0( Shape3<GT>{ni-1,nj,  nk  } );
+      Array3<FaceT,GT> faces1( Shape3<GT>{ni,  nj-1,nk  } );
+      Array3<FaceT,GT> faces2( Shape3<GT>{ni,  nj,  nk-1} );
 
-            dst(ijr) = accr_func( std::move(dst(ijr)),
-                                  acc_v );
-        }
-     }
+      for_each_index( policy, Idx3<GT>{0,0,0}, Idx3<GT>{ni-1,nj,nk},
+                      [&]( const Idx3<GT>& ijkl )
+                     {
+                         const Idx3<GT> ijkr{ijkl[0]+1,ijkl[1],ijkl[2]};
 
-# ifdef _OPENMP
-   # pragma omp parallel for
-# endif
-   // i-normal faces
-      for( size_t i=0; i<ni; ++i )
+                         faces0(ijkl) = apply_stencil2_idx( edge_func,
+                                                            ijkl,ijkr,
+                                                            src0, srcs... );
+                     } );
+
+      for_each_index( policy, Idx3<GT>{0,0,0}, Idx3<GT>{ni,nj-1,nk},
+                      [&]( const Idx3<GT>& ijkl )
+                     {
+                         const Idx3<GT> ijkr{ijkl[0],ijkl[1]+1,ijkl[2]};
+
+                         faces1(ijkl) = apply_stencil2_idx( edge_func,
+                                                            ijkl,ijkr,
+                                                            src0, srcs... );
+                     } );
+
+      for_each_index( policy, Idx3<GT>{0,0,0}, Idx3<GT>{ni,nj,nk-1},
+                      [&]( const Idx3<GT>& ijkl )
+                     {
+                         const Idx3<GT> ijkr{ijkl[0],ijkl[1],ijkl[2]+1};
+
+                         faces2(ijkl) = apply_stencil2_idx( edge_func,
+                                                            ijkl,ijkr,
+                                                            src0, srcs... );
+                     } );
+
+   // gather in the same order as serial execution: dimension 0, then 1, then 2 faces, left face before right face
+      for_each_index( policy, Idx3<GT>{0,0,0}, Idx3<GT>{ni,nj,nk},
+                      [&]( const Idx3<GT>& ijk )
+                     {
+                         const size_t i = ijk[0];
+                         const size_t j = ijk[1];
+                         const size_t k = ijk[2];
+
+                         if( i>0 )
+                        {
+                            dst(ijk) = accr_func( std::move(dst(ijk)),
+                                                  faces0(Idx3<GT>{i-1,j,k}) );
+                        }
+                         if( i<ni-1 )
+                        {
+                            dst(ijk) = accl_func( std::move(dst(ijk)),
+                                                  faces0(ijk) );
+                        }
+
+                         if( j>0 )
+                        {
+                            dst(ijk) = accr_func( std::move(dst(ijk)),
+                                                  faces1(Idx3<GT>{i,j-1,k}) );
+                        }
+                         if( j<nj-1 )
+                        {
+                            dst(ijk) = accl_func( std::move(dst(ijk)),
+                                                  faces1(ijk) );
+                        }
+
+                         if( k>0 )
+                        {
+                            dst(ijk) = accr_func( std::move(dst(ijk)),
+                                                  faces2(Idx3<GT>{i,j,k-1}) );
+                        }
+                         if( k<nk-1 )
+                        {
+                            dst(ijk) = accl_func( std::move(dst(ijk)),
+                                                  faces2(ijk) );
+                        }
+                     } );
+  }
+
+/*
+ * Bounding-box overloads: only the faces between two elements with indices in box are visited
+ *    the arrays are accumulated through views of the box, so every execution policy and accumulation scheme is supported,
+ *    and edge_func is passed the indices of the elements in the whole arrays
+ */
+   template<execution_policy          Policy,
+            typename           EdgeFuncObj,
+            typename        AccLeftFuncObj,
+            typename       AccRightFuncObj,
+            typename                ElemTd,
+            typename                ElemT0,
+            typename...             ElemTs,
+            int                       NDIM,
+            GridType                    GT,
+            ArraySizing                ASd,
+            ArraySizing                AS0,
+            ArraySizing...             ASs>
+   void neighbour_accumulation_idx( const Policy                              policy,
+                                    const Box<NDIM,GT>&                          box,
+                                          EdgeFuncObj                      edge_func,
+                                          AccLeftFuncObj                   accl_func,
+                                          AccRightFuncObj                  accr_func,
+                                          Array<ElemTd,NDIM,GT,ASd>&             dst,
+                                    const Array<ElemT0,NDIM,GT,AS0>&            src0,
+                                    const Array<ElemTs,NDIM,GT,ASs>&...         srcs )
+  {
+      neighbour_accumulation_idx( policy, accumulation::colour, box,
+                                  edge_func, accl_func, accr_func,
+                                  dst, src0, srcs... );
+  }
+
+   template<execution_policy          Policy,
+            accumulation_policy       Scheme,
+            typename           EdgeFuncObj,
+            typename        AccLeftFuncObj,
+            typename       AccRightFuncObj,
+            typename                ElemTd,
+            typename                ElemT0,
+            typename...             ElemTs,
+            int                       NDIM,
+            GridType                    GT,
+            ArraySizing                ASd,
+            ArraySizing                AS0,
+            ArraySizing...             ASs>
+   void neighbour_accumulation_idx( const Policy                              policy,
+                                    const Scheme                              scheme,
+                                    const Box<NDIM,GT>&                          box,
+                                          EdgeFuncObj                      edge_func,
+                                          AccLeftFuncObj                   accl_func,
+                                          AccRightFuncObj                  accr_func,
+                                          Array<ElemTd,NDIM,GT,ASd>&             dst,
+                                    const Array<ElemT0,NDIM,GT,AS0>&            src0,
+                                    const Array<ElemTs,NDIM,GT,ASs>&...         srcs )
+  {
+         assert(   (dst.shape() == src0.shape())
+                && "par::neighbour_accumulation - arrays must be the same shape" );
+
+      (( assert(   (dst.shape() == srcs.shape())
+                && "par::neighbour_accumulation - arrays must be the same shape" ) ),... );
+
+   // indices in the views are relative to the first index of the box
+      const auto edge_func_box = [&]( const Idx<NDIM,GT>& idxl,
+                                      const Idx<NDIM,GT>& idxr,
+                                      const auto&...      args )
      {
-         for( size_t j=0; j<nj-1; ++j )
+         Idx<NDIM,GT> il=idxl;
+         Idx<NDIM,GT> ir=idxr;
+         for( int d=0; d<NDIM; ++d )
         {
-            const Idx2<GT> ijl{i,j  };
-            const Idx2<GT> ijr{i,j+1};
+            il.idxs[d]+=box.first[d];
+            ir.idxs[d]+=box.first[d];
+        }
+         return edge_func( il, ir, args... );
+     };
 
-            const auto acc_v = apply_stencil2( edge_func,
-                                               ijl,ijr,
-                                               src0, srcs... );
+      auto dst_box = subview( dst, box );
 
-            dst(ijl) = accl_func( std::move(dst(ijl)),
-                                  acc_v );
+      neighbour_accumulation_idx( policy, scheme,
+                                  edge_func_box, accl_func, accr_func,
+                                  dst_box,
+                                  subview( src0, box ),
+                                  subview( srcs, box )... );
+  }
 
-            dst(ijr) = accr_func( std::move(dst(ijr)),
-                                  acc_v );
-        }
-     }
+/*
+ * ------------------------- par::neighbour_accumulation ------------------------
+ *
+ * Same as neighbour_accumulation_idx, but edge_func is only passed the values from the source arrays:
+ *    acc_v = edge_func( src0(idxl),src0(idxr), srcs(idxl),srcs(idxr)... )
+ */
 
+/*
+ * run in serial if no policy provided
+ */
+   template<typename       EdgeFuncObj,
+            typename    AccLeftFuncObj,
+            typename   AccRightFuncObj,
+            typename            ElemTd,
+            typename            ElemT0,
+            typename...         ElemTs,
+            int                   NDIM,
+            GridType               GTd,
+            GridType               GT0,
+            GridType...            GTs,
+            ArraySizing            ASd,
+            ArraySizing            AS0,
+            ArraySizing...         ASs>
+   void neighbour_accumulation(       EdgeFuncObj                 edge_func,
+                                      AccLeftFuncObj              accl_func,
+                                      AccRightFuncObj             accr_func,
+                                      Array<ElemTd,NDIM,GTd,ASd>&       dst,
+                                const Array<ElemT0,NDIM,GT0,AS0>&      src0,
+                                const Array<ElemTs,NDIM,GTs,ASs>&...   srcs )
+  {
+      neighbour_accumulation( execution::seq,
+                              edge_func, accl_func, accr_func,
+                              dst, src0, srcs... );
       return;
   }
+
+/*
+ * use face colouring if no accumulation scheme provided
+ */
+   template<execution_policy          Policy,
+            typename           EdgeFuncObj,
+            typename        AccLeftFuncObj,
+            typename       AccRightFuncObj,
+            typename                ElemTd,
+            typename                ElemT0,
+            typename...             ElemTs,
+            int                       NDIM,
+            GridType                    GT,
+            ArraySizing                ASd,
+            ArraySizing                AS0,
+            ArraySizing...             ASs>
+   void neighbour_accumulation( const Policy                              policy,
+                                      EdgeFuncObj                      edge_func,
+                                      AccLeftFuncObj                   accl_func,
+                                      AccRightFuncObj                  accr_func,
+                                      Array<ElemTd,NDIM,GT,ASd>&             dst,
+                                const Array<ElemT0,NDIM,GT,AS0>&            src0,
+                                const Array<ElemTs,NDIM,GT,ASs>&...         srcs )
+  {
+      neighbour_accumulation( policy, accumulation::colour,
+                              edge_func, accl_func, accr_func,
+                              dst, src0, srcs... );
+  }
+
+/*
+ * discard the indices and forward to neighbour_accumulation_idx
+ */
+   template<execution_policy          Policy,
+            accumulation_policy       Scheme,
+            typename           EdgeFuncObj,
+            typename        AccLeftFuncObj,
+            typename       AccRightFuncObj,
+            typename                ElemTd,
+            typename                ElemT0,
+            typename...             ElemTs,
+            int                       NDIM,
+            GridType                    GT,
+            ArraySizing                ASd,
+            ArraySizing                AS0,
+            ArraySizing...             ASs>
+   void neighbour_accumulation( const Policy                              policy,
+                                const Scheme                              scheme,
+                                      EdgeFuncObj                      edge_func,
+                                      AccLeftFuncObj                   accl_func,
+                                      AccRightFuncObj                  accr_func,
+                                      Array<ElemTd,NDIM,GT,ASd>&             dst,
+                                const Array<ElemT0,NDIM,GT,AS0>&            src0,
+                                const Array<ElemTs,NDIM,GT,ASs>&...         srcs )
+  {
+      const auto edge_func_idx = [&]( const Idx<NDIM,GT>&,
+                                      const Idx<NDIM,GT>&,
+                                      const auto&...   args )
+     {
+         return edge_func( args... );
+     };
+
+      neighbour_accumulation_idx( policy, scheme,
+                                  edge_func_idx, accl_func, accr_func,
+                                  dst, src0, srcs... );
+  }
+
+/*
+ * Bounding-box overloads: only the faces between two elements with indices in box are visited
+ */
+   template<execution_policy          Policy,
+            typename           EdgeFuncObj,
+            typename        AccLeftFuncObj,
+            typename       AccRightFuncObj,
+            typename                ElemTd,
+            typename                ElemT0,
+            typename...             ElemTs,
+            int                       NDIM,
+            GridType                    GT,
+            ArraySizing                ASd,
+            ArraySizing                AS0,
+            ArraySizing...             ASs>
+   void neighbour_accumulation( const Policy                              policy,
+                                const Box<NDIM,GT>&                          box,
+                                      EdgeFuncObj                      edge_func,
+                                      AccLeftFuncObj                   accl_func,
+                                      AccRightFuncObj                  accr_func,
+                                      Array<ElemTd,NDIM,GT,ASd>&             dst,
+                                const Array<ElemT0,NDIM,GT,AS0>&            src0,
+                                const Array<ElemTs,NDIM,GT,ASs>&...         srcs )
+  {
+      neighbour_accumulation( policy, accumulation::colour, box,
+                              edge_func, accl_func, accr_func,
+                              dst, src0, srcs... );
+  }
+
+   template<execution_policy          Policy,
+            accumulation_policy       Scheme,
+            typename           EdgeFuncObj,
+            typename        AccLeftFuncObj,
+            typename       AccRightFuncObj,
+            typename                ElemTd,
+            typename                ElemT0,
+            typename...             ElemTs,
+            int                       NDIM,
+            GridType                    GT,
+            ArraySizing                ASd,
+            ArraySizing                AS0,
+            ArraySizing...             ASs>
+   void neighbour_accumulation( const Policy                              policy,
+                                const Scheme                              scheme,
+                                const Box<NDIM,GT>&                          box,
+                                      EdgeFuncObj                      edge_func,
+                                      AccLeftFuncObj                   accl_func,
+                                      AccRightFuncObj                  accr_func,
+                                      Array<ElemTd,NDIM,GT,ASd>&             dst,
+                                const Array<ElemT0,NDIM,GT,AS0>&            src0,
+                                const Array<ElemTs,NDIM,GT,ASs>&...         srcs )
+  {
+      auto dst_box = subview( dst, box );
+
+      neighbour_accumulation( policy, scheme,
+                              edge_func, accl_func, accr_func,
+                              dst_box,
+                              subview( src0, box ),
+                              subview( srcs, box )... );
+  }
 }
@@ -70,19 +70,180 @@ namespace par
       struct serial_policy {};
       inline constexpr serial_policy seq;
    
-      struct openmp_policy {};
+   /*
+    * loop schedule used by OpenMP execution, see the OpenMP schedule clause
+    */
+      enum struct Schedule { Static, Dynamic, Guided, Auto };
+
+   /*
+    * OpenMP execution, optionally carrying loop parameters which index loops (for_each_idx, generate_idx, neighbour algorithms and tiled loops) honour:
+    *    schedule, chunk_size - loop schedule and chunk size, a chunk size of 0 uses the OpenMP default for the schedule
+    *    collapse             - number of outer dimensions of 2D/3D loops split between threads, 0 chooses enough dimensions to keep every thread busy
+    *    num_threads          - number of threads, 0 uses omp_get_max_threads()
+    *    flat element loops (for_each, transform, copy, fill, reductions) only honour num_threads, and keep a static schedule to match first touch
+    *
+    *    e.g. execution::omp.with_schedule( execution::Schedule::Dynamic, 4 ).with_collapse(2)
+    */
+      struct openmp_policy
+     {
+         Schedule schedule=Schedule::Static;
+         int    chunk_size=0;
+         int      collapse=0;
+         int   num_threads=0;
+
+         constexpr openmp_policy with_schedule( const Schedule kind, const int chunk=0 ) const
+        {
+            openmp_policy policy=*this;
+            policy.schedule=kind;
+            policy.chunk_size=chunk;
+            return policy;
+        }
+
+         constexpr openmp_policy with_collapse( const int depth ) const
+        {
+            openmp_policy policy=*this;
+            policy.collapse=depth;
+            return policy;
+        }
+
+         constexpr openmp_policy with_threads( const int nthreads ) const
+        {
+            openmp_policy policy=*this;
+            policy.num_threads=nthreads;
+            return policy;
+        }
+     };
       inline constexpr openmp_policy omp;
+
+   /*
+    * vectorised variants of the serial and OpenMP policies
+    *    algorithms with a vectorised implementation (for_each, transform, transform_reduce, neighbour_accumulation) assert to the
+    *    compiler that iterations are independent (#pragma omp simd), so functors passed with these policies must not carry state
+    *    between elements. Each derives from its unvectorised policy, so all other algorithms fall back to the unvectorised loops
+    */
+      struct simd_policy : serial_policy {};
+      inline constexpr simd_policy simd;
+
+      struct openmp_simd_policy : openmp_policy
+     {
+         constexpr openmp_simd_policy() = default;
+         constexpr explicit openmp_simd_policy( const openmp_policy& policy ) : openmp_policy(policy) {}
+
+         constexpr openmp_simd_policy with_schedule( const Schedule kind, const int chunk=0 ) const
+        {
+            return openmp_simd_policy( openmp_policy::with_schedule( kind, chunk ) );
+        }
+
+         constexpr openmp_simd_policy with_collapse( const int depth ) const
+        {
+            return openmp_simd_policy( openmp_policy::with_collapse( depth ) );
+        }
+
+         constexpr openmp_simd_policy with_threads( const int nthreads ) const
+        {
+            return openmp_simd_policy( openmp_policy::with_threads( nthreads ) );
+        }
+     };
+      inline constexpr openmp_simd_policy omp_simd;
+
+   /*
+    * loops are split into chunked range tasks executed by a persistent work-stealing thread pool (par::default_thread_pool)
+    */
+      struct thread_pool_policy {};
+      inline constexpr thread_pool_policy pool;
   }
 
    template<typename T>
    struct is_execution_policy : std::false_type {};
 
-   template<> struct is_execution_policy<execution::serial_policy> : std::true_type {};
-   template<> struct is_execution_policy<execution::openmp_policy> : std::true_type {};
+   template<> struct is_execution_policy<execution::serial_policy>      : std::true_type {};
+   template<> struct is_execution_policy<execution::openmp_policy>      : std::true_type {};
+   template<> struct is_execution_policy<execution::simd_policy>        : std::true_type {};
+   template<> struct is_execution_policy<execution::openmp_simd_policy> : std::true_type {};
+   template<> struct is_execution_policy<execution::thread_pool_policy> : std::true_type {};
 
    template<typename T>
    inline constexpr bool is_execution_policy_v = is_execution_policy<T>::value;
 
+/*
+ * true for policies which vectorise loops
+ */
+   template<typename T>
+   struct is_simd_policy : std::false_type {};
+
+   template<> struct is_simd_policy<execution::simd_policy>        : std::true_type {};
+   template<> struct is_simd_policy<execution::openmp_simd_policy> : std::true_type {};
+
+   template<typename T>
+   inline constexpr bool is_simd_policy_v = is_simd_policy<T>::value;
+
+/*
+ * number of independent partial results kept by vectorised reductions, one per vector lane
+ */
+   inline constexpr size_t simd_lanes = 8;
+
    template<typename T>
    concept bool execution_policy = is_execution_policy_v<T>;
+
+/*
+ * namespace holding classes used to determine how parallel neighbour accumulations avoid two threads writing to the same element
+ */
+   namespace accumulation
+  {
+   /*
+    * unique types indicating how concurrent writes to the elements either side of a face are avoided
+    */
+      // faces are split into alternating colours. No two faces of the same colour share an element, so each colour is processed in parallel
+      struct colouring_policy {};
+      inline constexpr colouring_policy colour;
+
+      // the value over every face is first calculated in parallel into a temporary face array, then gathered into each element in parallel
+      // each element is accumulated in the same order as the serial algorithm, so results are identical to serial execution
+      struct face_gather_policy {};
+      inline constexpr face_gather_policy gather;
+  }
+
+   template<typename T>
+   struct is_accumulation_policy : std::false_type {};
+
+   template<> struct is_accumulation_policy<accumulation::colouring_policy>   : std::true_type {};
+   template<> struct is_accumulation_policy<accumulation::face_gather_policy> : std::true_type {};
+
+   template<typename T>
+   inline constexpr bool is_accumulation_policy_v = is_accumulation_policy<T>::value;
+
+   template<typename T>
+   concept bool accumulation_policy = is_accumulation_policy_v<T>;
+
+/*
+ * Shape of the tiles used for cache-blocked iteration over an NDIM-dimensional array, e.g.:
+ *    par::for_each_idx( par::execution::omp, par::Tiling<2>{64,64}, func, array );
+ *
+ *    Can also be used as an accumulation scheme. All faces of one tile are then visited together,
+ *    and tiles are coloured so that tiles which share elements are not processed concurrently
+ */
+   template<int NDIM>
+   struct Tiling
+  {
+      std::array<size_t,NDIM> tile_shape;
+      const size_t& operator[]( const unsigned int i ) const { return tile_shape[i]; }
+  };
+
+   template<int NDIM> struct is_accumulation_policy<Tiling<NDIM>> : std::true_type {};
+
+/*
+ * accumulation schemes supported by par::for_each_face, whose face function accumulates into the elements either side of a face itself
+ *    face gather needs the value over each face separately from its accumulation, so is only supported by par::neighbour_accumulation
+ */
+   template<typename T>
+   struct is_face_accumulation_policy : std::false_type {};
+
+   template<>         struct is_face_accumulation_policy<accumulation::colouring_policy> : std::true_type {};
+   template<int NDIM> struct is_face_accumulation_policy<Tiling<NDIM>>                    : std::true_type {};
+
+   template<typename T>
+   inline constexpr bool is_face_accumulation_policy_v = is_face_accumulation_policy<T>::value;
+
+   template<typename T>
+   concept bool face_accumulation_policy = is_face_accumulation_policy_v<T>;
 }
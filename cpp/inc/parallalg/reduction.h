@@ -0,0 +1,303 @@
+
+# pragma once
+
+# include <parallalg/array.h>
+# include <parallalg/parallalg.h>
+# include <parallalg/allocator.h>
+# include <parallalg/thread_pool.h>
+# include <parallalg/schedule.h>
+
+# include <algorithm>
+# include <array>
+# include <utility>
+# include <vector>
+
+# include <omp.h>
+
+namespace par
+{
+
+/*
+ * number of elements reduced together into one partial result
+ *    chunk boundaries depend only on the number of elements, never on the number of threads
+ */
+   inline constexpr size_t reduction_chunk_size = 4096;
+
+/*
+ * ------------------------- par::flat_row ------------------------
+ *
+ * flattened index of the first element of the r-th row (along the fastest-varying dimension) of an array, counting rows in row-major order
+ *    rows are separated by padding, and by the halo in every dimension
+ */
+   template<typename   ElemT,
+            int         NDIM,
+            GridType      GT,
+            ArraySizing   AS>
+   size_t flat_row( const Array<ElemT,NDIM,GT,AS>& array,
+                          size_t                       r ) _PAR_ALWAYS_INLINE_
+  {
+      size_t i = array.flat_origin();
+      for( int d=NDIM-2; d>0; --d )
+     {
+         i+= array.stride(d)*(r%array.shape(d));
+         r/= array.shape(d);
+     }
+      return NDIM>1 ? i+array.stride(0)*r : i;
+  }
+
+/*
+ * ------------------------- par::flat_index ------------------------
+ *
+ * flattened index of the n-th element of an array, counting elements in row-major order and skipping any padding and halo
+ */
+   template<typename   ElemT,
+            int         NDIM,
+            GridType      GT,
+            ArraySizing   AS>
+   size_t flat_index( const Array<ElemT,NDIM,GT,AS>& array,
+                      const size_t                       n ) _PAR_ALWAYS_INLINE_
+  {
+      if( array.is_contiguous() ){ return n; }
+
+      const size_t nj = array.shape(NDIM-1);
+
+      return flat_row( array, n/nj ) + n%nj;
+  }
+
+/*
+ * ------------------------- par::for_each_flat_index_in_range ------------------------
+ *
+ * Call func(i) for the flattened index i of the elements [nbegin,nend) of an array, counting elements in row-major order and skipping any padding and halo
+ */
+   template<typename FuncObj,
+            typename   ElemT,
+            int         NDIM,
+            GridType      GT,
+            ArraySizing   AS>
+   void for_each_flat_index_in_range( const Array<ElemT,NDIM,GT,AS>&    array,
+                                      const size_t                     nbegin,
+                                      const size_t                       nend,
+                                            FuncObj                      func ) _PAR_ALWAYS_INLINE_
+  {
+      if( array.is_contiguous() )
+     {
+         for( size_t i=nbegin; i<nend; ++i ){ func(i); }
+     }
+      else
+     {
+         const size_t nj = array.shape(NDIM-1);
+
+         size_t r = nbegin/nj;
+         size_t j = nbegin%nj;
+         size_t row = flat_row( array, r );
+
+         for( size_t n=nbegin; n<nend; ++n )
+        {
+            func( row+j );
+            if( ++j==nj ){ j=0; row=flat_row( array, ++r ); }
+        }
+     }
+  }
+
+/*
+ * ------------------------- par::reduce_lanes ------------------------
+ *
+ * Vectorisable reduction of the values value_func(n) for the (non-empty) range of elements [nbegin,nend)
+ *    element n is reduced in order into lane (n-nbegin)%simd_lanes, so the lanes are independent and can be held in one vector register,
+ *    then the lanes are combined with a fixed-shape pairwise tree. The result only depends on nbegin and nend
+ */
+   template<typename ReductionType,
+            typename  ValueFuncObj,
+            typename ReduceFuncObj>
+   ReductionType reduce_lanes( const size_t              nbegin,
+                               const size_t                nend,
+                               const ValueFuncObj&   value_func,
+                               const ReduceFuncObj&       rfunc )
+  {
+      constexpr size_t W = simd_lanes;
+
+   // too short to fill the lanes
+      if( nend-nbegin < W )
+     {
+         ReductionType partial( value_func( nbegin ) );
+         for( size_t n=nbegin+1; n<nend; ++n )
+        {
+            partial = rfunc( std::move(partial), value_func( n ) );
+        }
+         return partial;
+     }
+
+      std::array<ReductionType,W> lanes;
+
+      for( size_t l=0; l<W; ++l ){ lanes[l] = ReductionType( value_func( nbegin+l ) ); }
+
+      const size_t nblock = nbegin + W*((nend-nbegin)/W);
+
+      for( size_t n=nbegin+W; n<nblock; n+=W )
+     {
+# ifdef _OPENMP
+   # pragma omp simd
+# endif
+         for( size_t l=0; l<W; ++l )
+        {
+            lanes[l] = rfunc( std::move(lanes[l]), value_func( n+l ) );
+        }
+     }
+
+   // remainder
+      for( size_t n=nblock; n<nend; ++n )
+     {
+         lanes[n-nblock] = rfunc( std::move(lanes[n-nblock]), value_func( n ) );
+     }
+
+      for( size_t s=1; s<W; s*=2 )
+     {
+         for( size_t l=0; l+s<W; l+=2*s )
+        {
+            lanes[l] = rfunc( std::move(lanes[l]), lanes[l+s] );
+        }
+     }
+
+      return lanes[0];
+  }
+
+/*
+ * ------------------------- par::reduce_chunks ------------------------
+ *
+ * Reduce nelems values with a deterministic combination order, independent of the execution policy and the number of threads:
+ *    1) the elements are split into fixed chunks of reduction_chunk_size elements
+ *    2) each chunk is reduced in order, starting from its first value: partial = rfunc( rfunc( v0, v1 ), v2 ) ...
+ *    3) the chunk partials are combined with a fixed-shape pairwise tree
+ *    4) init is combined once with the result of the tree
+ *
+ * chunk_func( nbegin, nend ) must return the in-order reduction of the (non-empty) range of elements [nbegin,nend)
+ * chunk partials are stored on separate cache lines, so parallel execution has no false sharing
+ */
+
+/*
+ * combine partials[0,n) in place with a fixed-shape pairwise tree, result is left in partials[0]
+ */
+   template<typename ReduceFuncObj,
+            typename ReductionType>
+   void tree_combine( const ReduceFuncObj&                                      rfunc,
+                            std::vector<CacheLinePadded<ReductionType>,
+                                        aligned_allocator<CacheLinePadded<ReductionType>>>& partials )
+  {
+      const size_t n = partials.size();
+
+      for( size_t s=1; s<n; s*=2 )
+     {
+         for( size_t i=0; i+s<n; i+=2*s )
+        {
+            partials[i].value = rfunc( std::move(partials[i].value),
+                                                 partials[i+s].value );
+        }
+     }
+  }
+
+/*
+ * Serial execution
+ */
+   template<typename      ChunkFuncObj,
+            typename     ReduceFuncObj,
+            typename     ReductionType>
+   ReductionType reduce_chunks(       execution::serial_policy,
+                                const size_t                nelems,
+                                const ChunkFuncObj&     chunk_func,
+                                const ReduceFuncObj&         rfunc,
+                                      ReductionType           init )
+  {
+      if( nelems==0 ){ return init; }
+
+      const size_t nchunks = (nelems+reduction_chunk_size-1)/reduction_chunk_size;
+
+      std::vector<CacheLinePadded<ReductionType>,
+                  aligned_allocator<CacheLinePadded<ReductionType>>> partials(nchunks);
+
+      for( size_t c=0; c<nchunks; ++c )
+     {
+         const size_t nbegin = c*reduction_chunk_size;
+         const size_t nend   = std::min( nbegin+reduction_chunk_size, nelems );
+
+         partials[c].value = chunk_func( nbegin, nend );
+     }
+
+      tree_combine( rfunc, partials );
+
+      return rfunc( std::move(init), partials[0].value );
+  }
+
+/*
+ * OpenMP execution
+ *    chunks are distributed with a static schedule, so each thread reduces one contiguous block of elements
+ */
+   template<typename      ChunkFuncObj,
+            typename     ReduceFuncObj,
+            typename     ReductionType>
+   ReductionType reduce_chunks( const execution::openmp_policy&     policy,
+                                const size_t                nelems,
+                                const ChunkFuncObj&     chunk_func,
+                                const ReduceFuncObj&         rfunc,
+                                      ReductionType           init )
+  {
+      if( nelems==0 ){ return init; }
+
+      const size_t nchunks = (nelems+reduction_chunk_size-1)/reduction_chunk_size;
+
+      std::vector<CacheLinePadded<ReductionType>,
+                  aligned_allocator<CacheLinePadded<ReductionType>>> partials(nchunks);
+
+      const int nthreads = openmp_num_threads( policy );
+
+# ifdef _OPENMP
+   # pragma omp parallel for schedule(static) num_threads(nthreads)
+# endif
+      for( size_t c=0; c<nchunks; ++c )
+     {
+         const size_t nbegin = c*reduction_chunk_size;
+         const size_t nend   = std::min( nbegin+reduction_chunk_size, nelems );
+
+         partials[c].value = chunk_func( nbegin, nend );
+     }
+
+      tree_combine( rfunc, partials );
+
+      return rfunc( std::move(init), partials[0].value );
+  }
+
+/*
+ * Thread pool execution
+ */
+   template<typename      ChunkFuncObj,
+            typename     ReduceFuncObj,
+            typename     ReductionType>
+   ReductionType reduce_chunks(       execution::thread_pool_policy,
+                                const size_t                nelems,
+                                const ChunkFuncObj&     chunk_func,
+                                const ReduceFuncObj&         rfunc,
+                                      ReductionType           init )
+  {
+      if( nelems==0 ){ return init; }
+
+      const size_t nchunks = (nelems+reduction_chunk_size-1)/reduction_chunk_size;
+
+      std::vector<CacheLinePadded<ReductionType>,
+                  aligned_allocator<CacheLinePadded<ReductionType>>> partials(nchunks);
+
+      default_thread_pool().parallel_for( nchunks,
+                                          [&]( const size_t begin, const size_t end )
+                                         {
+                                             for( size_t c=begin; c<end; ++c )
+                                            {
+                                                const size_t nbegin = c*reduction_chunk_size;
+                                                const size_t nend   = std::min( nbegin+reduction_chunk_size, nelems );
+
+                                                partials[c].value = chunk_func( nbegin, nend );
+                                            }
+                                         } );
+
+      tree_combine( rfunc, partials );
+
+      return rfunc( std::move(init), partials[0].value );
+  }
+}
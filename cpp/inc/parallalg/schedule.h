@@ -0,0 +1,261 @@
+
+# pragma once
+
+# include <parallalg/parallalg.h>
+# include <parallalg/thread_pool.h>
+
+# include <algorithm>
+
+# include <omp.h>
+
+namespace par
+{
+
+/*
+ * minimum number of parallel iterations per thread before an OpenMP index loop stops collapsing further dimensions
+ */
+   inline constexpr size_t openmp_min_iterations_per_thread = 4;
+
+/*
+ * number of threads used by OpenMP loops with this policy
+ */
+   inline int openmp_num_threads( const execution::openmp_policy& policy )
+  {
+# ifdef _OPENMP
+      return policy.num_threads>0 ? policy.num_threads : omp_get_max_threads();
+# else
+      return 1;
+# endif
+  }
+
+/*
+ * sets the schedule used by schedule(runtime) loops to the schedule of a policy for the lifetime of the scope
+ *    the previous schedule is restored on leaving the scope, so parallel index loops leave no trace on schedule(runtime) loops
+ *    elsewhere in the program
+ */
+   class openmp_schedule_scope
+  {
+   private:
+
+# ifdef _OPENMP
+      omp_sched_t previous_kind;
+      int         previous_chunk_size;
+# endif
+
+   public:
+
+      openmp_schedule_scope( const openmp_schedule_scope& ) = delete;
+      openmp_schedule_scope& operator=( const openmp_schedule_scope& ) = delete;
+
+      explicit openmp_schedule_scope( const execution::openmp_policy& policy )
+     {
+# ifdef _OPENMP
+         omp_get_schedule( &previous_kind, &previous_chunk_size );
+
+         omp_sched_t kind = omp_sched_static;
+         switch( policy.schedule )
+        {
+            case execution::Schedule::Static:  kind = omp_sched_static;  break;
+            case execution::Schedule::Dynamic: kind = omp_sched_dynamic; break;
+            case execution::Schedule::Guided:  kind = omp_sched_guided;  break;
+            case execution::Schedule::Auto:    kind = omp_sched_auto;    break;
+        }
+         omp_set_schedule( kind, policy.chunk_size );
+# endif
+     }
+
+      ~openmp_schedule_scope()
+     {
+# ifdef _OPENMP
+         omp_set_schedule( previous_kind, previous_chunk_size );
+# endif
+     }
+  };
+
+/*
+ * number of outer dimensions of the index range [first,last) which are collapsed into one parallel loop
+ *    the policy's collapse depth if set, otherwise the fewest outer dimensions giving every thread openmp_min_iterations_per_thread iterations
+ */
+   template<int       NDIM,
+            GridType    GT>
+   int openmp_collapse_depth( const execution::openmp_policy& policy,
+                              const Idx<NDIM,GT>&              first,
+                              const Idx<NDIM,GT>&               last,
+                              const int                     nthreads )
+  {
+      if( policy.collapse>0 ){ return std::min( policy.collapse, NDIM ); }
+
+      const size_t target = openmp_min_iterations_per_thread*size_t(nthreads);
+
+      size_t niter=1;
+      for( int d=0; d<NDIM; ++d )
+     {
+         niter *= last[d]>first[d] ? last[d]-first[d] : 0;
+         if( niter>=target ){ return d+1; }
+     }
+      return NDIM;
+  }
+
+/*
+ * ------------------------- par::for_each_index ------------------------
+ *
+ * Call func( idx ) for every index in the half-open range [first,last)
+ *    the OpenMP overload honours the schedule, chunk size, collapse depth and thread count of the policy
+ *    all parallel index loops in parallalg are built on this function
+ */
+
+/*
+ * Serial execution, last index changes fastest
+ */
+   template<typename FuncObj,
+            int         NDIM,
+            GridType      GT>
+   void for_each_index(       execution::serial_policy,
+                        const Idx<NDIM,GT>&            first,
+                        const Idx<NDIM,GT>&             last,
+                              FuncObj                   func )
+  {
+      if constexpr( NDIM==1 )
+     {
+         for( size_t i=first[0]; i<last[0]; ++i ){ func( Idx1<GT>{i} ); }
+     }
+      else if constexpr( NDIM==2 )
+     {
+         for( size_t i=first[0]; i<last[0]; ++i )
+        {
+            for( size_t j=first[1]; j<last[1]; ++j ){ func( Idx2<GT>{i,j} ); }
+        }
+     }
+      else
+     {
+         static_assert( NDIM==3, "par::for_each_index - only 1D, 2D and 3D ranges supported" );
+
+         for( size_t i=first[0]; i<last[0]; ++i )
+        {
+            for( size_t j=first[1]; j<last[1]; ++j )
+           {
+               for( size_t k=first[2]; k<last[2]; ++k ){ func( Idx3<GT>{i,j,k} ); }
+           }
+        }
+     }
+  }
+
+/*
+ * OpenMP execution
+ *    the outer dimensions are collapsed to the depth given by openmp_collapse_depth, the remaining dimensions run in serial inside each iteration
+ */
+   template<typename FuncObj,
+            int         NDIM,
+            GridType      GT>
+   void for_each_index( const execution::openmp_policy& policy,
+                        const Idx<NDIM,GT>&              first,
+                        const Idx<NDIM,GT>&               last,
+                              FuncObj                     func )
+  {
+      const int nthreads = openmp_num_threads( policy );
+      const int collapse = openmp_collapse_depth( policy, first, last, nthreads );
+
+      const openmp_schedule_scope schedule( policy );
+
+      if constexpr( NDIM==1 )
+     {
+# ifdef _OPENMP
+   # pragma omp parallel for schedule(runtime) num_threads(nthreads)
+# endif
+         for( size_t i=first[0]; i<last[0]; ++i ){ func( Idx1<GT>{i} ); }
+     }
+      else if constexpr( NDIM==2 )
+     {
+         if( collapse==2 )
+        {
+# ifdef _OPENMP
+   # pragma omp parallel for collapse(2) schedule(runtime) num_threads(nthreads)
+# endif
+            for( size_t i=first[0]; i<last[0]; ++i )
+           {
+               for( size_t j=first[1]; j<last[1]; ++j ){ func( Idx2<GT>{i,j} ); }
+           }
+        }
+         else
+        {
+# ifdef _OPENMP
+   # pragma omp parallel for schedule(runtime) num_threads(nthreads)
+# endif
+            for( size_t i=first[0]; i<last[0]; ++i )
+           {
+               for( size_t j=first[1]; j<last[1]; ++j ){ func( Idx2<GT>{i,j} ); }
+           }
+        }
+     }
+      else
+     {
+         static_assert( NDIM==3, "par::for_each_index - only 1D, 2D and 3D ranges supported" );
+
+         if( collapse==3 )
+        {
+# ifdef _OPENMP
+   # pragma omp parallel for collapse(3) schedule(runtime) num_threads(nthreads)
+# endif
+            for( size_t i=first[0]; i<last[0]; ++i )
+           {
+               for( size_t j=first[1]; j<last[1]; ++j )
+              {
+                  for( size_t k=first[2]; k<last[2]; ++k ){ func( Idx3<GT>{i,j,k} ); }
+              }
+           }
+        }
+         else if( collapse==2 )
+        {
+# ifdef _OPENMP
+   # pragma omp parallel for collapse(2) schedule(runtime) num_threads(nthreads)
+# endif
+            for( size_t i=first[0]; i<last[0]; ++i )
+           {
+               for( size_t j=first[1]; j<last[1]; ++j )
+              {
+                  for( size_t k=first[2]; k<last[2]; ++k ){ func( Idx3<GT>{i,j,k} ); }
+              }
+           }
+        }
+         else
+        {
+# ifdef _OPENMP
+   # pragma omp parallel for schedule(runtime) num_threads(nthreads)
+# endif
+            for( size_t i=first[0]; i<last[0]; ++i )
+           {
+               for( size_t j=first[1]; j<last[1]; ++j )
+              {
+                  for( size_t k=first[2]; k<last[2]; ++k ){ func( Idx3<GT>{i,j,k} ); }
+              }
+           }
+        }
+     }
+  }
+
+/*
+ * Thread pool execution
+ *    the outermost dimension is split between the threads
+ */
+   template<typename FuncObj,
+            int         NDIM,
+            GridType      GT>
+   void for_each_index(       execution::thread_pool_policy,
+                        const Idx<NDIM,GT>&                 first,
+                        const Idx<NDIM,GT>&                  last,
+                              FuncObj                        func )
+  {
+      if( last[0]<=first[0] ){ return; }
+
+      default_thread_pool().parallel_for( last[0]-first[0],
+                                          [&]( const size_t begin, const size_t end )
+                                         {
+                                             Idx<NDIM,GT> slab_first=first;
+                                             Idx<NDIM,GT> slab_last =last;
+                                             slab_first.idxs[0] = first[0]+begin;
+                                             slab_last.idxs[0]  = first[0]+end;
+
+                                             for_each_index( execution::seq, slab_first, slab_last, func );
+                                         } );
+  }
+}
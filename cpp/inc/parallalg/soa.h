@@ -0,0 +1,337 @@
+
+# pragma once
+
+# include <parallalg/array.h>
+# include <parallalg/parallalg.h>
+
+# include <utils/type-traits.h>
+
+# include <type_traits>
+# include <vector>
+
+# include <cassert>
+
+namespace par
+{
+
+/*
+ * ---------------- Structure-of-Arrays element types -----------------------------------------
+ */
+
+/*
+ * Types which can be stored component-wise in a Structure-of-Arrays layout
+ *    must have a compile-time number of components N, all of type value_type, accessible with operator[]
+ *    e.g. VariableSet, VariableDelta, geom::Point
+ */
+   template<typename T>
+   concept bool SoAElement =
+         requires(){ { T::N } -> int; }
+      && requires{ typename T::value_type; }
+      && requires( T t, const int c ){ { t[c] } -> typename T::value_type&; }
+      && std::is_default_constructible_v<T>;
+
+/*
+ * Tag type used as the element type of an Array to request a Structure-of-Arrays layout:
+ *    Array<SoA<ElemT>,NDIM> stores each component of ElemT in a separate contiguous stream,
+ *    instead of storing contiguous ElemTs (Array-of-Structures)
+ */
+   template<SoAElement ElemT>
+   struct SoA
+  {
+      using type = ElemT;
+  };
+
+/*
+ * Proxy reference to one element of a Structure-of-Arrays Array
+ *    gathers the components to an ElemT when converted, and scatters the components of an ElemT when assigned to
+ *    individual components can be accessed in-place with operator[]
+ */
+   template<SoAElement ElemT,
+            typename  ValueT>
+   struct SoARef
+  {
+      using ElemType = ElemT;
+      constexpr static int N = ElemT::N;
+
+   // first component of the element, and distance in memory between consecutive components
+      ValueT* first;
+      size_t  cstride;
+
+   // gather
+      operator ElemT() const
+     {
+         ElemT elem;
+         for( int c=0; c<N; ++c ){ elem[c] = first[c*cstride]; }
+         return elem;
+     }
+
+   // scatter
+      SoARef& operator=( const ElemT& elem )
+     {
+         for( int c=0; c<N; ++c ){ first[c*cstride] = elem[c]; }
+         return *this;
+     }
+
+   // assigning between proxies copies the values, not the reference
+      SoARef& operator=( const SoARef& other )
+     {
+         return operator=( static_cast<ElemT>(other) );
+     }
+
+   // component accessor
+      ValueT& operator[]( const int c ) const { return first[c*cstride]; }
+
+   // in-place arithmetic uses arithmetic defined for ElemT
+      template<typename T>
+      SoARef& operator+=( const T& other )
+     {
+         ElemT elem = static_cast<ElemT>(*this);
+         elem+=other;
+         return operator=( elem );
+     }
+
+      template<typename T>
+      SoARef& operator-=( const T& other )
+     {
+         ElemT elem = static_cast<ElemT>(*this);
+         elem-=other;
+         return operator=( elem );
+     }
+  };
+
+
+/*
+ * ---------------- Structure-of-Arrays specialisation of Array -----------------------------------------
+ */
+
+/*
+ * NDIM-dimensional array of ElemT stored as a Structure-of-Arrays. Last index changes fastest (row-major)
+ *    Each of the ElemT::N components is stored in its own contiguous stream of flattened_length() values, e.g.:
+ *       Array<SoA<VarSet>,2> q(Shape<2>{ni,nj});
+ *    has ElemT::N streams of ni*nj values, so that the same component of neighbouring cells is adjacent in memory.
+ *
+ *    The element interface is the same as for the Array-of-Structures layout, so the array can be used directly with par algorithms:
+ *       const accessors return a (gathered) ElemT by value:
+ *          const VarSet v = q[{i,j}];
+ *       non-const accessors return a SoARef proxy, which can be assigned to, converted to ElemT, or have its components accessed:
+ *          q[{i,j}] = v;
+ *          q[{i,j}][2] = 1.;
+ *       functors passed to algorithms which modify elements in place (eg for_each) must take the proxy by value or forwarding reference (auto&&) rather than ElemT&
+ *
+ *    Each component stream can be accessed directly with component(c), e.g. to vectorise a loop over cells for one component
+ *    Views (ArraySizing::View) of Structure-of-Arrays layouts are not supported
+ */
+   template<typename       ElemT,
+            int             NDIM,
+            GridType    GRIDTYPE,
+            ArraySizing   SIZING>
+      requires (SIZING!=ViewSizing)
+   struct Array<SoA<ElemT>,NDIM,GRIDTYPE,SIZING>
+  {
+   public: /* typedefs and static members */
+
+      using ElemType  = ElemT;
+      using ValueType = typename ElemT::value_type;
+      constexpr static int         nComponents = ElemT::N;
+      constexpr static int         nDim        = NDIM;
+      constexpr static GridType    gridType    = GRIDTYPE;
+      constexpr static ArraySizing arraySizing = SIZING;
+
+      using IdxType    = Idx<   NDIM,GRIDTYPE>;
+      using OffsetType = Offset<NDIM,GRIDTYPE>;
+      using ShapeType  = Shape< NDIM,GRIDTYPE>;
+      using StrideType = Stride<NDIM,GRIDTYPE>;
+
+      using Reference      = SoARef<ElemT,      ValueType>;
+      using ConstReference = ElemT;
+
+      using StorageType = std::vector<ValueType,aligned_allocator<ValueType>>;
+
+   private: /* invariant members and underlying memory */
+
+   // shape of multi-dimensional array
+      ShapeType   shape_array;
+
+   // place-values for flattening a multi-dimensional index to a 1D index
+      StrideType stride_array;
+
+   // memory layout options (component streams are never padded)
+      MemoryLayout layout_array;
+
+   // number of elements, which is also the length of each component stream
+      size_t length_array;
+
+   // the component streams, stored one after the other
+      // component c of flattened element i is at elems_array[c*length_array+i]
+      StorageType elems_array;
+
+   public:
+
+   // constructors (no construction without dimensions, no copying, only move)
+      Array() = delete;
+      Array( const Array&  ) = delete;
+      Array(       Array&& ) = default;
+
+   // assignment (no copying, only move)
+      Array& operator=( const Array&  ) = delete;
+      Array& operator=(       Array&& ) = default;
+
+   // construct with specified dimensions, calculate place-value strides, and initialise component streams to correct size
+      template<typename... Ints>
+         requires   (sizeof...(Ints)==NDIM)
+                 && (is_integer_v<Ints>&&...)
+      Array( const Ints... Is ) : Array( ShapeType{{static_cast<size_t>(Is)...}} ) {}
+
+   // constructor array with shape s, and value-initialise array elements
+      Array( const ShapeType& s, const MemoryLayout layout=MemoryLayout{} )
+         : shape_array(s),
+           stride_array(s),
+           layout_array(layout),
+           length_array(length(s)),
+           elems_array( nComponents*length(s),
+                        aligned_allocator<ValueType>(layout.huge_pages) )
+     {
+         assert( (layout.halo==0) && "par::Array - Structure-of-Arrays layouts do not support a halo" );
+     }
+
+   // constructor array with shape s, and no initialisation of array elements (see par::uninitialised)
+      Array( uninitialised_t, const ShapeType& s, const MemoryLayout layout=MemoryLayout{} )
+         : shape_array(s),
+           stride_array(s),
+           layout_array(layout),
+           length_array(length(s)),
+           elems_array( nComponents*length(s),
+                        aligned_allocator<ValueType>(layout.huge_pages,true) )
+     {
+         assert( (layout.halo==0) && "par::Array - Structure-of-Arrays layouts do not support a halo" );
+     }
+
+   // constructor array with shape s, and initialise array elements to val
+      Array( const ShapeType& s, const ElemT& val, const MemoryLayout layout=MemoryLayout{} ) : Array(uninitialised,s,layout)
+     {
+         first_touch( execution::seq, val );
+     }
+
+   // constructor array with shape s, and value-initialise (or initialise to val) the array elements according to policy
+      // each component stream is first touched with the same static schedule as the parallel flat algorithms
+      template<execution_policy Policy>
+      Array( const Policy policy, const ShapeType& s, const MemoryLayout layout=MemoryLayout{} ) : Array(uninitialised,s,layout)
+     {
+         first_touch( policy, ElemT{} );
+     }
+
+      template<execution_policy Policy>
+      Array( const Policy policy, const ShapeType& s, const ElemT& val, const MemoryLayout layout=MemoryLayout{} )
+         : Array(uninitialised,s,layout)
+     {
+         first_touch( policy, val );
+     }
+
+   // flattened length of array (number of elements, not number of values)
+      size_t flattened_length() const { return length_array; }
+
+   // component streams are never padded
+      bool is_contiguous() const { return true; }
+
+   // component streams have no halo
+      size_t flat_origin() const { return 0; }
+
+   // accessors
+      // elements of array
+      ConstReference operator()( const IdxType& idx ) const { return flatten( stride_array*idx ); }
+           Reference operator()( const IdxType& idx )       { return flatten( stride_array*idx ); }
+
+      // flattened elements of array
+      ConstReference flatten( const size_t i ) const
+     {
+         ElemT elem;
+         for( int c=0; c<nComponents; ++c ){ elem[c] = elems_array[c*length_array+i]; }
+         return elem;
+     }
+
+      Reference flatten( const size_t i )
+     {
+         return Reference{ elems_array.data()+i, length_array };
+     }
+
+      // all component streams
+      const StorageType& flatten() const { return elems_array; }
+
+      // single component stream
+      const ValueType* component( const int c ) const { return elems_array.data()+c*length_array; }
+            ValueType* component( const int c )       { return elems_array.data()+c*length_array; }
+
+      // single component of one element
+      const ValueType& component( const int c, const IdxType& idx ) const { return component(c)[stride_array*idx]; }
+            ValueType& component( const int c, const IdxType& idx )       { return component(c)[stride_array*idx]; }
+
+      // array properties
+      const size_t& shape(  const unsigned int i ) const { return  shape_array[i]; }
+      const size_t& stride( const unsigned int i ) const { return stride_array[i]; }
+
+      const ShapeType&   shape() const { return  shape_array; }
+      const StrideType& stride() const { return stride_array; }
+
+      const MemoryLayout& layout() const { return layout_array; }
+
+   /*
+    * Can resize array (same dimensions, different shape) if originally declared as dynamic
+    *    the offset of each component stream depends on the length, so the contents are discarded and every element is value-initialised
+    */
+      void resize( const ShapeType& s ) requires (SIZING==DynamicSize)
+     {
+         shape_array  =  ShapeType(s);
+         stride_array = StrideType(s);
+         length_array = length(s);
+         elems_array.assign(nComponents*length_array,ValueType{});
+     }
+
+   private:
+
+   // initialise every element to val
+      void first_touch( execution::serial_policy, const ElemT& val )
+     {
+         for( size_t i=0; i<length_array; ++i ){ flatten(i) = val; }
+     }
+
+      void first_touch( const execution::openmp_policy& policy, const ElemT& val )
+     {
+         const size_t len = length_array;
+         const int nthreads = openmp_num_threads( policy );
+
+# ifdef _OPENMP
+   # pragma omp parallel for schedule(static) num_threads(nthreads)
+# endif
+         for( size_t i=0; i<len; ++i ){ flatten(i) = val; }
+     }
+
+      void first_touch( execution::thread_pool_policy, const ElemT& val )
+     {
+         default_thread_pool().parallel_for( length_array,
+                                             [&]( const size_t begin, const size_t end )
+                                            {
+                                                for( size_t i=begin; i<end; ++i ){ flatten(i) = val; }
+                                            } );
+     }
+  };
+
+/*
+ * ---------------- Convenience SoA Array typedefs -----------------------------------------
+ */
+
+   template<typename       ElemT,
+            int             NDIM,
+            GridType    GRIDTYPE= Primal,
+            ArraySizing   SIZING= FixedSize>
+   using SoAArray = Array<SoA<ElemT>,NDIM,GRIDTYPE,SIZING>;
+
+   template<typename       ElemT,
+            int             NDIM,
+            ArraySizing   SIZING= FixedSize>
+   using PrimalSoAArray = Array<SoA<ElemT>,NDIM,Primal,SIZING>;
+
+   template<typename       ElemT,
+            int             NDIM,
+            ArraySizing   SIZING= FixedSize>
+   using DualSoAArray = Array<SoA<ElemT>,NDIM,Dual,SIZING>;
+}
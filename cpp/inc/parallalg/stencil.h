@@ -0,0 +1,381 @@
+
+# pragma once
+
+# include <parallalg/algorithm.h>
+# include <parallalg/array.h>
+# include <parallalg/parallalg.h>
+# include <parallalg/schedule.h>
+# include <parallalg/tiling.h>
+
+# include <algorithm>
+# include <array>
+# include <cstddef>
+# include <tuple>
+# include <utility>
+
+# include <cassert>
+
+namespace par
+{
+
+/*
+ * ---------------- Stencils -----------------------------------------
+ */
+
+/*
+ * Fixed list of NPOINTS offsets from a centre index, e.g. the 5-point Laplacian:
+ *    constexpr Stencil<2,5> laplacian{{ Offset<2>{0,0}, Offset<2>{-1,0}, Offset<2>{1,0}, Offset<2>{0,-1}, Offset<2>{0,1} }};
+ *    The number of points is part of the type, so the neighbours are gathered with a fully unrolled loop,
+ *    and the offsets of constexpr stencils are constants after inlining
+ *    GRIDTYPE is the grid type of the arrays which are gathered from
+ */
+   template<int          NDIM,
+            size_t    NPOINTS,
+            GridType GRIDTYPE= Primal>
+   struct Stencil
+  {
+      using OffsetType = Offset<NDIM,GRIDTYPE>;
+      constexpr static size_t nPoints = NPOINTS;
+
+      std::array<OffsetType,NPOINTS> offsets;
+
+      constexpr const OffsetType& operator[]( const size_t p ) const { return offsets[p]; }
+
+   // lowest and highest offset of any point in dimension d
+      constexpr int lower( const int d ) const
+     {
+         int lo=offsets[0][d];
+         for( size_t p=1; p<NPOINTS; ++p ){ lo = std::min( lo, offsets[p][d] ); }
+         return lo;
+     }
+
+      constexpr int upper( const int d ) const
+     {
+         int hi=offsets[0][d];
+         for( size_t p=1; p<NPOINTS; ++p ){ hi = std::max( hi, offsets[p][d] ); }
+         return hi;
+     }
+  };
+
+/*
+ * stencil of NPOINTS consecutive points along dimension dim, starting from offset first
+ */
+   template<int          NDIM,
+            size_t    NPOINTS,
+            GridType GRIDTYPE= Primal>
+   constexpr Stencil<NDIM,NPOINTS,GRIDTYPE> line_stencil( const int dim, const int first )
+  {
+      Stencil<NDIM,NPOINTS,GRIDTYPE> st{};
+      for( size_t p=0; p<NPOINTS; ++p ){ st.offsets[p].offsets[dim] = first+int(p); }
+      return st;
+  }
+
+/*
+ * stencil of the 2^NDIM corners of the unit box with lowest corner at offset first, dimension 0 changing fastest
+ */
+   template<int          NDIM,
+            GridType GRIDTYPE= Primal>
+   constexpr Stencil<NDIM,(size_t(1)<<NDIM),GRIDTYPE> corner_stencil( const int first )
+  {
+      Stencil<NDIM,(size_t(1)<<NDIM),GRIDTYPE> st{};
+      for( size_t p=0; p<(size_t(1)<<NDIM); ++p )
+     {
+         for( int d=0; d<NDIM; ++d ){ st.offsets[p].offsets[d] = first+int((p>>d)&1); }
+     }
+      return st;
+  }
+
+/*
+ * stencil of the primal nodes of the face normal to dimension dim (see par::faceShape), ordered so that geom::surface
+ * gives the normal pointing towards increasing index in dimension dim
+ *    3D faces are ordered like 2D cells in the two tangential dimensions, taken cyclically after dim
+ */
+   template<int NDIM>
+   constexpr Stencil<NDIM,(size_t(1)<<(NDIM-1))> face_stencil( const int dim )
+  {
+      Stencil<NDIM,(size_t(1)<<(NDIM-1))> st{};
+      if constexpr( NDIM==2 )
+     {
+         const int t = 1-dim;
+         st.offsets[dim==0 ? 1 : 0].offsets[t] = 1;
+     }
+      else if constexpr( NDIM==3 )
+     {
+         for( size_t p=0; p<4; ++p )
+        {
+            st.offsets[p].offsets[(dim+1)%3] = int( p    &1);
+            st.offsets[p].offsets[(dim+2)%3] = int((p>>1)&1);
+        }
+     }
+      return st;
+  }
+
+/*
+ * commonly used stencils
+ */
+   namespace stencils
+  {
+   // centre and nearest neighbours: 3-point (1D), 5-point (2D) and 7-point (3D) Laplacians
+      inline constexpr Stencil<1,3> laplacian3{{ Offset<1>{0}, Offset<1>{-1}, Offset<1>{1} }};
+
+      inline constexpr Stencil<2,5> laplacian5{{ Offset<2>{0,0},
+                                                 Offset<2>{-1,0}, Offset<2>{1,0},
+                                                 Offset<2>{0,-1}, Offset<2>{0,1} }};
+
+      inline constexpr Stencil<3,7> laplacian7{{ Offset<3>{0,0,0},
+                                                 Offset<3>{-1,0,0}, Offset<3>{1,0,0},
+                                                 Offset<3>{0,-1,0}, Offset<3>{0,1,0},
+                                                 Offset<3>{0,0,-1}, Offset<3>{0,0,1} }};
+
+   // nodes of a cell {i,j} of the dual grid, in the order of geom::volume
+      inline constexpr Stencil<1,2> cell_nodes1{{ Offset<1>{0}, Offset<1>{1} }};
+
+      inline constexpr Stencil<2,4> cell_nodes2{{ Offset<2>{0,0}, Offset<2>{1,0},
+                                                  Offset<2>{0,1}, Offset<2>{1,1} }};
+
+   // nodes of a cell of the dual grid in any dimension, and dual cells around a node of the primal grid
+      template<int NDIM>
+      inline constexpr Stencil<NDIM,(size_t(1)<<NDIM)>      cell_nodes = corner_stencil<NDIM>( 0 );
+
+      template<int NDIM>
+      inline constexpr Stencil<NDIM,(size_t(1)<<NDIM),Dual> node_cells = corner_stencil<NDIM,Dual>( -1 );
+
+   // 5 points centred on an element along dimension DIM, e.g. for WENO5 reconstruction
+      template<int NDIM, int DIM>
+      inline constexpr Stencil<NDIM,5> weno5 = line_stencil<NDIM,5>( DIM, -2 );
+  }
+
+/*
+ * ------------------------- par::gather_stencil ------------------------
+ *
+ * call func with the stencil points of each array in turn: func( a(p0), a(p1), ..., b(p0), b(p1), ... )
+ *    point( array, p ) returns the element of array at stencil point p
+ */
+   template<typename    FuncObj,
+            typename PointFuncObj,
+            size_t...           P,
+            typename...    Arrays>
+   auto gather_stencil( const FuncObj&              func,
+                        const PointFuncObj&        point,
+                              std::index_sequence<P...>,
+                        const Arrays&...          arrays ) _PAR_ALWAYS_INLINE_
+  {
+      const auto points = [&]( const auto& array ){ return std::forward_as_tuple( point( array, P )... ); };
+
+      return std::apply( func, std::tuple_cat( points( arrays )... ) );
+  }
+
+/*
+ * ------------------------- par::stencil_range ------------------------
+ *
+ * half-open range of destination indices for which every stencil point lies in the arrays or their halos
+ */
+   template<int         NDIM,
+            size_t   NPOINTS,
+            GridType     GTs,
+            GridType     GTd,
+            typename... Arrays>
+   std::pair<Idx<NDIM,GTd>,Idx<NDIM,GTd>> stencil_range( const Stencil<NDIM,NPOINTS,GTs>&    st,
+                                                         const Shape<NDIM,GTd>&            shape,
+                                                         const Arrays&...                 arrays )
+  {
+   // views are not assumed to have accessible elements outside their shape
+      const auto halo = []( const auto& array ) -> std::ptrdiff_t
+     {
+         if constexpr( std::decay_t<decltype(array)>::arraySizing==ViewSizing ){ return 0; }
+         else                                                                 { return array.halo(); }
+     };
+
+      Idx<NDIM,GTd> first, last;
+      for( int d=0; d<NDIM; ++d )
+     {
+         std::ptrdiff_t lo = 0;
+         std::ptrdiff_t hi = shape[d];
+
+         (( lo = std::max( lo, -halo(arrays) - st.lower(d) ) ),... );
+         (( hi = std::min( hi, std::ptrdiff_t(arrays.shape(d)) + halo(arrays) - st.upper(d) ) ),... );
+
+         first.idxs[d] = lo;
+         last.idxs[d]  = std::max( lo, hi );
+     }
+      return { first, last };
+  }
+
+/*
+ * ------------------------- par::stencil ------------------------
+ *
+ * For each index idx of dst, gather the stencil points idx+offset of the source arrays, and store func( points... ) in dst(idx):
+ *    dst(idx) = func( src0(idx+o0), ..., src0(idx+oN), src1(idx+o0), ..., src1(idx+oN), ... )
+ *    only the indices of dst whose stencil points all lie inside the source arrays or their halos are visited (see par::stencil_range),
+ *    so arrays with a halo as wide as the stencil are updated everywhere, and arrays without a halo only away from their edges
+ *    dst may have a different grid type and shape from the sources, e.g. dual cells gathered from their primal nodes
+ *    source arrays with the same storage are gathered with precomputed flattened offsets, other arrays (and views) by index
+ *    dst must not be one of the source arrays
+ */
+   template<typename    FuncObj,
+            int            NDIM,
+            size_t      NPOINTS,
+            GridType        GTs,
+            typename     ElemTd,
+            GridType        GTd,
+            ArraySizing     ASd,
+            typename     ElemT0,
+            typename...  ElemTs,
+            ArraySizing     AS0,
+            ArraySizing...  ASs>
+   void stencil( const Stencil<NDIM,NPOINTS,GTs>&      st,
+                 const FuncObj&                      func,
+                       Array<ElemTd,NDIM,GTd,ASd>&    dst,
+                 const Array<ElemT0,NDIM,GTs,AS0>&   src0,
+                 const Array<ElemTs,NDIM,GTs,ASs>&... srcs )
+  {
+      stencil( execution::seq, st, func, dst, src0, srcs... );
+      return;
+  }
+
+/*
+ * visit every index of the range of dst with the stencil points of the sources, calling loop( first, last, visit )
+ */
+   template<typename    FuncObj,
+            typename    LoopObj,
+            int            NDIM,
+            size_t      NPOINTS,
+            GridType        GTs,
+            typename     ElemTd,
+            GridType        GTd,
+            ArraySizing     ASd,
+            typename     ElemT0,
+            typename...  ElemTs,
+            ArraySizing     AS0,
+            ArraySizing...  ASs>
+   void stencil_loop( const LoopObj&                      loop,
+                      const Stencil<NDIM,NPOINTS,GTs>&      st,
+                      const FuncObj&                      func,
+                            Array<ElemTd,NDIM,GTd,ASd>&    dst,
+                      const Array<ElemT0,NDIM,GTs,AS0>&   src0,
+                      const Array<ElemTs,NDIM,GTs,ASs>&... srcs )
+  {
+      (( assert(   (src0.shape() == srcs.shape())
+                && "par::stencil - source arrays must be the same shape" ) ),... );
+
+      const auto range = stencil_range( st, dst.shape(), src0, srcs... );
+      const Idx<NDIM,GTd> first = range.first;
+      const Idx<NDIM,GTd> last  = range.second;
+
+      constexpr auto points = std::make_index_sequence<NPOINTS>{};
+
+   // sources with the same storage: flattened offset of each point, wrapping modulo 2^64 like halo indices
+      if( same_storage( src0, srcs... ) )
+     {
+         std::array<size_t,NPOINTS> flat;
+         for( size_t p=0; p<NPOINTS; ++p )
+        {
+            flat[p]=0;
+            for( int d=0; d<NDIM; ++d ){ flat[p]+= src0.stride(d)*size_t(std::ptrdiff_t(st[p][d])); }
+        }
+
+         loop( first, last,
+               [&]( const Idx<NDIM,GTd>& idx )
+              {
+                  const size_t i = src0.flat_origin() + src0.stride()*Idx<NDIM,GTs>{idx.idxs};
+
+                  const auto point = [&]( const auto& array, const size_t p ) -> decltype(auto)
+                 {
+                     return array.flatten( i+flat[p] );
+                 };
+
+                  dst(idx) = gather_stencil( func, point, points, src0, srcs... );
+              } );
+         return;
+     }
+
+      loop( first, last,
+            [&]( const Idx<NDIM,GTd>& idx )
+           {
+               const Idx<NDIM,GTs> is{idx.idxs};
+
+               const auto point = [&]( const auto& array, const size_t p ) -> decltype(auto)
+              {
+                  return array( is+st[p] );
+              };
+
+               dst(idx) = gather_stencil( func, point, points, src0, srcs... );
+           } );
+      return;
+  }
+
+/*
+ * Serial, OpenMP and thread pool execution
+ */
+   template<execution_policy Policy,
+            typename        FuncObj,
+            int                NDIM,
+            size_t          NPOINTS,
+            GridType            GTs,
+            typename         ElemTd,
+            GridType            GTd,
+            ArraySizing         ASd,
+            typename         ElemT0,
+            typename...      ElemTs,
+            ArraySizing         AS0,
+            ArraySizing...      ASs>
+   void stencil( const Policy                         policy,
+                 const Stencil<NDIM,NPOINTS,GTs>&      st,
+                 const FuncObj&                      func,
+                       Array<ElemTd,NDIM,GTd,ASd>&    dst,
+                 const Array<ElemT0,NDIM,GTs,AS0>&   src0,
+                 const Array<ElemTs,NDIM,GTs,ASs>&... srcs )
+  {
+      const auto loop = [&]( const Idx<NDIM,GTd>& first, const Idx<NDIM,GTd>& last, const auto& visit )
+     {
+         for_each_index( policy, first, last, visit );
+     };
+
+      stencil_loop( loop, st, func, dst, src0, srcs... );
+      return;
+  }
+
+/*
+ * Cache-blocked execution: the range is visited tile by tile, and tiles are processed in parallel if the policy allows
+ */
+   template<execution_policy Policy,
+            typename        FuncObj,
+            int                NDIM,
+            size_t          NPOINTS,
+            GridType            GTs,
+            typename         ElemTd,
+            GridType            GTd,
+            ArraySizing         ASd,
+            typename         ElemT0,
+            typename...      ElemTs,
+            ArraySizing         AS0,
+            ArraySizing...      ASs>
+   void stencil( const Policy                         policy,
+                 const Tiling<NDIM>&                  tiling,
+                 const Stencil<NDIM,NPOINTS,GTs>&      st,
+                 const FuncObj&                      func,
+                       Array<ElemTd,NDIM,GTd,ASd>&    dst,
+                 const Array<ElemT0,NDIM,GTs,AS0>&   src0,
+                 const Array<ElemTs,NDIM,GTs,ASs>&... srcs )
+  {
+      const auto loop = [&]( const Idx<NDIM,GTd>& first, const Idx<NDIM,GTd>& last, const auto& visit )
+     {
+         Shape<NDIM,GTd> range;
+         for( int d=0; d<NDIM; ++d ){ range.shape[d] = last[d]-first[d]; }
+
+         for_each_tile( policy, tiling, range,
+                        [&]( const Idx<NDIM,GTd>& tfirst, const Idx<NDIM,GTd>& tlast )
+                       {
+                           for_each_in_tile( tfirst, tlast,
+                                             [&]( Idx<NDIM,GTd> idx )
+                                            {
+                                                for( int d=0; d<NDIM; ++d ){ idx.idxs[d]+=first[d]; }
+                                                visit( idx );
+                                            } );
+                       } );
+     };
+
+      stencil_loop( loop, st, func, dst, src0, srcs... );
+      return;
+  }
+}
@@ -0,0 +1,307 @@
+
+# pragma once
+
+# include <parallalg/parallalg.h>
+# include <parallalg/allocator.h>
+
+# include <atomic>
+# include <condition_variable>
+# include <cstdint>
+# include <memory>
+# include <mutex>
+# include <thread>
+# include <vector>
+
+namespace par
+{
+
+/*
+ * number of chunks each thread's share of a range is split into. Chunks are the unit of work stealing
+ */
+   inline constexpr size_t pool_chunks_per_thread = 4;
+
+/*
+ * number of times an idle worker checks for new work before going to sleep
+ *    back-to-back parallel loops are picked up by spinning workers without waking them from sleep
+ */
+   inline constexpr size_t pool_spin_count = 1<<14;
+
+/*
+ * Persistent pool of worker threads executing parallel loops over index ranges with work stealing
+ *    the calling thread takes part in every loop, so a pool of nthreads has nthreads-1 worker threads
+ *
+ *    parallel_for( n, func ) calls func( begin, end ) for contiguous chunks covering [0,n):
+ *       the chunks are first split into one contiguous block per thread (the same distribution as a static schedule)
+ *       a thread which runs out of chunks steals half of the remaining chunks from the back of another thread's block
+ *       the call returns once every chunk has been executed and every worker has finished with the loop
+ *
+ *    blocks are held as packed [first,last) pairs in a single atomic word, so claiming and stealing chunks is lock-free
+ *    parallel_for called from inside a pool loop runs in serial on the calling thread
+ */
+   class ThreadPool
+  {
+   private:
+
+   // [first,last) chunk indices packed into one word
+      static uint64_t pack( const uint64_t first, const uint64_t last ){ return (first<<32) | last; }
+      static uint64_t first_of( const uint64_t range ){ return range>>32; }
+      static uint64_t  last_of( const uint64_t range ){ return range & 0xffffffff; }
+
+   // type-erased loop body
+      using ChunkInvoker = void(*)( const void*, size_t, size_t );
+
+      struct Job
+     {
+         ChunkInvoker invoke=nullptr;
+         const void*  body=nullptr;
+         size_t       n=0;
+         size_t       nchunks=0;
+     };
+
+      unsigned int nthreads_pool;
+
+      std::vector<std::thread> workers;
+
+   // chunk block owned by each thread
+      std::vector<CacheLinePadded<std::atomic<uint64_t>>,
+                  aligned_allocator<CacheLinePadded<std::atomic<uint64_t>>>> blocks;
+
+      Job job;
+
+   // incremented to start each loop
+      std::atomic<uint64_t> generation{0};
+
+   // number of chunks not yet executed, and number of workers finished with the current loop
+      alignas(cache_line_size) std::atomic<size_t> remaining{0};
+      alignas(cache_line_size) std::atomic<unsigned int> finished{0};
+
+      bool stopping=false;
+
+      std::mutex              sleep_mutex;
+      std::condition_variable sleep_cv;
+
+      static bool& inside_pool_loop()
+     {
+         thread_local bool inside=false;
+         return inside;
+     }
+
+   public:
+
+      ThreadPool() = delete;
+      ThreadPool( const ThreadPool&  ) = delete;
+      ThreadPool(       ThreadPool&& ) = delete;
+
+      ThreadPool& operator=( const ThreadPool&  ) = delete;
+      ThreadPool& operator=(       ThreadPool&& ) = delete;
+
+   // nthreads includes the calling thread
+      explicit ThreadPool( const unsigned int nthreads )
+         : nthreads_pool( std::max(nthreads,1u) ),
+           blocks( nthreads_pool )
+     {
+         for( unsigned int t=0; t<nthreads_pool; ++t ){ blocks[t].value.store( pack(0,0) ); }
+
+         workers.reserve( nthreads_pool-1 );
+         for( unsigned int t=1; t<nthreads_pool; ++t )
+        {
+            workers.emplace_back( [this,t](){ worker_loop(t); } );
+        }
+     }
+
+      ~ThreadPool()
+     {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            stopping=true;
+            generation.fetch_add(1);
+        }
+         sleep_cv.notify_all();
+
+         for( std::thread& w : workers ){ w.join(); }
+     }
+
+      unsigned int size() const { return nthreads_pool; }
+
+   /*
+    * call func( begin, end ) for contiguous chunks covering [0,n)
+    */
+      template<typename FuncObj>
+      void parallel_for( const size_t n, const FuncObj& func )
+     {
+         if( n==0 ){ return; }
+
+         if( nthreads_pool==1 || inside_pool_loop() )
+        {
+            func( size_t(0), n );
+            return;
+        }
+
+         job.invoke = []( const void* body, const size_t begin, const size_t end )
+                     {
+                        (*static_cast<const FuncObj*>(body))( begin, end );
+                     };
+         job.body    = static_cast<const void*>(&func);
+         job.n       = n;
+         job.nchunks = std::min( n, pool_chunks_per_thread*nthreads_pool );
+
+      // static initial distribution of chunks
+         for( unsigned int t=0; t<nthreads_pool; ++t )
+        {
+            blocks[t].value.store( pack( ( t   *job.nchunks)/nthreads_pool,
+                                         ((t+1)*job.nchunks)/nthreads_pool ),
+                                   std::memory_order_relaxed );
+        }
+         remaining.store( job.nchunks, std::memory_order_relaxed );
+         finished.store( 0, std::memory_order_relaxed );
+
+      // start the loop
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            generation.fetch_add( 1, std::memory_order_release );
+        }
+         sleep_cv.notify_all();
+
+         run_chunks(0);
+
+      // wait for every worker to finish with this loop, so job can be safely replaced by the next loop
+         while( finished.load( std::memory_order_acquire ) < nthreads_pool-1 )
+        {
+            std::this_thread::yield();
+        }
+     }
+
+   private:
+
+   // execute chunk c of the current job
+      void execute( const size_t c )
+     {
+         const size_t begin = ( c   *job.n)/job.nchunks;
+         const size_t end   = ((c+1)*job.n)/job.nchunks;
+
+         job.invoke( job.body, begin, end );
+
+         remaining.fetch_sub( 1, std::memory_order_acq_rel );
+     }
+
+   // claim the first chunk of the block owned by thread t
+      bool pop( const unsigned int t, size_t& c )
+     {
+         std::atomic<uint64_t>& block = blocks[t].value;
+
+         uint64_t range = block.load( std::memory_order_acquire );
+         while( first_of(range) < last_of(range) )
+        {
+            if( block.compare_exchange_weak( range, pack( first_of(range)+1, last_of(range) ),
+                                             std::memory_order_acq_rel ) )
+           {
+               c = first_of(range);
+               return true;
+           }
+        }
+         return false;
+     }
+
+   // move the back half of another thread's block to the (empty) block of thread t
+      bool steal( const unsigned int t )
+     {
+         for( unsigned int k=1; k<nthreads_pool; ++k )
+        {
+            std::atomic<uint64_t>& victim = blocks[(t+k)%nthreads_pool].value;
+
+            uint64_t range = victim.load( std::memory_order_acquire );
+            while( first_of(range) < last_of(range) )
+           {
+               const uint64_t first = first_of(range);
+               const uint64_t last  =  last_of(range);
+               const uint64_t mid   = first + (last-first)/2;
+
+               if( victim.compare_exchange_weak( range, pack( first, mid ),
+                                                 std::memory_order_acq_rel ) )
+              {
+                  blocks[t].value.store( pack( mid, last ), std::memory_order_release );
+                  return true;
+              }
+           }
+        }
+         return false;
+     }
+
+   // execute own chunks, then stolen chunks, until no chunks are left to claim
+      void run_chunks( const unsigned int t )
+     {
+         inside_pool_loop() = true;
+
+         size_t c;
+         do
+        {
+            while( pop( t, c ) ){ execute(c); }
+        }
+         while( steal(t) );
+
+      // chunks claimed by other threads may still be running
+         while( remaining.load( std::memory_order_acquire ) > 0 )
+        {
+            std::this_thread::yield();
+        }
+
+         inside_pool_loop() = false;
+     }
+
+      void worker_loop( const unsigned int t )
+     {
+         uint64_t seen = 0;
+
+         while( true )
+        {
+         // spin briefly, then sleep until the next loop is started
+            size_t spins=0;
+            while( generation.load( std::memory_order_acquire )==seen && spins<pool_spin_count )
+           {
+               ++spins;
+           }
+
+            if( generation.load( std::memory_order_acquire )==seen )
+           {
+               std::unique_lock<std::mutex> lock(sleep_mutex);
+               sleep_cv.wait( lock, [&](){ return generation.load( std::memory_order_acquire )!=seen; } );
+           }
+
+            seen = generation.load( std::memory_order_acquire );
+
+            if( stopping ){ return; }
+
+            run_chunks(t);
+
+            finished.fetch_add( 1, std::memory_order_acq_rel );
+        }
+     }
+  };
+
+/*
+ * pool used by the execution::pool policy
+ *    created on first use, with one thread per hardware thread unless set_default_thread_pool_size is called first
+ */
+   inline std::unique_ptr<ThreadPool>& default_thread_pool_ptr()
+  {
+      static std::unique_ptr<ThreadPool> pool;
+      return pool;
+  }
+
+   inline ThreadPool& default_thread_pool()
+  {
+      std::unique_ptr<ThreadPool>& pool = default_thread_pool_ptr();
+      if( !pool ){ pool = std::make_unique<ThreadPool>( std::max( std::thread::hardware_concurrency(), 1u ) ); }
+      return *pool;
+  }
+
+/*
+ * replace the default pool with one of nthreads threads. Must not be called while a pool loop is running
+ */
+   inline void set_default_thread_pool_size( const unsigned int nthreads )
+  {
+      std::unique_ptr<ThreadPool>& pool = default_thread_pool_ptr();
+      pool.reset();
+      pool = std::make_unique<ThreadPool>( nthreads );
+  }
+}
@@ -0,0 +1,357 @@
+
+# pragma once
+
+# include <parallalg/array.h>
+# include <parallalg/parallalg.h>
+# include <parallalg/thread_pool.h>
+# include <parallalg/schedule.h>
+
+# include <algorithm>
+
+# include <omp.h>
+
+namespace par
+{
+/*
+ * ------------------------- par::for_each_in_tile ------------------------
+ *
+ * Call func( idx ) for every index in the half-open range [first,last), last index changes fastest
+ */
+   template<typename FuncObj,
+            GridType      GT>
+   void for_each_in_tile( const Idx1<GT>& first,
+                          const Idx1<GT>&  last,
+                                FuncObj    func ) _PAR_ALWAYS_INLINE_
+  {
+      for( size_t i=first[0]; i<last[0]; ++i )
+     {
+         func( Idx1<GT>{i} );
+     }
+  }
+
+   template<typename FuncObj,
+            GridType      GT>
+   void for_each_in_tile( const Idx2<GT>& first,
+                          const Idx2<GT>&  last,
+                                FuncObj    func ) _PAR_ALWAYS_INLINE_
+  {
+      for( size_t i=first[0]; i<last[0]; ++i )
+     {
+         for( size_t j=first[1]; j<last[1]; ++j )
+        {
+            func( Idx2<GT>{i,j} );
+        }
+     }
+  }
+
+   template<typename FuncObj,
+            GridType      GT>
+   void for_each_in_tile( const Idx3<GT>& first,
+                          const Idx3<GT>&  last,
+                                FuncObj    func ) _PAR_ALWAYS_INLINE_
+  {
+      for( size_t i=first[0]; i<last[0]; ++i )
+     {
+         for( size_t j=first[1]; j<last[1]; ++j )
+        {
+            for( size_t k=first[2]; k<last[2]; ++k )
+           {
+               func( Idx3<GT>{i,j,k} );
+           }
+        }
+     }
+  }
+
+/*
+ * bounds of the slab of an array of the given shape covering [begin,end) in the outermost dimension, and the whole of every other dimension
+ */
+   template<int       NDIM,
+            GridType    GT>
+   Idx<NDIM,GT> outer_slab_first( const size_t begin )
+  {
+      Idx<NDIM,GT> first{};
+      first.idxs[0]=begin;
+      return first;
+  }
+
+   template<int       NDIM,
+            GridType    GT>
+   Idx<NDIM,GT> outer_slab_last( const Shape<NDIM,GT>& shape,
+                                 const size_t            end )
+  {
+      Idx<NDIM,GT> last{shape.shape};
+      last.idxs[0]=end;
+      return last;
+  }
+
+/*
+ * number of tiles of shape tiling in each dimension of an array of the given shape
+ */
+   template<int       NDIM,
+            GridType    GT>
+   std::array<size_t,NDIM> tile_counts( const Tiling<NDIM>&    tiling,
+                                        const Shape<NDIM,GT>&   shape )
+  {
+      std::array<size_t,NDIM> ntiles;
+      for( int d=0; d<NDIM; ++d ){ ntiles[d] = (shape[d]+tiling[d]-1)/tiling[d]; }
+      return ntiles;
+  }
+
+/*
+ * ------------------------- par::for_each_tile ------------------------
+ *
+ * Split an array of the given shape into tiles of shape tiling, and call tile_func( first, last ) for each tile
+ *    first and last are the bounds of the half-open range of indices in the tile, tiles at the high end of each dimension may be truncated
+ *    tiles are independent and may be processed concurrently, so tile_func must only write to elements in its own tile
+ */
+
+/*
+ * 1D - serial execution
+ */
+   template<typename FuncObj,
+            GridType      GT>
+   void for_each_tile(       execution::serial_policy,
+                       const Tiling<1>&               tiling,
+                       const Shape1<GT>&               shape,
+                             FuncObj               tile_func )
+  {
+      const size_t ni = shape[0];
+      const size_t ti = tiling[0];
+
+      for( size_t i0=0; i0<ni; i0+=ti )
+     {
+         tile_func( Idx1<GT>{i0},
+                    Idx1<GT>{std::min(i0+ti,ni)} );
+     }
+  }
+
+/*
+ * 2D - serial execution
+ */
+   template<typename FuncObj,
+            GridType      GT>
+   void for_each_tile(       execution::serial_policy,
+                       const Tiling<2>&               tiling,
+                       const Shape2<GT>&               shape,
+                             FuncObj               tile_func )
+  {
+      const size_t ni = shape[0];
+      const size_t nj = shape[1];
+
+      const size_t ti = tiling[0];
+      const size_t tj = tiling[1];
+
+      for( size_t i0=0; i0<ni; i0+=ti )
+     {
+         for( size_t j0=0; j0<nj; j0+=tj )
+        {
+            tile_func( Idx2<GT>{i0,j0},
+                       Idx2<GT>{std::min(i0+ti,ni),
+                                std::min(j0+tj,nj)} );
+        }
+     }
+  }
+
+/*
+ * 3D - serial execution
+ */
+   template<typename FuncObj,
+            GridType      GT>
+   void for_each_tile(       execution::serial_policy,
+                       const Tiling<3>&               tiling,
+                       const Shape3<GT>&               shape,
+                             FuncObj               tile_func )
+  {
+      const size_t ni = shape[0];
+      const size_t nj = shape[1];
+      const size_t nk = shape[2];
+
+      const size_t ti = tiling[0];
+      const size_t tj = tiling[1];
+      const size_t tk = tiling[2];
+
+      for( size_t i0=0; i0<ni; i0+=ti )
+     {
+         for( size_t j0=0; j0<nj; j0+=tj )
+        {
+            for( size_t k0=0; k0<nk; k0+=tk )
+           {
+               tile_func( Idx3<GT>{i0,j0,k0},
+                          Idx3<GT>{std::min(i0+ti,ni),
+                                   std::min(j0+tj,nj),
+                                   std::min(k0+tk,nk)} );
+           }
+        }
+     }
+  }
+
+/*
+ * OpenMP execution, any dimension
+ *    the loop over tile indices honours the schedule, collapse depth and thread count of the policy
+ */
+   template<typename FuncObj,
+            int         NDIM,
+            GridType      GT>
+   void for_each_tile( const execution::openmp_policy&       policy,
+                       const Tiling<NDIM>&                   tiling,
+                       const Shape<NDIM,GT>&                  shape,
+                             FuncObj                      tile_func )
+  {
+      Idx<NDIM,GT> ntiles{tile_counts( tiling, shape )};
+
+      for_each_index( policy, Idx<NDIM,GT>{}, ntiles,
+                      [&]( const Idx<NDIM,GT>& t )
+                     {
+                         Idx<NDIM,GT> first, last;
+                         for( int d=0; d<NDIM; ++d )
+                        {
+                            first.idxs[d] = t[d]*tiling[d];
+                            last.idxs[d]  = std::min( first[d]+tiling[d], shape[d] );
+                        }
+                         tile_func( first, last );
+                     } );
+  }
+
+/*
+ * Thread pool execution, any dimension
+ *    tiles are numbered in row-major order, and the range of tile numbers is split between the threads
+ */
+   template<typename FuncObj,
+            int         NDIM,
+            GridType      GT>
+   void for_each_tile(       execution::thread_pool_policy,
+                       const Tiling<NDIM>&                  tiling,
+                       const Shape<NDIM,GT>&                 shape,
+                             FuncObj                     tile_func )
+  {
+      const std::array<size_t,NDIM> ntiles = tile_counts( tiling, shape );
+
+      size_t total=1;
+      for( int d=0; d<NDIM; ++d ){ total*=ntiles[d]; }
+
+      default_thread_pool().parallel_for( total,
+                                          [&]( const size_t begin, const size_t end )
+                                         {
+                                             for( size_t t=begin; t<end; ++t )
+                                            {
+                                                Idx<NDIM,GT> first, last;
+                                                size_t rem=t;
+                                                for( int d=NDIM-1; d>=0; --d )
+                                               {
+                                                   first.idxs[d] = (rem%ntiles[d])*tiling[d];
+                                                   last.idxs[d]  = std::min( first[d]+tiling[d], shape[d] );
+                                                   rem/=ntiles[d];
+                                               }
+                                                tile_func( first, last );
+                                            }
+                                         } );
+  }
+
+/*
+ * ------------------------- par::for_each_tile_coloured ------------------------
+ *
+ * Same as for_each_tile, but tile_func may also write to elements in the neighbouring tiles in the positive direction of each dimension
+ *    tiles are coloured by the parity of their tile index in each dimension (2^NDIM colours), and each colour is processed in parallel
+ *    only tiles of the same colour are processed concurrently, and these never share a positive neighbour
+ */
+
+/*
+ * serial execution is the same as uncoloured serial execution
+ */
+   template<typename FuncObj,
+            int         NDIM,
+            GridType      GT>
+   void for_each_tile_coloured(       execution::serial_policy,
+                                const Tiling<NDIM>&            tiling,
+                                const Shape<NDIM,GT>&           shape,
+                                      FuncObj               tile_func )
+  {
+      for_each_tile( execution::seq, tiling, shape, tile_func );
+  }
+
+/*
+ * OpenMP execution, any dimension
+ *    each of the 2^NDIM colours is one parallel loop over the tiles of that colour, honouring the schedule, collapse depth and thread count of the policy
+ */
+   template<typename FuncObj,
+            int         NDIM,
+            GridType      GT>
+   void for_each_tile_coloured( const execution::openmp_policy&       policy,
+                                const Tiling<NDIM>&                   tiling,
+                                const Shape<NDIM,GT>&                  shape,
+                                      FuncObj                      tile_func )
+  {
+      const std::array<size_t,NDIM> ntiles = tile_counts( tiling, shape );
+
+      for( size_t colour=0; colour<(size_t(1)<<NDIM); ++colour )
+     {
+      // parity of the tile index in each dimension, and number of tiles of this colour in each dimension
+         std::array<size_t,NDIM> parity;
+         Idx<NDIM,GT> ncoloured;
+
+         for( int d=0; d<NDIM; ++d )
+        {
+            parity[d]          = (colour>>d)&1;
+            ncoloured.idxs[d]  = (ntiles[d]+1-parity[d])/2;
+        }
+
+         for_each_index( policy, Idx<NDIM,GT>{}, ncoloured,
+                         [&]( const Idx<NDIM,GT>& t )
+                        {
+                            Idx<NDIM,GT> first, last;
+                            for( int d=0; d<NDIM; ++d )
+                           {
+                               first.idxs[d] = (2*t[d]+parity[d])*tiling[d];
+                               last.idxs[d]  = std::min( first[d]+tiling[d], shape[d] );
+                           }
+                            tile_func( first, last );
+                        } );
+     }
+  }
+
+/*
+ * Thread pool execution, any dimension
+ *    each of the 2^NDIM colours is one pool loop over the tiles of that colour
+ */
+   template<typename FuncObj,
+            int         NDIM,
+            GridType      GT>
+   void for_each_tile_coloured(       execution::thread_pool_policy,
+                                const Tiling<NDIM>&                  tiling,
+                                const Shape<NDIM,GT>&                 shape,
+                                      FuncObj                     tile_func )
+  {
+      const std::array<size_t,NDIM> ntiles = tile_counts( tiling, shape );
+
+      for( size_t colour=0; colour<(size_t(1)<<NDIM); ++colour )
+     {
+      // parity of the tile index in each dimension, and number of tiles of this colour in each dimension
+         std::array<size_t,NDIM> parity, ncoloured;
+
+         size_t total=1;
+         for( int d=0; d<NDIM; ++d )
+        {
+            parity[d]    = (colour>>d)&1;
+            ncoloured[d] = (ntiles[d]+1-parity[d])/2;
+            total*=ncoloured[d];
+        }
+
+         default_thread_pool().parallel_for( total,
+                                             [&]( const size_t begin, const size_t end )
+                                            {
+                                                for( size_t t=begin; t<end; ++t )
+                                               {
+                                                   Idx<NDIM,GT> first, last;
+                                                   size_t rem=t;
+                                                   for( int d=NDIM-1; d>=0; --d )
+                                                  {
+                                                      first.idxs[d] = (2*(rem%ncoloured[d])+parity[d])*tiling[d];
+                                                      last.idxs[d]  = std::min( first[d]+tiling[d], shape[d] );
+                                                      rem/=ncoloured[d];
+                                                  }
+                                                   tile_func( first, last );
+                                               }
+                                            } );
+     }
+  }
+}
@@ -0,0 +1,352 @@
+
+# pragma once
+
+# include <parallalg/array.h>
+# include <parallalg/parallalg.h>
+
+# include <type_traits>
+# include <utility>
+
+# include <cassert>
+
+namespace par
+{
+
+/*
+ * ---------------- Non-owning views of Arrays -----------------------------------------
+ */
+
+/*
+ * NDIM-dimensional view of elements owned by another array, e.g. a sub-block, a boundary row or column, or a strided subset
+ *    A view is defined by the address of its first element (origin), its shape, and its strides in memory, so it does not need to be contiguous:
+ *       the element of a view at index idx is origin[ stride*idx ]
+ *    Views are Arrays with ArraySizing::View, so every par algorithm which accepts an Array also accepts a view e.g.:
+ *       auto interior = subview( q, Idx<2>{1,1}, Shape<2>{ni-2,nj-2} );
+ *       auto boundary = slice<0>( q, 0 );           // first row of q as a 1D view
+ *       par::fill( execution::omp, boundary, VarSet{} );
+ *    Algorithms which write through a view take it by reference, so the view must be a named variable rather than a temporary
+ *
+ *    Views are cheap to copy and never copy elements. Copying or assigning a view refers the copy to the same elements (like std::span)
+ *    A view of a const array has const ElemT. A view must not outlive the array it refers to, and is invalidated if that array is resized
+ */
+   template<typename       ElemT,
+            int             NDIM,
+            GridType    GRIDTYPE>
+   struct Array<ElemT,NDIM,GRIDTYPE,ViewSizing>
+  {
+   public: /* typedefs and static members */
+
+      using ElemType = ElemT;
+      constexpr static int         nDim        = NDIM;
+      constexpr static GridType    gridType    = GRIDTYPE;
+      constexpr static ArraySizing arraySizing = ViewSizing;
+
+      using IdxType    = Idx<   NDIM,GRIDTYPE>;
+      using OffsetType = Offset<NDIM,GRIDTYPE>;
+      using ShapeType  = Shape< NDIM,GRIDTYPE>;
+      using StrideType = Stride<NDIM,GRIDTYPE>;
+
+   private:
+
+   // first element of the view in memory
+      ElemT* origin_view;
+
+   // shape of the view
+      ShapeType shape_view;
+
+   // place-values for flattening a multi-dimensional index to a 1D index, relative to origin_view
+      StrideType stride_view;
+
+   public:
+
+      Array() = delete;
+      Array( const Array&  ) = default;
+      Array(       Array&& ) = default;
+
+      Array& operator=( const Array&  ) = default;
+      Array& operator=(       Array&& ) = default;
+
+   // evaluate a lazy array expression into the elements referred to by the view (see parallalg/expression.h)
+      template<typename ExprT>
+         requires is_array_expression_v<ExprT>
+      Array& operator=( const ExprT& expr ){ assign( execution::seq, *this, expr ); return *this; }
+
+   // view of the elements origin[ stride*idx ] for every idx in shape s
+      Array( ElemT* origin, const ShapeType& s, const StrideType& st )
+         : origin_view(origin),
+           shape_view(s),
+           stride_view(st) {}
+
+   // number of elements of memory spanned by the view, from its first to its last element
+      size_t flattened_length() const
+     {
+         if( length(shape_view)==0 ){ return 0; }
+
+         size_t span=1;
+         for( int i=0; i<NDIM; ++i ){ span+= stride_view[i]*(shape_view[i]-1); }
+         return span;
+     }
+
+   // true if the elements of the view are adjacent in memory with no gaps
+      bool is_contiguous() const { return stride_view==StrideType(shape_view); }
+
+   // flattened index of the first element of the view, relative to origin_view
+      size_t flat_origin() const { return 0; }
+
+   // accessors
+      // elements of view. Constness of the view does not change the constness of the elements it refers to
+      ElemT& operator()( const IdxType& idx ) const { return origin_view[ stride_view*idx ]; }
+
+      // flattened elements of view, relative to the first element of the view
+      ElemT& flatten( const size_t i ) const { return origin_view[i]; }
+
+      ElemT* data() const { return origin_view; }
+
+      // view properties
+      const size_t& shape(  const unsigned int i ) const { return  shape_view[i]; }
+      const size_t& stride( const unsigned int i ) const { return stride_view[i]; }
+
+      const ShapeType&   shape() const { return  shape_view; }
+      const StrideType& stride() const { return stride_view; }
+
+      // views have no memory layout options of their own. Arrays created from views use the default layout
+      MemoryLayout layout() const { return MemoryLayout{}; }
+  };
+
+/*
+ * ---------------- Convenience view typedefs -----------------------------------------
+ */
+
+   template<typename       ElemT,
+            int             NDIM,
+            GridType    GRIDTYPE= Primal>
+   using ArrayView = Array<ElemT,NDIM,GRIDTYPE,ViewSizing>;
+
+   template<typename       ElemT,
+            GridType    GRIDTYPE= Primal>
+   using ArrayView1 = Array<ElemT,1,GRIDTYPE,ViewSizing>;
+
+   template<typename       ElemT,
+            GridType    GRIDTYPE= Primal>
+   using ArrayView2 = Array<ElemT,2,GRIDTYPE,ViewSizing>;
+
+   template<typename       ElemT,
+            GridType    GRIDTYPE= Primal>
+   using ArrayView3 = Array<ElemT,3,GRIDTYPE,ViewSizing>;
+
+/*
+ * ---------------- Functions creating views -----------------------------------------
+ *
+ * each function accepts an owning Array or another view, and returns a view of the same grid type
+ * views of non-const arrays have the same element type as the array, views of const arrays have const elements
+ */
+
+/*
+ * element type of views of an array: const if the array elements cannot be modified through the array
+ */
+   template<typename ArrayT>
+   using view_elem_t = std::conditional_t<   std::is_const_v<std::remove_reference_t<ArrayT>>
+                                          && std::remove_reference_t<ArrayT>::arraySizing!=ViewSizing,
+                                             const typename std::remove_reference_t<ArrayT>::ElemType,
+                                                   typename std::remove_reference_t<ArrayT>::ElemType>;
+
+/*
+ * view of a whole array
+ */
+   template<typename       ElemT,
+            int             NDIM,
+            GridType          GT,
+            ArraySizing       AS>
+   auto view( Array<ElemT,NDIM,GT,AS>& array )
+  {
+      return ArrayView<ElemT,NDIM,GT>( array.data(), array.shape(), array.stride() );
+  }
+
+   template<typename       ElemT,
+            int             NDIM,
+            GridType          GT,
+            ArraySizing       AS>
+   auto view( const Array<ElemT,NDIM,GT,AS>& array )
+  {
+      using ViewElemT = view_elem_t<const Array<ElemT,NDIM,GT,AS>&>;
+      return ArrayView<ViewElemT,NDIM,GT>( array.data(), array.shape(), array.stride() );
+  }
+
+/*
+ * view of the sub-block of an array with shape s, starting at index first
+ */
+   template<typename       ArrayT,
+            int             NDIM,
+            GridType          GT>
+      requires (std::remove_reference_t<ArrayT>::nDim==NDIM) && (std::remove_reference_t<ArrayT>::gridType==GT)
+   auto subview(       ArrayT&&          array,
+                 const Idx<NDIM,GT>&     first,
+                 const Shape<NDIM,GT>&       s )
+  {
+      for( int i=0; i<NDIM; ++i )
+     {
+         assert( (first[i]+s[i] <= array.shape(i)) && "par::subview - sub-block must lie within the array" );
+     }
+
+      using ViewElemT = view_elem_t<ArrayT>;
+      return ArrayView<ViewElemT,NDIM,GT>( array.data() + array.stride()*first, s, array.stride() );
+  }
+
+/*
+ * view of the elements of an array with indices in box
+ */
+   template<typename       ArrayT,
+            int             NDIM,
+            GridType          GT>
+      requires (std::remove_reference_t<ArrayT>::nDim==NDIM) && (std::remove_reference_t<ArrayT>::gridType==GT)
+   auto subview(       ArrayT&&        array,
+                 const Box<NDIM,GT>&     box )
+  {
+      assert( box_within( box, array.shape() ) && "par::subview - box must lie within the array" );
+
+      return subview( std::forward<ArrayT>(array), box.first, box_shape(box) );
+  }
+
+/*
+ * view of every step-th element of an array in each dimension, starting at index first
+ *    e.g. the even-even cells of a 2D array are strided_view( q, Idx<2>{0,0}, {2,2} )
+ */
+   template<typename       ArrayT,
+            int             NDIM,
+            GridType          GT>
+      requires (std::remove_reference_t<ArrayT>::nDim==NDIM) && (std::remove_reference_t<ArrayT>::gridType==GT)
+   auto strided_view(       ArrayT&&                      array,
+                      const Idx<NDIM,GT>&                 first,
+                      const std::array<size_t,NDIM>&       step )
+  {
+      Shape<NDIM,GT> s;
+      std::array<size_t,NDIM> st;
+      for( int i=0; i<NDIM; ++i )
+     {
+         assert( (step[i]>0 && first[i]<=array.shape(i)) && "par::strided_view - invalid start or step" );
+
+         s.shape[i] = (array.shape(i)-first[i]+step[i]-1)/step[i];
+         st[i]      = array.stride(i)*step[i];
+     }
+
+      using ViewElemT = view_elem_t<ArrayT>;
+      return ArrayView<ViewElemT,NDIM,GT>( array.data() + array.stride()*first, s, Stride<NDIM,GT>(st) );
+  }
+
+/*
+ * (NDIM-1)-dimensional view of the elements of an array with index i in dimension DIM, e.g. a boundary row or column
+ */
+   template<int             DIM,
+            typename     ArrayT>
+      requires (std::remove_reference_t<ArrayT>::nDim>1) && (DIM<std::remove_reference_t<ArrayT>::nDim)
+   auto slice( ArrayT&&        array,
+               const size_t        i )
+  {
+      constexpr int      NDIM = std::remove_reference_t<ArrayT>::nDim;
+      constexpr GridType GT   = std::remove_reference_t<ArrayT>::gridType;
+
+      assert( (i < array.shape(DIM)) && "par::slice - index out of range" );
+
+      Shape<NDIM-1,GT> s;
+      std::array<size_t,NDIM-1> st;
+      for( int d=0, k=0; d<NDIM; ++d )
+     {
+         if( d==DIM ){ continue; }
+         s.shape[k] = array.shape(d);
+         st[k]      = array.stride(d);
+         ++k;
+     }
+
+      using ViewElemT = view_elem_t<ArrayT>;
+      return ArrayView<ViewElemT,NDIM-1,GT>( array.data() + array.stride(DIM)*i, s, Stride<NDIM-1,GT>(st) );
+  }
+
+/*
+ * ---------------- Views of the halo of Arrays -----------------------------------------
+ *
+ * the halo of an array constructed with halo_layout( width ) holds width layers of elements around the array in every dimension
+ * faces of the array are numbered 2*dim+side, where side 0 is the face before index 0 and side 1 the face after index shape(dim)-1
+ */
+
+/*
+ * view of an array including its halo, the element of the view at index {0,0,...} is the first halo element
+ */
+   template<typename       ElemT,
+            int             NDIM,
+            GridType          GT,
+            ArraySizing       AS>
+      requires (AS!=ViewSizing)
+   auto halo_view( Array<ElemT,NDIM,GT,AS>& array )
+  {
+      Shape<NDIM,GT> s(array.shape());
+      for( int i=0; i<NDIM; ++i ){ s.shape[i]+= 2*array.halo(); }
+
+      return ArrayView<ElemT,NDIM,GT>( array.data() - haloOrigin( array.stride(), array.halo() ), s, array.stride() );
+  }
+
+   template<typename       ElemT,
+            int             NDIM,
+            GridType          GT,
+            ArraySizing       AS>
+      requires (AS!=ViewSizing)
+   auto halo_view( const Array<ElemT,NDIM,GT,AS>& array )
+  {
+      Shape<NDIM,GT> s(array.shape());
+      for( int i=0; i<NDIM; ++i ){ s.shape[i]+= 2*array.halo(); }
+
+      return ArrayView<const ElemT,NDIM,GT>( array.data() - haloOrigin( array.stride(), array.halo() ), s, array.stride() );
+  }
+
+/*
+ * view of the halo elements beyond one face of an array, excluding the corners of the halo
+ *    the view has the shape of the array, except for its width array.halo() in dimension dim
+ */
+   template<typename       ArrayT>
+      requires (std::remove_reference_t<ArrayT>::arraySizing!=ViewSizing)
+   auto halo_layer( ArrayT&&        array,
+                    const int         dim,
+                    const int        side )
+  {
+      constexpr int      NDIM = std::remove_reference_t<ArrayT>::nDim;
+      constexpr GridType GT   = std::remove_reference_t<ArrayT>::gridType;
+
+      assert( (dim>=0 && dim<NDIM && (side==0 || side==1)) && "par::halo_layer - invalid face" );
+
+      Shape<NDIM,GT> s(array.shape());
+      s.shape[dim] = array.halo();
+
+      const size_t stride = array.stride(dim);
+
+      using ViewElemT = view_elem_t<ArrayT>;
+      return ArrayView<ViewElemT,NDIM,GT>( side==0 ? array.data() - array.halo()*stride
+                                                   : array.data() + array.shape(dim)*stride,
+                                           s, array.stride() );
+  }
+
+/*
+ * view of the elements of an array next to one face, with the same shape as the halo layer beyond that face
+ *    e.g. the halo of a periodic array is filled by copying edge_layer( q, dim, 1-side ) into halo_layer( q, dim, side )
+ */
+   template<typename       ArrayT>
+      requires (std::remove_reference_t<ArrayT>::arraySizing!=ViewSizing)
+   auto edge_layer( ArrayT&&        array,
+                    const int         dim,
+                    const int        side )
+  {
+      constexpr int      NDIM = std::remove_reference_t<ArrayT>::nDim;
+      constexpr GridType GT   = std::remove_reference_t<ArrayT>::gridType;
+
+      assert( (dim>=0 && dim<NDIM && (side==0 || side==1)) && "par::edge_layer - invalid face" );
+      assert( (array.halo()<=array.shape(dim)) && "par::edge_layer - array is narrower than its halo" );
+
+      Shape<NDIM,GT> s(array.shape());
+      s.shape[dim] = array.halo();
+
+      const size_t stride = array.stride(dim);
+
+      using ViewElemT = view_elem_t<ArrayT>;
+      return ArrayView<ViewElemT,NDIM,GT>( side==0 ? array.data()
+                                                   : array.data() + (array.shape(dim)-array.halo())*stride,
+                                           s, array.stride() );
+  }
+}
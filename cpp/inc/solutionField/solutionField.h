@@ -5,53 +5,69 @@
 
 # include <parallalg/algorithm.h>
 # include <parallalg/array.h>
+# include <parallalg/view.h>
 # include <parallalg/parallalg.h>
 
-   template<typename ElemT>
-   auto makeBoundaryArray( const par::DualShape1& s )
+/*
+ * arrays of boundary reference solutions, one element for each ghost cell of each boundary
+ *    each array has the shape of the halo layer beyond its boundary, so is indexed with the same index as the ghost cells
+ *    each array is value-initialised according to policy, so that it is first touched by the threads which will use it
+ */
+   template<typename            ElemT,
+            par::execution_policy Policy>
+   auto makeReferenceArrays( const Policy             policy,
+                             const par::DualShape1& s )
   {
       using ArrayT = par::DualArray1<ElemT>;
-      using BoundaryArrays = std::array<ArrayT,2>;
+      using ReferenceArrays = std::array<ArrayT,2>;
 
-      par::DualShape1 s01{2};
+      par::DualShape1 s01{1};
 
-      return BoundaryArrays{ArrayT(s01),ArrayT(s01)};
+      return ReferenceArrays{ArrayT(policy,s01),ArrayT(policy,s01)};
   }
 
-   template<typename ElemT>
-   auto makeBoundaryArray( const par::DualShape2& s )
+   template<typename            ElemT,
+            par::execution_policy Policy>
+   auto makeReferenceArrays( const Policy             policy,
+                             const par::DualShape2& s )
   {
       using ArrayT = par::DualArray2<ElemT>;
-      using BoundaryArrays = std::array<ArrayT,4>;
+      using ReferenceArrays = std::array<ArrayT,4>;
 
-      par::DualShape2 s01{s[1],2};
-      par::DualShape2 s23{s[0],2};
+      par::DualShape2 s01{1,s[1]};
+      par::DualShape2 s23{s[0],1};
 
-      return BoundaryArrays{ArrayT(s01),ArrayT(s01),
-                            ArrayT(s23),ArrayT(s23)};
+      return ReferenceArrays{ArrayT(policy,s01),ArrayT(policy,s01),
+                             ArrayT(policy,s23),ArrayT(policy,s23)};
   }
 
-   template<typename ElemT>
-   auto makeBoundaryArray( const par::DualShape3& s )
+   template<typename            ElemT,
+            par::execution_policy Policy>
+   auto makeReferenceArrays( const Policy             policy,
+                             const par::DualShape3& s )
   {
       using ArrayT = par::DualArray3<ElemT>;
-      using BoundaryArrays = std::array<ArrayT,6>;
+      using ReferenceArrays = std::array<ArrayT,6>;
 
-      par::DualShape3 s01{s[1],s[2],2};
-      par::DualShape3 s23{s[0],s[2],2};
-      par::DualShape3 s45{s[0],s[1],2};
+      par::DualShape3 s01{1,s[1],s[2]};
+      par::DualShape3 s23{s[0],1,s[2]};
+      par::DualShape3 s45{s[0],s[1],1};
 
-      return BoundaryArrays{ArrayT(s01),ArrayT(s01),
-                            ArrayT(s23),ArrayT(s23),
-                            ArrayT(s45),ArrayT(s45)};
+      return ReferenceArrays{ArrayT(policy,s01),ArrayT(policy,s01),
+                             ArrayT(policy,s23),ArrayT(policy,s23),
+                             ArrayT(policy,s45),ArrayT(policy,s45)};
   }
 
 /*
  * data structure holding the solution field for a conservation law.
  *    solution over the internal domain
- *    solution over the boundary
+ *    solution over the boundary, stored in the ghost cells of the halo of the internal solution
  *    boundary condition types
  *    boundary reference solutions
+ *
+ *    boundary bID is the face 2*dim+side of the domain, where side 0 is before the first cell and side 1 after the last cell in dimension dim
+ *    the ghost cell beyond interior cell ic on boundary bID is q.interior( ic+offset ), with offset -1 (side 0) or +1 (side 1) in dimension dim,
+ *    or ghost(bID)( ib ) with ib equal to ic except ib[dim]=0
  */
    template<ImplementedVarSet VarSet,
             int                 nDim>
@@ -68,9 +84,14 @@
    // enum for specifying boundary condition
       using BCType = BoundaryType<Law>;
 
-   // internal and boundary solution fields
-      VarField                         interior;
-      std::array<VarField,nBoundaries> boundary;
+   // width of the layer of ghost cells around the internal domain
+      constexpr static size_t haloWidth=1;
+
+   // internal solution field, with ghost cells in its halo
+      VarField interior;
+
+   // boundary reference solutions, e.g. the farfield solution
+      std::array<VarField,nBoundaries> reference;
 
    // boundary condition types
       std::array<BCType,nBoundaries> bcTypes;
@@ -85,9 +106,17 @@
       SolutionField& operator=(       SolutionField&& ) = default;
 
    // must be initialised with shape of domain
-      SolutionField( const par::DualShape<nDim>& s )
-                     : interior(s),
-                       boundary(makeBoundaryArray<VarSet>(s)){}
+      SolutionField( const par::DualShape<nDim>& s ) : SolutionField(par::execution::seq,s){}
+
+   // initialise interior field and boundary references according to policy, so that they are first touched by the threads which will use them
+      template<par::execution_policy Policy>
+      SolutionField( const Policy policy, const par::DualShape<nDim>& s )
+                     : interior(policy,s,par::halo_layout(haloWidth)),
+                       reference(makeReferenceArrays<VarSet>(policy,s)){}
+
+   // view of the ghost cells beyond boundary bID, with the same shape as reference[bID]
+      auto ghost( const size_t bID )       { return par::halo_layer( interior, bID/2, bID%2 ); }
+      auto ghost( const size_t bID ) const { return par::halo_layer( interior, bID/2, bID%2 ); }
   };
 
 
@@ -103,12 +132,13 @@
   {
       assert( dst.interior.shape() == src.interior.shape() );
 
+   // copies the ghost cells in the halo too
       par::copy( policy, dst.interior, src.interior );
 
    // copy boundaries
       for( unsigned int i=0; i<src.nBoundaries; i++ )
      {
-         par::copy( policy, dst.boundary[i], src.boundary[i] );
+         par::copy( policy, dst.reference[i], src.reference[i] );
          dst.bcTypes[i] = src.bcTypes[i];
      }
   }
@@ -119,7 +149,8 @@
    SolutionField<VarSet,nDim> copy( const Policy                   policy,
                                     const SolutionField<VarSet,nDim>& src )
   {
-      SolutionField<VarSet,nDim> dst(src.interior.shape());
+   // dst is initialised according to policy, so it is first touched by the same threads as the copy
+      SolutionField<VarSet,nDim> dst(policy,src.interior.shape());
       copy( policy, dst,src );
       return dst;
   }
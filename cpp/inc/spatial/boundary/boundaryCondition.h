@@ -26,6 +26,22 @@
       const auto& func() const { return std::get<N>(funcs); }
   };
 
+/*
+ * boundary conditions with a boundary flux function calculate the flux over their faces themselves (see boundaryFluxLoop.h),
+ * the faces of all other boundaries are interior faces to their ghost cells, or to the cells at the other end of a periodic domain
+ */
+   template<typename BC>
+   struct has_boundary_flux : std::false_type {};
+
+   template<LawType              Law,
+            BoundaryType<Law> BCType,
+            typename      UpdateFunc,
+            typename      BCFluxFunc>
+   struct has_boundary_flux<BoundaryCondition<Law,BCType,UpdateFunc,BCFluxFunc>> : std::true_type {};
+
+   template<typename BC>
+   constexpr bool has_boundary_flux_v = has_boundary_flux<BC>::value;
+
    template<typename              BCType,
             typename...    BoundaryConds,
             typename    BoundaryFunction,
@@ -2,265 +2,86 @@
 # pragma once
 
 # include <spatial/boundary/boundaryCondition.h>
+# include <spatial/boundary/boundaryGeometry.h>
 
 # include <conservationLaws/base/base.h>
 # include <solutionField/solutionField.h>
 
+# include <lsq/lsq.h>
+
 # include <geometry/geometry.h>
 # include <mesh/mesh.h>
 
 # include <parallalg/array.h>
+# include <parallalg/schedule.h>
+# include <parallalg/view.h>
 
 # include <cassert>
 
 
 /*
- * Accumulate cell residual contributions over boundary flux boundary faces for 1D domain
- */
-   template<LawType                   Law,
-            BoundaryType<Law>      BCType,
-            ImplementedVarSet     SolVarT,
-            ImplementedVarDelta   SolDelT,
-            typename              FluxRes,
-            typename           UpdateFunc,
-            typename           BCFluxFunc,
-            typename        HighOrderFlux,
-            floating_point           Real>
-      requires   ConsistentTypes<Law,
-                                 1,
-                                 Real,
-                                 SolVarT,
-                                 SolDelT>
-              && std::is_same_v<FluxRes,
-                                fluxresult_t<SolVarT>>
-   void boundaryResidual( const BoundaryCondition<Law,BCType,UpdateFunc,BCFluxFunc>& bc,
-                          const size_t                                       boundaryId,
-                          const HighOrderFlux&                                   hoflux,
-                          const Species<Law,Real>&                              species,
-                          const Mesh<1,Real>&                                      mesh,
-                          const SolutionField<SolVarT,1>&                             q,
-                          const par::DualArray<lsq::XMetric<1,Real>, 1>&           dxdx,
-                          const par::DualArray<lsq::QMetric<SolVarT>,1>&           dqdx,
-                                par::DualArray1<FluxRes>&                           res )
-  {
-   // check mesh sizes match
-      assert( mesh.cells.shape() == q.interior.shape() );
-      assert( mesh.cells.shape() == dxdx.shape() );
-      assert( mesh.cells.shape() == dqdx.shape() );
-      assert( mesh.cells.shape() ==  res.shape() );
-      assert( mesh.cells.shape() ==   dq.shape() );
-
-   // boundary condition type selection was correct?
-      assert( q.bcTypes[boundaryId] == BCType );
-
-      auto& boundaryFlux = std::get<1>(bc.funcs);
-
-      using CellIdx = typename SolutionField<SolVarT,1>::VarField::IdxType;
-      using NodeIdx = typename Mesh<1,Real>::NodeArray::IdxType;
-
-   // first order boundaries
-      if( boundaryId==0 ) // left boundary
-     {
-         const NodeIdx ip{0};
-         const CellIdx ic{0};
-         const CellIdx ib0{0};
-         const CellIdx ib1{1};
-
-         const FluxRes fr = boundaryFlux( species,
-                                          surface( mesh.nodes(ip) ),
-                                          mesh.cells(ic),
-                                          q.interior(ic),
-                                          q.boundary[0](ib0),
-                                          q.boundary[0](ib1),
-                                          dxdx(ic),
-                                          dqdx(ic) );
-         res(ic)+=fr;
-     }
-      else if( boundaryId==1 ) // right boundary
-     {
-         const size_t nc = q.interior.shape(0);
-
-         const NodeIdx ip{nc-1};
-         const CellIdx ic{nc-1};
-         const CellIdx ib0{0};
-         const CellIdx ib1{1};
-
-         const FluxRes fr = boundaryFlux( species,
-                                          flip( surface( mesh.nodes(ip) ) ),
-                                          mesh.cells(ic),
-                                          q.interior(ic),
-                                          q.boundary[1](ib0),
-                                          q.boundary[1](ib1),
-                                          dxdx(ic),
-                                          dqdx(ic) );
-         res(ic)+=fr;
-     }
-      else{ assert( false && "invalid boundary id for 1D ghost cell flux, must be 0 or 1" ); }
-
-      return;
-  }
-
-/*
- * Accumulate cell residual contributions over boundary flux boundary faces for 2D domain
+ * Accumulate cell residual contributions over the faces of a boundary flux boundary
+ *    the boundary flux is calculated from the interior cell, its ghost cell and the boundary reference solution
+ *    the same loop is used for every boundary of 1D, 2D and 3D domains, and the faces of a boundary are accumulated in parallel according to policy
  */
-   template<LawType                   Law,
+   template<par::execution_policy Policy,
+            LawType                   Law,
             BoundaryType<Law>      BCType,
+            int                      nDim,
             ImplementedVarSet     SolVarT,
-            ImplementedVarDelta   SolDelT,
             typename              FluxRes,
             typename           UpdateFunc,
             typename           BCFluxFunc,
             typename        HighOrderFlux,
             floating_point           Real>
       requires   ConsistentTypes<Law,
-                                 2,
+                                 nDim,
                                  Real,
-                                 SolVarT,
-                                 SolDelT>
+                                 SolVarT>
               && std::is_same_v<FluxRes,
                                 fluxresult_t<SolVarT>>
    void boundaryResidual( const BoundaryCondition<Law,BCType,UpdateFunc,BCFluxFunc>& bc,
+                          const Policy                                           policy,
                           const size_t                                       boundaryId,
-                          const Mesh<2,Real>&                                      mesh,
                           const HighOrderFlux&                                   hoflux,
                           const Species<Law,Real>&                              species,
-                          const SolutionField<SolVarT,2>&                             q,
-                          const par::DualArray<lsq::XMetric<2,Real>, 2>&           dxdx,
-                          const par::DualArray<lsq::QMetric<SolVarT>,2>&           dqdx,
-                                par::DualArray2<FluxRes>&                           res )
+                          const Mesh<nDim,Real>&                                   mesh,
+                          const SolutionField<SolVarT,nDim>&                          q,
+                          const par::DualArray<lsq::XMetricFactor<nDim,Real>,nDim>&      dxdx,
+                          const par::DualArray<lsq::QMetric<SolVarT>,  nDim>&      dqdx,
+                                par::DualArray<FluxRes,nDim>&                       res )
   {
    // check mesh sizes match
       assert( mesh.cells.shape() == q.interior.shape() );
       assert( mesh.cells.shape() == dxdx.shape() );
       assert( mesh.cells.shape() == dqdx.shape() );
       assert( mesh.cells.shape() ==  res.shape() );
-      assert( mesh.cells.shape() ==   dq.shape() );
 
    // boundary condition type selection was correct?
       assert( q.bcTypes[boundaryId] == BCType );
 
-      const size_t ni = q.interior.shape(0);
-      const size_t nj = q.interior.shape(1);
-
-      using CellIdx = typename SolutionField<SolVarT,2>::VarField::IdxType;
-      using NodeIdx = typename Mesh<2,Real>::NodeArray::IdxType;
-
-      auto& boundaryFlux = std::get<1>(bc.funcs);
-
-      if( boundaryId==0 ) // left face
-     {
-         const size_t i=0;
-         for( size_t j=0; j<nj; ++j )
-        {
-         // interior cell  index
-            const CellIdx ic{i,j};
-
-         // boundary cell index
-            const CellIdx ib0{j,0};
-            const CellIdx ib1{j,1};
-   
-         // face node indices
-            const NodeIdx ip0{i,j  };
-            const NodeIdx ip1{i,j+1};
-   
-            const FluxRes fr = boundaryFlux( species,
-                                             surface( mesh.nodes(ip0),
-                                                      mesh.nodes(ip1) ),
-                                             mesh.cells(ic),
-                                             q.interior(ic),
-                                             q.boundary[0](ib0),
-                                             q.boundary[0](ib1),
-                                             dxdx(ic),
-                                             dqdx(ic) );
-            res(ic)+=fr;
-        }
-     }
-      else if( boundaryId==1 ) // right face
-     {
-         const size_t i=ni-1;
-         for( size_t j=0; j<nj; ++j )
-        {
-         // interior cell  index
-            const CellIdx ic{i,j};
-
-         // boundary cell index
-            const CellIdx ib0{j,0};
-            const CellIdx ib1{j,1};
-   
-         // face node indices
-            const NodeIdx ip0{i+1,j+1};
-            const NodeIdx ip1{i+1,j  };
-   
-            const FluxRes fr = boundaryFlux( species,
-                                             surface( mesh.nodes(ip0),
-                                                      mesh.nodes(ip1) ),
-                                             mesh.cells(ic),
-                                             q.interior(ic),
-                                             q.boundary[1](ib0),
-                                             q.boundary[1](ib1),
-                                             dxdx(ic),
-                                             dqdx(ic) );
-            res(ic)+=fr;
-        }
-     }
-      else if ( boundaryId==2 ) // bottom face
-     {
-         const size_t j=0;
-         for( size_t i=0; i<ni; ++i )
-        {
-         // interior cell  index
-            const CellIdx ic{i,j};
-
-         // boundary cell index
-            const CellIdx ib0{i,0};
-            const CellIdx ib1{i,1};
-   
-         // face node indices
-            const NodeIdx ip0{i+1,j};
-            const NodeIdx ip1{i  ,j};
-   
-            const FluxRes fr = boundaryFlux( species,
-                                             surface( mesh.nodes(ip0),
-                                                      mesh.nodes(ip1) ),
-                                             mesh.cells(ic),
-                                             q.interior(ic),
-                                             q.boundary[2](ib0),
-                                             q.boundary[2](ib1),
-                                             dxdx(ic),
-                                             dqdx(ic) );
-            res(ic)+=fr;
-        }
-     }
-      else if ( boundaryId==3 ) // top face
-     {
-         const size_t j=nj-1;
-         for( size_t i=0; i<ni; ++i )
-        {
-         // interior cell  index
-            const CellIdx ic{i,j};
-
-         // boundary cell index
-            const CellIdx ib0{i,0};
-            const CellIdx ib1{i,1};
-   
-         // face node indices
-            const NodeIdx ip0{i  ,j+1};
-            const NodeIdx ip1{i+1,j+1};
-   
-            const FluxRes fr = boundaryFlux( species,
-                                             surface( mesh.nodes(ip0),
-                                                      mesh.nodes(ip1) ),
-                                             mesh.cells(ic),
-                                             q.interior(ic),
-                                             q.boundary[3](ib0),
-                                             q.boundary[3](ib1),
-                                             dxdx(ic),
-                                             dqdx(ic) );
-            res(ic)+=fr;
-        }
-     }
-      else{ std::cout << boundaryId << "\n"; assert( false && "invalid boundary id for 2D, must be 0,1,2 or 3" ); }
-
+      const auto& boundaryFlux = std::get<1>(bc.funcs);
+
+      using CellIdx = typename SolutionField<SolVarT,nDim>::VarField::IdxType;
+
+      const auto  ghost     = q.ghost( boundaryId );
+      const auto& reference = q.reference[boundaryId];
+
+   // ib indexes the ghost cells and reference solutions, ic the interior cell next to each ghost cell
+      par::for_each_index( policy, CellIdx{}, CellIdx{ghost.shape().shape},
+                           [&]( const CellIdx& ib )
+                          {
+                              const CellIdx ic = boundaryCell( mesh, ib, boundaryId );
+
+                           // boundary surface faces into domain
+                              res(ic)+= boundaryFlux( species,
+                                                      boundaryFace( mesh, ic, boundaryId ),
+                                                      mesh.cells(ic),
+                                                      q.interior(ic),
+                                                      ghost(ib),
+                                                      reference(ib),
+                                                      dxdx(ic),
+                                                      dqdx(ic) );
+                          } );
       return;
   }
-
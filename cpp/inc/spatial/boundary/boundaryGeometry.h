@@ -0,0 +1,63 @@
+
+# pragma once
+
+# include <geometry/geometry.h>
+# include <mesh/mesh.h>
+
+# include <parallalg/array.h>
+
+# include <cassert>
+
+/*
+ * index of the interior cell next to the ghost cell ib of boundary boundaryId
+ *    ib indexes the halo layer of the boundary (see SolutionField::ghost), so ib[dim]=0 for the normal dimension dim of the boundary
+ */
+   template<int            nDim,
+            floating_point Real>
+   par::DualIdx<nDim> boundaryCell( const Mesh<nDim,Real>&        mesh,
+                                          par::DualIdx<nDim>        ib,
+                                    const size_t            boundaryId )
+  {
+      const size_t dim = boundaryId/2;
+
+      assert( dim<size_t(nDim) && "invalid boundary id" );
+
+      ib.idxs[dim] = boundaryId%2==0 ? 0 : mesh.cells.shape(dim)-1;
+      return ib;
+  }
+
+/*
+ * surface of the boundary face of interior cell ic on boundary boundaryId, with the normal facing into the domain
+ *    faces on the high boundary of each dimension are flipped, because the mesh faces point towards increasing index
+ */
+   template<int            nDim,
+            floating_point Real>
+   geom::Surface<nDim,Real> boundaryFace( const Mesh<nDim,Real>&     mesh,
+                                          const par::DualIdx<nDim>&    ic,
+                                          const size_t         boundaryId )
+  {
+      using FaceIdx = typename Mesh<nDim,Real>::FaceArray::IdxType;
+
+      const size_t dim = boundaryId/2;
+
+      assert( dim<size_t(nDim) && "invalid boundary id" );
+
+      FaceIdx ip{ic.idxs};
+
+      if( boundaryId%2==0 ){ return mesh.faces[dim](ip); } // low boundary
+
+      ip.idxs[dim]+=1;
+      return flip( mesh.faces[dim](ip) );                  // high boundary
+  }
+
+/*
+ * ghost cell volume outside the boundary face of an interior cell: the interior cell reflected through the centre of the face
+ */
+   template<int            nDim,
+            floating_point Real>
+   geom::Volume<nDim,Real> ghostCell( const geom::Volume<nDim,Real>&  cell,
+                                      const geom::Surface<nDim,Real>& face )
+  {
+      return geom::Volume<nDim,Real>{cell.volume,
+                                     face.centre + (face.centre - cell.centre)};
+  }
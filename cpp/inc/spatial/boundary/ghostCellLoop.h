@@ -2,228 +2,112 @@
 # pragma once
 
 # include <spatial/boundary/boundaryCondition.h>
+# include <spatial/boundary/boundaryGeometry.h>
 
 # include <conservationLaws/base/base.h>
 # include <solutionField/solutionField.h>
 
+# include <lsq/lsq.h>
+
 # include <geometry/geometry.h>
 # include <mesh/mesh.h>
 
 # include <parallalg/array.h>
+# include <parallalg/schedule.h>
+# include <parallalg/view.h>
 
 # include <cassert>
 
 
 /*
- * Accumulate cell residual contributions over ghost cell boundary faces for 1D domain
+ * flux into the domain across face ib of ghost cell boundary boundaryId
+ *    the ghost cells in the halo of q.interior must have been filled by boundaryUpdate, so the boundary face is the same as an interior face
+ *    with the ghost cell on the left and the interior cell on the right
+ *    ghost cells have the geometry of the interior cell reflected through the face, but no least squares metrics of their own, so they
+ *    reuse those of the interior cell: the ghost side of the face is reconstructed with the unreflected interior gradient, which is only
+ *    a first order ghost reconstruction wherever the boundary condition reflects the solution (e.g. the normal velocity at a wall)
  */
    template<LawType                   Law,
-            BoundaryType<Law>      BCType,
+            int                      nDim,
             ImplementedVarSet     SolVarT,
-            ImplementedVarDelta   SolDelT,
-            typename              FluxRes,
-            typename           UpdateFunc,
             typename        HighOrderFlux,
             floating_point           Real>
       requires   ConsistentTypes<Law,
-                                 1,
+                                 nDim,
                                  Real,
-                                 SolVarT,
-                                 SolDelT>
-              && std::is_same_v<FluxRes,
-                                fluxresult_t<SolVarT>>
-   void boundaryResidual( const BoundaryCondition<Law,BCType,UpdateFunc>&,
-                          const size_t                              boundaryId,
-                          const HighOrderFlux&                          hoflux,
-                          const Species<Law,Real>&                     species,
-                          const Mesh<1,Real>&                             mesh,
-                          const SolutionField<SolVarT,1>&                    q,
-                          const par::DualArray<lsq::XMetric<1,Real>, 1>&  dxdx,
-                          const par::DualArray<lsq::QMetric<SolVarT>,1>&  dqdx,
-                                par::DualArray1<FluxRes>&                  res )
+                                 SolVarT>
+   fluxresult_t<SolVarT> ghostCellFlux( const HighOrderFlux&                             hoflux,
+                                        const Species<Law,Real>&                        species,
+                                        const Mesh<nDim,Real>&                             mesh,
+                                        const SolutionField<SolVarT,nDim>&                    q,
+                                        const par::DualArray<lsq::XMetricFactor<nDim,Real>,nDim>& dxdx,
+                                        const par::DualArray<lsq::QMetric<SolVarT>,  nDim>& dqdx,
+                                        const par::DualIdx<nDim>&                            ib,
+                                        const size_t                                 boundaryId )
   {
-   // check mesh sizes match
-      assert( mesh.cells.shape() == q.interior.shape() );
-      assert( mesh.cells.shape() == dxdx.shape() );
-      assert( mesh.cells.shape() == dqdx.shape() );
-      assert( mesh.cells.shape() ==  res.shape() );
-      assert( mesh.cells.shape() ==   dq.shape() );
-
-   // boundary condition type selection was correct?
-      assert( q.bcTypes[boundaryId] == BCType );
-
-      using CellIdx = typename SolutionField<SolVarT,1>::VarField::IdxType;
-      using NodeIdx = typename Mesh<1,Real>::NodeArray::IdxType;
-
-      constexpr lsq::XMetric<1,Real> xm1{1.,0.,1.};
+      const par::DualIdx<nDim> ic = boundaryCell( mesh, ib, boundaryId );
 
-   // first order boundaries
-      if( boundaryId==0 ) // left boundary
-     {
-         const NodeIdx ip{0};
-         const CellIdx ir{0};
-         const CellIdx ib{0};
-         const FluxRes fr = hoflux( species,
-                                    surface( mesh.nodes(ip) ),
-                                    SolDelT{},         dq(ir)[0],
-                                    q.boundary[0](ib), q.interior(ir) );
-         res(ir)+=fr;
-     }
-      else if( boundaryId==1 ) // right boundary
-     {
-         const size_t nc = q.interior.shape(0);
+   // boundary surface faces into domain, from the ghost cell to the interior cell
+      const auto face = boundaryFace( mesh, ic, boundaryId );
 
-         const NodeIdx ip{nc};
-         const CellIdx il{nc-1};
-         const CellIdx ib{0};
-
-         const FluxRes fr = hoflux( species,
-                                    surface( mesh.nodes(ip) ),
-                                    dq(il)[0],      SolDelT{},
-                                    q.interior(il), q.boundary[1](ib) );
-         res(il)-=fr;
-     }
-      else{ assert( false && "invalid boundary id for 1D ghost cell flux, must be 0 or 1" ); }
-
-      return;
+      return hoflux( species,
+                     face,
+                     ghostCell( mesh.cells(ic), face ), mesh.cells(ic),
+                     q.ghost( boundaryId )(ib),         q.interior(ic),
+                     dxdx(ic),                          dxdx(ic),
+                     dqdx(ic),                          dqdx(ic) );
   }
 
 /*
- * Accumulate cell residual contributions over ghost cell boundary faces for 2D domain
+ * Accumulate cell residual contributions over the faces of a ghost cell boundary
+ *    the same loop is used for every boundary of 1D, 2D and 3D domains
+ *    periodic boundaries are accumulated separately (see periodicLoop.h), because their faces are shared by two interior cells
+ *    each interior cell has at most one face on one boundary, so the faces of a boundary are accumulated in parallel according to policy
  */
-   template<LawType                   Law,
+   template<par::execution_policy Policy,
+            LawType                   Law,
             BoundaryType<Law>      BCType,
+            int                      nDim,
             ImplementedVarSet     SolVarT,
-            ImplementedVarDelta   SolDelT,
             typename              FluxRes,
-            typename           UpdateFunc,
             typename        HighOrderFlux,
+            typename...       UpdateFuncs,
             floating_point           Real>
       requires   ConsistentTypes<Law,
-                                 2,
+                                 nDim,
                                  Real,
-                                 SolVarT,
-                                 SolDelT>
+                                 SolVarT>
               && std::is_same_v<FluxRes,
                                 fluxresult_t<SolVarT>>
-   void boundaryResidual( const BoundaryCondition<Law,BCType,UpdateFunc>&,
-                          const size_t                            boundaryId,
-                          const Mesh<2,Real>&                           mesh,
-                          const HighOrderFlux&                        hoflux,
-                          const Species<Law,Real>&                   species,
-                          const SolutionField<SolVarT,2>&                  q,
-                          const par::DualArray2<std::array<SolDelT,2>>&   dq,
-                                par::DualArray2<FluxRes>&                res )
+              && (sizeof...(UpdateFuncs)<2)
+              && (BCType!=BoundaryType<Law>::Periodic)
+   void boundaryResidual( const BoundaryCondition<Law,BCType,UpdateFuncs...>&,
+                          const Policy                                     policy,
+                          const size_t                                 boundaryId,
+                          const HighOrderFlux&                             hoflux,
+                          const Species<Law,Real>&                        species,
+                          const Mesh<nDim,Real>&                             mesh,
+                          const SolutionField<SolVarT,nDim>&                    q,
+                          const par::DualArray<lsq::XMetricFactor<nDim,Real>,nDim>& dxdx,
+                          const par::DualArray<lsq::QMetric<SolVarT>,  nDim>& dqdx,
+                                par::DualArray<FluxRes,nDim>&                  res )
   {
    // check mesh sizes match
-      assert( mesh.cells.shape() == res.shape() );
-      assert( mesh.cells.shape() == dq.shape() );
       assert( mesh.cells.shape() == q.interior.shape() );
+      assert( mesh.cells.shape() == dxdx.shape() );
+      assert( mesh.cells.shape() == dqdx.shape() );
+      assert( mesh.cells.shape() ==  res.shape() );
 
    // boundary condition type selection was correct?
       assert( q.bcTypes[boundaryId] == BCType );
 
-      const size_t ni = q.interior.shape(0);
-      const size_t nj = q.interior.shape(1);
-      const size_t bID= boundaryId;
-
-      using CellIdx = typename SolutionField<SolVarT,2>::VarField::IdxType;
-      using NodeIdx = typename Mesh<2,Real>::NodeArray::IdxType;
-
-      if( boundaryId==0 ) // left face
-     {
-         const size_t i=0;
-         for( size_t j=0; j<nj; ++j )
-        {
-         // interior cell index
-            const CellIdx ic{i,j};
-
-         // boundary cell index
-            const CellIdx ib{j,0};
-   
-         // face node indices
-            const NodeIdx ip0{i,j  };
-            const NodeIdx ip1{i,j+1};
-   
-            const FluxRes fr = hoflux( species,
-                                       surface( mesh.nodes(ip0),
-                                                mesh.nodes(ip1) ),
-                                       SolDelT{},           dq(ic)[0],
-                                       q.boundary[bID](ib), q.interior(ic) );
-            res(ic)+=fr;
-        }
-     }
-      else if( boundaryId==1 ) // right face
-     {
-         const size_t i=ni-1;
-         for( size_t j=0; j<nj; ++j )
-        {
-         // interior cell index
-            const CellIdx ic{i,j};
-
-         // boundary cell index
-            const CellIdx ib{j,0};
-   
-         // face node indices
-            const NodeIdx ip0{i+1,j  };
-            const NodeIdx ip1{i+1,j+1};
-   
-            const FluxRes fr = hoflux( species,
-                                       surface( mesh.nodes(ip0),
-                                                mesh.nodes(ip1) ),
-                                       dq(ic)[0],      SolDelT{},       
-                                       q.interior(ic), q.boundary[bID](ib) );
-            res(ic)-=fr;
-        }
-     }
-      else if ( boundaryId==2 ) // bottom face
-     {
-         const size_t j=0;
-         for( size_t i=0; i<ni; ++i )
-        {
-         // interior cell index
-            const CellIdx ic{i,j};
-
-         // boundary cell index
-            const CellIdx ib{i,0};
-   
-         // face node indices
-            const NodeIdx ip0{i+1,j};
-            const NodeIdx ip1{i  ,j};
-   
-            const FluxRes fr = hoflux( species,
-                                       surface( mesh.nodes(ip0),
-                                                mesh.nodes(ip1) ),
-                                       SolDelT{},           dq(ic)[0],
-                                       q.boundary[bID](ib), q.interior(ic) );
-            res(ic)+=fr;
-        }
-     }
-      else if ( boundaryId==3 ) // top face
-     {
-         const size_t j=nj-1;
-         for( size_t i=0; i<ni; ++i )
-        {
-         // interior cell index
-            const CellIdx ic{i,j};
-
-         // boundary cell index
-            const CellIdx ib{i,0};
-   
-         // face node indices
-            const NodeIdx ip0{i+1,j+1};
-            const NodeIdx ip1{i  ,j+1};
-   
-            const FluxRes fr = hoflux( species,
-                                       surface( mesh.nodes(ip0),
-                                                mesh.nodes(ip1) ),
-                                        dq(ic)[0],      SolDelT{},        
-                                        q.interior(ic), q.boundary[bID](ib) );
-            res(ic)-=fr;
-        }
-     }
-      else{ assert( false && "invalid boundary id for 2D ghost cell flux, must be 0,1,2 or 3" ); }
+      using CellIdx = typename SolutionField<SolVarT,nDim>::VarField::IdxType;
 
+   // ib indexes the ghost cells
+      par::for_each_index( policy, CellIdx{}, CellIdx{q.ghost( boundaryId ).shape().shape},
+                           [&]( const CellIdx& ib )
+                          {
+                              res(boundaryCell( mesh, ib, boundaryId ))+= ghostCellFlux( hoflux, species, mesh, q, dxdx, dqdx, ib, boundaryId );
+                          } );
       return;
   }
-
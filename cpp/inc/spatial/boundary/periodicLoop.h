@@ -2,179 +2,126 @@
 # pragma once
 
 # include <spatial/boundary/boundaryCondition.h>
+# include <spatial/boundary/boundaryGeometry.h>
 
 # include <conservationLaws/base/base.h>
 # include <solutionField/solutionField.h>
 
+# include <lsq/lsq.h>
+
 # include <geometry/geometry.h>
 # include <mesh/mesh.h>
 
 # include <parallalg/array.h>
-
-# include <utils/concepts.h>
+# include <parallalg/schedule.h>
 
 # include <cassert>
 
 
 /*
- * Accumulate cell residual contributions over periodic boundary face for 1D domain
+ * flux across face ib of the periodic boundary pair in the normal dimension of boundaryId, from the cell next to the high boundary (left)
+ * to the cell next to the low boundary (right), which is subtracted from the left cell and added to the right cell as for an interior face
+ *    the left cell has its own solution and least squares metrics, and its geometry translated by the period of the domain, so the
+ *    face sees the same neighbour as an interior face would
+ *    the flux is the same function of the same arguments whichever boundary of the pair it is calculated from, so the two sides of a
+ *    face can be accumulated separately (e.g. by the threads sweeping either end of the domain) and the flux is still conservative
  */
    template<LawType                   Law,
+            int                      nDim,
             ImplementedVarSet     SolVarT,
-            ImplementedVarDelta   SolDelT,
-            typename              FluxRes,
             typename        HighOrderFlux,
             floating_point           Real>
       requires   ConsistentTypes<Law,
-                                 1,
+                                 nDim,
                                  Real,
-                                 SolVarT,
-                                 SolDelT>
-              && std::is_same_v<FluxRes,
-                                fluxresult_t<SolVarT>>
-   void boundaryResidual( const BoundaryCondition<Law,BoundaryType<Law>::Periodic>&,
-                          const size_t                           boundaryId,
-                          const Mesh<1,Real>&                          mesh,
-                          const HighOrderFlux&                       hoflux,
-                          const Species<Law,Real>&                  species,
-                          const SolutionField<SolVarT,1>&                 q,
-                          const par::DualArray1<std::array<SolDelT,1>>&  dq,
-                                par::DualArray1<FluxRes>&               res )
+                                 SolVarT>
+   fluxresult_t<SolVarT> periodicFlux( const HighOrderFlux&                             hoflux,
+                                       const Species<Law,Real>&                        species,
+                                       const Mesh<nDim,Real>&                             mesh,
+                                       const SolutionField<SolVarT,nDim>&                    q,
+                                       const par::DualArray<lsq::XMetricFactor<nDim,Real>,nDim>& dxdx,
+                                       const par::DualArray<lsq::QMetric<SolVarT>,  nDim>& dqdx,
+                                       const par::DualIdx<nDim>&                            ib,
+                                       const size_t                                 boundaryId )
   {
-   // valid boundary?
-      assert( (boundaryId==0 or boundaryId==1)
-              && "invalid boundary id for 1D boundary condition, must be 0 or 1"  );
-
-   // boundary condition type selection was correct?
-      assert( q.bcTypes[boundaryId] == BoundaryType<Law>::Periodic );
-
-   // flux contribution from periodic face should only be calculated from 'lower' face
-      if( boundaryId==1 ){ return; }
+   // low boundary of the pair
+      const size_t lowId = boundaryId - boundaryId%2;
 
-   // check mesh sizes match
-      assert( mesh.cells.shape() == res.shape() );
-      assert( mesh.cells.shape() == dq.shape() );
-      assert( mesh.cells.shape() == q.interior.shape() );
-
-   // periodic boundary
-      const size_t nc = q.interior.shape(0);
+      const par::DualIdx<nDim> icr = boundaryCell( mesh, ib, lowId   );
+      const par::DualIdx<nDim> icl = boundaryCell( mesh, ib, lowId+1 );
 
-      using CellIdx = typename SolutionField<SolVarT,1>::VarField::IdxType;
-      using NodeIdx = typename Mesh<1,Real>::NodeArray::IdxType;
+   // low boundary surface faces into domain, from the left cell to the right cell
+      const auto face = boundaryFace( mesh, icr, lowId );
 
-      const NodeIdx ip{0};
-      const CellIdx il{nc-1};
-      const CellIdx ir{0};
+   // left cell moved across the domain, by the distance between the low and high boundary faces
+      const auto periodicFace = boundaryFace( mesh, icl, lowId+1 );
 
-      const FluxRes fr = hoflux( species,
-                                 surface( mesh.nodes(ip) ),
-                                 dq(il)[0],      dq(ir)[0],
-                                 q.interior(il), q.interior(ir) );
-      res(il)-=fr;
-      res(ir)+=fr;
+      const geom::Volume<nDim,Real> cell{mesh.cells(icl).volume,
+                                         mesh.cells(icl).centre + (face.centre - periodicFace.centre)};
 
-      return;
+      return hoflux( species,
+                     face,
+                     cell,            mesh.cells(icr),
+                     q.interior(icl), q.interior(icr),
+                     dxdx(icl),       dxdx(icr),
+                     dqdx(icl),       dqdx(icr) );
   }
 
 /*
- * Accumulate cell residual contributions over periodic boundary faces for 2D domain
+ * Accumulate cell residual contributions over the faces of a periodic boundary
+ *    each periodic face is shared by the interior cells next to the low and high boundaries of one dimension, so its flux is only
+ *    calculated once, from the low boundary
+ *    each interior cell has at most one face on one boundary, so the faces of a boundary are accumulated in parallel according to policy
  */
-   template<LawType                   Law,
+   template<par::execution_policy Policy,
+            LawType                   Law,
+            int                      nDim,
             ImplementedVarSet     SolVarT,
-            ImplementedVarDelta   SolDelT,
             typename              FluxRes,
             typename        HighOrderFlux,
             floating_point           Real>
       requires   ConsistentTypes<Law,
-                                 2,
+                                 nDim,
                                  Real,
-                                 SolVarT,
-                                 SolDelT>
+                                 SolVarT>
               && std::is_same_v<FluxRes,
                                 fluxresult_t<SolVarT>>
    void boundaryResidual( const BoundaryCondition<Law,BoundaryType<Law>::Periodic>&,
-                          const size_t                            boundaryId,
-                          const Mesh<2,Real>&                           mesh,
-                          const HighOrderFlux&                        hoflux,
-                          const Species<Law,Real>&                   species,
-                          const SolutionField<SolVarT,2>&                  q,
-                          const par::DualArray2<std::array<SolDelT,2>>&   dq,
-                                par::DualArray2<FluxRes>&                res )
+                          const Policy                                     policy,
+                          const size_t                                 boundaryId,
+                          const HighOrderFlux&                             hoflux,
+                          const Species<Law,Real>&                        species,
+                          const Mesh<nDim,Real>&                             mesh,
+                          const SolutionField<SolVarT,nDim>&                    q,
+                          const par::DualArray<lsq::XMetricFactor<nDim,Real>,nDim>& dxdx,
+                          const par::DualArray<lsq::QMetric<SolVarT>,  nDim>& dqdx,
+                                par::DualArray<FluxRes,nDim>&                  res )
   {
-//    return;
-   // valid boundary?
-      assert((   (boundaryId==0)
-              or (boundaryId==1)
-              or (boundaryId==2)
-              or (boundaryId==3))
-             && "invalid boundary id for 1D boundary condition, must be 0 or 1"  );
+   // check mesh sizes match
+      assert( mesh.cells.shape() == q.interior.shape() );
+      assert( mesh.cells.shape() == dxdx.shape() );
+      assert( mesh.cells.shape() == dqdx.shape() );
+      assert( mesh.cells.shape() ==  res.shape() );
 
    // boundary condition type selection was correct?
       assert( q.bcTypes[boundaryId] == BoundaryType<Law>::Periodic );
 
    // flux contribution from periodic face should only be calculated from 'lower' face
-      if( (boundaryId==1) or (boundaryId==3) ){ return; }
+      if( boundaryId%2==1 ){ return; }
 
-   // check mesh sizes match
-      assert( mesh.cells.shape() == res.shape() );
-      assert( mesh.cells.shape() == dq.shape() );
-      assert( mesh.cells.shape() == q.interior.shape() );
+   // check consistency
+      assert( q.bcTypes[boundaryId+1] == BoundaryType<Law>::Periodic );
 
-      const size_t ni = q.interior.shape(0);
-      const size_t nj = q.interior.shape(1);
-
-      using CellIdx = typename SolutionField<SolVarT,2>::VarField::IdxType;
-      using NodeIdx = typename Mesh<2,Real>::NodeArray::IdxType;
-
-      if( boundaryId==0 ) // periodic boundary along +/- i direction
-     {
-         for( size_t j=0; j<nj; ++j )
-        {
-            const size_t il=ni-1;
-            const size_t ir=0;
-   
-         // cell left/right indices
-            const CellIdx icl{il,j};
-            const CellIdx icr{ir,j};
-   
-         // face node indices
-            const NodeIdx ip0{0,j  };
-            const NodeIdx ip1{0,j+1};
-   
-            const FluxRes fr = hoflux( species,
-                                       surface( mesh.nodes(ip0),
-                                                mesh.nodes(ip1) ),
-                                       dq(icl)[0],      dq(icr)[0],
-                                       q.interior(icl), q.interior(icr) );
-            res(icl)-=fr;
-            res(icr)+=fr;
-        }
-     }
-      else if ( boundaryId==2 ) // periodic boundary along +/- j direction
-     { 
-         for( size_t i=0; i<ni; ++i )
-        {
-            const size_t jl=nj-1;
-            const size_t jr=0;
-   
-         // cell left/right indices
-            const CellIdx icl{i,jl};
-            const CellIdx icr{i,jr};
-   
-         // face node indices
-            const NodeIdx ip0{i+1,0};
-            const NodeIdx ip1{i  ,0};
-   
-            const FluxRes fr = hoflux( species,
-                                       surface( mesh.nodes(ip0),
-                                                mesh.nodes(ip1) ),
-                                       dq(icl)[1],      dq(icr)[1],
-                                       q.interior(icl), q.interior(icr) );
-            res(icl)-=fr;
-            res(icr)+=fr;
-        }
-     }
+      using CellIdx = typename SolutionField<SolVarT,nDim>::VarField::IdxType;
 
+   // ib indexes the faces of the boundary
+      par::for_each_index( policy, CellIdx{}, CellIdx{q.ghost( boundaryId ).shape().shape},
+                           [&]( const CellIdx& ib )
+                          {
+                              const FluxRes fr = periodicFlux( hoflux, species, mesh, q, dxdx, dqdx, ib, boundaryId );
+
+                              res(boundaryCell( mesh, ib, boundaryId+1 ))-=fr;
+                              res(boundaryCell( mesh, ib, boundaryId   ))+=fr;
+                          } );
       return;
   }
-
@@ -92,7 +92,6 @@
   }
 
 
-
 // overload with return value (must be used to construct vector to use RVO)
    template<par::execution_policy Policy,
             LawType                  Law,
@@ -0,0 +1,161 @@
+
+# pragma once
+
+# include <spatial/residualCalc.h>
+# include <spatial/lsqMetrics.h>
+# include <spatial/stateCalc.h>
+
+# include <solutionField/solutionField.h>
+# include <conservationLaws/base/base.h>
+
+# include <mesh/mesh.h>
+# include <geometry/geometry.h>
+
+# include <lsq/lsq.h>
+
+# include <parallalg/algorithm.h>
+# include <parallalg/neighbour_algorithm.h>
+# include <parallalg/array.h>
+
+# include <array>
+# include <tuple>
+# include <type_traits>
+# include <cassert>
+
+/*
+ * Accumulate least squares solution metrics and cell residuals in a single sweep
+ *    the same as qmetrics followed by residualCalc, but interior faces are visited by par::for_each_face_lagged, so the flux
+ *    across each face is computed as soon as the solution metrics of the cells either side are complete, while the cells
+ *    are still in cache, and the solution and mesh are read from memory about once per residual evaluation
+ *    the ghost cells must have been filled by boundaryUpdate, so the faces of periodic and ghost cell boundaries are visited by the same
+ *    sweep, from the states in the halo of the solution, and only boundaries with a boundary flux function are accumulated afterwards
+ *    states is a State cache filled by stateCalc, or NoStateCache
+ *    res is scaled by resScale instead of zeroed before the fluxes are accumulated into it, so the residual can be added straight into the
+ *    increment of a low-storage runge-kutta stage. The spectral radii are always accumulated afresh
+ */
+   template<par::execution_policy  Policy,
+            LawType                   Law,
+            int                      nDim,
+            ImplementedVarSet     SolVarT,
+            typename              FluxRes,
+            typename        HighOrderFlux,
+            typename...     BoundaryConds,
+            typename           StateCache,
+            floating_point           Real>
+      requires   ConsistentTypes<Law,
+                                 nDim,
+                                 Real,
+                                 SolVarT>
+              && std::is_same_v<FluxRes,
+                                fluxresult_t<SolVarT>>
+   void fusedResidualCalc( const Policy                                             policy,
+                           const HighOrderFlux&                                     hoflux,
+                           const std::tuple<BoundaryConds...>                          bcs,
+                           const Species<Law,Real>&                                species,
+                           const Mesh<nDim,Real>&                                     mesh,
+                           const SolutionField<SolVarT,nDim>&                            q,
+                           const StateCache&                                        states,
+                           const par::DualArray<lsq::XMetricFactor<nDim,Real>,nDim>&  dxdx,
+                                 par::DualArray<lsq::QMetric<SolVarT>,nDim>&          dqdx,
+                                 par::DualArray<FluxRes,nDim>&                         res,
+                           const Real                                             resScale=0 )
+  {
+   // check mesh sizes match
+      assert( mesh.cells.shape() == q.interior.shape() );
+      assert( mesh.cells.shape() == dxdx.shape() );
+      assert( mesh.cells.shape() == dqdx.shape() );
+      assert( mesh.cells.shape() ==  res.shape() );
+
+      using QMetric = lsq::QMetric<SolVarT>;
+      using CellIdx = typename SolutionField<SolVarT,nDim>::VarField::IdxType;
+      using FaceIdx = typename Mesh<nDim,Real>::FaceArray::IdxType;
+
+      par::fill( policy, dqdx, QMetric{} );
+
+      if( resScale==0 )
+     {
+         par::fill( policy, res, FluxRes{} );
+     }
+      else
+     {
+         par::for_each( policy,
+                        [resScale]( FluxRes& r ){ r.flux*=resScale; r.lambda=0; },
+                        res );
+     }
+
+   // solution metric contribution of the face between cells icl and icr
+      const auto qmetric_face = [&]( const CellIdx& icl,
+                                     const CellIdx& icr,
+                                     const int           ) -> void
+     {
+         const QMetric dqm = lsq::qmetric( mesh.cells(icl).centre,
+                                           mesh.cells(icr).centre,
+                                           q.interior(icl),
+                                           q.interior(icr) );
+         dqdx(icl)+=dqm;
+         dqdx(icr)+=dqm;
+     };
+
+   // flux across the face between cells icl and icr, which is face icr of the faces normal to dim
+      const auto flux_face = [&]( const CellIdx& icl,
+                                  const CellIdx& icr,
+                                  const int      dim ) -> void
+     {
+         const auto& face = mesh.faces[dim](FaceIdx{icr.idxs});
+
+         const auto flux = [&]( const auto&... cached ) -> FluxRes
+        {
+            return hoflux( species, face,
+                           mesh.cells(icl), mesh.cells(icr),
+                           q.interior(icl), q.interior(icr),
+                           dxdx(icl),       dxdx(icr),
+                           dqdx(icl),       dqdx(icr),
+                           cached... );
+        };
+
+         FluxRes flx;
+         if constexpr( std::is_same_v<StateCache,NoStateCache> ){ flx = flux(); }
+         else                                                   { flx = flux( states(icl), states(icr) ); }
+
+         res(icl)-=flx;
+         res(icr)+=flx;
+     };
+
+   // boundaries whose faces are accumulated by boundaryFluxResidual instead of the sweep
+      std::array<bool,2*nDim> fluxBoundary{};
+      for( unsigned int boundaryId=0; boundaryId<q.nBoundaries; ++boundaryId )
+     {
+         selectBoundaryCondition( q.bcTypes[boundaryId], bcs,
+                                  [&]( const auto& bc ){ fluxBoundary[boundaryId] = has_boundary_flux_v<std::decay_t<decltype(bc)>>; } );
+     }
+
+   // flux across the face of cell ic on the low or high boundary normal to dim, where ib indexes the face in its boundary
+      const auto boundary_face = [&]( const CellIdx& ic,
+                                      const int     dim,
+                                      const bool   high ) -> void
+     {
+         const size_t boundaryId = 2*dim + (high ? 1 : 0);
+
+         if( fluxBoundary[boundaryId] ){ return; }
+
+         CellIdx ib=ic;
+         ib.idxs[dim]=0;
+
+         if( q.bcTypes[boundaryId] == BoundaryType<Law>::Periodic )
+        {
+            const FluxRes flx = periodicFlux( hoflux, species, mesh, q, dxdx, dqdx, ib, boundaryId );
+            if( high ){ res(ic)-=flx; }
+            else      { res(ic)+=flx; }
+        }
+         else
+        {
+            res(ic)+=ghostCellFlux( hoflux, species, mesh, q, dxdx, dqdx, ib, boundaryId );
+        }
+     };
+
+      par::for_each_face_lagged( policy, qmetric_face, flux_face, boundary_face, mesh.cells.shape() );
+
+      boundaryFluxResidual( policy, hoflux, bcs, species, mesh, q, dxdx, dqdx, res );
+
+      return;
+  }
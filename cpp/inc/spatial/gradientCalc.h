@@ -30,6 +30,10 @@
       return dq;
   }
 
+/*
+ * gradient calculation over whole domain
+ *    interior faces are accumulated with face colouring if no accumulation scheme provided
+ */
    template<par::execution_policy Policy,
             ImplementedVarSet    VarSetT,
             ImplementedVarDelta  VarDelT,
@@ -47,152 +51,77 @@
                       const SolutionField<VarSetT,nDim>&                 q,
                             par::DualArray<std::array<VarDelT,N>,nDim>& dq )
   {
-      par::fill( policy, dq, std::array<VarDelT,N>{} );
-      interiorGradient( policy, mesh,q, dq );
-      boundaryGradient( policy, mesh,q, dq );
+      gradientCalc( policy, par::accumulation::colour, mesh,q, dq );
   }
 
 /*
- * gradient calculation for interior of 1D domain
+ * gradient calculation over whole domain
+ *    scheme determines how parallel accumulation over interior faces avoids write conflicts
+ *    interior faces are visited by par::for_each_face, so face gather is not supported
  */
-   template<par::execution_policy Policy,
-            ImplementedVarSet    VarSetT,
-            ImplementedVarDelta  VarDelT,
-            floating_point          Real>
+   template<par::execution_policy          Policy,
+            par::face_accumulation_policy  Scheme,
+            ImplementedVarSet             VarSetT,
+            ImplementedVarDelta           VarDelT,
+            int                              nDim,
+            size_t                              N,
+            floating_point                   Real>
       requires ConsistentTypes<law_of_v<VarSetT>,
-                               1,
+                               nDim,
                                Real,
                                VarSetT,
                                VarDelT>
-   void interiorGradient( const Policy                              policy,
-                          const Mesh<1,Real>&                         mesh,
-                          const SolutionField<VarSetT,1>&                q,
-                                par::DualArray1<std::array<VarDelT,1>>& dq )
+               && N==nDim
+   void gradientCalc( const Policy                                  policy,
+                      const Scheme                                  scheme,
+                      const Mesh<nDim,Real>&                          mesh,
+                      const SolutionField<VarSetT,nDim>&                 q,
+                            par::DualArray<std::array<VarDelT,N>,nDim>& dq )
   {
-/*
-      const auto dq_calc = []( const VarSetT& ql,
-                               const VarSetT& qr ) -> VarDelT
-     {
-         return qr-ql;
-     };
-
-      const auto accumulator = []( const VarDelT& acc_old,
-                                   const VarDelT& dq_new ) -> VarDelT
-     {
-         VarDelT acc_new = acc_old+dq_new;
-         return acc_new;
-     };
-
-      par::neighbour_accumulation( policy,
-                                   dq_calc,
-                                   accumulator,
-                                   accumulator,
-                                   dq,
-                                   q.interior );
-*/
-  
-      assert( mesh.cells.shape() == q.interior.shape() );
-      assert( mesh.cells.shape() == dq.shape() );
-      const size_t nc = mesh.cells.shape(0);
-
-      using CellIdx = typename SolutionField<VarSetT,1>::VarField::IdxType;
-
-      for( size_t i=0; i<nc-1; ++i )
-     {
-         const CellIdx idx0{i};
-         const CellIdx idx1{i+1};
-
-         const VarDelT d = q.interior(idx1) - q.interior(idx0);
-
-         dq(idx0)[0]+=d;
-         dq(idx1)[0]+=d;
-     }
-
-      return;
+      par::fill( policy, dq, std::array<VarDelT,N>{} );
+      interiorGradient( policy, scheme, mesh,q, dq );
+      boundaryGradient( policy,         mesh,q, dq );
   }
 
 /*
- * gradient calculation for interior of 2D domain
+ * gradient calculation for interior of 1D or 2D domain
+ *    the difference across each face is accumulated into the gradient component of the face's dimension in the cells either side
  */
-   template<par::execution_policy Policy,
-            ImplementedVarSet    VarSetT,
-            ImplementedVarDelta  VarDelT,
-            floating_point          Real>
+   template<par::execution_policy          Policy,
+            par::face_accumulation_policy  Scheme,
+            ImplementedVarSet             VarSetT,
+            ImplementedVarDelta           VarDelT,
+            int                              nDim,
+            size_t                              N,
+            floating_point                   Real>
       requires ConsistentTypes<law_of_v<VarSetT>,
-                               2,
+                               nDim,
                                Real,
                                VarSetT,
                                VarDelT>
-   void interiorGradient( const Policy                              policy,
-                          const Mesh<2,Real>&                         mesh,
-                          const SolutionField<VarSetT,2>&                q,
-                                par::DualArray2<std::array<VarDelT,2>>& dq )
+               && N==nDim
+   void interiorGradient( const Policy                                  policy,
+                          const Scheme                                  scheme,
+                          const Mesh<nDim,Real>&                          mesh,
+                          const SolutionField<VarSetT,nDim>&                 q,
+                                par::DualArray<std::array<VarDelT,N>,nDim>& dq )
   {
-      assert( mesh.cells.shape() == dq.shape() );
       assert( mesh.cells.shape() == q.interior.shape() );
+      assert( mesh.cells.shape() == dq.shape() );
 
-/*
-      const auto dq_calc = []( const VarSetT& ql,
-                               const VarSetT& qr ) -> VarDelT
-     {
-         return qr-ql;
-     };
-
-      const auto accumulator = []( const VarDelT& acc_old,
-                                   const VarDelT& dq_new ) -> VarDelT
-     {
-         VarDelT acc_new = acc_old+dq_new;
-         return acc_new;
-     };
-
-      par::neighbour_accumulation( policy,
-                                   dq_calc,
-                                   accumulator,
-                                   accumulator,
-                                   dq,
-                                   q.interior );
-*/
-
-      const size_t ni = mesh.cells.shape(0);
-      const size_t nj = mesh.cells.shape(1);
-
-      using CellIdx = typename SolutionField<VarSetT,2>::VarField::IdxType;
+      using CellIdx = typename SolutionField<VarSetT,nDim>::VarField::IdxType;
 
-   // derivatives over i-normal faces
-# ifdef _OPENMP
-   # pragma omp parallel for
-# endif
-      for( size_t j=0; j<nj; ++j )
+      const auto face_gradient = [&]( const CellIdx& icl,
+                                      const CellIdx& icr,
+                                      const int      dim ) -> void
      {
-         for( size_t i=0; i<ni-1; ++i )
-        {
-            const CellIdx icl{i  ,j};
-            const CellIdx icr{i+1,j};
-
-            const VarDelT d = q.interior(icr) - q.interior(icl);
-   
-            dq(icl)[0]+=d;
-            dq(icr)[0]+=d;
-        }
-     }
+         const VarDelT d = q.interior(icr) - q.interior(icl);
 
-   // derivatives over i-normal faces
-# ifdef _OPENMP
-   # pragma omp parallel for
-# endif
-      for( size_t i=0; i<ni; ++i )
-     {
-         for( size_t j=0; j<nj-1; ++j )
-        {
-            const CellIdx icl{i,j  };
-            const CellIdx icr{i,j+1};
+         dq(icl)[dim]+=d;
+         dq(icr)[dim]+=d;
+     };
 
-            const VarDelT d = q.interior(icr) - q.interior(icl);
-   
-            dq(icl)[1]+=d;
-            dq(icr)[1]+=d;
-        }
-     }
+      par::for_each_face( policy, scheme, face_gradient, mesh.cells.shape() );
 
       return;
   }
@@ -9,57 +9,12 @@
 # include <geometry/geometry.h>
 
 # include <parallalg/neighbour_algorithm.h>
+# include <parallalg/algorithm.h>
 # include <parallalg/array.h>
 # include <parallalg/parallalg.h>
 
 # include <functional>
-
-/*
- * Calculate array of spatial metrics for least squares gradient calculation
- */
-   template<par::execution_policy Policy,
-            int                     nDim,
-            floating_point          Real>
-   auto xmetrics( const Policy                   policy,
-                  const MeshCellArray<nDim,Real>& cells )
-  {
-      par::DualArray<lsq::XMetric<nDim,Real>,nDim> dxdx(cells.shape());
-      xmetrics( policy, cells, dxdx );
-      return dxdx;
-  }
-
-   template<par::execution_policy Policy,
-            int                     nDim,
-            floating_point          Real>
-   void xmetrics( const Policy                                      policy,
-                  const MeshCellArray<nDim,Real>&                    cells,
-                        par::DualArray<lsq::XMetric<nDim,Real>,nDim>& dxdx )
-  {
-      using XMetric = lsq::XMetric<nDim,Real>;
-      using Cell = typename Mesh<nDim,Real>::Cell;
-
-      assert( cells.shape() == dxdx.shape() );
-
-      par::fill( policy, dxdx, XMetric{0.} )
-
-      const auto xmetric_calc = []( const Cell& c0,
-                                    const Cell& c1 ) -> XMetric
-     {
-         return lsq::xmetric( c0.centre,
-                              c1.centre );
-     }
-
-      par::neighbour_accumulation( policy,
-                                   xmetric_calc,
-                                   std::plus<XMetric>,
-                                   std::plus<XMetric>,
-                                   dxdx,
-                                   cells );
-
-      boundary_xmetrics( policy, cells, dxdx );
-
-      return;
-  }
+# include <cassert>
 
 /*
  * use boundary contributions to xmetrics to prevent rank deficient biased metrics
@@ -74,13 +29,13 @@
       using XMetric = lsq::XMetric<1,Real>;
 
       const auto boundary_dxdx_calc = []( const Cell& c0,
-                                                Cell& c1 ) -> XMetric
+                                          const Cell& c1 ) -> XMetric
      {
-         const auto displacement = cell0.centre - cell1.centre;
-         const auto boundary_point = cell0.centre + displacement;
+         const auto displacement = c0.centre - c1.centre;
+         const auto boundary_point = c0.centre + displacement;
 
-        return lsq::xmetric( cell0.centre,
-                             boundary_point );
+         return lsq::xmetric( c0.centre,
+                              boundary_point );
      };
 
    // left face
@@ -114,13 +69,13 @@
       using XMetric = lsq::XMetric<2,Real>;
 
       const auto boundary_dxdx_calc = []( const Cell& c0,
-                                                Cell& c1 ) -> XMetric
+                                          const Cell& c1 ) -> XMetric
      {
-         const auto displacement = cell0.centre - cell1.centre;
-         const auto boundary_point = cell0.centre + displacement;
+         const auto displacement = c0.centre - c1.centre;
+         const auto boundary_point = c0.centre + displacement;
 
-        return lsq::xmetric( cell0.centre,
-                             boundary_point );
+         return lsq::xmetric( c0.centre,
+                              boundary_point );
      };
 
    // left/right faces
@@ -163,34 +118,99 @@
   }
 
 /*
- * Calculate array of solution metrics for least squares gradient calculation
+ * Calculate array of spatial metrics for least squares gradient calculation
  */
-   template<par::execution_policy  Policy,
-            ImplementedVarSet   SolVarSet,
-            int                      nDim,
-            floating_point           Real>
-   auto qmetrics( const Policy                        policy,
-                  const MeshCellArray<nDim,Real>&      cells,
-                        par::DualArray<SolVarSet,nDim>&   q0 )
+   template<par::execution_policy Policy,
+            int                     nDim,
+            floating_point          Real>
+   void xmetrics( const Policy                                      policy,
+                  const MeshCellArray<nDim,Real>&                    cells,
+                        par::DualArray<lsq::XMetric<nDim,Real>,nDim>& dxdx )
   {
-      par::DualArray<lsq::QMetric<SolVarSet>,nDim> dqdx(cells.shape());
-      qmetrics( policy, cells, q0, dqdx );
-      return dqdx;
+      using XMetric = lsq::XMetric<nDim,Real>;
+      using Cell = typename Mesh<nDim,Real>::Cell;
+
+      assert( cells.shape() == dxdx.shape() );
+
+      par::fill( policy, dxdx, XMetric{} );
+
+      const auto xmetric_calc = []( const Cell& c0,
+                                    const Cell& c1 ) -> XMetric
+     {
+         return lsq::xmetric( c0.centre,
+                              c1.centre );
+     };
+
+      par::neighbour_accumulation( policy,
+                                   xmetric_calc,
+                                   std::plus<XMetric>{},
+                                   std::plus<XMetric>{},
+                                   dxdx,
+                                   cells );
+
+      boundary_xmetrics( policy, cells, dxdx );
+
+      return;
+  }
+
+   template<par::execution_policy Policy,
+            int                     nDim,
+            floating_point          Real>
+   auto xmetrics( const Policy                   policy,
+                  const MeshCellArray<nDim,Real>& cells )
+  {
+      par::DualArray<lsq::XMetric<nDim,Real>,nDim> dxdx(cells.shape());
+      xmetrics( policy, cells, dxdx );
+      return dxdx;
   }
 
+/*
+ * Calculate array of factored spatial metrics for least squares gradient calculation
+ *    the spatial metrics only depend on the mesh, so they are factored once here rather than on every face of every residual evaluation
+ */
+   template<par::execution_policy Policy,
+            int                     nDim,
+            floating_point          Real>
+   void xmetric_factors( const Policy                                             policy,
+                         const par::DualArray<lsq::XMetric<nDim,Real>,nDim>&        dxdx,
+                               par::DualArray<lsq::XMetricFactor<nDim,Real>,nDim>&    xf )
+  {
+      assert( dxdx.shape() == xf.shape() );
+
+      par::transform( policy,
+                      []( const lsq::XMetric<nDim,Real>& xm ){ return lsq::factor( xm ); },
+                      xf,
+                      dxdx );
+      return;
+  }
+
+   template<par::execution_policy Policy,
+            int                     nDim,
+            floating_point          Real>
+   auto xmetric_factors( const Policy                   policy,
+                         const MeshCellArray<nDim,Real>& cells )
+  {
+      par::DualArray<lsq::XMetricFactor<nDim,Real>,nDim> xf(policy,cells.shape());
+      xmetric_factors( policy, xmetrics( policy, cells ), xf );
+      return xf;
+  }
+
+/*
+ * Calculate array of solution metrics for least squares gradient calculation
+ */
    template<par::execution_policy   Policy,
             ImplementedVarSet    SolVarSet,
             int                       nDim,
             floating_point            Real>
    void qmetrics( const Policy                                      policy,
                   const MeshCellArray<nDim,Real>&                    cells,
-                  const par::DualArray<SolVarSet,nDim>&                 q0,
+                  const par::DualArray<SolVarSet,nDim>&                  q,
                         par::DualArray<lsq::QMetric<SolVarSet>,nDim>& dqdx )
   {
       using QMetric = lsq::QMetric<SolVarSet>;
       using Cell = typename MeshCellArray<nDim,Real>::ElemType;
 
-      par::fill( policy, dqdx, QMetric{0.} )
+      par::fill( policy, dqdx, QMetric{} );
 
       const auto qmetric_calc = []( const Cell&      c0,
                                     const Cell&      c1,
@@ -201,14 +221,26 @@
                               c1.centre,
                               q0,
                               q1 );
-     }
+     };
 
       par::neighbour_accumulation( policy,
                                    qmetric_calc,
-                                   std::plus<QMetric>,
-                                   std::plus<QMetric>,
+                                   std::plus<QMetric>{},
+                                   std::plus<QMetric>{},
                                    dqdx,
-                                   cells, q0 );
+                                   cells, q );
       return;
   }
 
+   template<par::execution_policy  Policy,
+            ImplementedVarSet   SolVarSet,
+            int                      nDim,
+            floating_point           Real>
+   auto qmetrics( const Policy                        policy,
+                  const MeshCellArray<nDim,Real>&      cells,
+                  const par::DualArray<SolVarSet,nDim>&    q )
+  {
+      par::DualArray<lsq::QMetric<SolVarSet>,nDim> dqdx(cells.shape());
+      qmetrics( policy, cells, q, dqdx );
+      return dqdx;
+  }
@@ -7,6 +7,13 @@
 
 # include <limiters/limiter.h>
 
+# include <type_traits>
+
+/*
+ * MUSCL flux with limited least squares gradients
+ *    the spatial metrics are passed already factored (see xmetric_factors), so only the cheap rank-1 correction for the
+ *    biased gradients is made on each face
+ */
    template<LawType            Law,
             typename       Limiter,
             FluxFunctor<Law>  Flux>
@@ -23,8 +30,8 @@
               const geom::Volume<nDim,Real>&  cell_r,
               const SolVarSet&                   q_l,
               const SolVarSet&                   q_r,
-              const lsq::XMetric<nDim,Real>&   dxm_l,
-              const lsq::XMetric<nDim,Real>&   dxm_r,
+              const lsq::XMetricFactor<nDim,Real>& xf_l,
+              const lsq::XMetricFactor<nDim,Real>& xf_r,
               const lsq::QMetric<SolVarSet>&   dqm_l,
               const lsq::QMetric<SolVarSet>&   dqm_r ) -> fluxresult_t<SolVarSet>
 //       requires ConsistentTypes<Law,nDim,Real,SolVarSet>
@@ -45,7 +52,7 @@
 
       // biased left/right gradients
          const std::pair dqdx_lr = lsq::bias_solves( dx_c, dq_c,
-                                                     dxm_l,dxm_r,
+                                                     xf_l,xf_r,
                                                      dqm_l,dqm_r,
                                                      face.normal );
 
@@ -59,6 +66,11 @@
      };
   }
 
+/*
+ * first order flux from the cell values
+ *    the States of the left and right cells can be passed after the other arguments (see stateCalc), and are then used
+ *    instead of converting ql and qr to States on every face
+ */
    template<LawType            Law,
             FluxFunctor<Law>  Flux>
    auto make_muscl_flux( const Limiters::NoLimit1&,
@@ -68,21 +80,25 @@
              <int                      nDim,
               floating_point           Real,
               ImplementedVarSet   SolVarSet,
-              ImplementedVarDelta SolVarDel>
+              typename...          StateT>
             ( const Species<Law,Real>&     species,
               const geom::Surface<nDim,Real>& face,
               const geom::Volume<nDim,Real>&,
               const geom::Volume<nDim,Real>&,
               const SolVarSet&                 ql,
               const SolVarSet&                 qr,
-              const lsq::XMetric<nDim,Real>&,
-              const lsq::XMetric<nDim,Real>&,
+              const lsq::XMetricFactor<nDim,Real>&,
+              const lsq::XMetricFactor<nDim,Real>&,
+              const lsq::QMetric<SolVarSet>&,
               const lsq::QMetric<SolVarSet>&,
-              const lsq::QMetric<SolVarSet>& ) -> fluxresult_t<SolVarSet>
-//       requires ConsistentTypes<Law,nDim,Real,SolVarSet,SolVarDel>
+              const StateT&...             slr ) -> fluxresult_t<SolVarSet>
+         requires sizeof...(StateT)==0
+               || (sizeof...(StateT)==2 && (std::is_same_v<StateT,state_t<SolVarSet>> && ...))
+//       requires ConsistentTypes<Law,nDim,Real,SolVarSet>
      {
-      // first order inviscid flux
-         return flux( species, face, ql, qr );
+      // first order inviscid flux, from the cached cell States if provided
+         if constexpr( sizeof...(StateT)==2 ){ return flux( species, face, slr... ); }
+         else                                 { return flux( species, face, ql, qr ); }
      };
   }
 
@@ -5,6 +5,7 @@
 # include <spatial/boundary/ghostCellLoop.h>
 # include <spatial/boundary/boundaryFluxLoop.h>
 # include <spatial/boundary/boundaryCondition.h>
+# include <spatial/stateCalc.h>
 
 # include <solutionField/solutionField.h>
 # include <conservationLaws/base/base.h>
@@ -13,23 +14,24 @@
 # include <geometry/geometry.h>
 
 # include <parallalg/algorithm.h>
+# include <parallalg/neighbour_algorithm.h>
 # include <parallalg/array.h>
 
 # include <utils/utils.h>
 # include <utils/concepts.h>
 
 # include <tuple>
+# include <type_traits>
 # include <cassert>
 
 /*
  * Accumulate cell residuals from fluxes over all cell faces
+ *    interior faces are accumulated with face colouring if no accumulation scheme provided
  */
    template<par::execution_policy  Policy,
             LawType                   Law,
             int                      nDim,
-            size_t                      N,
             ImplementedVarSet     SolVarT,
-            ImplementedVarDelta   SolDelT,
             typename              FluxRes,
             typename        HighOrderFlux,
             typename...     BoundaryConds,
@@ -37,60 +39,152 @@
       requires   ConsistentTypes<Law,
                                  nDim,
                                  Real,
-                                 SolVarT,
-                                 SolDelT>
+                                 SolVarT>
               && std::is_same_v<FluxRes,
                                 fluxresult_t<SolVarT>>
-              && N==nDim
    void residualCalc( const Policy                                       policy,
                       const HighOrderFlux&                               hoflux,
                       const std::tuple<BoundaryConds...>                    bcs,
                       const Species<Law,Real>&                          species,
                       const Mesh<nDim,Real>&                               mesh,
                       const SolutionField<SolVarT,nDim>&                      q,
-                      const par::DualArray<lsq::XMetric<nDim,Real>,nDim>&  dxdx,
+                      const par::DualArray<lsq::XMetricFactor<nDim,Real>,nDim>&  dxdx,
                       const par::DualArray<lsq::QMetric<SolVarT>,  nDim>&  dqdx,
                             par::DualArray<FluxRes,nDim>&                   res )
+  {
+      residualCalc( policy, par::accumulation::colour,
+                    hoflux, bcs, species, mesh, q, dxdx, dqdx, res );
+  }
 
+/*
+ * Accumulate cell residuals from fluxes over all cell faces
+ *    scheme determines how parallel accumulation over interior faces avoids write conflicts
+ */
+   template<par::execution_policy     Policy,
+            par::accumulation_policy  Scheme,
+            LawType                   Law,
+            int                      nDim,
+            ImplementedVarSet     SolVarT,
+            typename              FluxRes,
+            typename        HighOrderFlux,
+            typename...     BoundaryConds,
+            floating_point           Real>
+      requires   ConsistentTypes<Law,
+                                 nDim,
+                                 Real,
+                                 SolVarT>
+              && std::is_same_v<FluxRes,
+                                fluxresult_t<SolVarT>>
+   void residualCalc( const Policy                                       policy,
+                      const Scheme                                       scheme,
+                      const HighOrderFlux&                               hoflux,
+                      const std::tuple<BoundaryConds...>                    bcs,
+                      const Species<Law,Real>&                          species,
+                      const Mesh<nDim,Real>&                               mesh,
+                      const SolutionField<SolVarT,nDim>&                      q,
+                      const par::DualArray<lsq::XMetricFactor<nDim,Real>,nDim>&  dxdx,
+                      const par::DualArray<lsq::QMetric<SolVarT>,  nDim>&  dqdx,
+                            par::DualArray<FluxRes,nDim>&                   res )
+  {
+      residualCalc( policy, scheme,
+                    hoflux, bcs, species, mesh, q, NoStateCache{}, dxdx, dqdx, res );
+  }
+
+/*
+ * Accumulate cell residuals from fluxes over all cell faces
+ *    states is a State cache filled by stateCalc, which is passed to the flux function of interior faces, or NoStateCache
+ */
+   template<par::execution_policy     Policy,
+            par::accumulation_policy  Scheme,
+            LawType                   Law,
+            int                      nDim,
+            ImplementedVarSet     SolVarT,
+            typename              FluxRes,
+            typename        HighOrderFlux,
+            typename...     BoundaryConds,
+            typename           StateCache,
+            floating_point           Real>
+      requires   ConsistentTypes<Law,
+                                 nDim,
+                                 Real,
+                                 SolVarT>
+              && std::is_same_v<FluxRes,
+                                fluxresult_t<SolVarT>>
+   void residualCalc( const Policy                                       policy,
+                      const Scheme                                       scheme,
+                      const HighOrderFlux&                               hoflux,
+                      const std::tuple<BoundaryConds...>                    bcs,
+                      const Species<Law,Real>&                          species,
+                      const Mesh<nDim,Real>&                               mesh,
+                      const SolutionField<SolVarT,nDim>&                      q,
+                      const StateCache&                                  states,
+                      const par::DualArray<lsq::XMetricFactor<nDim,Real>,nDim>&  dxdx,
+                      const par::DualArray<lsq::QMetric<SolVarT>,  nDim>&  dqdx,
+                            par::DualArray<FluxRes,nDim>&                   res )
   {
    // check mesh sizes match
       assert( mesh.cells.shape() == q.interior.shape() );
       assert( mesh.cells.shape() == dxdx.shape() );
       assert( mesh.cells.shape() == dqdx.shape() );
       assert( mesh.cells.shape() ==  res.shape() );
-      assert( mesh.cells.shape() ==   dq.shape() );
 
-      par::fill( policy, res, FluxRes{0.} );
+      par::fill( policy, res, FluxRes{} );
 
-      interiorResidual( policy, hoflux,      species, mesh, q, dxdx, dqdx, res );
+      interiorResidual( policy, scheme, hoflux, species, mesh, q, states, dxdx, dqdx, res );
       boundaryResidual( policy, hoflux, bcs, species, mesh, q, dxdx, dqdx, res );
 
       return;
   }
 
 /*
- * Accumulate cell residual contributions from interior faces in 1D domain
+ * Accumulate cell residual contributions from interior faces
+ *    interior faces are accumulated with face colouring if no accumulation scheme provided
  */
    template<par::execution_policy  Policy,
             LawType                   Law,
+            int                      nDim,
             ImplementedVarSet     SolVarT,
-            ImplementedVarDelta   SolDelT,
             typename              FluxRes,
             typename        HighOrderFlux,
             floating_point           Real>
+   void interiorResidual( const Policy                                        policy,
+                          const HighOrderFlux&                                hoflux,
+                          const Species<Law,Real>&                           species,
+                          const Mesh<nDim,Real>&                                mesh,
+                          const SolutionField<SolVarT,nDim>&                       q,
+                          const par::DualArray<lsq::XMetricFactor<nDim,Real>,nDim>&   dxdx,
+                          const par::DualArray<lsq::QMetric<SolVarT>,  nDim>&   dqdx,
+                                par::DualArray<FluxRes,nDim>&                    res )
+  {
+      interiorResidual( policy, par::accumulation::colour,
+                        hoflux, species, mesh, q, NoStateCache{}, dxdx, dqdx, res );
+  }
+
+/*
+ * Accumulate cell residual contributions from interior faces in 1D domain
+ */
+   template<par::execution_policy     Policy,
+            par::accumulation_policy  Scheme,
+            LawType                      Law,
+            ImplementedVarSet        SolVarT,
+            typename                 FluxRes,
+            typename           HighOrderFlux,
+            typename              StateCache,
+            floating_point              Real>
       requires   ConsistentTypes<Law,
                                  1,
                                  Real,
-                                 SolVarT,
-                                 SolDelT>
+                                 SolVarT>
               && std::is_same_v<FluxRes,
                                 fluxresult_t<SolVarT>>
    void interiorResidual( const Policy                                  policy,
+                          const Scheme                                  scheme,
                           const HighOrderFlux&                          hoflux,
                           const Species<Law,Real>&                     species,
                           const Mesh<1,Real>&                             mesh,
                           const SolutionField<SolVarT,1>&                    q,
-                          const par::DualArray<lsq::XMetric<1,Real>, 1>&  dxdx,
+                          const StateCache&                              states,
+                          const par::DualArray<lsq::XMetricFactor<1,Real>, 1>&  dxdx,
                           const par::DualArray<lsq::QMetric<SolVarT>,1>&  dqdx,
                                 par::DualArray1<FluxRes>&                  res )
   {
@@ -99,56 +193,79 @@
       assert( mesh.cells.shape() == dxdx.shape() );
       assert( mesh.cells.shape() == dqdx.shape() );
       assert( mesh.cells.shape() ==  res.shape() );
-      assert( mesh.cells.shape() ==   dq.shape() );
-
-      const size_t nc = mesh.cells.shape(0);
 
       using CellIdx = typename SolutionField<SolVarT,1>::VarField::IdxType;
-      using NodeIdx = typename Mesh<1,Real>::NodeArray::IdxType;
+      using FaceIdx = typename Mesh<1,Real>::FaceArray::IdxType;
 
-   // accumulate cell residual contributions from the flux across each face
-      for( size_t i=0; i<nc-1; ++i )
+   // flux across the face between cells icl and icr, which is face icr of the mesh
+      const auto flux = [&]( const CellIdx&    icl,
+                             const CellIdx&    icr,
+                             const auto&...   args ) -> FluxRes
      {
-         const NodeIdx ip{i};
-         const CellIdx il{i};
-         const CellIdx ir{i+1};
-
-         const FluxRes fr = hoflux( species,
-                                    surface( mesh.nodes(ip) ),
-                                    mesh.cells(il), mesh.cells(ir),
-                                    q.interior(il), q.interior(ir),
-                                          dxdx(il),       dxdx(ir),
-                                          dqdx(il),       dqdx(ir) );
-         res(il)-=fr;
-         res(ir)+=fr;
-     }
+         const auto& face = mesh.faces[0](FaceIdx{icr.idxs});
+
+         if constexpr( std::is_same_v<StateCache,NoStateCache> )
+        {
+            return hoflux( species, face, args... );
+        }
+         else
+        {
+            return hoflux( species, face, args..., states(icl), states(icr) );
+        }
+     };
+
+      const auto acc_left = []( FluxRes acc_old,
+                                const FluxRes& new_flx ) -> FluxRes
+     {
+         acc_old-=new_flx;
+         return acc_old;
+     };
 
+      const auto acc_right = []( FluxRes acc_old,
+                                 const FluxRes& new_flx ) -> FluxRes
+     {
+         acc_old+=new_flx;
+         return acc_old;
+     };
+
+   // accumulate cell residual contributions from the flux across each face
+      par::neighbour_accumulation_idx( policy, scheme,
+                                       flux,
+                                       acc_left,
+                                       acc_right,
+                                       res,
+                                       mesh.cells,
+                                       q.interior,
+                                       dxdx,
+                                       dqdx );
       return;
   }
 
 /*
  * Accumulate cell residual contributions from interior faces in 2D domain
  */
-   template<par::execution_policy  Policy,
-            LawType                   Law,
-            ImplementedVarSet     SolVarT,
-            ImplementedVarDelta   SolDelT,
-            typename              FluxRes,
-            typename        HighOrderFlux,
-            floating_point           Real>
+   template<par::execution_policy     Policy,
+            par::accumulation_policy  Scheme,
+            LawType                      Law,
+            ImplementedVarSet        SolVarT,
+            typename                 FluxRes,
+            typename           HighOrderFlux,
+            typename              StateCache,
+            floating_point              Real>
       requires   ConsistentTypes<Law,
                                  2,
                                  Real,
-                                 SolVarT,
-                                 SolDelT>
+                                 SolVarT>
               && std::is_same_v<FluxRes,
                                 fluxresult_t<SolVarT>>
    void interiorResidual( const Policy                                  policy,
+                          const Scheme                                  scheme,
                           const HighOrderFlux&                          hoflux,
                           const Species<Law,Real>&                     species,
                           const Mesh<2,Real>&                             mesh,
                           const SolutionField<SolVarT,2>&                    q,
-                          const par::DualArray<lsq::XMetric<2,Real>, 2>&  dxdx,
+                          const StateCache&                              states,
+                          const par::DualArray<lsq::XMetricFactor<2,Real>, 2>&  dxdx,
                           const par::DualArray<lsq::QMetric<SolVarT>,2>&  dqdx,
                                 par::DualArray2<FluxRes>&                  res )
   {
@@ -156,114 +273,65 @@
       assert( mesh.cells.shape() == dxdx.shape() );
       assert( mesh.cells.shape() == dqdx.shape() );
       assert( mesh.cells.shape() == res.shape() );
-      assert( mesh.cells.shape() == dq.shape() );
-
-      const size_t ni = mesh.cells.shape(0);
-      const size_t nj = mesh.cells.shape(1);
 
       using CellIdx = typename SolutionField<SolVarT,2>::VarField::IdxType;
-      using NodeIdx = typename Mesh<2,Real>::NodeArray::IdxType;
+      using FaceIdx = typename Mesh<2,Real>::FaceArray::IdxType;
 
-/*
-      const auto flux = [hoflux,species]( const Node& n0,
-                                          const Node& n1,
-                                          auto...   args ) -> FluxRes
+   // flux across the face between cells icl and icr, which is face icr of the i-normal (icr={i+1,j}) or j-normal (icr={i,j+1}) faces
+      const auto flux = [&]( const CellIdx&    icl,
+                             const CellIdx&    icr,
+                             const auto&...   args ) -> FluxRes
      {
-         return hoflux( species,
-                        surface( n0,n1 ),
-                        args... );
+         const bool inormal = icr[0]!=icl[0];
+
+         const auto& face = mesh.faces[inormal ? 0 : 1](FaceIdx{icr.idxs});
+
+         if constexpr( std::is_same_v<StateCache,NoStateCache> )
+        {
+            return hoflux( species, face, args... );
+        }
+         else
+        {
+            return hoflux( species, face, args..., states(icl), states(icr) );
+        }
      };
 
-      const auto acc_left = []( const FluxRes& acc_old,
+      const auto acc_left = []( FluxRes acc_old,
                                 const FluxRes& new_flx ) -> FluxRes
      {
-         return acc_old-=new_flx;
-     }
+         acc_old-=new_flx;
+         return acc_old;
+     };
 
-      const auto acc_right = []( const FluxRes& acc_old,
+      const auto acc_right = []( FluxRes acc_old,
                                  const FluxRes& new_flx ) -> FluxRes
      {
-         return acc_old+=new_flx;
-     }
-
-      par::accumulate_edge( parallel_schedule,
-                            flux,
-                            acc_left,
-                            acc_right,
-                            res,
-                            mesh.nodes,
-                            dq,
-                            q.interior );
-*/
-
-   // accumulate cell residual contributions from fluxes across i-normal faces
-# ifdef _OPENMP
-   # pragma omp parallel for
-# endif
-      for( size_t j=0; j<nj; ++j )
-     {
-         for( size_t i=0; i<ni-1; ++i )
-        {
-         // cell left/right indices
-            const CellIdx icl{i,  j};
-            const CellIdx icr{i+1,j};
-
-         // face node indices
-            const NodeIdx ip0{i+1,j  };
-            const NodeIdx ip1{i+1,j+1};
-
-            const FluxRes fr = hoflux( species,
-                                       surface( mesh.nodes(ip0),
-                                                mesh.nodes(ip1) ),
-                                       mesh.cells(icl), mesh.cells(icr),
-                                       q.interior(icl), q.interior(icr),
-                                             dxdx(icl),       dxdx(icr),
-                                             dqdx(icl),       dqdx(icr) );
-            res(icl)-=fr;
-            res(icr)+=fr;
-        }
-     }
-
-   // accumulate cell residual contributions from fluxes across j-normal faces
-# ifdef _OPENMP
-   # pragma omp parallel for
-# endif
-      for( size_t i=0; i<ni; ++i )
-     {
-         for( size_t j=0; j<nj-1; ++j )
-        {
-         // cell left/right indices
-            const CellIdx icl{i,j  };
-            const CellIdx icr{i,j+1};
-
-         // face node indices
-            const NodeIdx ip0{i+1,j+1};
-            const NodeIdx ip1{i  ,j+1};
-
-            const FluxRes fr = hoflux( species,
-                                       surface( mesh.nodes(ip0),
-                                                mesh.nodes(ip1) ),
-                                       mesh.cells(icl), mesh.cells(icr),
-                                       q.interior(icl), q.interior(icr),
-                                             dxdx(icl),       dxdx(icr),
-                                             dqdx(icl),       dqdx(icr) );
-            res(icl)-=fr;
-            res(icr)+=fr;
-        }
-     }
+         acc_old+=new_flx;
+         return acc_old;
+     };
 
+   // accumulate cell residual contributions from fluxes across i-normal and j-normal faces
+      par::neighbour_accumulation_idx( policy, scheme,
+                                       flux,
+                                       acc_left,
+                                       acc_right,
+                                       res,
+                                       mesh.cells,
+                                       q.interior,
+                                       dxdx,
+                                       dqdx );
       return;
   }
 
 /*
  * Accumulate cell residuals from fluxes over boundary cell faces
+ *    ghost cells must have been updated by boundaryUpdate
+ *    boundaries are accumulated one after another, because cells in the corners of the domain have faces on two boundaries
  */
    template<par::execution_policy  Policy,
             LawType                   Law,
             int                      nDim,
-            size_t                      N,
             ImplementedVarSet     SolVarT,
-            ImplementedVarDelta   SolDelT,
             typename              FluxRes,
             typename        HighOrderFlux,
             typename...     BoundaryConds,
@@ -271,24 +339,23 @@
       requires   ConsistentTypes<Law,
                                  nDim,
                                  Real,
-                                 SolVarT,
-                                 SolDelT>
+                                 SolVarT>
               && std::is_same_v<FluxRes,
                                 fluxresult_t<SolVarT>>
-              && N==nDim
    void boundaryResidual( const Policy                                      policy,
                           const HighOrderFlux&                              hoflux,
                           const std::tuple<BoundaryConds...>                   bcs,
                           const Species<Law,Real>&                         species,
                           const Mesh<nDim,Real>&                              mesh,
                           const SolutionField<SolVarT,nDim>&                     q,
-                          const par::DualArray<lsq::XMetric<nDim,Real>,nDim>& dxdx,
+                          const par::DualArray<lsq::XMetricFactor<nDim,Real>,nDim>& dxdx,
                           const par::DualArray<lsq::QMetric<SolVarT>,  nDim>& dqdx,
                                 par::DualArray<FluxRes,nDim>&                  res )
   {
    // check mesh sizes match
-      assert( mesh.cells.shape() == res.shape() );
-      assert( mesh.cells.shape() == dq.shape() );
+      assert( mesh.cells.shape() ==  res.shape() );
+      assert( mesh.cells.shape() == dxdx.shape() );
+      assert( mesh.cells.shape() == dqdx.shape() );
       assert( mesh.cells.shape() == q.interior.shape() );
 
    // if boundary condition type matches type of bc in tuple, calculate boundary residual
@@ -301,8 +368,54 @@
       for( unsigned int boundaryId=0; boundaryId<q.nBoundaries; ++boundaryId )
      {
          selectBoundaryCondition( q.bcTypes[boundaryId], bcs, call_bc_resid,
-                                  boundaryId, hoflux, species, mesh, q, dxdx, dqdx, res );
+                                  policy, boundaryId, hoflux, species, mesh, q, dxdx, dqdx, res );
      }
       return;
   }
 
+
+/*
+ * Accumulate cell residuals from fluxes over the faces of boundaries with a boundary flux function only
+ *    the faces of periodic and ghost cell boundaries are visited by the interior face sweep of fusedResidualCalc
+ */
+   template<par::execution_policy  Policy,
+            LawType                   Law,
+            int                      nDim,
+            ImplementedVarSet     SolVarT,
+            typename              FluxRes,
+            typename        HighOrderFlux,
+            typename...     BoundaryConds,
+            floating_point           Real>
+      requires   ConsistentTypes<Law,
+                                 nDim,
+                                 Real,
+                                 SolVarT>
+              && std::is_same_v<FluxRes,
+                                fluxresult_t<SolVarT>>
+   void boundaryFluxResidual( const Policy                                      policy,
+                              const HighOrderFlux&                              hoflux,
+                              const std::tuple<BoundaryConds...>                   bcs,
+                              const Species<Law,Real>&                         species,
+                              const Mesh<nDim,Real>&                              mesh,
+                              const SolutionField<SolVarT,nDim>&                     q,
+                              const par::DualArray<lsq::XMetricFactor<nDim,Real>,nDim>& dxdx,
+                              const par::DualArray<lsq::QMetric<SolVarT>,  nDim>& dqdx,
+                                    par::DualArray<FluxRes,nDim>&                  res )
+  {
+   // if boundary condition type matches type of bc in tuple and it has a boundary flux function, calculate boundary residual
+      const auto call_bc_resid = []( const auto& bc, auto&&... args )
+     {
+         if constexpr( has_boundary_flux_v<std::decay_t<decltype(bc)>> )
+        {
+            boundaryResidual( bc, std::forward<decltype(args)>(args)... );
+        }
+     };
+
+   // for each boundary, calculate the residual from the matching boundary condition in the bc tuple
+      for( unsigned int boundaryId=0; boundaryId<q.nBoundaries; ++boundaryId )
+     {
+         selectBoundaryCondition( q.bcTypes[boundaryId], bcs, call_bc_resid,
+                                  policy, boundaryId, hoflux, species, mesh, q, dxdx, dqdx, res );
+     }
+      return;
+  }
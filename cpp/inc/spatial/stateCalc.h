@@ -0,0 +1,134 @@
+
+# pragma once
+
+# include <conservationLaws/base/base.h>
+
+# include <solutionField/solutionField.h>
+
+# include <geometry/geometry.h>
+
+# include <lsq/lsq.h>
+
+# include <parallalg/algorithm.h>
+# include <parallalg/array.h>
+# include <parallalg/view.h>
+
+# include <type_traits>
+
+# include <cassert>
+
+/*
+ * Per-cell thermodynamic State cache
+ *    flux functions act on States, so without a cache each cell is converted from its VariableSet once for every face it shares
+ *    the cache is filled once per cell (ghost cells included) at the start of each residual evaluation, and is read by flux functions
+ *    which evaluate the flux from the cell values themselves, i.e. first order fluxes. Reconstructed fluxes build their own States
+ */
+
+/*
+ * tag for residual evaluations without a State cache
+ */
+   struct NoStateCache {};
+
+/*
+ * true if the high order flux function accepts the cached States of the left and right cells after its usual arguments
+ */
+   template<typename   HighOrderFlux,
+            typename       SolVarSet,
+            int                 nDim,
+            floating_point      Real>
+   inline constexpr bool reads_state_cache_v = std::is_invocable_v<const HighOrderFlux&,
+                                                                    const Species<law_of_v<SolVarSet>,Real>&,
+                                                                    const geom::Surface<nDim,Real>&,
+                                                                    const geom::Volume<nDim,Real>&,
+                                                                    const geom::Volume<nDim,Real>&,
+                                                                    const SolVarSet&,
+                                                                    const SolVarSet&,
+                                                                    const lsq::XMetricFactor<nDim,Real>&,
+                                                                    const lsq::XMetricFactor<nDim,Real>&,
+                                                                    const lsq::QMetric<SolVarSet>&,
+                                                                    const lsq::QMetric<SolVarSet>&,
+                                                                    const state_t<SolVarSet>&,
+                                                                    const state_t<SolVarSet>&>;
+
+/*
+ * State cache for a solution field with the given shape, with the same halo as the solution so ghost cells are cached too
+ *    returns NoStateCache if Cache is false
+ */
+   template<bool                    Cache,
+            ImplementedVarSet   SolVarSet,
+            par::execution_policy  Policy,
+            int                      nDim>
+   auto makeStateCache( const Policy                     policy,
+                        const par::DualShape<nDim>&       shape )
+  {
+      if constexpr( Cache )
+     {
+         return par::DualArray<state_t<SolVarSet>,nDim>( policy,
+                                                         shape,
+                                                         par::halo_layout( SolutionField<SolVarSet,nDim>::haloWidth ) );
+     }
+      else
+     {
+         return NoStateCache{};
+     }
+  }
+
+   template<bool                    Cache,
+            par::execution_policy  Policy,
+            ImplementedVarSet   SolVarSet,
+            int                      nDim>
+   auto makeStateCache( const Policy                          policy,
+                        const SolutionField<SolVarSet,nDim>&       q )
+  {
+      return makeStateCache<Cache,SolVarSet>( policy, q.interior.shape() );
+  }
+
+/*
+ * Fill the State cache from every cell of the solution field, including the ghost cells
+ *    ghost cells must have been updated by boundaryUpdate
+ *    the corners of the halo are not ghost cells of any face, so are never written by boundaryUpdate and are skipped
+ */
+   template<par::execution_policy  Policy,
+            LawType                   Law,
+            int                      nDim,
+            ImplementedVarSet     SolVarT,
+            floating_point           Real>
+      requires ConsistentTypes<Law,nDim,Real,SolVarT>
+   void stateCalc( const Policy                                    policy,
+                   const Species<Law,Real>&                       species,
+                   const SolutionField<SolVarT,nDim>&                   q,
+                         par::DualArray<state_t<SolVarT>,nDim>&    states )
+  {
+      assert( states.shape() == q.interior.shape() );
+      assert( states.halo()  == q.interior.halo()  );
+
+      const auto toState = [&species]( const SolVarT& qc ){ return set2State( species, qc ); };
+
+   // interior cells
+      par::transform( policy, toState, states, q.interior );
+
+   // ghost cells beyond each boundary
+      for( unsigned int bID=0; bID<q.nBoundaries; bID++ )
+     {
+         auto dst = par::halo_layer( states, bID/2, bID%2 );
+
+         par::transform( policy, toState, dst, q.ghost( bID ) );
+     }
+      return;
+  }
+
+/*
+ * nothing to fill without a State cache
+ */
+   template<par::execution_policy  Policy,
+            LawType                   Law,
+            int                      nDim,
+            ImplementedVarSet     SolVarT,
+            floating_point           Real>
+   void stateCalc( const Policy,
+                   const Species<Law,Real>&,
+                   const SolutionField<SolVarT,nDim>&,
+                         NoStateCache& )
+  {
+      return;
+  }
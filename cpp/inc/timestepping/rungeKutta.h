@@ -1,10 +1,14 @@
-
 # pragma once
 
+# include <timestepping/solverWorkspace.h>
+
 # include <spatial/boundary/boundaryUpdate.h>
 # include <spatial/gradientCalc.h>
+# include <spatial/lsqMetrics.h>
 # include <spatial/residualCalc.h>
+# include <spatial/fusedResidualCalc.h>
 # include <spatial/spectralRadius.h>
+# include <spatial/stateCalc.h>
 # include <spatial/eulerForwardUpdate.h>
 
 # include <conservationLaws/base/base.h>
@@ -27,172 +31,489 @@
 # include <tuple>
 # include <array>
 # include <vector>
+# include <limits>
+# include <algorithm>
+# include <type_traits>
 # include <cassert>
 
 # include <unistd.h>
 
 /*
- * integrates dq/dt = rhs forward in time using an explicit runge kutta scheme
+ * One runge-kutta stage in a single sweep: for each cell, accumulate the stage residuals, integrate forward by dt from q0 and average over
+ * the cell volume into q1
+ *    the update is made in conserved variables, like eulerForwardUpdateGlobal
+ *    the last stage also returns the maximum spectral radius of its residual, from which the next timestep can be set, in the same sweep.
+ *    Earlier stages skip the reduction and return zero
  */
-   template<par::execution_policy   Policy,
-            LawType                    Law,
-            int                       nDim,
-            floating_point            Real,
-            ImplementedVarSet    SolVarSet,
-            typename       SecondOrderFlux,
-            typename...      BoundaryConds>
-   void integrate( const Policy                                policy,
-                   const UnsteadyTimeControls<Real>&     timeControls,
-                   const ODE::Explicit::RungeKutta<Real>&  rungeKutta,
-                   const SecondOrderFlux&                       flux2,
-                   const std::tuple<BoundaryConds...>   boundaryConds,
-                   const Species<Law,Real>&                   species,
-                   const Mesh<nDim,Real>&                        mesh,
-                         SolutionField<SolVarSet,nDim>&            q0 )
+   template<par::execution_policy Policy,
+            LawType                  Law,
+            int                     nDim,
+            ImplementedVarSet    SolVarT,
+            floating_point          Real>
+      requires ConsistentTypes<Law,nDim,Real,SolVarT>
+   Real rungeKuttaStageUpdate( const Policy                                                    policy,
+                               const par::DualArray<geom::Volume<nDim,Real>,nDim>&              cells,
+                               const Species<Law,Real>&                                       species,
+                               const ODE::Explicit::RungeKutta<Real>&                      rungeKutta,
+                               const size_t                                                       stg,
+                               const Real                                                          dt,
+                               const std::vector<par::DualArray<FluxResult<Law,nDim,Real>,nDim>>& resStage,
+                               const par::DualArray<SolVarT,nDim>&                                 q0,
+                                     par::DualArray<SolVarT,nDim>&                                 q1 )
   {
-   // check sizes match
-      assert( q0.interior.shape() == mesh.cells.shape() );
+   // conserved variables needed for correct shock speeds
+      constexpr BasisType<Law> ConservedBasis = BasisType<Law>::Conserved;
+      using ConsVarT = VariableSet<Law,nDim,ConservedBasis,Real>;
+      using FluxRes  = FluxResult<Law,nDim,Real>;
+
+   // check mesh sizes match
+      assert( stg < resStage.size() );
+      assert( cells.shape() == q1.shape() );
+      assert( cells.shape() == q0.shape() );
+      assert( cells.shape() == resStage[stg].shape() );
+
+      const Real betadt = rungeKutta.beta[stg]*dt;
+
+   // new = old + beta*dt*sum( alpha*residual )/vol
+      // solv -> (consv + increment) -> solv
+      const auto update = [&]( const par::DualIdx<nDim>&     idx,
+                                     SolVarT&                 v1,
+                               const SolVarT&                 v0,
+                               const geom::Volume<nDim,Real>& cell )
+     {
+         FluxRes frtotal{};
+         for( unsigned int k=0; k<=stg; k++ )
+        {
+            frtotal.flux+=rungeKutta.alpha[stg][k]*resStage[k](idx).flux;
+        }
 
-   // spare solution arrays for rk/timestepping iterations
-      // q0 is solution at beginning of current timestep
-      // q1 is solution at beginning of current rk stage
-      // q2 is working array to save update into at end of rk stage
-      SolutionField<SolVarSet,nDim> q1 = copy(q0);
-      SolutionField<SolVarSet,nDim> q2 = copy(q0);
+         v1 = set2Set<SolVarT>( species, set2Set<ConsVarT>( species, v0 ) + frtotal.flux*(betadt/cell.volume) );
+     };
 
-   // residual arrays
-      using FluxRes = FluxResult<Law,nDim,Real>;
-      using ResidualArray = par::DualArray<FluxRes,nDim>;
+      if( stg+1 < rungeKutta.nstages )
+     {
+         par::for_each_idx( policy,
+                            [&]( const par::DualIdx<nDim>& idx, const geom::Volume<nDim,Real>& cell )
+                           { update( idx, q1(idx), q0(idx), cell ); },
+                            cells );
+         return 0;
+     }
 
-      ResidualArray resTotal(q0.interior.shape());
-      std::vector<ResidualArray> resStage = par::vec_of_Arrays<FluxRes,nDim>(rungeKutta.nstages,q0.interior.shape());
+      return par::for_each_idx_reduce( policy,
+                                       [&]( const par::DualIdx<nDim>&     idx,
+                                                  SolVarT&                 v1,
+                                            const SolVarT&                 v0,
+                                            const geom::Volume<nDim,Real>& cell ) -> Real
+                                      {
+                                          update( idx, v1, v0, cell );
+                                          return resStage[stg](idx).lambda / cell.volume;
+                                      },
+                                       []( const Real l, const Real r ) -> Real
+                                      { return std::max( l,r ); },
+                                       std::numeric_limits<Real>::min(),
+                                       q1,
+                                       q0, cells );
+  }
 
-   // least squares gradient arrays
-      using XMetric = lsq::XMetric<nDim,Real>;
-      using QMetric = lsq::QMetric<SolVarSet>;
+/*
+ * One low-storage runge-kutta stage in a single sweep: for each cell, integrate the increment forward by dt from q0, relax towards the
+ * solution at the beginning of the timestep qn, and average over the cell volume into q1
+ *    q1 = (1-gamma)*q0 + gamma*qn + b*dt*increment/vol, combined in conserved variables
+ *    qn is only read if gamma is not zero, and q0 and q1 may be the same array, since each cell only reads its own old value
+ *    the last stage also returns the maximum spectral radius of its residual, as rungeKuttaStageUpdate. The increment holds the spectral
+ *    radius of the current stage only (see fusedResidualCalc)
+ */
+   template<par::execution_policy Policy,
+            LawType                  Law,
+            int                     nDim,
+            ImplementedVarSet    SolVarT,
+            floating_point          Real>
+      requires ConsistentTypes<Law,nDim,Real,SolVarT>
+   Real lowStorageStageUpdate( const Policy                                            policy,
+                               const par::DualArray<geom::Volume<nDim,Real>,nDim>&      cells,
+                               const Species<Law,Real>&                               species,
+                               const ODE::Explicit::LowStorage::RungeKutta<Real>& rungeKutta,
+                               const size_t                                               stg,
+                               const Real                                                  dt,
+                               const par::DualArray<FluxResult<Law,nDim,Real>,nDim>& increment,
+                               const par::DualArray<SolVarT,nDim>&                         qn,
+                               const par::DualArray<SolVarT,nDim>&                         q0,
+                                     par::DualArray<SolVarT,nDim>&                         q1 )
+  {
+   // conserved variables/deltas needed for correct shock speeds
+      constexpr BasisType<Law> ConservedBasis = BasisType<Law>::Conserved;
+      using ConsVarT = VariableSet<  Law,nDim,ConservedBasis,Real>;
+      using ConsDelT = VariableDelta<Law,nDim,ConservedBasis,Real>;
+
+      const Real gamma = rungeKutta.gamma[stg];
+      const Real   bdt = rungeKutta.b[stg]*dt;
+
+   // check mesh sizes match
+      assert( stg < rungeKutta.nstages );
+      assert( cells.shape() == q1.shape() );
+      assert( cells.shape() == q0.shape() );
+      assert( cells.shape() == increment.shape() );
+      assert( gamma==0 || cells.shape() == qn.shape() );
+
+   // new = old + gamma*(initial-old) + b*dt*increment/vol
+      // solv -> (consv + increments) -> solv
+      const auto update = [&]( const par::DualIdx<nDim>&     idx,
+                                     SolVarT&                 v1,
+                               const SolVarT&                 v0,
+                               const geom::Volume<nDim,Real>& cell )
+     {
+         const ConsVarT vc0 = set2Set<ConsVarT>( species, v0 );
+         const ConsDelT dvc = increment(idx).flux*(bdt/cell.volume);
+         if( gamma==0 )
+        {
+            v1 = set2Set<SolVarT>( species, vc0 + dvc );
+            return;
+        }
+         const ConsDelT dvn = set2Set<ConsVarT>( species, qn(idx) ) - vc0;
+         v1 = set2Set<SolVarT>( species, vc0 + gamma*dvn + dvc );
+     };
 
-      using XMetArray = par::DualArray<XMetric,nDim>;
-      using QMetArray = par::DualArray<QMetric,nDim>;
+      if( stg+1 < rungeKutta.nstages )
+     {
+         par::for_each_idx( policy,
+                            [&]( const par::DualIdx<nDim>& idx, const geom::Volume<nDim,Real>& cell )
+                           { update( idx, q1(idx), q0(idx), cell ); },
+                            cells );
+         return 0;
+     }
 
-   // calculate spatial metrics for least squares
-      const XMetric dxdx = xmetrics( policy, mesh.cells );
-      QMetric dqdx(mesh.cells.shape());
+      return par::for_each_idx_reduce( policy,
+                                       [&]( const par::DualIdx<nDim>&     idx,
+                                                  SolVarT&                 v1,
+                                            const SolVarT&                 v0,
+                                            const geom::Volume<nDim,Real>& cell ) -> Real
+                                      {
+                                          update( idx, v1, v0, cell );
+                                          return increment(idx).lambda / cell.volume;
+                                      },
+                                       []( const Real l, const Real r ) -> Real
+                                      { return std::max( l,r ); },
+                                       std::numeric_limits<Real>::min(),
+                                       q1,
+                                       q0, cells );
+  }
+
+/*
+ * advances a solution field forward in time with an explicit runge kutta scheme (classical or low-storage), any number of timesteps at a time
+ *    owns the SolverWorkspace and the current timestep, so integration can be continued with further calls to step (e.g. between
+ *    output dumps) without allocating or recomputing anything, and with the same result as a single call
+ *    the species, mesh and solution field are held by reference, and must outlive the stepper
+ *    the workspace and residual evaluation are shared with SteadyStateStepper, which derives from it
+ *
+ *    the timestep is set from the spectral radius of the first stage residual of the first timestep, and after that from the spectral
+ *    radius of the last stage residual of the previous timestep, which is reduced in the same sweep as the last stage update
+ */
+   template<par::execution_policy   Policy,
+            typename           RungeKuttaT,
+            typename       SecondOrderFlux,
+            typename        BoundaryCondsT,
+            ImplementedVarSet    SolVarSet>
+   class RungeKuttaStepper
+  {
+   protected:
+
+      constexpr static LawType Law = law_of_v<SolVarSet>;
+      constexpr static int    nDim = dim_of_v<SolVarSet>;
+
+      using Real = fptype_of_t<SolVarSet>;
+
+      constexpr static bool lowStorage = std::is_same_v<RungeKuttaT,ODE::Explicit::LowStorage::RungeKutta<Real>>;
+      constexpr static bool cacheStates = reads_state_cache_v<SecondOrderFlux,SolVarSet,nDim,Real>;
+
+      using Workspace = SolverWorkspace<SolVarSet,cacheStates>;
 
-   // timers
       using FunctionTimer = utils::StopWatchTimer<std::chrono::steady_clock,
                                                   std::chrono::nanoseconds,
                                                   std::chrono::milliseconds>;
 
-      FunctionTimer bcupdate_timer( "bcupdate loop time: " );
-      FunctionTimer gradient_timer( "gradient loop time: " );
-      FunctionTimer residual_timer( "residual loop time: " );
-      FunctionTimer specrads_timer( "specrads loop time: " );
-      FunctionTimer rkaccums_timer( "rkaccums loop time: " );
-      FunctionTimer eulerfwd_timer( "eulerfwd loop time: " );
-      FunctionTimer copyswap_timer( "copyswap func time: " );
+      const Policy                      policy;
+      const Real                           cfl;
+      const RungeKuttaT             rungeKutta;
+      const SecondOrderFlux              flux2;
+      const BoundaryCondsT       boundaryConds;
+      const Species<Law,Real>&         species;
+      const Mesh<nDim,Real>&              mesh;
+            SolutionField<SolVarSet,nDim>&   q;
 
-      utils::LifetimeTimer timer( "main loop time: " );
+            Workspace workspace;
+
+   // number of timesteps taken, physical time elapsed, and timestep for the next timestep
+      size_t nsteps;
+      Real        t;
+      Real       dt;
 
-      Real t=0;
-      for( size_t tstep=0; tstep<timeControls.nTimesteps; tstep++ )
+   // timers
+      FunctionTimer bcupdate_timer;
+      FunctionTimer statecal_timer;
+      FunctionTimer residual_timer;
+      FunctionTimer specrads_timer;
+      FunctionTimer stageupd_timer;
+      FunctionTimer copyswap_timer;
+
+   public:
+
+      RungeKuttaStepper( const Policy                          policy0,
+                         const Real                               cfl0,
+                         const RungeKuttaT&                rungeKutta0,
+                         const SecondOrderFlux&                 flux20,
+                         const BoundaryCondsT&          boundaryConds0,
+                         const Species<Law,Real>&             species0,
+                         const Mesh<nDim,Real>&                  mesh0,
+                               SolutionField<SolVarSet,nDim>&       q0 )
+                         : policy(policy0),
+                           cfl(cfl0),
+                           rungeKutta(rungeKutta0),
+                           flux2(flux20),
+                           boundaryConds(boundaryConds0),
+                           species(species0),
+                           mesh(mesh0),
+                           q(q0),
+                           workspace(makeSolverWorkspace( policy0, rungeKutta0, flux20, mesh0, q0 )),
+                           nsteps(0),
+                           t(0),
+                           dt(0),
+                           bcupdate_timer( "bcupdate loop time: " ),
+                           statecal_timer( "statecal loop time: " ),
+                           residual_timer( "residual loop time: " ),
+                           specrads_timer( "specrads loop time: " ),
+                           stageupd_timer( "stageupd loop time: " ),
+                           copyswap_timer( "copyswap func time: " ) {}
+
+   // advance the solution field by n timesteps
+      void step( const size_t n )
      {
-         Real dt{};
-         for( unsigned int stg=0; stg<rungeKutta.nstages; stg++ )
+         for( size_t i=0; i<n; i++ )
         {
-         // update boundary conditions
-            bcupdate_timer.start();
-            boundaryUpdate( mesh,
+            if constexpr( lowStorage ){ lowStorageTimestep(); }
+            else                      {  classicalTimestep(); }
+            nsteps++;
+        }
+     }
+
+   // number of timesteps taken so far
+      size_t timesteps() const { return nsteps; }
+
+   // physical time elapsed so far
+      Real time() const { return t; }
+
+   protected:
+
+   // residual of the current solution field, with the boundary conditions and the State cache updated first
+      // res is scaled by resScale and the residual added into it (see fusedResidualCalc), so 0 overwrites res with the residual
+      void residual( typename Workspace::ResidualArray& res, const Real resScale=0 )
+     {
+      // update boundary conditions
+         bcupdate_timer.start();
+         boundaryUpdate( policy,
+                         mesh,
+                         boundaryConds,
+                         species,
+                         q );
+         bcupdate_timer.pause();
+
+      // convert each cell to a State once for all of its faces
+         statecal_timer.start();
+         stateCalc( policy,
+                    species,
+                    q,
+                    workspace.states );
+         statecal_timer.pause();
+
+      // accumulate solution metrics and flux residual in a single sweep
+         residual_timer.start();
+         fusedResidualCalc( policy,
+                            flux2,
                             boundaryConds,
                             species,
-                            q1 );
-            bcupdate_timer.pause();
-
-         // calculate differences
-            gradient_timer.start();
-            qmetrics( policy,
-                      mesh.cells,
-                      q1.interior,
-                      dqdx );
-            gradient_timer.pause();
-
-         // accumulate flux residual
-            residual_timer.start();
-            residualCalc( policy,
-                          flux2,
-                          boundaryConds,
-                          species,
-                          mesh,
-                          q1,
-                          dxdx,
-                          dqdx,
-                          resStage[stg] );
-            residual_timer.pause();
-
-         // calculate maximum stable timestep for this timestep
+                            mesh,
+                            q,
+                            workspace.states,
+                            workspace.dxdx,
+                            workspace.dqdx,
+                            res,
+                            resScale );
+         residual_timer.pause();
+     }
+
+   private:
+
+   // one timestep of a classical scheme
+      // the first stage updates out of place from q into qn, and the two then swap arrays, so qn holds the solution at the beginning
+      // of the timestep. Every later stage update only reads qn and the stage residuals, so it is made in place
+      void classicalTimestep()
+     {
+         auto& qn       = workspace.qn;
+         auto& resStage = workspace.residuals;
+
+         Real specrad{};
+         for( unsigned int stg=0; stg<rungeKutta.nstages; stg++ )
+        {
+            residual( resStage[stg] );
+
+         // calculate maximum stable timestep for the first timestep, later timesteps reuse the reduction from the stage update
             specrads_timer.start();
-            if( stg==0 ){ dt = timeControls.cfl/spectralRadius( policy, mesh.cells, resStage[stg] ); }
+            if( nsteps==0 && stg==0 ){ dt = cfl/spectralRadius( policy, mesh.cells, resStage[stg] ); }
             specrads_timer.pause();
 
-         // accumulate stage residual
-            rkaccums_timer.start();
-            rungeKuttaAccumulation( policy,
-                                    rungeKutta,
-                                    stg,
-                                    resStage,
-                                    resTotal );
-            rkaccums_timer.pause();
-
-         // integrate cell residuals forward by dt and average over cell volume
-            eulerfwd_timer.start();
-            eulerForwardUpdateGlobal( policy,
-                                      mesh.cells,
-                                      species,
-                                      rungeKutta.beta[stg]*dt,
-                                      resTotal,
-                                      q0.interior,
-                                      q2.interior );
-            eulerfwd_timer.pause();
-
-            copyswap_timer.start();
-            std::swap( q1,q2 );
-            copyswap_timer.pause();
+         // accumulate stage residuals and integrate forward by dt in a single sweep, reducing the spectral radius on the last stage
+            stageupd_timer.start();
+            if( stg==0 )
+           {
+               specrad = rungeKuttaStageUpdate( policy, mesh.cells, species, rungeKutta, stg, dt, resStage, q.interior, qn );
+           }
+            else
+           {
+               specrad = rungeKuttaStageUpdate( policy, mesh.cells, species, rungeKutta, stg, dt, resStage, qn, q.interior );
+           }
+            stageupd_timer.pause();
+
+            if( stg==0 )
+           {
+               copyswap_timer.start();
+               std::swap( q.interior,qn );
+               copyswap_timer.pause();
+           }
         }
-         copyswap_timer.start();
-         copy( policy, q0, q1 );
-         copyswap_timer.pause();
          t+=dt;
+         dt = cfl/specrad;
      }
-//    std::cout << "physical time elapsed: " << t << "\n";
-      std::cout << "\n";
+
+   // one timestep of a low-storage scheme, the solution is updated in place at each stage
+      // the stage residual is accumulated straight into the increment register, dU := a*dU + R(U), which for 2S* schemes (a=0) is just
+      // the stage residual, so one residual register is needed whatever the scheme
+      // if the scheme uses the solution at the beginning of the timestep, the first stage (euler forward whatever gamma) updates out of
+      // place from q into qn, and the two then swap arrays
+      void lowStorageTimestep()
+     {
+         const bool keepInitial = ODE::Explicit::LowStorage::usesInitial( rungeKutta );
+
+         auto& qn        = workspace.qn;
+         auto& increment = workspace.residuals[0];
+
+         Real specrad{};
+         for( unsigned int stg=0; stg<rungeKutta.nstages; stg++ )
+        {
+            residual( increment, rungeKutta.a[stg] );
+
+         // calculate maximum stable timestep for the first timestep, later timesteps reuse the reduction from the stage update
+            specrads_timer.start();
+            if( nsteps==0 && stg==0 ){ dt = cfl/spectralRadius( policy, mesh.cells, increment ); }
+            specrads_timer.pause();
+
+         // relax towards qn and integrate the increment forward by dt in a single sweep, reducing the spectral radius on the last stage
+            stageupd_timer.start();
+            if( stg==0 && keepInitial )
+           {
+               specrad = lowStorageStageUpdate( policy, mesh.cells, species, rungeKutta, stg, dt, increment, qn, q.interior, qn );
+           }
+            else
+           {
+               specrad = lowStorageStageUpdate( policy, mesh.cells, species, rungeKutta, stg, dt, increment, qn, q.interior, q.interior );
+           }
+            stageupd_timer.pause();
+
+            if( stg==0 && keepInitial )
+           {
+               copyswap_timer.start();
+               std::swap( q.interior,qn );
+               copyswap_timer.pause();
+           }
+        }
+         t+=dt;
+         dt = cfl/specrad;
+     }
+  };
+
+/*
+ * stepper for integrating q on mesh with the given scheme, see RungeKuttaStepper
+ */
+   template<par::execution_policy   Policy,
+            typename           RungeKuttaT,
+            typename       SecondOrderFlux,
+            typename...      BoundaryConds,
+            LawType                    Law,
+            int                       nDim,
+            floating_point            Real,
+            ImplementedVarSet    SolVarSet>
+   auto makeRungeKuttaStepper( const Policy                              policy,
+                               const Real                                   cfl,
+                               const RungeKuttaT&                    rungeKutta,
+                               const SecondOrderFlux&                     flux2,
+                               const std::tuple<BoundaryConds...> boundaryConds,
+                               const Species<Law,Real>&                 species,
+                               const Mesh<nDim,Real>&                      mesh,
+                                     SolutionField<SolVarSet,nDim>&           q )
+  {
+      return RungeKuttaStepper<Policy,
+                               RungeKuttaT,
+                               SecondOrderFlux,
+                               std::tuple<BoundaryConds...>,
+                               SolVarSet>( policy, cfl, rungeKutta, flux2, boundaryConds, species, mesh, q );
   }
 
 /*
- * Accumulate the total residual for the current runge-kutta stage from the vector of stage residuals
+ * integrates dq/dt = rhs forward in time using an explicit runge kutta scheme
+ *    see RungeKuttaStepper for how the timestep is set. To integrate in several chunks, e.g. between output dumps, use a stepper directly
  */
-   template<par::execution_policy Policy,
-            int                     nDim,
-            typename             FluxRes,
-            floating_point          Real>
-   void rungeKuttaAccumulation( const Policy                                       policy,
-                                const ODE::Explicit::RungeKutta<Real>&         rungeKutta,
-                                const size_t                                          stg,
-                                const std::vector<par::DualArray<FluxRes,nDim>>& resStage,
-                                      par::DualArray<FluxRes,nDim>&              resTotal )
+   template<par::execution_policy   Policy,
+            LawType                    Law,
+            int                       nDim,
+            floating_point            Real,
+            ImplementedVarSet    SolVarSet,
+            typename       SecondOrderFlux,
+            typename...      BoundaryConds>
+   void integrate( const Policy                                policy,
+                   const UnsteadyTimeControls<Real>&     timeControls,
+                   const ODE::Explicit::RungeKutta<Real>&  rungeKutta,
+                   const SecondOrderFlux&                       flux2,
+                   const std::tuple<BoundaryConds...>   boundaryConds,
+                   const Species<Law,Real>&                   species,
+                   const Mesh<nDim,Real>&                        mesh,
+                         SolutionField<SolVarSet,nDim>&             q )
   {
-   // runge kutta residual accumulation for each cell
-      auto rkacc = [&]( const par::DualIdx<nDim>&  idx,
-                              FluxRes&         frtotal ) -> void
-     {
-         for( unsigned int k=0; k<=stg; k++ )
-        {
-            frtotal.flux+=rungeKutta.alpha[stg][k]*resStage[k](idx).flux;
-        }
-         return;
-     };
+      auto stepper = makeRungeKuttaStepper( policy, timeControls.cfl, rungeKutta, flux2, boundaryConds, species, mesh, q );
+
+      utils::LifetimeTimer timer( "main loop time: " );
 
-      par::fill( policy, resTotal, {} );
-      par::for_each_idx( policy, rkacc, resTotal );
+      stepper.step( timeControls.nTimesteps );
 
-      return;
+      std::cout << "physical time elapsed: " << stepper.time() << "\n";
+      std::cout << "\n";
   }
 
+/*
+ * integrates dq/dt = rhs forward in time using a low-storage explicit runge kutta scheme
+ *    the solution is updated in place at each stage, so the storage is the same for any number of stages:
+ *    one residual register, which also holds the increment of 2N schemes, plus the solution at the start of the timestep only if the
+ *    scheme uses it
+ */
+   template<par::execution_policy   Policy,
+            LawType                    Law,
+            int                       nDim,
+            floating_point            Real,
+            ImplementedVarSet    SolVarSet,
+            typename       SecondOrderFlux,
+            typename...      BoundaryConds>
+   void integrate( const Policy                                            policy,
+                   const UnsteadyTimeControls<Real>&                 timeControls,
+                   const ODE::Explicit::LowStorage::RungeKutta<Real>&  rungeKutta,
+                   const SecondOrderFlux&                                   flux2,
+                   const std::tuple<BoundaryConds...>               boundaryConds,
+                   const Species<Law,Real>&                               species,
+                   const Mesh<nDim,Real>&                                    mesh,
+                         SolutionField<SolVarSet,nDim>&                         q )
+  {
+      auto stepper = makeRungeKuttaStepper( policy, timeControls.cfl, rungeKutta, flux2, boundaryConds, species, mesh, q );
+
+      utils::LifetimeTimer timer( "main loop time: " );
+
+      stepper.step( timeControls.nTimesteps );
+
+      std::cout << "physical time elapsed: " << stepper.time() << "\n";
+      std::cout << "\n";
+  }
@@ -0,0 +1,134 @@
+
+# pragma once
+
+# include <spatial/lsqMetrics.h>
+# include <spatial/stateCalc.h>
+
+# include <conservationLaws/base/base.h>
+# include <solutionField/solutionField.h>
+
+# include <lsq/lsq.h>
+
+# include <mesh/mesh.h>
+
+# include <ode.h>
+
+# include <parallalg/array.h>
+# include <parallalg/parallalg.h>
+
+# include <type_traits>
+# include <vector>
+
+# include <cassert>
+
+/*
+ * scratch arrays and static metrics for integrating a solution field on one mesh
+ *    the least squares metric factors only depend on the mesh, so they are computed once at construction. The scratch arrays are
+ *    allocated once and reused by every timestep, so integration can be stopped and restarted (e.g. between output dumps) for free
+ *    all arrays are initialised according to policy, so they are first touched by the threads which will use them
+ *    CacheStates is true if the flux function reads per-cell States (see reads_state_cache_v)
+ */
+   template<ImplementedVarSet SolVarSet,
+            bool            CacheStates>
+   struct SolverWorkspace
+  {
+      constexpr static LawType Law = law_of_v<SolVarSet>;
+      constexpr static int    nDim = dim_of_v<SolVarSet>;
+
+      using Real = fptype_of_t<SolVarSet>;
+
+      using FluxRes = FluxResult<Law,nDim,Real>;
+      using XFactor = lsq::XMetricFactor<nDim,Real>;
+      using QMetric = lsq::QMetric<SolVarSet>;
+
+      using SolutionArray = par::DualArray<SolVarSet,nDim>;
+      using ResidualArray = par::DualArray<FluxRes,  nDim>;
+      using XFacArray     = par::DualArray<XFactor,  nDim>;
+      using QMetArray     = par::DualArray<QMetric,  nDim>;
+
+      using StateCache = std::conditional_t<CacheStates,
+                                            par::DualArray<state_t<SolVarSet>,nDim>,
+                                            NoStateCache>;
+
+   // solution at the beginning of the current timestep, empty if the scheme does not need it
+      // it has the same halo as SolutionField::interior, so the two can swap arrays instead of being copied
+      SolutionArray qn;
+
+   // residual registers, e.g. one for each runge-kutta stage
+      std::vector<ResidualArray> residuals;
+
+   // per-cell States, cached once per stage (see stateCalc)
+      StateCache states;
+
+   // factored least squares spatial metrics
+      XFacArray dxdx;
+
+   // least squares solution metrics
+      QMetArray dqdx;
+
+   // par::Array only supports move construction, so same must be for SolverWorkspace
+      SolverWorkspace() = delete;
+      SolverWorkspace( const SolverWorkspace&  ) = delete;
+      SolverWorkspace(       SolverWorkspace&& ) = default;
+
+   // par::Array only supports move assignment, so same must be for SolverWorkspace
+      SolverWorkspace& operator=( const SolverWorkspace&  ) = delete;
+      SolverWorkspace& operator=(       SolverWorkspace&& ) = default;
+
+   // allocate nresiduals residual registers and, if keepInitial, the initial solution
+      template<par::execution_policy Policy>
+      SolverWorkspace( const Policy                 policy,
+                       const Mesh<nDim,Real>&         mesh,
+                       const size_t             nresiduals,
+                       const bool              keepInitial )
+                       : qn(policy,
+                            keepInitial ? mesh.cells.shape() : par::DualShape<nDim>{},
+                            par::halo_layout( SolutionField<SolVarSet,nDim>::haloWidth )),
+                         residuals(par::vec_of_Arrays<FluxRes,nDim>(policy,nresiduals,mesh.cells.shape())),
+                         states(makeStateCache<CacheStates,SolVarSet>(policy,mesh.cells.shape())),
+                         dxdx(xmetric_factors(policy,mesh.cells)),
+                         dqdx(policy,mesh.cells.shape()) {}
+  };
+
+/*
+ * workspace for an explicit runge kutta scheme: one residual for each stage, and the solution at the beginning of the timestep
+ */
+   template<par::execution_policy   Policy,
+            typename       SecondOrderFlux,
+            int                       nDim,
+            floating_point            Real,
+            ImplementedVarSet    SolVarSet>
+   auto makeSolverWorkspace( const Policy                                policy,
+                             const ODE::Explicit::RungeKutta<Real>&  rungeKutta,
+                             const SecondOrderFlux&,
+                             const Mesh<nDim,Real>&                        mesh,
+                             const SolutionField<SolVarSet,nDim>&             q )
+  {
+      assert( q.interior.shape() == mesh.cells.shape() );
+
+      constexpr bool cacheStates = reads_state_cache_v<SecondOrderFlux,SolVarSet,nDim,Real>;
+
+      return SolverWorkspace<SolVarSet,cacheStates>( policy, mesh, rungeKutta.nstages, true );
+  }
+
+/*
+ * workspace for a low-storage explicit runge kutta scheme: one residual register, into which each stage residual is accumulated as the
+ * increment, and the solution at the beginning of the timestep only if the scheme uses it
+ */
+   template<par::execution_policy   Policy,
+            typename       SecondOrderFlux,
+            int                       nDim,
+            floating_point            Real,
+            ImplementedVarSet    SolVarSet>
+   auto makeSolverWorkspace( const Policy                                            policy,
+                             const ODE::Explicit::LowStorage::RungeKutta<Real>&  rungeKutta,
+                             const SecondOrderFlux&,
+                             const Mesh<nDim,Real>&                                    mesh,
+                             const SolutionField<SolVarSet,nDim>&                         q )
+  {
+      assert( q.interior.shape() == mesh.cells.shape() );
+
+      constexpr bool cacheStates = reads_state_cache_v<SecondOrderFlux,SolVarSet,nDim,Real>;
+
+      return SolverWorkspace<SolVarSet,cacheStates>( policy, mesh, 1, ODE::Explicit::LowStorage::usesInitial( rungeKutta ) );
+  }
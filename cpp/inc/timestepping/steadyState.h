@@ -0,0 +1,302 @@
+# pragma once
+
+# include <timestepping/rungeKutta.h>
+
+# include <conservationLaws/base/base.h>
+# include <solutionField/solutionField.h>
+
+# include <mesh/mesh.h>
+
+# include <controls.h>
+
+# include <ode.h>
+
+# include <parallalg/algorithm.h>
+# include <parallalg/array.h>
+# include <parallalg/parallalg.h>
+
+# include <utils/timing.h>
+
+# include <tuple>
+# include <vector>
+# include <cmath>
+# include <cassert>
+
+/*
+ * One runge-kutta stage with local timestepping in a single sweep: for each cell, accumulate the stage residuals, integrate forward by
+ * the cell's own timestep dt = cfl*vol/lambda from q0 and average over the cell volume into q1
+ *    lambda is the spectral radius accumulated in the first stage residual, so each cell keeps the same timestep for every stage
+ *    with a single stage scheme this is the same update as eulerForwardUpdateLocal
+ *    the first stage also returns the sum over cells of its squared residual per unit volume (see residualNorm), in the same sweep.
+ *    Later stages skip the reduction and return zero
+ */
+   template<par::execution_policy Policy,
+            LawType                  Law,
+            int                     nDim,
+            ImplementedVarSet    SolVarT,
+            floating_point          Real>
+      requires ConsistentTypes<Law,nDim,Real,SolVarT>
+   Real rungeKuttaStageUpdateLocal( const Policy                                                    policy,
+                                    const par::DualArray<geom::Volume<nDim,Real>,nDim>&              cells,
+                                    const Species<Law,Real>&                                       species,
+                                    const ODE::Explicit::RungeKutta<Real>&                      rungeKutta,
+                                    const size_t                                                       stg,
+                                    const Real                                                         cfl,
+                                    const std::vector<par::DualArray<FluxResult<Law,nDim,Real>,nDim>>& resStage,
+                                    const par::DualArray<SolVarT,nDim>&                                 q0,
+                                          par::DualArray<SolVarT,nDim>&                                 q1 )
+  {
+   // conserved variables needed for correct shock speeds
+      constexpr BasisType<Law> ConservedBasis = BasisType<Law>::Conserved;
+      using ConsVarT = VariableSet<Law,nDim,ConservedBasis,Real>;
+      using FluxRes  = FluxResult<Law,nDim,Real>;
+
+   // check mesh sizes match
+      assert( stg < resStage.size() );
+      assert( cells.shape() == q1.shape() );
+      assert( cells.shape() == q0.shape() );
+      assert( cells.shape() == resStage[stg].shape() );
+
+      const Real betacfl = rungeKutta.beta[stg]*cfl;
+
+   // new = old + beta*(cfl*vol/lambda)*sum( alpha*residual )/vol
+      // solv -> (consv + increment) -> solv
+      const auto update = [&]( const par::DualIdx<nDim>& idx,
+                                     SolVarT&             v1,
+                               const SolVarT&             v0 )
+     {
+         FluxRes frtotal{};
+         for( unsigned int k=0; k<=stg; k++ )
+        {
+            frtotal.flux+=rungeKutta.alpha[stg][k]*resStage[k](idx).flux;
+        }
+
+         v1 = set2Set<SolVarT>( species, set2Set<ConsVarT>( species, v0 ) + frtotal.flux*(betacfl/resStage[0](idx).lambda) );
+     };
+
+      if( stg>0 )
+     {
+         par::for_each_idx( policy,
+                            [&]( const par::DualIdx<nDim>& idx, const geom::Volume<nDim,Real>& )
+                           { update( idx, q1(idx), q0(idx) ); },
+                            cells );
+         return 0;
+     }
+
+      return par::for_each_idx_reduce( policy,
+                                       [&]( const par::DualIdx<nDim>&     idx,
+                                                  SolVarT&                 v1,
+                                            const SolVarT&                 v0,
+                                            const geom::Volume<nDim,Real>& cell ) -> Real
+                                      {
+                                          update( idx, v1, v0 );
+
+                                          const FluxRes& res = resStage[stg](idx);
+                                          Real r2{0};
+                                          for( int i=0; i<nVar<Law,nDim>; i++ )
+                                         {
+                                             const Real r = res.flux[i]/cell.volume;
+                                             r2+=r*r;
+                                         }
+                                          return r2;
+                                      },
+                                       []( const Real l, const Real r ) -> Real
+                                      { return l+r; },
+                                       Real{0},
+                                       q1,
+                                       q0, cells );
+  }
+
+/*
+ * root mean square over cells and variables of the residual per unit volume, from the sum of squares returned by the stage update
+ */
+   template<LawType  Law,
+            int     nDim,
+            floating_point Real>
+   Real residualNorm( const Real                      sum2,
+                      const par::DualShape<nDim>&    shape )
+  {
+      return std::sqrt( sum2/( par::length( shape )*nVar<Law,nDim> ) );
+  }
+
+/*
+ * iterates a solution field towards a steady state with an explicit runge kutta scheme and local timestepping, any number of iterations
+ * at a time
+ *    each cell is advanced by its own timestep dt = cfl*vol/lambda, where lambda is the spectral radius accumulated in its residual,
+ *    so small cells (e.g. near a wall on a stretched mesh) do not limit the timestep of the rest of the domain. The solution is only
+ *    time-accurate at the steady state
+ *    the workspace, residual evaluation and timers are those of RungeKuttaStepper, so iteration can be continued with further calls to
+ *    step or converge without allocating or recomputing anything
+ *    the residual norm (see residualNorm) is that of the solution at the beginning of each iteration, and is kept for the first and
+ *    the latest iteration
+ */
+   template<par::execution_policy   Policy,
+            typename       SecondOrderFlux,
+            typename        BoundaryCondsT,
+            ImplementedVarSet    SolVarSet>
+   class SteadyStateStepper : private RungeKuttaStepper<Policy,
+                                                         ODE::Explicit::RungeKutta<fptype_of_t<SolVarSet>>,
+                                                         SecondOrderFlux,
+                                                         BoundaryCondsT,
+                                                         SolVarSet>
+  {
+   private:
+
+      using Base = RungeKuttaStepper<Policy,
+                                     ODE::Explicit::RungeKutta<fptype_of_t<SolVarSet>>,
+                                     SecondOrderFlux,
+                                     BoundaryCondsT,
+                                     SolVarSet>;
+
+      constexpr static LawType Law = law_of_v<SolVarSet>;
+      constexpr static int    nDim = dim_of_v<SolVarSet>;
+
+      using Real = fptype_of_t<SolVarSet>;
+
+   // residual norm at the beginning of the first and of the latest iteration
+      Real resid0;
+      Real resid;
+
+   public:
+
+      SteadyStateStepper( const Policy                                policy0,
+                          const Real                                     cfl0,
+                          const ODE::Explicit::RungeKutta<Real>&  rungeKutta0,
+                          const SecondOrderFlux&                       flux20,
+                          const BoundaryCondsT&                boundaryConds0,
+                          const Species<Law,Real>&                   species0,
+                          const Mesh<nDim,Real>&                        mesh0,
+                                SolutionField<SolVarSet,nDim>&             q0 )
+                          : Base(policy0, cfl0, rungeKutta0, flux20, boundaryConds0, species0, mesh0, q0),
+                            resid0(0),
+                            resid(0) {}
+
+   // advance the solution field by n iterations
+      void step( const size_t n )
+     {
+         for( size_t i=0; i<n; i++ )
+        {
+            iteration();
+            this->nsteps++;
+        }
+     }
+
+   // iterate until converged (see converged), or until niterations iterations have been taken in total, and return whether converged
+      bool converge( const size_t niterations, const Real residual_drop )
+     {
+         while( !converged( residual_drop ) && this->nsteps<niterations ){ step( 1 ); }
+         return converged( residual_drop );
+     }
+
+   // whether the residual norm has dropped to residual_drop times its value at the first iteration
+      // residual_drop is a ratio, so must be less than one. The first iteration only sets the reference, so at least two are needed
+      bool converged( const Real residual_drop ) const
+     {
+         assert( residual_drop<1 && "SteadyStateStepper - residual_drop is the ratio of the final to the initial residual norm" );
+         return this->nsteps>1 && resid<=residual_drop*resid0;
+     }
+
+   // number of iterations taken so far
+      using Base::timesteps;
+
+   // residual norm at the beginning of the first and of the latest iteration
+      Real initialResidual() const { return resid0; }
+      Real latestResidual()  const { return resid;  }
+
+   private:
+
+   // one iteration, the first stage updates out of place from q into qn, and the two then swap arrays, as for a classical timestep
+      void iteration()
+     {
+         auto& qn       = this->workspace.qn;
+         auto& resStage = this->workspace.residuals;
+         auto& qi       = this->q.interior;
+
+         Real sum2{};
+         for( unsigned int stg=0; stg<this->rungeKutta.nstages; stg++ )
+        {
+            this->residual( resStage[stg] );
+
+         // accumulate stage residuals and integrate forward by the local timesteps in a single sweep, reducing the residual norm on the
+         // first stage
+            this->stageupd_timer.start();
+            if( stg==0 )
+           {
+               sum2 = rungeKuttaStageUpdateLocal( this->policy, this->mesh.cells, this->species, this->rungeKutta, stg, this->cfl,
+                                                  resStage, qi, qn );
+           }
+            else
+           {
+               rungeKuttaStageUpdateLocal( this->policy, this->mesh.cells, this->species, this->rungeKutta, stg, this->cfl,
+                                           resStage, qn, qi );
+           }
+            this->stageupd_timer.pause();
+
+            if( stg==0 )
+           {
+               this->copyswap_timer.start();
+               std::swap( qi,qn );
+               this->copyswap_timer.pause();
+           }
+        }
+
+         resid = residualNorm<Law>( sum2, this->mesh.cells.shape() );
+         if( this->nsteps==0 ){ resid0=resid; }
+     }
+  };
+
+/*
+ * steady state stepper for iterating q on mesh with the given scheme, see SteadyStateStepper
+ */
+   template<par::execution_policy   Policy,
+            typename       SecondOrderFlux,
+            typename...      BoundaryConds,
+            LawType                    Law,
+            int                       nDim,
+            floating_point            Real,
+            ImplementedVarSet    SolVarSet>
+   auto makeSteadyStateStepper( const Policy                              policy,
+                                const Real                                   cfl,
+                                const ODE::Explicit::RungeKutta<Real>& rungeKutta,
+                                const SecondOrderFlux&                     flux2,
+                                const std::tuple<BoundaryConds...> boundaryConds,
+                                const Species<Law,Real>&                 species,
+                                const Mesh<nDim,Real>&                      mesh,
+                                      SolutionField<SolVarSet,nDim>&           q )
+  {
+      return SteadyStateStepper<Policy,
+                                SecondOrderFlux,
+                                std::tuple<BoundaryConds...>,
+                                SolVarSet>( policy, cfl, rungeKutta, flux2, boundaryConds, species, mesh, q );
+  }
+
+/*
+ * integrates dq/dt = rhs towards a steady state using an explicit runge kutta scheme with local timestepping
+ *    iterates until the residual norm has dropped by the ratio residual_drop relative to the first iteration, or nTimesteps iterations,
+ *    and returns the number of iterations taken. To iterate in several chunks, e.g. between output dumps, use a stepper directly
+ *    see SteadyStateStepper
+ */
+   template<par::execution_policy   Policy,
+            LawType                    Law,
+            int                       nDim,
+            floating_point            Real,
+            ImplementedVarSet    SolVarSet,
+            typename       SecondOrderFlux,
+            typename...      BoundaryConds>
+   size_t integrate( const Policy                                policy,
+                     const SteadyTimeControls<Real>&       timeControls,
+                     const ODE::Explicit::RungeKutta<Real>&  rungeKutta,
+                     const SecondOrderFlux&                       flux2,
+                     const std::tuple<BoundaryConds...>   boundaryConds,
+                     const Species<Law,Real>&                   species,
+                     const Mesh<nDim,Real>&                        mesh,
+                           SolutionField<SolVarSet,nDim>&             q )
+  {
+      auto stepper = makeSteadyStateStepper( policy, timeControls.cfl, rungeKutta, flux2, boundaryConds, species, mesh, q );
+
+      utils::LifetimeTimer timer( "main loop time: " );
+
+      stepper.converge( timeControls.nTimesteps, timeControls.residual_drop );
+
+      return stepper.timesteps();
+  }
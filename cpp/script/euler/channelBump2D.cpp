@@ -179,7 +179,7 @@ using MeshT      = Mesh<nDim,Real>;
                                           make_periodic_BCond<Law>(),
                                           make_fixed_BCond<Law>()};
 
-      for( SolField::VarField& qb : q.boundary ){ par::fill( qb, qref ); }
+      for( SolField::VarField& qb : q.reference ){ par::fill( qb, qref ); }
       q.bcTypes[0] = BCType::Fixed;
       q.bcTypes[1] = BCType::Fixed;
       q.bcTypes[2] = BCType::InviscidWall;
@@ -235,7 +235,7 @@ using MeshT      = Mesh<nDim,Real>;
                writeState( solutionFile,
                            species,
                            set2State( species,
-                                      q.boundary[0]({i,1}) ),
+                                      q.reference[0]({0,i}) ),
                            sref );
            }
 //          for( size_t i=0; i<q.interior.shape(1); ++i )
@@ -250,7 +250,7 @@ using MeshT      = Mesh<nDim,Real>;
                writeState( solutionFile,
                            species,
                            set2State( species,
-                                      q.boundary[0]({i,0}) ),
+                                      q.ghost(0)({0,i}) ),
                            sref );
            }
             par::for_each_idx( writer,
@@ -306,7 +306,7 @@ using MeshT      = Mesh<nDim,Real>;
                writeState( solutionFile,
                            species,
                            set2State( species,
-                                      q.boundary[0]({i,1}) ),
+                                      q.reference[0]({0,i}) ),
                            sref );
                if( i==ny-1 ){ solutionFile << "\n"; }
            }
@@ -321,7 +321,7 @@ using MeshT      = Mesh<nDim,Real>;
                writeState( solutionFile,
                            species,
                            set2State( species,
-                                      q.boundary[0]({i,0}) ),
+                                      q.ghost(0)({0,i}) ),
                            sref );
                if( i==ny-1 ){ solutionFile << "\n"; }
            }
@@ -5,7 +5,7 @@
 # include <spatial/muscl.h>
 # include <limiters/limiter.h>
 
-# include <timestepping/rungeKutta.h>
+# include <timestepping/steadyState.h>
 
 # include <conservationLaws/euler/euler.h>
 # include <conservationLaws/euler/boundaryConditions.h>
@@ -93,10 +93,16 @@ constexpr Real rc =  1.0;
 constexpr Real rb =  8.0;
 
 // time discretisation
+//    nt is the maximum number of iterations
+//    resdrop is the ratio of the final to the initial residual norm at convergence
 constexpr size_t nt = 200'000;
 constexpr Real  cfl = 0.8;
+constexpr Real  resdrop = 1.e-8;
 
-# ifdef _OPENMP
+# ifndef _OPENMP
+constexpr auto policy = par::execution::seq;
+# else
+constexpr auto policy = par::execution::omp;
 constexpr int nthreads=16;
 # endif
 
@@ -144,7 +150,7 @@ using MeshT      = Mesh<nDim,Real>;
 # endif
 
       const ODE::Explicit::RungeKutta<Real> rk = ODE::Explicit::ssp11<Real>();
-      const UnsteadyTimeControls<Real> timeControls{.nTimesteps=nt, .cfl=cfl};
+      const SteadyTimeControls<Real> timeControls{.nTimesteps=nt, .cfl=cfl, .residual_drop=resdrop};
 
       const Species<Law,Real> species = []() -> Species<Law,Real>
      {
@@ -174,7 +180,7 @@ using MeshT      = Mesh<nDim,Real>;
                                           make_fixed_BCond<Law>(),
                                           make_periodic_BCond<Law>()};
 
-      for( SolField::VarField& qb : q.boundary ){ par::fill( qb, qref ); }
+      for( SolField::VarField& qb : q.reference ){ par::fill( qb, qref ); }
       q.bcTypes[0] = BCType::InviscidWall;
       q.bcTypes[1] = BCType::Fixed;
       q.bcTypes[2] = BCType::Periodic;
@@ -183,11 +189,13 @@ using MeshT      = Mesh<nDim,Real>;
    // high order reconstruction and flux functions
       const auto hoflux = make_muscl_flux<Law>( Limiter{}, Flux{} );
 
-   // integrate forward in time
-      integrate( timeControls, rk,
-                 hoflux, boundaryConditions,
-                 species,
-                 mesh, q );
+   // iterate towards the steady state
+      const size_t niterations = integrate( policy, timeControls, rk,
+                                            hoflux, boundaryConditions,
+                                            species,
+                                            mesh, q );
+
+      std::cout << "steady-state iterations: " << niterations << "\n";
 
    // write solution to file
       if( true )
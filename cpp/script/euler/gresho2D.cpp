@@ -26,6 +26,7 @@
 # include <omp.h>
 
 # include <vector>
+# include <string>
 # include <iostream>
 # include <fstream>
 
@@ -102,6 +103,9 @@ constexpr Real h = 1.0;
 constexpr size_t nt = 10;
 constexpr Real  cfl = 1.6;
 
+// number of solution files written, evenly spaced over the nt timesteps
+constexpr size_t ndumps = 1;
+
 // variable flow conditions
 constexpr Real mach = 3.e-1;
 constexpr Real vel_inf = 0.1;
@@ -148,7 +152,7 @@ using MeshT      = Mesh<nDim,Real>;
 
       const par::DualShape<nDim> cellShape{nx,nx};
 
-      const ODE::Explicit::RungeKutta<Real> rk = ODE::Explicit::ssp34<Real>();
+      const ODE::Explicit::LowStorage::RungeKutta<Real> rk = ODE::Explicit::LowStorage::ssp34<Real>();
       const UnsteadyTimeControls<Real> timeControls{.nTimesteps=nt, .cfl=cfl};
 
       const Species<Law,Real> species = [&]() -> Species<Law,Real>
@@ -211,57 +215,70 @@ using MeshT      = Mesh<nDim,Real>;
    // boundary conditions
       const std::tuple boundaryConditions{make_periodic_BCond<Law>()};
 
-      for( auto& qb : q.boundary ){ par::fill( qb, qref ); }
+      for( auto& qb : q.reference ){ par::fill( qb, qref ); }
       for( auto& bc : q.bcTypes  ){ bc = BCType::Periodic; }
 
    // high order reconstruction and flux functions
       const auto hoflux = make_muscl_flux<Law>( Limiter{}, Flux{} );
 
-   // integrate forward in time
-      integrate( policy, timeControls, rk,
-                 hoflux, boundaryConditions,
-                 species,
-                 mesh, q );
-
    // write solution to file
-      if( true )
+      const auto writeSolution = [&]( const std::string& filename ) -> bool
      {
-         std::ofstream solutionFile( "data/euler/gresho2D/result.dat" );
+         std::ofstream solutionFile( filename );
    
-         if( solutionFile.is_open() )
+         if( !solutionFile.is_open() )
         {
-            auto writePoint = [&]( const MeshT::Node& p ) -> void
-           {
-               solutionFile << p[0] << " "
-                            << p[1] << " ";
-           };
+            std::cout << "cannot open \"" << filename << "\" for writing\n" << std::endl;
+            return false;
+        }
 
-            solutionFile << std::scientific;
-            solutionFile.precision(16);
+         const auto writePoint = [&]( const MeshT::Node& p ) -> void
+        {
+            solutionFile << p[0] << " "
+                         << p[1] << " ";
+        };
 
-            const auto sref = set2State( species, qref );
+         solutionFile << std::scientific;
+         solutionFile.precision(16);
 
-            auto writer = [&]( const par::DualIdx2 idx,
-                               const MeshT::Cell&   c0,
-                               const SolVarSet&     qc ) -> void
-           {
-               writePoint(c0.centre);
-               writeState( solutionFile, species, set2State( species, qc ), sref );
-               solutionFile << "\n";
-               if( idx[1]==nx-1 ){ solutionFile << "\n"; }
-               return;
-           };
-   
-            par::for_each_idx( writer,
-                               mesh.cells,
-                               q.interior );
-        }
-         else
+         const auto sref = set2State( species, qref );
+
+         const auto writer = [&]( const par::DualIdx2 idx,
+                                  const MeshT::Cell&   c0,
+                                  const SolVarSet&     qc ) -> void
         {
-            std::cout << "cannot open \"data/euler/gresho2D/result.dat\" for writing\n" << std::endl;
-            return 1;
-        }
+            writePoint(c0.centre);
+            writeState( solutionFile, species, set2State( species, qc ), sref );
+            solutionFile << "\n";
+            if( idx[1]==nx-1 ){ solutionFile << "\n"; }
+            return;
+        };
+   
+         par::for_each_idx( writer,
+                            mesh.cells,
+                            q.interior );
+
          solutionFile.close();
+         return true;
+     };
+
+   // integrate forward in time, writing the solution between chunks of timesteps
+      // the stepper keeps its workspace and timestep between chunks, so the result does not depend on ndumps
+      auto stepper = makeRungeKuttaStepper( policy, timeControls.cfl, rk,
+                                            hoflux, boundaryConditions,
+                                            species,
+                                            mesh, q );
+
+      for( size_t n=0; n<ndumps; ++n )
+     {
+         stepper.step( ((n+1)*timeControls.nTimesteps)/ndumps - (n*timeControls.nTimesteps)/ndumps );
+
+         std::cout << "physical time elapsed: " << stepper.time() << "\n";
+
+         const std::string filename = n+1<ndumps ? "data/euler/gresho2D/result_"+std::to_string(n)+".dat"
+                                                 : "data/euler/gresho2D/result.dat";
+
+         if( !writeSolution( filename ) ){ return 1; }
      }
 
    // write mesh to file
@@ -189,8 +189,8 @@ using MeshT      = Mesh<nDim,Real>;
 
       const SolVarSet qref{velocity,density,pressure};
       par::fill( q.interior,    qref );
-      par::fill( q.boundary[0], qref );
-      par::fill( q.boundary[1], qref );
+      par::fill( q.reference[0], qref );
+      par::fill( q.reference[1], qref );
       q.bcTypes[0] = BCType::Riemann;
       q.bcTypes[1] = BCType::Riemann;
 //    q.bcTypes[0] = BCType::Periodic;
@@ -255,15 +255,15 @@ using MeshT      = Mesh<nDim,Real>;
             solutionFile << std::scientific;
             solutionFile.precision(12);
    
-            writeState( solutionFile, species, set2State( species, q.boundary[0]({1}) ) );
-            writeState( solutionFile, species, set2State( species, q.boundary[0]({0}) ) );
+            writeState( solutionFile, species, set2State( species, q.reference[0]({0}) ) );
+            writeState( solutionFile, species, set2State( species, q.ghost(0)({0}) ) );
             par::for_each( // write state to file
                            [&]( const SolVarSet& q0 ) -> void
                               { writeState( solutionFile, species, set2State( species, q0 ) ); },
                            // solution array
                            q.interior );
-            writeState( solutionFile, species, set2State( species, q.boundary[1]({0}) ) );
-            writeState( solutionFile, species, set2State( species, q.boundary[1]({1}) ) );
+            writeState( solutionFile, species, set2State( species, q.ghost(1)({0}) ) );
+            writeState( solutionFile, species, set2State( species, q.reference[1]({0}) ) );
         }
          else
         {
@@ -125,7 +125,7 @@ using MeshT     = Mesh<nDim,Real>;
 //    par::fill( q.interior, qref );
 
    // initialise boundaries
-      for( SolField::VarField& v : q.boundary ){ par::fill( v, q.interior({0,0}) ); }
+      for( SolField::VarField& v : q.reference ){ par::fill( v, q.interior({0,0}) ); }
       q.bcTypes[0] = SolField::BCType::Periodic;
       q.bcTypes[1] = SolField::BCType::Periodic;
       q.bcTypes[2] = SolField::BCType::Riemann;
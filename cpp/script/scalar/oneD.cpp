@@ -104,7 +104,7 @@ using MeshT     = Mesh<nDim,Real>;
                       mesh.cells );
 
    // initialise boundaries
-      for( SolField::VarField& v : q.boundary ){ par::fill( v, SolVarSet{velocity,1.} ); }
+      for( SolField::VarField& v : q.reference ){ par::fill( v, SolVarSet{velocity,1.} ); }
 //    for( SolField::BCType&  bc : q.bcTypes  ){ bc = SolField::BCType::Periodic; }
       for( SolField::BCType&  bc : q.bcTypes  ){ bc = SolField::BCType::Riemann; }
 
@@ -0,0 +1,28 @@
+# pragma once
+
+# include <cppunit/TestFixture.h>
+# include <cppunit/extensions/HelperMacros.h>
+
+# include <conservationLaws/euler/euler.h>
+# include <lsq/lsq.h>
+
+/*
+   Tests least squares gradients from factored spatial metrics, and biased gradients from the factor of the full metric
+*/
+
+   class Test_lsq_solve : public CppUnit::TestFixture
+  {
+   private:
+      CPPUNIT_TEST_SUITE( Test_lsq_solve );
+
+         CPPUNIT_TEST( test_linear_exact );
+         CPPUNIT_TEST( test_bias_solve );
+
+      CPPUNIT_TEST_SUITE_END();
+
+   public:
+      void test_linear_exact();
+      void test_bias_solve();
+  };
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Test_lsq_solve );
@@ -0,0 +1,28 @@
+# pragma once
+
+# include <cppunit/TestFixture.h>
+# include <cppunit/extensions/HelperMacros.h>
+
+# include <mesh/generate/twoD.h>
+# include <mesh/mesh.h>
+
+/*
+   Tests the face geometry cached in Mesh by updateGeometry and the mesh generators
+*/
+
+   class Test_mesh_geometry : public CppUnit::TestFixture
+  {
+   private:
+      CPPUNIT_TEST_SUITE( Test_mesh_geometry );
+
+         CPPUNIT_TEST( test_faces_from_nodes );
+         CPPUNIT_TEST( test_cylinder_mesh );
+
+      CPPUNIT_TEST_SUITE_END();
+
+   public:
+      void test_faces_from_nodes();
+      void test_cylinder_mesh();
+  };
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Test_mesh_geometry );
@@ -0,0 +1,29 @@
+# pragma once
+
+# include <cppunit/TestFixture.h>
+# include <cppunit/extensions/HelperMacros.h>
+
+# include <ode.h>
+
+/*
+   Tests low-storage explicit runge-kutta schemes against their classical forms and their order of accuracy
+*/
+
+   class Test_ode_low_storage : public CppUnit::TestFixture
+  {
+   private:
+      CPPUNIT_TEST_SUITE( Test_ode_low_storage );
+
+         CPPUNIT_TEST( test_matches_classical );
+         CPPUNIT_TEST( test_order );
+         CPPUNIT_TEST( test_registers );
+
+      CPPUNIT_TEST_SUITE_END();
+
+   public:
+      void test_matches_classical();
+      void test_order();
+      void test_registers();
+  };
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Test_ode_low_storage );
@@ -0,0 +1,35 @@
+
+# pragma once
+
+# include <cppunit/TestFixture.h>
+# include <cppunit/extensions/HelperMacros.h>
+
+# include <parallalg/algorithm.h>
+# include <parallalg/array.h>
+# include <parallalg/neighbour_algorithm.h>
+# include <parallalg/view.h>
+
+/*
+   Tests bounding-box overloads of parallalg algorithms
+*/
+
+   class Test_par_box : public CppUnit::TestFixture
+  {
+   private:
+      CPPUNIT_TEST_SUITE( Test_par_box );
+
+         CPPUNIT_TEST( test_for_each_and_transform );
+         CPPUNIT_TEST( test_transform_reduce );
+         CPPUNIT_TEST( test_neighbour_accumulation );
+         CPPUNIT_TEST( test_edge_cases );
+
+      CPPUNIT_TEST_SUITE_END();
+
+   public:
+      void test_for_each_and_transform();
+      void test_transform_reduce();
+      void test_neighbour_accumulation();
+      void test_edge_cases();
+  };
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Test_par_box );
@@ -0,0 +1,33 @@
+# pragma once
+
+# include <cppunit/TestFixture.h>
+# include <cppunit/extensions/HelperMacros.h>
+
+# include <parallalg/algorithm.h>
+# include <parallalg/array.h>
+# include <parallalg/neighbour_algorithm.h>
+
+# include <vector>
+
+/*
+   Tests parallel neighbour accumulation with face colouring against serial execution
+*/
+
+   class Test_par_colour : public CppUnit::TestFixture
+  {
+   private:
+      CPPUNIT_TEST_SUITE( Test_par_colour );
+
+         CPPUNIT_TEST( test_colour_1d );
+         CPPUNIT_TEST( test_colour_2d );
+         CPPUNIT_TEST( test_colour_3d );
+
+      CPPUNIT_TEST_SUITE_END();
+
+   public:
+      void test_colour_1d();
+      void test_colour_2d();
+      void test_colour_3d();
+  };
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Test_par_colour );
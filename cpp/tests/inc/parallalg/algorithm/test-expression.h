@@ -0,0 +1,35 @@
+
+# pragma once
+
+# include <cppunit/TestFixture.h>
+# include <cppunit/extensions/HelperMacros.h>
+
+# include <parallalg/algorithm.h>
+# include <parallalg/array.h>
+# include <parallalg/expression.h>
+# include <parallalg/view.h>
+
+/*
+   Tests lazy whole-array expressions of parallalg Arrays
+*/
+
+   class Test_par_expression : public CppUnit::TestFixture
+  {
+   private:
+      CPPUNIT_TEST_SUITE( Test_par_expression );
+
+         CPPUNIT_TEST( test_arithmetic );
+         CPPUNIT_TEST( test_policies_and_storage );
+         CPPUNIT_TEST( test_lazy_transform );
+         CPPUNIT_TEST( test_edge_cases );
+
+      CPPUNIT_TEST_SUITE_END();
+
+   public:
+      void test_arithmetic();
+      void test_policies_and_storage();
+      void test_lazy_transform();
+      void test_edge_cases();
+  };
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Test_par_expression );
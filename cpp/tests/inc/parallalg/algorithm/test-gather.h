@@ -0,0 +1,33 @@
+# pragma once
+
+# include <cppunit/TestFixture.h>
+# include <cppunit/extensions/HelperMacros.h>
+
+# include <parallalg/algorithm.h>
+# include <parallalg/array.h>
+# include <parallalg/neighbour_algorithm.h>
+
+# include <vector>
+
+/*
+   Tests parallel neighbour accumulation with face gather against serial execution
+*/
+
+   class Test_par_gather : public CppUnit::TestFixture
+  {
+   private:
+      CPPUNIT_TEST_SUITE( Test_par_gather );
+
+         CPPUNIT_TEST( test_gather_1d );
+         CPPUNIT_TEST( test_gather_2d );
+         CPPUNIT_TEST( test_gather_3d );
+
+      CPPUNIT_TEST_SUITE_END();
+
+   public:
+      void test_gather_1d();
+      void test_gather_2d();
+      void test_gather_3d();
+  };
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Test_par_gather );
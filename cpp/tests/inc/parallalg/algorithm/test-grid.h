@@ -0,0 +1,34 @@
+
+# pragma once
+
+# include <cppunit/TestFixture.h>
+# include <cppunit/extensions/HelperMacros.h>
+
+# include <parallalg/algorithm.h>
+# include <parallalg/array.h>
+# include <parallalg/grid_algorithm.h>
+
+/*
+   Tests parallalg algorithms with mixed primal and dual grid arguments
+*/
+
+   class Test_par_grid : public CppUnit::TestFixture
+  {
+   private:
+      CPPUNIT_TEST_SUITE( Test_par_grid );
+
+         CPPUNIT_TEST( test_cells_from_nodes );
+         CPPUNIT_TEST( test_nodes_from_cells );
+         CPPUNIT_TEST( test_faces_from_nodes );
+         CPPUNIT_TEST( test_small_grids );
+
+      CPPUNIT_TEST_SUITE_END();
+
+   public:
+      void test_cells_from_nodes();
+      void test_nodes_from_cells();
+      void test_faces_from_nodes();
+      void test_small_grids();
+  };
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Test_par_grid );
@@ -0,0 +1,38 @@
+
+# pragma once
+
+# include <cppunit/TestFixture.h>
+# include <cppunit/extensions/HelperMacros.h>
+
+# include <parallalg/algorithm.h>
+# include <parallalg/array.h>
+# include <parallalg/neighbour_algorithm.h>
+
+# include <array>
+# include <atomic>
+# include <cmath>
+
+/*
+   Tests lagged sweeps calling two face functions, and optionally a boundary face function, in one pass
+*/
+
+   class Test_par_lagged : public CppUnit::TestFixture
+  {
+   private:
+      CPPUNIT_TEST_SUITE( Test_par_lagged );
+
+         CPPUNIT_TEST( test_faces_visited );
+         CPPUNIT_TEST( test_lag );
+         CPPUNIT_TEST( test_two_pass );
+         CPPUNIT_TEST( test_boundary_faces );
+
+      CPPUNIT_TEST_SUITE_END();
+
+   public:
+      void test_faces_visited();
+      void test_lag();
+      void test_two_pass();
+      void test_boundary_faces();
+  };
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Test_par_lagged );
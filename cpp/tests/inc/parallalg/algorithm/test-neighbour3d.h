@@ -0,0 +1,35 @@
+
+# pragma once
+
+# include <cppunit/TestFixture.h>
+# include <cppunit/extensions/HelperMacros.h>
+
+# include <parallalg/algorithm.h>
+# include <parallalg/array.h>
+# include <parallalg/neighbour_algorithm.h>
+
+# include <array>
+# include <cmath>
+
+/*
+   Tests 3D overloads of parallalg index and neighbour algorithms
+*/
+
+   class Test_par_neighbour3d : public CppUnit::TestFixture
+  {
+   private:
+      CPPUNIT_TEST_SUITE( Test_par_neighbour3d );
+
+         CPPUNIT_TEST( test_for_each_idx );
+         CPPUNIT_TEST( test_for_each_face );
+         CPPUNIT_TEST( test_neighbour_accumulation );
+
+      CPPUNIT_TEST_SUITE_END();
+
+   public:
+      void test_for_each_idx();
+      void test_for_each_face();
+      void test_neighbour_accumulation();
+  };
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Test_par_neighbour3d );
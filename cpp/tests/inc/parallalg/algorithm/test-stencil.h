@@ -0,0 +1,35 @@
+
+# pragma once
+
+# include <cppunit/TestFixture.h>
+# include <cppunit/extensions/HelperMacros.h>
+
+# include <parallalg/algorithm.h>
+# include <parallalg/array.h>
+# include <parallalg/stencil.h>
+# include <parallalg/view.h>
+
+/*
+   Tests stencil gathers of parallalg Arrays
+*/
+
+   class Test_par_stencil : public CppUnit::TestFixture
+  {
+   private:
+      CPPUNIT_TEST_SUITE( Test_par_stencil );
+
+         CPPUNIT_TEST( test_laplacian_bounds );
+         CPPUNIT_TEST( test_policies_and_storage );
+         CPPUNIT_TEST( test_dual_grid );
+         CPPUNIT_TEST( test_small_arrays );
+
+      CPPUNIT_TEST_SUITE_END();
+
+   public:
+      void test_laplacian_bounds();
+      void test_policies_and_storage();
+      void test_dual_grid();
+      void test_small_arrays();
+  };
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Test_par_stencil );
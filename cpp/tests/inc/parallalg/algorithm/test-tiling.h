@@ -0,0 +1,31 @@
+# pragma once
+
+# include <cppunit/TestFixture.h>
+# include <cppunit/extensions/HelperMacros.h>
+
+# include <parallalg/algorithm.h>
+# include <parallalg/array.h>
+# include <parallalg/neighbour_algorithm.h>
+
+# include <vector>
+
+/*
+   Tests cache-blocked tiled traversal of parallalg arrays
+*/
+
+   class Test_par_tiling : public CppUnit::TestFixture
+  {
+   private:
+      CPPUNIT_TEST_SUITE( Test_par_tiling );
+
+         CPPUNIT_TEST( test_every_index_once );
+         CPPUNIT_TEST( test_accumulation );
+
+      CPPUNIT_TEST_SUITE_END();
+
+   public:
+      void test_every_index_once();
+      void test_accumulation();
+  };
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Test_par_tiling );
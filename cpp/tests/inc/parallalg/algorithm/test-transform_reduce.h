@@ -0,0 +1,39 @@
+
+# pragma once
+
+# include <cppunit/TestFixture.h>
+# include <cppunit/extensions/HelperMacros.h>
+
+# include <parallalg/algorithm.h>
+# include <parallalg/array.h>
+
+/*
+   Tests transform_reduce and for_each_idx_reduce functions of parallalg library
+*/
+
+   class Test_par_transform_reduce : public CppUnit::TestFixture
+  {
+   private:
+      CPPUNIT_TEST_SUITE( Test_par_transform_reduce );
+
+         CPPUNIT_TEST( test_init_used_once );
+         CPPUNIT_TEST( test_padded );
+         CPPUNIT_TEST( test_deterministic );
+         CPPUNIT_TEST( test_chunk_counts );
+         CPPUNIT_TEST( test_simd_deterministic );
+         CPPUNIT_TEST( test_simd_lengths );
+         CPPUNIT_TEST( test_for_each_idx_reduce );
+
+      CPPUNIT_TEST_SUITE_END();
+
+   public:
+      void test_init_used_once();
+      void test_padded();
+      void test_deterministic();
+      void test_chunk_counts();
+      void test_simd_deterministic();
+      void test_simd_lengths();
+      void test_for_each_idx_reduce();
+  };
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Test_par_transform_reduce );
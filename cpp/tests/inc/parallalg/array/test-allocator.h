@@ -0,0 +1,36 @@
+# pragma once
+
+# include <cppunit/TestFixture.h>
+# include <cppunit/extensions/HelperMacros.h>
+
+# include <parallalg/algorithm.h>
+# include <parallalg/allocator.h>
+# include <parallalg/array.h>
+
+# include <cstdint>
+# include <vector>
+
+/*
+   Tests aligned memory allocation and padded memory layouts of parallalg Array
+*/
+
+   class Test_par_allocator : public CppUnit::TestFixture
+  {
+   private:
+      CPPUNIT_TEST_SUITE( Test_par_allocator );
+
+         CPPUNIT_TEST( test_alignment );
+         CPPUNIT_TEST( test_padded_strides );
+         CPPUNIT_TEST( test_initialisation );
+         CPPUNIT_TEST( test_empty );
+
+      CPPUNIT_TEST_SUITE_END();
+
+   public:
+      void test_alignment();
+      void test_padded_strides();
+      void test_initialisation();
+      void test_empty();
+  };
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Test_par_allocator );
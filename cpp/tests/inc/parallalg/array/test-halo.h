@@ -0,0 +1,34 @@
+# pragma once
+
+# include <cppunit/TestFixture.h>
+# include <cppunit/extensions/HelperMacros.h>
+
+# include <parallalg/algorithm.h>
+# include <parallalg/neighbour_algorithm.h>
+# include <parallalg/array.h>
+# include <parallalg/view.h>
+
+/*
+   Tests halo layers of parallalg Array
+*/
+
+   class Test_par_halo : public CppUnit::TestFixture
+  {
+   private:
+      CPPUNIT_TEST_SUITE( Test_par_halo );
+
+         CPPUNIT_TEST( test_halo_indexing );
+         CPPUNIT_TEST( test_flat_algorithms_skip_halo );
+         CPPUNIT_TEST( test_halo_layers );
+         CPPUNIT_TEST( test_edge_cases );
+
+      CPPUNIT_TEST_SUITE_END();
+
+   public:
+      void test_halo_indexing();
+      void test_flat_algorithms_skip_halo();
+      void test_halo_layers();
+      void test_edge_cases();
+  };
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Test_par_halo );
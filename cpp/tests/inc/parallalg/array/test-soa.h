@@ -0,0 +1,33 @@
+# pragma once
+
+# include <cppunit/TestFixture.h>
+# include <cppunit/extensions/HelperMacros.h>
+
+# include <parallalg/algorithm.h>
+# include <parallalg/array.h>
+# include <parallalg/soa.h>
+
+/*
+   Tests Structure-of-Arrays layout of parallalg Array
+*/
+
+   class Test_par_soa : public CppUnit::TestFixture
+  {
+   private:
+      CPPUNIT_TEST_SUITE( Test_par_soa );
+
+         CPPUNIT_TEST( test_component_layout );
+         CPPUNIT_TEST( test_proxy_arithmetic );
+         CPPUNIT_TEST( test_algorithms );
+         CPPUNIT_TEST( test_resize );
+
+      CPPUNIT_TEST_SUITE_END();
+
+   public:
+      void test_component_layout();
+      void test_proxy_arithmetic();
+      void test_algorithms();
+      void test_resize();
+  };
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Test_par_soa );
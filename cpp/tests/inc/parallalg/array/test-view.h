@@ -0,0 +1,34 @@
+# pragma once
+
+# include <cppunit/TestFixture.h>
+# include <cppunit/extensions/HelperMacros.h>
+
+# include <parallalg/algorithm.h>
+# include <parallalg/neighbour_algorithm.h>
+# include <parallalg/array.h>
+# include <parallalg/view.h>
+
+/*
+   Tests non-owning views of parallalg Array
+*/
+
+   class Test_par_view : public CppUnit::TestFixture
+  {
+   private:
+      CPPUNIT_TEST_SUITE( Test_par_view );
+
+         CPPUNIT_TEST( test_indexing );
+         CPPUNIT_TEST( test_flat_algorithms );
+         CPPUNIT_TEST( test_index_algorithms );
+         CPPUNIT_TEST( test_edge_cases );
+
+      CPPUNIT_TEST_SUITE_END();
+
+   public:
+      void test_indexing();
+      void test_flat_algorithms();
+      void test_index_algorithms();
+      void test_edge_cases();
+  };
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Test_par_view );
@@ -0,0 +1,35 @@
+
+# pragma once
+
+# include <cppunit/TestFixture.h>
+# include <cppunit/extensions/HelperMacros.h>
+
+# include <parallalg/schedule.h>
+# include <parallalg/algorithm.h>
+# include <parallalg/neighbour_algorithm.h>
+# include <parallalg/array.h>
+
+/*
+   Tests configurable OpenMP scheduling of parallalg library
+*/
+
+   class Test_par_schedule : public CppUnit::TestFixture
+  {
+   private:
+      CPPUNIT_TEST_SUITE( Test_par_schedule );
+
+         CPPUNIT_TEST( test_collapse_depth );
+         CPPUNIT_TEST( test_every_index_once );
+         CPPUNIT_TEST( test_neighbour_accumulation );
+         CPPUNIT_TEST( test_schedule_restored );
+
+      CPPUNIT_TEST_SUITE_END();
+
+   public:
+      void test_collapse_depth();
+      void test_every_index_once();
+      void test_neighbour_accumulation();
+      void test_schedule_restored();
+  };
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Test_par_schedule );
@@ -0,0 +1,34 @@
+
+# pragma once
+
+# include <cppunit/TestFixture.h>
+# include <cppunit/extensions/HelperMacros.h>
+
+# include <parallalg/thread_pool.h>
+# include <parallalg/algorithm.h>
+# include <parallalg/array.h>
+
+/*
+   Tests work-stealing thread pool of parallalg library
+*/
+
+   class Test_par_thread_pool : public CppUnit::TestFixture
+  {
+   private:
+      CPPUNIT_TEST_SUITE( Test_par_thread_pool );
+
+         CPPUNIT_TEST( test_every_index_once );
+         CPPUNIT_TEST( test_nested );
+         CPPUNIT_TEST( test_nested_algorithms );
+         CPPUNIT_TEST( test_algorithms );
+
+      CPPUNIT_TEST_SUITE_END();
+
+   public:
+      void test_every_index_once();
+      void test_nested();
+      void test_nested_algorithms();
+      void test_algorithms();
+  };
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Test_par_thread_pool );
@@ -0,0 +1,36 @@
+# pragma once
+
+# include <cppunit/TestFixture.h>
+# include <cppunit/extensions/HelperMacros.h>
+
+# include <spatial/fusedResidualCalc.h>
+# include <spatial/residualCalc.h>
+# include <spatial/lsqMetrics.h>
+# include <spatial/boundary/boundaryUpdate.h>
+# include <spatial/boundary/boundaryCondition.h>
+
+# include <conservationLaws/euler/euler.h>
+# include <solutionField/solutionField.h>
+# include <mesh/mesh.h>
+
+/*
+   Tests the fused residual sweep, which visits periodic and ghost cell boundary faces with the interior faces,
+   against the separate metric, interior and boundary passes
+*/
+
+   class Test_spatial_fused_residual : public CppUnit::TestFixture
+  {
+   private:
+      CPPUNIT_TEST_SUITE( Test_spatial_fused_residual );
+
+         CPPUNIT_TEST( test_matches_unfused );
+         CPPUNIT_TEST( test_periodic_conservative );
+
+      CPPUNIT_TEST_SUITE_END();
+
+   public:
+      void test_matches_unfused();
+      void test_periodic_conservative();
+  };
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Test_spatial_fused_residual );
@@ -0,0 +1,36 @@
+# pragma once
+
+# include <cppunit/TestFixture.h>
+# include <cppunit/extensions/HelperMacros.h>
+
+# include <timestepping/steadyState.h>
+
+# include <spatial/boundary/boundaryCondition.h>
+
+# include <conservationLaws/euler/euler.h>
+# include <solutionField/solutionField.h>
+# include <mesh/mesh.h>
+
+# include <controls.h>
+# include <ode.h>
+
+/*
+   Tests the steady state stepper, which iterates with local timestepping until the residual norm has dropped
+*/
+
+   class Test_timestepping_steady_state : public CppUnit::TestFixture
+  {
+   private:
+      CPPUNIT_TEST_SUITE( Test_timestepping_steady_state );
+
+         CPPUNIT_TEST( test_converges );
+         CPPUNIT_TEST( test_chunked_steps );
+
+      CPPUNIT_TEST_SUITE_END();
+
+   public:
+      void test_converges();
+      void test_chunked_steps();
+  };
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Test_timestepping_steady_state );
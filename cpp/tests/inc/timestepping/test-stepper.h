@@ -0,0 +1,35 @@
+# pragma once
+
+# include <cppunit/TestFixture.h>
+# include <cppunit/extensions/HelperMacros.h>
+
+# include <timestepping/rungeKutta.h>
+
+# include <spatial/boundary/boundaryCondition.h>
+
+# include <conservationLaws/euler/euler.h>
+# include <solutionField/solutionField.h>
+# include <mesh/mesh.h>
+
+# include <ode.h>
+
+/*
+   Tests the runge kutta stepper, which keeps its workspace and timestep between calls to step
+*/
+
+   class Test_timestepping_stepper : public CppUnit::TestFixture
+  {
+   private:
+      CPPUNIT_TEST_SUITE( Test_timestepping_stepper );
+
+         CPPUNIT_TEST( test_chunked_steps );
+         CPPUNIT_TEST( test_low_storage_matches_classical );
+
+      CPPUNIT_TEST_SUITE_END();
+
+   public:
+      void test_chunked_steps();
+      void test_low_storage_matches_classical();
+  };
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Test_timestepping_stepper );
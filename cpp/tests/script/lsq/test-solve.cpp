@@ -0,0 +1,16 @@
+
+# include <cppunit/ui/text/TestRunner.h>
+# include <cppunit/TestResult.h>
+
+# include <lsq/test-solve.h>
+
+   int main()
+  {
+      CppUnit::TextUi::TestRunner   runner;
+
+      runner.addTest( Test_lsq_solve::suite() );
+
+      bool wasSuccessful = runner.run( "", false );
+
+      return !wasSuccessful;
+  }
@@ -0,0 +1,16 @@
+
+# include <cppunit/ui/text/TestRunner.h>
+# include <cppunit/TestResult.h>
+
+# include <mesh/test-geometry.h>
+
+   int main()
+  {
+      CppUnit::TextUi::TestRunner   runner;
+
+      runner.addTest( Test_mesh_geometry::suite() );
+
+      bool wasSuccessful = runner.run( "", false );
+
+      return !wasSuccessful;
+  }
@@ -0,0 +1,16 @@
+
+# include <cppunit/ui/text/TestRunner.h>
+# include <cppunit/TestResult.h>
+
+# include <ode/test-low_storage.h>
+
+   int main()
+  {
+      CppUnit::TextUi::TestRunner   runner;
+
+      runner.addTest( Test_ode_low_storage::suite() );
+
+      bool wasSuccessful = runner.run( "", false );
+
+      return !wasSuccessful;
+  }
@@ -0,0 +1,16 @@
+
+# include <cppunit/ui/text/TestRunner.h>
+# include <cppunit/TestResult.h>
+
+# include <parallalg/algorithm/test-box.h>
+
+   int main()
+  {
+      CppUnit::TextUi::TestRunner   runner;
+
+      runner.addTest( Test_par_box::suite() );
+
+      bool wasSuccessful = runner.run( "", false );
+
+      return !wasSuccessful;
+  }
@@ -0,0 +1,15 @@
+# include <cppunit/ui/text/TestRunner.h>
+# include <cppunit/TestResult.h>
+
+# include <parallalg/algorithm/test-colour.h>
+
+   int main()
+  {
+      CppUnit::TextUi::TestRunner   runner;
+
+      runner.addTest( Test_par_colour::suite() );
+
+      bool wasSuccessful = runner.run( "", false );
+
+      return !wasSuccessful;
+  }
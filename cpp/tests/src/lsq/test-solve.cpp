@@ -0,0 +1,84 @@
+# include <lsq/test-solve.h>
+
+# include <array>
+# include <cmath>
+
+   namespace
+  {
+      using Point     = geom::Point<2,double>;
+      using Direction = geom::Direction<2,double>;
+      using VarSet    = VariableSet<LawType::Euler,2,EulerBases::Primitive,double>;
+      using VarDel    = vardelta_t<VarSet>;
+
+   // an irregular stencil of neighbours around x0
+      const Point x0{{0.3,-0.2}};
+      const std::array<Point,5> xs{ Point{{1.4,-0.1}}, Point{{0.2,0.9}}, Point{{-0.8,-0.4}}, Point{{0.5,-1.3}}, Point{{1.1,0.8}} };
+
+   // each variable is linear in x with a different gradient, plus a quadratic part scaled by c
+      VarSet field( const Point& x, const double c )
+     {
+         VarSet q;
+         for( int i=0; i<VarSet::N; ++i )
+        {
+            q[i] = 1.+i + (0.5+i)*x[0] - (1.5-0.7*i)*x[1] + c*(1.+i)*x[0]*x[1];
+        }
+         return q;
+     }
+
+      double gradient( const int i, const Direction& dir ){ return (0.5+i)*dir[0] - (1.5-0.7*i)*dir[1]; }
+  }
+
+/*
+ * the gradient of a linear field is recovered exactly in any direction
+ */
+   void Test_lsq_solve::test_linear_exact()
+  {
+      lsq::XMetric<2,double> xm{};
+      lsq::QMetric<VarSet>   qm{};
+      for( const Point& x : xs )
+     {
+         xm+=lsq::xmetric( x0, x );
+         qm+=lsq::qmetric( x0, x, field( x0, 0. ), field( x, 0. ) );
+     }
+
+      for( const Direction& dir : { Direction{{1.,0.}}, Direction{{0.,1.}}, Direction{{0.6,-0.8}} } )
+     {
+         const VarDel dq = lsq::solve( xm, qm, dir );
+         for( int i=0; i<VarSet::N; ++i )
+        {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL( gradient( i, dir ), dq[i], 1e-12 );
+        }
+     }
+  }
+
+/*
+ * removing one neighbour's contribution from the factor of the full metric gives the same gradient as solving the metrics
+ * accumulated without that neighbour
+ */
+   void Test_lsq_solve::test_bias_solve()
+  {
+      lsq::XMetric<2,double> xm{};
+      lsq::QMetric<VarSet>   qm{};
+      for( const Point& x : xs )
+     {
+         xm+=lsq::xmetric( x0, x );
+         qm+=lsq::qmetric( x0, x, field( x0, 1. ), field( x, 1. ) );
+     }
+      const lsq::XMetricFactor<2,double> xf = lsq::factor( xm );
+
+      const Direction dir{{0.6,-0.8}};
+
+      for( const Point& x : xs )
+     {
+         const Direction dx = x-x0;
+         const VarDel    dq = field( x, 1. )-field( x0, 1. );
+
+         const VarDel biased = lsq::bias_solve( xf, qm, dx, dq, dir );
+         const VarDel direct = lsq::solve( xm-lsq::xmetric( dx ), qm-lsq::qmetric( dx, dq ), dir );
+
+         for( int i=0; i<VarSet::N; ++i )
+        {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL( direct[i], biased[i], 1e-10 );
+        }
+     }
+  }
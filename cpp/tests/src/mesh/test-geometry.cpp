@@ -0,0 +1,92 @@
+# include <mesh/test-geometry.h>
+
+# include <cmath>
+
+   namespace
+  {
+      using Mesh2 = Mesh<2,double>;
+
+   // every cached face has the area and centre of the surface through its nodes, and its normal points towards increasing index
+      bool faces_match_nodes( const Mesh2& mesh )
+     {
+         const auto& n = mesh.nodes;
+         const size_t ni = mesh.cells.shape(0);
+         const size_t nj = mesh.cells.shape(1);
+
+         bool match=true;
+
+         const auto check = [&]( const geom::Surface<2,double>& face,
+                                 const geom::Point<2,double>&     p0,
+                                 const geom::Point<2,double>&     p1,
+                                 const geom::Direction<2,double>& dx )
+        {
+            const auto s = geom::surface( p0, p1 );
+            match = match && std::abs( face.area-s.area )<1e-12
+                          && std::abs( face.centre[0]-s.centre[0] )<1e-12
+                          && std::abs( face.centre[1]-s.centre[1] )<1e-12
+                          && face.metric[0][0]*dx[0] + face.metric[0][1]*dx[1] > 0.;
+        };
+
+      // i-normal faces, between nodes {i,j} and {i,j+1}
+         for( size_t i=0; i<=ni; ++i )
+        {
+            for( size_t j=0; j<nj; ++j )
+           {
+               const size_t i0 = i<ni ? i : i-1;
+               check( mesh.faces[0]({i,j}), n({i,j}), n({i,j+1}), n({i0+1,j})-n({i0,j}) );
+           }
+        }
+
+      // j-normal faces, between nodes {i,j} and {i+1,j}
+         for( size_t i=0; i<ni; ++i )
+        {
+            for( size_t j=0; j<=nj; ++j )
+           {
+               const size_t j0 = j<nj ? j : j-1;
+               check( mesh.faces[1]({i,j}), n({i,j}), n({i+1,j}), n({i,j0+1})-n({i,j0}) );
+           }
+        }
+         return match;
+     }
+  }
+
+/*
+ * the faces cached by updateGeometry on a small stretched and skewed mesh match the surfaces through their nodes, serially and in parallel
+ */
+   void Test_mesh_geometry::test_faces_from_nodes()
+  {
+      for( const int p : {0,1} )
+     {
+         Mesh2 mesh(par::DualShape<2>{5,4});
+         par::generate_idx( mesh.nodes, []( const par::PrimalIdx<2>& idx )
+                                       {
+                                           const double x = idx[0]*( 1.+0.2*idx[0] ) + 0.1*idx[1]*idx[1];
+                                           const double y = 0.5*idx[1]*( 1.+0.3*idx[1] ) - 0.05*idx[0];
+                                           return geom::Point<2,double>{{x,y}};
+                                       } );
+
+         if( p==0 ){ updateGeometry( mesh ); }
+         if( p==1 ){ updateGeometry( par::execution::omp, mesh ); }
+
+         CPPUNIT_ASSERT( faces_match_nodes( mesh ) );
+     }
+  }
+
+/*
+ * the cylinder mesh generator caches its face geometry, and its cells tile the polygonal annulus between the cylinder and outer boundary
+ */
+   void Test_mesh_geometry::test_cylinder_mesh()
+  {
+      const double rc=1., rb=3.;
+      const size_t nr=4, nth=12;
+
+      const Mesh2 mesh = make_cylinder_mesh<double>( {rc,rb}, {nr,nth} );
+
+      CPPUNIT_ASSERT( faces_match_nodes( mesh ) );
+
+      double volume=0;
+      par::for_each_idx( [&]( const par::DualIdx<2>&, const geom::Volume<2,double>& c ){ volume+=c.volume; }, mesh.cells );
+
+      const double area = 0.5*nth*std::sin( 2.*M_PI/nth )*( rb*rb - rc*rc );
+      CPPUNIT_ASSERT_DOUBLES_EQUAL( area, volume, 1e-12*area );
+  }
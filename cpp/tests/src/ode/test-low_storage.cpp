@@ -0,0 +1,162 @@
+# include <ode/test-low_storage.h>
+
+# include <array>
+# include <cmath>
+# include <vector>
+
+   namespace
+  {
+      using Vec = std::array<double,2>;
+
+   // du/dt = A*u, with A a damped rotation, so the stages of a scheme do not commute with each other trivially
+      Vec rhs( const Vec& u ){ return Vec{ -0.5*u[0] + 2.*u[1], -2.*u[0] - 0.5*u[1] }; }
+
+      Vec exact( const double t, const Vec& u0 )
+     {
+         const double d = std::exp( -0.5*t );
+         const double c = std::cos( 2.*t );
+         const double s = std::sin( 2.*t );
+         return Vec{ d*( c*u0[0] + s*u0[1] ), d*( -s*u0[0] + c*u0[1] ) };
+     }
+
+   // one timestep of a classical scheme: u_(s+1) = u^n + beta[s]*dt*sum( alpha[s][k]*R(u_k) ), as in rungeKuttaStageUpdate
+      Vec step( const ODE::Explicit::RungeKutta<double>& rk, const double dt, const Vec& un )
+     {
+         std::array<Vec,6> r;
+
+         Vec u=un;
+         for( unsigned int s=0; s<rk.nstages; ++s )
+        {
+            r[s] = rhs( u );
+
+            u = un;
+            for( unsigned int k=0; k<=s; ++k )
+           {
+               for( int i=0; i<2; ++i ){ u[i]+= rk.beta[s]*dt*rk.alpha[s][k]*r[k][i]; }
+           }
+        }
+         return u;
+     }
+
+   // one timestep of a low-storage scheme: dU = a[s]*dU + R(U), then U = (1-gamma[s])*U + gamma[s]*U^n + b[s]*dt*dU
+      Vec step( const ODE::Explicit::LowStorage::RungeKutta<double>& rk, const double dt, const Vec& un )
+     {
+         Vec u=un;
+         Vec du{0.,0.};
+         for( unsigned int s=0; s<rk.nstages; ++s )
+        {
+            const Vec r = rhs( u );
+            for( int i=0; i<2; ++i )
+           {
+               du[i] = rk.a[s]*du[i] + r[i];
+               u[i]  = (1.-rk.gamma[s])*u[i] + rk.gamma[s]*un[i] + rk.b[s]*dt*du[i];
+           }
+        }
+         return u;
+     }
+
+   // error at t=1 after n timesteps
+      template<typename RungeKuttaT>
+      double error( const RungeKuttaT& rk, const int n )
+     {
+         const Vec u0{1.,0.5};
+         const double dt = 1./n;
+
+         Vec u=u0;
+         for( int i=0; i<n; ++i ){ u = step( rk, dt, u ); }
+
+         const Vec ue = exact( 1., u0 );
+         return std::hypot( u[0]-ue[0], u[1]-ue[1] );
+     }
+
+   // observed order of accuracy from the errors with n and 2n timesteps
+      template<typename RungeKuttaT>
+      double order( const RungeKuttaT& rk, const int n ){ return std::log2( error( rk, n )/error( rk, 2*n ) ); }
+  }
+
+/*
+ * the low-storage forms of the SSP schemes give the same solution as their classical forms, to round-off
+ */
+   void Test_ode_low_storage::test_matches_classical()
+  {
+      using namespace ODE::Explicit;
+
+      const std::vector<std::pair<RungeKutta<double>,LowStorage::RungeKutta<double>>> schemes
+     {
+         { ssp11<double>(), LowStorage::ssp11<double>() },
+         { ssp22<double>(), LowStorage::ssp22<double>() },
+         { ssp33<double>(), LowStorage::ssp33<double>() },
+         { ssp34<double>(), LowStorage::ssp34<double>() }
+     };
+
+      for( const auto& scheme : schemes )
+     {
+         CPPUNIT_ASSERT_EQUAL( scheme.first.nstages, scheme.second.nstages );
+         CPPUNIT_ASSERT_EQUAL( scheme.first.order,   scheme.second.order   );
+
+         for( const double dt : {0.01,0.1,0.4} )
+        {
+            Vec uc{1.,0.5};
+            Vec ul{1.,0.5};
+            for( int n=0; n<10; ++n )
+           {
+               uc = step( scheme.first,  dt, uc );
+               ul = step( scheme.second, dt, ul );
+           }
+            CPPUNIT_ASSERT_DOUBLES_EQUAL( uc[0], ul[0], 1e-14 );
+            CPPUNIT_ASSERT_DOUBLES_EQUAL( uc[1], ul[1], 1e-14 );
+        }
+     }
+  }
+
+/*
+ * every low-storage scheme converges at its stated order of accuracy
+ */
+   void Test_ode_low_storage::test_order()
+  {
+      using namespace ODE::Explicit;
+
+      std::vector<LowStorage::RungeKutta<double>> schemes{ LowStorage::ssp11<double>(),
+                                                           LowStorage::ssp22<double>(),
+                                                           LowStorage::ssp33<double>(),
+                                                           LowStorage::ssp34<double>(),
+                                                           LowStorage::williamson3<double>(),
+                                                           LowStorage::carpenterKennedy4<double>() };
+
+      for( unsigned int s=2; s<=6; ++s ){ schemes.push_back( LowStorage::sspS2<double>( s ) ); }
+
+      for( const LowStorage::RungeKutta<double>& rk : schemes )
+     {
+         CPPUNIT_ASSERT_DOUBLES_EQUAL( double(rk.order), order( rk, 40 ), 0.1 );
+     }
+  }
+
+/*
+ * the registers each scheme needs: Williamson (2N) schemes only the increment, Ketcheson (2S*) schemes only the initial solution
+ */
+   void Test_ode_low_storage::test_registers()
+  {
+      using namespace ODE::Explicit::LowStorage;
+
+      CPPUNIT_ASSERT( !usesIncrement( ssp11<double>() ) );
+      CPPUNIT_ASSERT( !usesInitial(   ssp11<double>() ) );
+
+      CPPUNIT_ASSERT( !usesIncrement( ssp34<double>() ) );
+      CPPUNIT_ASSERT(  usesInitial(   ssp34<double>() ) );
+
+      CPPUNIT_ASSERT( !usesIncrement( sspS2<double>(4) ) );
+      CPPUNIT_ASSERT(  usesInitial(   sspS2<double>(4) ) );
+
+      CPPUNIT_ASSERT(  usesIncrement( williamson3<double>() ) );
+      CPPUNIT_ASSERT( !usesInitial(   williamson3<double>() ) );
+
+      CPPUNIT_ASSERT(  usesIncrement( carpenterKennedy4<double>() ) );
+      CPPUNIT_ASSERT( !usesInitial(   carpenterKennedy4<double>() ) );
+
+   // the first stage never reads the previous increment or the initial solution
+      for( const RungeKutta<double>& rk : { ssp22<double>(), ssp33<double>(), williamson3<double>(), carpenterKennedy4<double>() } )
+     {
+         CPPUNIT_ASSERT_EQUAL( 0., rk.a[0] );
+         CPPUNIT_ASSERT_EQUAL( 0., rk.gamma[0] );
+     }
+  }
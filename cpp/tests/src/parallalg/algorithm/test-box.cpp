@@ -0,0 +1,188 @@
+
+# include <parallalg/algorithm/test-box.h>
+
+# include <vector>
+
+/*
+ * only the elements inside the box are visited, and functors see their index in the whole array
+ */
+   void Test_par_box::test_for_each_and_transform()
+  {
+      const par::Shape<2> shape{6,8};
+      const par::Box<2>   box{ par::Idx<2>{1,2}, par::Idx<2>{4,7} };
+
+      for( const int p : {0,1,2} )
+     {
+         par::Array<double,2> a(shape,0.);
+         par::Array<double,2> b(shape,-1.,par::padded);
+
+         const auto set_idx = []( const par::Idx<2>& idx, double& v ){ v = 10.*idx[0]+idx[1]; };
+         const auto twice   = []( const double v ){ return 2.*v; };
+
+         if( p==0 ){ par::for_each_idx( par::execution::seq,  box, set_idx, a ); par::transform( par::execution::seq,  box, twice, b, a ); }
+         if( p==1 ){ par::for_each_idx( par::execution::omp,  box, set_idx, a ); par::transform( par::execution::omp,  box, twice, b, a ); }
+         if( p==2 ){ par::for_each_idx( par::execution::pool, box, set_idx, a ); par::transform( par::execution::pool, box, twice, b, a ); }
+
+         CPPUNIT_ASSERT_EQUAL( 12., a({1,2}) );
+         CPPUNIT_ASSERT_EQUAL( 36., a({3,6}) );
+         CPPUNIT_ASSERT_EQUAL(  0., a({0,2}) );
+         CPPUNIT_ASSERT_EQUAL(  0., a({3,7}) );
+
+         CPPUNIT_ASSERT_EQUAL( 72., b({3,6}) );
+         CPPUNIT_ASSERT_EQUAL( -1., b({4,6}) );
+         CPPUNIT_ASSERT_EQUAL( -1., b({1,1}) );
+     }
+
+      CPPUNIT_ASSERT( par::box_within( box, shape ) );
+      CPPUNIT_ASSERT( !par::box_within( par::Box<2>{ par::Idx<2>{0,0}, par::Idx<2>{7,8} }, shape ) );
+      CPPUNIT_ASSERT( par::box_shape( par::whole_box( shape ) ) == shape );
+  }
+
+/*
+ * reductions over a box match the reduction of a copy of the box, for every policy
+ */
+   void Test_par_box::test_transform_reduce()
+  {
+      const par::Shape<3> shape{20,30,40};
+      const par::Box<3>   box{ par::Idx<3>{2,0,5}, par::Idx<3>{19,30,33} };
+
+      par::Array<double,3> a(shape);
+      par::generate_idx( a, []( const par::Idx<3>& idx ){ return 1./(1.+idx[0]+0.1*idx[1]+0.01*idx[2]); } );
+
+      par::Array<double,3> sub(par::box_shape(box));
+      par::copy( sub, par::subview( a, box ) );
+
+      const auto val = []( const double v ){ return v; };
+      const auto sum = []( const double l, const double r ){ return l+r; };
+
+      const double ref = par::transform_reduce( par::execution::seq, val, sum, 0., par::subview( a, box ) );
+
+      CPPUNIT_ASSERT_DOUBLES_EQUAL( par::transform_reduce( par::execution::seq, val, sum, 0., sub ), ref, 1e-10 );
+
+      CPPUNIT_ASSERT_EQUAL( ref, par::transform_reduce( par::execution::seq,      box, val, sum, 0., a ) );
+      CPPUNIT_ASSERT_EQUAL( ref, par::transform_reduce( par::execution::omp,      box, val, sum, 0., a ) );
+      CPPUNIT_ASSERT_EQUAL( ref, par::transform_reduce( par::execution::omp_simd, box, val, sum, 0., a ) );
+      CPPUNIT_ASSERT_EQUAL( ref, par::transform_reduce( par::execution::pool,     box, val, sum, 0., a ) );
+  }
+
+/*
+ * only faces between two elements inside the box are accumulated, with every accumulation scheme
+ */
+   void Test_par_box::test_neighbour_accumulation()
+  {
+      const par::Shape<2> shape{7,9};
+      const par::Box<2>   box{ par::Idx<2>{2,1}, par::Idx<2>{6,8} };
+
+      par::Array<double,2> q(shape);
+      par::generate_idx( q, []( const par::Idx<2>& idx ){ return double(idx[0]*idx[1]) + 0.5*idx[1]; } );
+
+      const auto diff = []( const double ql, const double qr ){ return qr-ql; };
+      const auto accl = []( const double r, const double f ){ return r+f; };
+      const auto accr = []( const double r, const double f ){ return r-f; };
+
+   // reference: accumulate over a copy of the box
+      par::Array<double,2> qsub(par::box_shape(box));
+      par::Array<double,2> rsub(par::box_shape(box),0.);
+      par::copy( qsub, par::subview( q, box ) );
+      par::neighbour_accumulation( diff, accl, accr, rsub, qsub );
+
+      const auto check = [&]( const par::Array<double,2>& r )
+     {
+         bool match=true;
+         par::for_each_idx( [&]( const par::Idx<2>& idx, const double v )
+                           {
+                               const bool inside = idx[0]>=2 && idx[0]<6 && idx[1]>=1 && idx[1]<8;
+                               match = match && v==( inside ? rsub(par::Idx<2>{idx[0]-2,idx[1]-1}) : 0. );
+                           }, r );
+         return match;
+     };
+
+      for( const int p : {0,1,2,3} )
+     {
+         par::Array<double,2> r(shape,0.);
+
+         if( p==0 ){ par::neighbour_accumulation( par::execution::seq,                               box, diff, accl, accr, r, q ); }
+         if( p==1 ){ par::neighbour_accumulation( par::execution::omp,  par::accumulation::gather,   box, diff, accl, accr, r, q ); }
+         if( p==2 ){ par::neighbour_accumulation( par::execution::pool, par::Tiling<2>{2,3},         box, diff, accl, accr, r, q ); }
+         if( p==3 ){ par::neighbour_accumulation( par::execution::omp_simd,                          box, diff, accl, accr, r, q ); }
+
+         CPPUNIT_ASSERT( check( r ) );
+     }
+
+   // edge functions are passed indices in the whole array
+      par::Array<double,2> r(shape,0.);
+      par::neighbour_accumulation_idx( par::execution::omp, box,
+                                       [&]( const par::Idx<2>& il, const par::Idx<2>& ir, const double ql, const double qr )
+                                      {
+                                          return (ql==q(il) && qr==q(ir)) ? qr-ql : 1.e6;
+                                      },
+                                       accl, accr, r, q );
+      CPPUNIT_ASSERT( check( r ) );
+  }
+
+/*
+ * empty boxes, single element boxes and boxes of a single row or column, including boxes on the edge of the array
+ *    every element of the box is visited once, reductions over an empty box return init, and a box one element wide has no faces across it
+ */
+   void Test_par_box::test_edge_cases()
+  {
+      const par::Shape<2> shape{5,8};
+
+      const std::vector<par::Box<2>> boxes{ { par::Idx<2>{3,4}, par::Idx<2>{3,4} },
+                                            { par::Idx<2>{0,8}, par::Idx<2>{5,8} },
+                                            { par::Idx<2>{2,3}, par::Idx<2>{3,4} },
+                                            { par::Idx<2>{4,0}, par::Idx<2>{5,8} },
+                                            { par::Idx<2>{0,7}, par::Idx<2>{5,8} } };
+
+      par::Array<double,2> q(shape);
+      par::generate_idx( q, []( const par::Idx<2>& idx ){ return double(idx[0]*idx[1]) + 0.5*idx[1]; } );
+
+      const auto val  = []( const double v ){ return v; };
+      const auto sum  = []( const double l, const double r ){ return l+r; };
+      const auto diff = []( const double ql, const double qr ){ return qr-ql; };
+      const auto accl = []( const double r, const double f ){ return r+f; };
+      const auto accr = []( const double r, const double f ){ return r-f; };
+
+      for( const par::Box<2>& box : boxes )
+     {
+         CPPUNIT_ASSERT( par::box_within( box, shape ) );
+
+         const double n = double( par::length( par::box_shape( box ) ) );
+
+         for( const int p : {0,1,2,3} )
+        {
+            par::Array<double,2> hits(shape,0.);
+            par::Array<double,2> r(shape,0.);
+
+            const auto hit = []( const par::Idx<2>&, double& h ){ h+=1.; };
+
+            double total=0.;
+            if( p==0 ){ par::for_each_idx( par::execution::seq,      box, hit, hits ); total = par::transform_reduce( par::execution::seq,      box, val, sum, 1., hits );
+                        par::neighbour_accumulation( par::execution::seq,                       box, diff, accl, accr, r, q ); }
+            if( p==1 ){ par::for_each_idx( par::execution::omp,      box, hit, hits ); total = par::transform_reduce( par::execution::omp,      box, val, sum, 1., hits );
+                        par::neighbour_accumulation( par::execution::omp, par::accumulation::gather, box, diff, accl, accr, r, q ); }
+            if( p==2 ){ par::for_each_idx( par::execution::pool,     box, hit, hits ); total = par::transform_reduce( par::execution::pool,     box, val, sum, 1., hits );
+                        par::neighbour_accumulation( par::execution::pool, par::Tiling<2>{2,3},       box, diff, accl, accr, r, q ); }
+            if( p==3 ){ par::for_each_idx( par::execution::omp,      box, hit, hits ); total = par::transform_reduce( par::execution::omp_simd, box, val, sum, 1., hits );
+                        par::neighbour_accumulation( par::execution::omp_simd,                  box, diff, accl, accr, r, q ); }
+
+         // every element of the box once, and none outside it
+            CPPUNIT_ASSERT_EQUAL( 1.+n, total );
+            CPPUNIT_ASSERT_EQUAL( n, par::transform_reduce( par::execution::seq, val, sum, 0., hits ) );
+
+         // the accumulation over the box matches accumulation over a copy of the box, and does not write outside it
+            par::Array<double,2> qsub(par::box_shape(box));
+            par::Array<double,2> rsub(par::box_shape(box),0.);
+            par::copy( qsub, par::subview( q, box ) );
+            par::neighbour_accumulation( diff, accl, accr, rsub, qsub );
+
+            bool match=true;
+            par::for_each_idx( [&]( const par::Idx<2>& idx, const double v )
+                              {
+                                  const bool inside = idx[0]>=box.first[0] && idx[0]<box.last[0] && idx[1]>=box.first[1] && idx[1]<box.last[1];
+                                  match = match && v==( inside ? rsub(par::Idx<2>{idx[0]-box.first[0],idx[1]-box.first[1]}) : 0. );
+                              }, r );
+            CPPUNIT_ASSERT( match );
+        }
+     }
+  }
@@ -0,0 +1,85 @@
+# include <parallalg/algorithm/test-colour.h>
+
+/*
+ * accumulate the difference across every face into the elements either side with face colouring, and compare with serial execution
+ *    the source values are integers, so every sum is exact and any lost or repeated update shows up as a mismatch
+ */
+   template<typename Policy,
+            int         NDIM>
+   bool colour_matches_serial( const Policy policy, const par::Shape<NDIM>& shape )
+  {
+      par::Array<double,NDIM> q(shape);
+      par::generate_idx( q, []( const par::Idx<NDIM>& idx )
+                           {
+                               double v=1.;
+                               for( int d=0; d<NDIM; ++d ){ v += (d+2)*double(idx[d]) + double(idx[d]*idx[d]%5); }
+                               return v;
+                           } );
+
+      const auto diff = []( const double ql, const double qr ){ return qr-ql; };
+      const auto accl = []( const double r, const double f ){ return r+f; };
+      const auto accr = []( const double r, const double f ){ return r-2.*f; };
+
+      par::Array<double,NDIM> ref(shape,0.);
+      par::neighbour_accumulation( par::execution::seq, diff, accl, accr, ref, q );
+
+      par::Array<double,NDIM> r(shape,0.);
+      par::neighbour_accumulation( policy, par::accumulation::colour, diff, accl, accr, r, q );
+
+      bool match=true;
+      par::for_each( [&]( const double v, const double vref ){ match = match && v==vref; }, r, ref );
+      return match;
+  }
+
+/*
+ * 1D, with odd and even extents, a single element and no elements
+ */
+   void Test_par_colour::test_colour_1d()
+  {
+      for( const size_t ni : {0,1,2,7,8,33} )
+     {
+         const par::Shape<1> shape{ni};
+
+         CPPUNIT_ASSERT( colour_matches_serial( par::execution::simd,                   shape ) );
+         CPPUNIT_ASSERT( colour_matches_serial( par::execution::omp,                    shape ) );
+         CPPUNIT_ASSERT( colour_matches_serial( par::execution::omp.with_threads(3),    shape ) );
+         CPPUNIT_ASSERT( colour_matches_serial( par::execution::omp_simd,               shape ) );
+         CPPUNIT_ASSERT( colour_matches_serial( par::execution::pool,                   shape ) );
+     }
+  }
+
+/*
+ * 2D, with odd and even extents in each dimension, a single row or column and no rows or columns
+ */
+   void Test_par_colour::test_colour_2d()
+  {
+      const std::vector<par::Shape<2>> shapes{ {7,9}, {8,6}, {5,8}, {1,7}, {9,1}, {3,2}, {0,5}, {6,0} };
+
+      for( const par::Shape<2>& shape : shapes )
+     {
+         CPPUNIT_ASSERT( colour_matches_serial( par::execution::simd,                   shape ) );
+         CPPUNIT_ASSERT( colour_matches_serial( par::execution::omp,                    shape ) );
+         CPPUNIT_ASSERT( colour_matches_serial( par::execution::omp.with_collapse(2),   shape ) );
+         CPPUNIT_ASSERT( colour_matches_serial( par::execution::omp.with_threads(3),    shape ) );
+         CPPUNIT_ASSERT( colour_matches_serial( par::execution::omp_simd,               shape ) );
+         CPPUNIT_ASSERT( colour_matches_serial( par::execution::pool,                   shape ) );
+     }
+  }
+
+/*
+ * 3D, with odd and even extents in each dimension, a single layer and no layers
+ */
+   void Test_par_colour::test_colour_3d()
+  {
+      const std::vector<par::Shape<3>> shapes{ {5,3,7}, {4,6,3}, {7,7,7}, {1,5,3}, {3,1,4}, {4,3,1}, {0,3,4}, {3,0,2}, {2,5,0} };
+
+      for( const par::Shape<3>& shape : shapes )
+     {
+         CPPUNIT_ASSERT( colour_matches_serial( par::execution::simd,                   shape ) );
+         CPPUNIT_ASSERT( colour_matches_serial( par::execution::omp,                    shape ) );
+         CPPUNIT_ASSERT( colour_matches_serial( par::execution::omp.with_collapse(3),   shape ) );
+         CPPUNIT_ASSERT( colour_matches_serial( par::execution::omp.with_threads(3),    shape ) );
+         CPPUNIT_ASSERT( colour_matches_serial( par::execution::omp_simd,               shape ) );
+         CPPUNIT_ASSERT( colour_matches_serial( par::execution::pool,                   shape ) );
+     }
+  }
@@ -0,0 +1,143 @@
+
+# include <parallalg/algorithm/test-expression.h>
+
+/*
+ * arithmetic on arrays, scalars and nested expressions is evaluated when assigned
+ */
+   void Test_par_expression::test_arithmetic()
+  {
+      par::Array<double,2> a(par::Shape<2>{3,4});
+      par::Array<double,2> b(par::Shape<2>{3,4});
+      par::Array<double,2> c(par::Shape<2>{3,4},0.);
+
+      par::generate_idx( a, []( const par::Idx<2>& idx ){ return 10.*idx[0]+idx[1]; } );
+      par::fill( b, 2. );
+
+   // nothing is evaluated until assignment
+      const auto expr = a + 0.5*b/b - (-a);
+      CPPUNIT_ASSERT_EQUAL( 0., c({2,3}) );
+
+      c = expr;
+      CPPUNIT_ASSERT_EQUAL(  0.5, c({0,0}) );
+      CPPUNIT_ASSERT_EQUAL( 46.5, c({2,3}) );
+
+   // the destination can appear in the expression
+      c = 2.*c - 1.;
+      CPPUNIT_ASSERT_EQUAL(  0., c({0,0}) );
+      CPPUNIT_ASSERT_EQUAL( 92., c({2,3}) );
+
+   // evaluation into a new array
+      const auto d = par::evaluate( a*b );
+      CPPUNIT_ASSERT( d.shape() == a.shape() );
+      CPPUNIT_ASSERT_EQUAL( 46., d({2,3}) );
+  }
+
+/*
+ * every policy gives the same result, for arrays with the same storage (flattened path) and with different halo, padding or views (index path)
+ */
+   void Test_par_expression::test_policies_and_storage()
+  {
+      const par::Shape<3> shape{5,6,7};
+
+      par::Array<double,3> a(shape);
+      par::Array<double,3> b(shape,par::halo_layout(1,par::padded));
+
+      par::generate_idx( a, []( const par::Idx<3>& idx ){ return idx[0]+2.*idx[1]+3.*idx[2]; } );
+      par::copy( b, a );
+
+      const auto check = [&]( const auto& dst, const double scale )
+     {
+         bool match=true;
+         par::for_each_idx( [&]( const par::Idx<3>& idx, const double v ){ match = match && v==scale*a(idx)+1.; }, dst );
+         return match;
+     };
+
+      for( const int p : {0,1,2,3,4} )
+     {
+         par::Array<double,3> same(shape,0.);
+         par::Array<double,3> halo(shape,-1.,par::halo_layout(1));
+
+         const auto expr = a + b + 1.;
+
+         if( p==0 ){ par::assign( par::execution::seq,      same, expr ); par::assign( par::execution::seq,      halo, expr ); }
+         if( p==1 ){ par::assign( par::execution::omp,      same, expr ); par::assign( par::execution::omp,      halo, expr ); }
+         if( p==2 ){ par::assign( par::execution::simd,     same, expr ); par::assign( par::execution::simd,     halo, expr ); }
+         if( p==3 ){ par::assign( par::execution::omp_simd, same, expr ); par::assign( par::execution::omp_simd, halo, expr ); }
+         if( p==4 ){ par::assign( par::execution::pool,     same, expr ); par::assign( par::execution::pool,     halo, expr ); }
+
+         CPPUNIT_ASSERT( check( same, 2. ) );
+         CPPUNIT_ASSERT( check( halo, 2. ) );
+
+      // the halo of the destination is not written
+         CPPUNIT_ASSERT_EQUAL( -1., halo( par::Idx<3>{0,0,0} + par::Offset<3>{-1,0,0} ) );
+     }
+
+   // views as operands and as destination
+      par::Array<double,3> c(shape,0.);
+      auto cv = par::view( c );
+      cv = par::view( a ) + 1.;
+      CPPUNIT_ASSERT( check( c, 1. ) );
+  }
+
+/*
+ * arbitrary element functions, and operands with different element types
+ */
+   void Test_par_expression::test_lazy_transform()
+  {
+      par::Array<double,1> a(par::Shape<1>{10});
+      par::Array<int,1>    n(par::Shape<1>{10});
+      par::Array<double,1> r(par::Shape<1>{10},0.);
+
+      par::generate_idx( a, []( const par::Idx<1>& idx ){ return 0.5*idx[0]; } );
+      par::generate_idx( n, []( const par::Idx<1>& idx ){ return int(idx[0]%3); } );
+
+      const auto scale = []( const double v, const int k ){ return v*k; };
+
+      par::assign( par::execution::omp, r, par::lazy_transform( scale, a, n ) + a );
+      CPPUNIT_ASSERT_EQUAL( 0.,     r({0}) );
+      CPPUNIT_ASSERT_EQUAL( 3.*2.5, r({5}) );
+      CPPUNIT_ASSERT_EQUAL( 4.5,    r({9}) );
+  }
+
+/*
+ * empty and single element arrays, and rows which are not a multiple of the vector width, on the flattened and the index paths
+ */
+   void Test_par_expression::test_edge_cases()
+  {
+      const size_t w = par::simd_lanes;
+
+      for( const size_t n : { size_t{0}, size_t{1}, w-1, w+1 } )
+     {
+         for( const size_t ni : {0,1,3} )
+        {
+            const par::Shape<2> shape{ni,n};
+
+            par::Array<double,2> a(shape);
+            par::generate_idx( a, []( const par::Idx<2>& idx ){ return 3.*idx[0]+idx[1]; } );
+
+            for( const int p : {0,1,2,3,4} )
+           {
+               par::Array<double,2> same(shape,0.);
+               par::Array<double,2> padded(shape,0.,par::padded);
+
+               const auto expr = 2.*a - 1.;
+
+               if( p==0 ){ par::assign( par::execution::seq,      same, expr ); par::assign( par::execution::seq,      padded, expr ); }
+               if( p==1 ){ par::assign( par::execution::omp,      same, expr ); par::assign( par::execution::omp,      padded, expr ); }
+               if( p==2 ){ par::assign( par::execution::simd,     same, expr ); par::assign( par::execution::simd,     padded, expr ); }
+               if( p==3 ){ par::assign( par::execution::omp_simd, same, expr ); par::assign( par::execution::omp_simd, padded, expr ); }
+               if( p==4 ){ par::assign( par::execution::pool,     same, expr ); par::assign( par::execution::pool,     padded, expr ); }
+
+               bool match=true;
+               par::for_each_idx( [&]( const par::Idx<2>& idx, const double u, const double v )
+                                 {
+                                     match = match && u==2.*a(idx)-1. && v==u;
+                                 }, same, padded );
+               CPPUNIT_ASSERT( match );
+           }
+
+            const auto e = par::evaluate( par::execution::omp, a + a );
+            CPPUNIT_ASSERT( e.shape() == shape );
+        }
+     }
+  }
@@ -0,0 +1,90 @@
+# include <parallalg/algorithm/test-gather.h>
+
+/*
+ * accumulate the difference across every face into the elements either side with face gather, and compare with serial execution
+ *    the accumulation functions do not commute, so the result is only the same if every element is accumulated in the serial order:
+ *    faces in dimension 0 before 1 before 2, and in each dimension the face on the left of the element before the face on its right
+ *    the source values are integers, so the comparison is exact
+ */
+   template<typename Policy,
+            int         NDIM>
+   bool gather_matches_serial( const Policy policy, const par::Shape<NDIM>& shape )
+  {
+      par::Array<double,NDIM> q(shape);
+      par::generate_idx( q, []( const par::Idx<NDIM>& idx )
+                           {
+                               double v=1.;
+                               for( int d=0; d<NDIM; ++d ){ v += (d+2)*double(idx[d]) + double(idx[d]*idx[d]%5); }
+                               return v;
+                           } );
+
+      const auto diff = []( const double ql, const double qr ){ return qr-ql; };
+      const auto accl = []( const double r, const double f ){ return 3.*r+f; };
+      const auto accr = []( const double r, const double f ){ return 5.*r-f; };
+
+      par::Array<double,NDIM> ref(shape,1.);
+      par::neighbour_accumulation( par::execution::seq, diff, accl, accr, ref, q );
+
+      par::Array<double,NDIM> r(shape,1.);
+      par::neighbour_accumulation( policy, par::accumulation::gather, diff, accl, accr, r, q );
+
+      bool match=true;
+      par::for_each( [&]( const double v, const double vref ){ match = match && v==vref; }, r, ref );
+      return match;
+  }
+
+/*
+ * 1D, with odd and even extents, a single element and no elements
+ */
+   void Test_par_gather::test_gather_1d()
+  {
+      const auto dynamic = par::execution::omp.with_schedule( par::execution::Schedule::Dynamic, 2 );
+
+      for( const size_t ni : {0,1,2,7,8,33} )
+     {
+         const par::Shape<1> shape{ni};
+
+         CPPUNIT_ASSERT( gather_matches_serial( par::execution::omp,                   shape ) );
+         CPPUNIT_ASSERT( gather_matches_serial( par::execution::omp.with_threads(3),   shape ) );
+         CPPUNIT_ASSERT( gather_matches_serial( dynamic,                               shape ) );
+         CPPUNIT_ASSERT( gather_matches_serial( par::execution::omp_simd,              shape ) );
+     }
+  }
+
+/*
+ * 2D, with odd and even extents in each dimension, a single row or column and no rows or columns
+ */
+   void Test_par_gather::test_gather_2d()
+  {
+      const auto dynamic = par::execution::omp.with_schedule( par::execution::Schedule::Dynamic, 2 );
+
+      const std::vector<par::Shape<2>> shapes{ {7,9}, {8,6}, {5,8}, {1,7}, {9,1}, {3,2}, {0,5}, {6,0} };
+
+      for( const par::Shape<2>& shape : shapes )
+     {
+         CPPUNIT_ASSERT( gather_matches_serial( par::execution::omp,                   shape ) );
+         CPPUNIT_ASSERT( gather_matches_serial( par::execution::omp.with_collapse(2),  shape ) );
+         CPPUNIT_ASSERT( gather_matches_serial( par::execution::omp.with_threads(3),   shape ) );
+         CPPUNIT_ASSERT( gather_matches_serial( dynamic,                               shape ) );
+         CPPUNIT_ASSERT( gather_matches_serial( par::execution::omp_simd,              shape ) );
+     }
+  }
+
+/*
+ * 3D, with odd and even extents in each dimension, a single layer and no layers
+ */
+   void Test_par_gather::test_gather_3d()
+  {
+      const auto dynamic = par::execution::omp.with_schedule( par::execution::Schedule::Dynamic, 2 );
+
+      const std::vector<par::Shape<3>> shapes{ {5,3,7}, {4,6,3}, {7,7,7}, {1,5,3}, {3,1,4}, {4,3,1}, {0,3,4}, {3,0,2}, {2,5,0} };
+
+      for( const par::Shape<3>& shape : shapes )
+     {
+         CPPUNIT_ASSERT( gather_matches_serial( par::execution::omp,                   shape ) );
+         CPPUNIT_ASSERT( gather_matches_serial( par::execution::omp.with_collapse(3),  shape ) );
+         CPPUNIT_ASSERT( gather_matches_serial( par::execution::omp.with_threads(3),   shape ) );
+         CPPUNIT_ASSERT( gather_matches_serial( dynamic,                               shape ) );
+         CPPUNIT_ASSERT( gather_matches_serial( par::execution::omp_simd,              shape ) );
+     }
+  }
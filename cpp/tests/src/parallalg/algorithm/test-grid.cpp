@@ -0,0 +1,174 @@
+
+# include <parallalg/algorithm/test-grid.h>
+
+# include <vector>
+
+/*
+ * each cell is computed from its corner nodes, dimension 0 changing fastest, in 1, 2 and 3 dimensions and with every policy
+ */
+   void Test_par_grid::test_cells_from_nodes()
+  {
+      par::PrimalArray<double,1> nodes1(par::PrimalShape<1>{6});
+      par::DualArray<double,1>   cells1(par::DualShape<1>{5},0.);
+      par::generate_idx( nodes1, []( const par::PrimalIdx<1>& idx ){ return double(idx[0]*idx[0]); } );
+
+      par::cells_from_nodes( []( const double n0, const double n1 ){ return n1-n0; }, cells1, nodes1 );
+      CPPUNIT_ASSERT_EQUAL( 1., cells1({0}) );
+      CPPUNIT_ASSERT_EQUAL( 9., cells1({4}) );
+
+      par::PrimalArray<double,2> nodes2(par::PrimalShape<2>{4,5});
+      par::DualArray<double,2>   cells2(par::DualShape<2>{3,4},0.);
+      par::generate_idx( nodes2, []( const par::PrimalIdx<2>& idx ){ return 10.*idx[0]+idx[1]; } );
+
+      par::cells_from_nodes( par::execution::omp,
+                             []( const double n0, const double n1, const double n2, const double n3 ){ return n0+2.*n1+4.*n2+8.*n3; },
+                             cells2, nodes2 );
+   // corners {0,0}, {1,0}, {0,1}, {1,1} of cell {2,3} are 23, 33, 24, 34
+      CPPUNIT_ASSERT_EQUAL( 23.+66.+96.+272., cells2({2,3}) );
+
+      const par::PrimalShape<3> shape3{5,4,6};
+      par::PrimalArray<double,3> nodes3(shape3);
+      par::generate_idx( nodes3, []( const par::PrimalIdx<3>& idx ){ return 100.*idx[0]+10.*idx[1]+idx[2]; } );
+
+      const auto average = []( const auto... n ){ return ( n + ... )/8.; };
+
+      for( const int p : {0,1,2} )
+     {
+         par::DualArray<double,3> cells3(par::dualShape(shape3),0.);
+
+         if( p==0 ){ par::cells_from_nodes( par::execution::seq,  average, cells3, nodes3 ); }
+         if( p==1 ){ par::cells_from_nodes( par::execution::omp,  average, cells3, nodes3 ); }
+         if( p==2 ){ par::cells_from_nodes( par::execution::pool, average, cells3, nodes3 ); }
+
+         bool match=true;
+         par::for_each_idx( [&]( const par::DualIdx<3>& idx, const double v ){ match = match && v==100.*idx[0]+10.*idx[1]+idx[2]+55.5; }, cells3 );
+         CPPUNIT_ASSERT( match );
+     }
+  }
+
+/*
+ * nodes are computed from their surrounding cells, away from the boundary without a halo and everywhere with a halo
+ */
+   void Test_par_grid::test_nodes_from_cells()
+  {
+      const par::DualShape<2> shape{4,3};
+
+      const auto average = []( const double c0, const double c1, const double c2, const double c3 ){ return 0.25*(c0+c1+c2+c3); };
+      const auto linear  = []( const par::DualIdx<2>& idx ){ return 2.*idx[0]+idx[1]; };
+
+      par::DualArray<double,2> cells(shape);
+      par::generate_idx( cells, linear );
+
+      par::PrimalArray<double,2> nodes(par::primalShape(shape),-1.);
+      par::nodes_from_cells( par::execution::omp, average, nodes, cells );
+
+   // node {i,j} is the corner between cells {i-1,j-1} and {i,j}
+      CPPUNIT_ASSERT_EQUAL( 2.*0.5+0.5, nodes({1,1}) );
+      CPPUNIT_ASSERT_EQUAL( 2.*2.5+1.5, nodes({3,2}) );
+      CPPUNIT_ASSERT_EQUAL( -1., nodes({0,1}) );
+      CPPUNIT_ASSERT_EQUAL( -1., nodes({4,3}) );
+
+   // fill the halo by linear extrapolation, then every node is computed
+      par::DualArray<double,2> halo(shape,par::halo_layout(1));
+      auto all = par::halo_view( halo );
+      par::generate_idx( all, [&]( const par::DualIdx<2>& idx ){ return linear( idx ) - 3.; } );
+
+      par::nodes_from_cells( par::execution::pool, average, nodes, halo );
+      CPPUNIT_ASSERT_EQUAL( -1.5,       nodes({0,0}) );
+      CPPUNIT_ASSERT_EQUAL( 2.*3.5+2.5, nodes({4,3}) );
+  }
+
+/*
+ * faces normal to each dimension are computed from their nodes, ordered so the normal points towards increasing index
+ */
+   void Test_par_grid::test_faces_from_nodes()
+  {
+      const par::PrimalShape<2> shape{5,4};
+
+      par::PrimalArray<par::PrimalIdx<2>,2> nodes(shape);
+      par::generate_idx( nodes, []( const par::PrimalIdx<2>& idx ){ return idx; } );
+
+      using NodePair = std::array<par::PrimalIdx<2>,2>;
+      const auto pair = []( const par::PrimalIdx<2>& n0, const par::PrimalIdx<2>& n1 ){ return NodePair{n0,n1}; };
+
+      par::PrimalArray<NodePair,2> ifaces(par::faceShape( par::dualShape( shape ), 0 ));
+      par::PrimalArray<NodePair,2> jfaces(par::faceShape( par::dualShape( shape ), 1 ));
+
+      CPPUNIT_ASSERT( ifaces.shape() == (par::PrimalShape<2>{5,3}) );
+      CPPUNIT_ASSERT( jfaces.shape() == (par::PrimalShape<2>{4,4}) );
+
+      par::faces_from_nodes( par::execution::omp,  0, pair, ifaces, nodes );
+      par::faces_from_nodes( par::execution::pool, 1, pair, jfaces, nodes );
+
+   // i-face {i,j} runs from node {i,j} to {i,j+1}, j-face {i,j} runs from node {i+1,j} to {i,j}
+      bool match=true;
+      par::for_each_idx( [&]( const par::PrimalIdx<2>& idx, const NodePair& f )
+                        {
+                            match = match && f[0].idxs==idx.idxs && f[1].idxs==(par::PrimalIdx<2>{idx[0],idx[1]+1}).idxs;
+                        }, ifaces );
+      par::for_each_idx( [&]( const par::PrimalIdx<2>& idx, const NodePair& f )
+                        {
+                            match = match && f[0].idxs==(par::PrimalIdx<2>{idx[0]+1,idx[1]}).idxs && f[1].idxs==idx.idxs;
+                        }, jfaces );
+      CPPUNIT_ASSERT( match );
+
+   // 3D faces have 4 nodes
+      const par::PrimalShape<3> shape3{3,4,5};
+      par::PrimalArray<double,3> nodes3(shape3,1.);
+      par::PrimalArray<double,3> kfaces(par::faceShape( par::dualShape( shape3 ), 2 ),0.);
+
+      par::faces_from_nodes( 2, []( const auto... n ){ return ( n + ... ); }, kfaces, nodes3 );
+      CPPUNIT_ASSERT( kfaces.shape() == (par::PrimalShape<3>{2,3,5}) );
+      CPPUNIT_ASSERT_EQUAL( 4., kfaces({1,2,4}) );
+  }
+
+/*
+ * grids of a single cell, and grids with a single line of nodes and so no cells, with every policy
+ *    nodes are only computed from cells when the halo supplies the missing neighbours
+ */
+   void Test_par_grid::test_small_grids()
+  {
+      const auto sum4 = []( const double n0, const double n1, const double n2, const double n3 ){ return n0+n1+n2+n3; };
+      const auto sum2 = []( const double n0, const double n1 ){ return n0+n1; };
+
+      for( const par::PrimalShape<2>& shape : std::vector<par::PrimalShape<2>>{ {2,2}, {1,4}, {3,1}, {1,1} } )
+     {
+         par::PrimalArray<double,2> nodes(shape,1.);
+         const par::DualShape<2> cshape = par::dualShape( shape );
+
+         for( const int p : {0,1,2} )
+        {
+            par::DualArray<double,2>   cells(cshape,0.);
+            par::PrimalArray<double,2> inner(shape,-1.);
+            par::PrimalArray<double,2> ifaces(par::faceShape( cshape, 0 ),0.);
+            par::PrimalArray<double,2> jfaces(par::faceShape( cshape, 1 ),0.);
+
+            par::DualArray<double,2> halo(cshape,2.,par::halo_layout(1));
+            par::PrimalArray<double,2> all(shape,-1.);
+
+            if( p==0 ){ par::cells_from_nodes( par::execution::seq,  sum4, cells, nodes );
+                        par::nodes_from_cells( par::execution::seq,  sum4, inner, cells );
+                        par::nodes_from_cells( par::execution::seq,  sum4, all,   halo  );
+                        par::faces_from_nodes( par::execution::seq,  0, sum2, ifaces, nodes );
+                        par::faces_from_nodes( par::execution::seq,  1, sum2, jfaces, nodes ); }
+            if( p==1 ){ par::cells_from_nodes( par::execution::omp,  sum4, cells, nodes );
+                        par::nodes_from_cells( par::execution::omp,  sum4, inner, cells );
+                        par::nodes_from_cells( par::execution::omp,  sum4, all,   halo  );
+                        par::faces_from_nodes( par::execution::omp,  0, sum2, ifaces, nodes );
+                        par::faces_from_nodes( par::execution::omp,  1, sum2, jfaces, nodes ); }
+            if( p==2 ){ par::cells_from_nodes( par::execution::pool, sum4, cells, nodes );
+                        par::nodes_from_cells( par::execution::pool, sum4, inner, cells );
+                        par::nodes_from_cells( par::execution::pool, sum4, all,   halo  );
+                        par::faces_from_nodes( par::execution::pool, 0, sum2, ifaces, nodes );
+                        par::faces_from_nodes( par::execution::pool, 1, sum2, jfaces, nodes ); }
+
+            bool match=true;
+            par::for_each( [&]( const double v ){ match = match && v==4.; }, cells );
+            par::for_each( [&]( const double v ){ match = match && v==-1.; }, inner );
+            par::for_each( [&]( const double v ){ match = match && v==8.; }, all );
+            par::for_each( [&]( const double v ){ match = match && v==2.; }, ifaces );
+            par::for_each( [&]( const double v ){ match = match && v==2.; }, jfaces );
+            CPPUNIT_ASSERT( match );
+        }
+     }
+  }
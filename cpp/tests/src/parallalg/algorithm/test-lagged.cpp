@@ -0,0 +1,222 @@
+
+# include <parallalg/algorithm/test-lagged.h>
+
+/*
+ * count the faces visited by each function by the element on their left, one counter per direction and function
+ */
+   template<typename Policy,
+            int         NDIM>
+   bool count_lagged_faces( const Policy policy, const par::Shape<NDIM>& shape )
+  {
+      using Counts = std::array<int,2*NDIM>;
+
+      par::Array<Counts,NDIM> n(shape,Counts{});
+
+      const auto neighbours = []( const par::Idx<NDIM>& l, const par::Idx<NDIM>& r, const int dim )
+     {
+         bool nb=true;
+         for( int d=0; d<NDIM; ++d ){ nb = nb && r[d]==l[d]+(d==dim ? 1 : 0); }
+         return nb;
+     };
+
+      par::for_each_face_lagged( policy,
+                                 [&]( const par::Idx<NDIM>& l, const par::Idx<NDIM>& r, const int dim )
+                                {
+                                    if( neighbours( l,r,dim ) ){ n(l)[dim] += 1; }
+                                },
+                                 [&]( const par::Idx<NDIM>& l, const par::Idx<NDIM>& r, const int dim )
+                                {
+                                    if( neighbours( l,r,dim ) ){ n(l)[NDIM+dim] += 1; }
+                                },
+                                 shape );
+
+      bool match=true;
+      par::for_each_idx( [&]( const par::Idx<NDIM>& idx, const Counts& v )
+                        {
+                            for( int d=0; d<NDIM; ++d )
+                           {
+                               const int expected = idx[d]<shape[d]-1 ? 1 : 0;
+                               match = match && v[d]==expected && v[NDIM+d]==expected;
+                           }
+                        }, n );
+      return match;
+  }
+
+/*
+ * count the boundary faces visited by the element inside them, one counter per boundary, and check that first_func has visited every
+ * face of the element and of the element at the other end of the array in the normal dimension before each boundary face is visited
+ */
+   template<typename Policy,
+            int         NDIM>
+   bool count_boundary_faces( const Policy policy, const par::Shape<NDIM>& shape )
+  {
+      using Counts = std::array<int,2*NDIM>;
+
+      par::Array<Counts,NDIM> n(shape,Counts{});
+
+      par::Array<int,NDIM> nbrs(shape,0);
+      par::for_each_face( [&]( const par::Idx<NDIM>& l, const par::Idx<NDIM>& r, const int ){ ++nbrs(l); ++nbrs(r); }, shape );
+
+      par::Array<int,NDIM> visited(shape,0);
+      std::atomic<bool> complete{true};
+
+      par::for_each_face_lagged( policy,
+                                 [&]( const par::Idx<NDIM>& l, const par::Idx<NDIM>& r, const int ){ ++visited(l); ++visited(r); },
+                                 []( const par::Idx<NDIM>&, const par::Idx<NDIM>&, const int ){},
+                                 [&]( const par::Idx<NDIM>& idx, const int dim, const bool high )
+                                {
+                                    par::Idx<NDIM> other=idx;
+                                    other.idxs[dim] = high ? 0 : shape[dim]-1;
+
+                                    if( visited(idx)!=nbrs(idx) || visited(other)!=nbrs(other) ){ complete=false; }
+
+                                    n(idx)[2*dim+(high ? 1 : 0)] += 1;
+                                },
+                                 shape );
+
+      bool match=complete;
+      par::for_each_idx( [&]( const par::Idx<NDIM>& idx, const Counts& v )
+                        {
+                            for( int d=0; d<NDIM; ++d )
+                           {
+                               match = match && v[2*d  ]==(idx[d]==0          ? 1 : 0)
+                                             && v[2*d+1]==(idx[d]==shape[d]-1 ? 1 : 0);
+                           }
+                        }, n );
+      return match;
+  }
+
+/*
+ * every interior face is visited exactly once by each function, in 1, 2 and 3 dimensions and with every policy, including shapes
+ * with no elements, a single element, or a single row or column
+ */
+   void Test_par_lagged::test_faces_visited()
+  {
+      for( const size_t ni : {0,1,3,4,17} )
+     {
+         CPPUNIT_ASSERT( count_lagged_faces( par::execution::seq,      par::Shape<1>{ni}     ) );
+         CPPUNIT_ASSERT( count_lagged_faces( par::execution::omp,      par::Shape<1>{ni}     ) );
+         CPPUNIT_ASSERT( count_lagged_faces( par::execution::pool,     par::Shape<1>{ni}     ) );
+         CPPUNIT_ASSERT( count_lagged_faces( par::execution::seq,      par::Shape<2>{ni,6}   ) );
+         CPPUNIT_ASSERT( count_lagged_faces( par::execution::simd,     par::Shape<2>{ni,6}   ) );
+         CPPUNIT_ASSERT( count_lagged_faces( par::execution::omp,      par::Shape<2>{ni,6}   ) );
+         CPPUNIT_ASSERT( count_lagged_faces( par::execution::omp_simd, par::Shape<2>{ni,6}   ) );
+         CPPUNIT_ASSERT( count_lagged_faces( par::execution::pool,     par::Shape<2>{ni,6}   ) );
+         CPPUNIT_ASSERT( count_lagged_faces( par::execution::omp,      par::Shape<3>{ni,4,5} ) );
+         CPPUNIT_ASSERT( count_lagged_faces( par::execution::pool,     par::Shape<3>{ni,4,5} ) );
+
+         CPPUNIT_ASSERT( count_lagged_faces( par::execution::omp,                  par::Shape<2>{6,ni}   ) );
+         CPPUNIT_ASSERT( count_lagged_faces( par::execution::omp.with_threads(3), par::Shape<2>{6,ni}   ) );
+         CPPUNIT_ASSERT( count_lagged_faces( par::execution::pool,                 par::Shape<2>{6,ni}   ) );
+         CPPUNIT_ASSERT( count_lagged_faces( par::execution::omp,                  par::Shape<3>{3,ni,1} ) );
+         CPPUNIT_ASSERT( count_lagged_faces( par::execution::pool,                 par::Shape<3>{1,4,ni} ) );
+     }
+  }
+
+/*
+ * the second function only reaches a face once the first has visited every face of the elements either side of it
+ */
+   void Test_par_lagged::test_lag()
+  {
+      const par::Shape<2> shape{23,9};
+
+   // number of neighbours of each element
+      par::Array<int,2> nbrs(shape,0);
+      par::for_each_face( [&]( const par::Idx<2>& l, const par::Idx<2>& r, const int ){ ++nbrs(l); ++nbrs(r); }, shape );
+
+      for( const int p : {0,1,2,3} )
+     {
+         par::Array<int,2> visited(shape,0);
+         par::Array<int,2> complete(shape,1);
+
+         const auto first  = [&]( const par::Idx<2>& l, const par::Idx<2>& r, const int ){ ++visited(l); ++visited(r); };
+         const auto second = [&]( const par::Idx<2>& l, const par::Idx<2>& r, const int )
+        {
+            complete(l) = complete(l) && visited(l)==nbrs(l) && visited(r)==nbrs(r);
+        };
+
+         if( p==0 ){ par::for_each_face_lagged( first, second, shape ); }
+         if( p==1 ){ par::for_each_face_lagged( par::execution::omp,                  first, second, shape ); }
+         if( p==2 ){ par::for_each_face_lagged( par::execution::omp.with_threads(5), first, second, shape ); }
+         if( p==3 ){ par::for_each_face_lagged( par::execution::pool,                 first, second, shape ); }
+
+         bool match=true;
+         par::for_each_idx( [&]( const par::Idx<2>&, const int c ){ match = match && c==1; }, complete );
+         CPPUNIT_ASSERT( match );
+     }
+  }
+
+/*
+ * a lagged sweep gives the same result as a sweep of each function in turn, exactly in serial
+ */
+   void Test_par_lagged::test_two_pass()
+  {
+      const par::Shape<2> shape{31,12};
+
+      par::Array<double,2> q(shape);
+      par::generate_idx( q, []( const par::Idx<2>& idx ){ return std::sin( 0.3*idx[0] ) + 0.1*idx[1]*idx[0] - 0.02*idx[1]*idx[1]; } );
+
+   // gradient-like accumulation, then a flux from the accumulated values
+      const auto sweep = [&]( const int p, par::Array<double,2>& res )
+     {
+         par::Array<double,2> g(shape,0.);
+
+         const auto first  = [&]( const par::Idx<2>& l, const par::Idx<2>& r, const int dim )
+        {
+            const double d = (1.+dim)*(q(r)-q(l));
+            g(l)+=d;
+            g(r)+=d;
+        };
+         const auto second = [&]( const par::Idx<2>& l, const par::Idx<2>& r, const int )
+        {
+            const double f = 0.5*(q(l)+q(r)) + 0.25*(g(l)-g(r));
+            res(l)-=f;
+            res(r)+=f;
+        };
+
+         if( p==0 )
+        {
+            par::for_each_face( first, shape );
+            par::for_each_face( second, shape );
+        }
+         if( p==1 ){ par::for_each_face_lagged( par::execution::seq,  first, second, shape ); }
+         if( p==2 ){ par::for_each_face_lagged( par::execution::omp,  first, second, shape ); }
+         if( p==3 ){ par::for_each_face_lagged( par::execution::pool, first, second, shape ); }
+     };
+
+      par::Array<double,2> ref(shape,0.);
+      sweep( 0, ref );
+
+      for( const int p : {1,2,3} )
+     {
+         par::Array<double,2> res(shape,0.);
+         sweep( p, res );
+
+         bool match=true;
+         par::for_each_idx( [&]( const par::Idx<2>& idx, const double v ){ match = match && std::abs( v-ref(idx) )<1e-12; }, res );
+         CPPUNIT_ASSERT( match );
+     }
+  }
+
+/*
+ * every boundary face is visited exactly once, once its element and the element at the other end of the array are complete,
+ * in 1, 2 and 3 dimensions and with every policy, including shapes with no elements, a single element, or a single row or column
+ */
+   void Test_par_lagged::test_boundary_faces()
+  {
+      for( const size_t ni : {0,1,3,4,17} )
+     {
+         CPPUNIT_ASSERT( count_boundary_faces( par::execution::seq,                  par::Shape<1>{ni}     ) );
+         CPPUNIT_ASSERT( count_boundary_faces( par::execution::omp,                  par::Shape<1>{ni}     ) );
+         CPPUNIT_ASSERT( count_boundary_faces( par::execution::pool,                 par::Shape<1>{ni}     ) );
+         CPPUNIT_ASSERT( count_boundary_faces( par::execution::seq,                  par::Shape<2>{ni,6}   ) );
+         CPPUNIT_ASSERT( count_boundary_faces( par::execution::omp,                  par::Shape<2>{ni,6}   ) );
+         CPPUNIT_ASSERT( count_boundary_faces( par::execution::omp.with_threads(3), par::Shape<2>{ni,6}   ) );
+         CPPUNIT_ASSERT( count_boundary_faces( par::execution::pool,                 par::Shape<2>{ni,6}   ) );
+         CPPUNIT_ASSERT( count_boundary_faces( par::execution::omp,                  par::Shape<3>{ni,4,5} ) );
+         CPPUNIT_ASSERT( count_boundary_faces( par::execution::pool,                 par::Shape<3>{ni,4,5} ) );
+
+         CPPUNIT_ASSERT( count_boundary_faces( par::execution::omp,                  par::Shape<2>{6,ni}   ) );
+         CPPUNIT_ASSERT( count_boundary_faces( par::execution::pool,                 par::Shape<3>{1,4,ni} ) );
+     }
+  }
@@ -0,0 +1,115 @@
+
+# include <parallalg/algorithm/test-neighbour3d.h>
+
+# include <vector>
+
+/*
+ * every element of a 3D array is visited once with its own index, by every policy with and without tiling
+ */
+   void Test_par_neighbour3d::test_for_each_idx()
+  {
+      const par::Shape<3> shape{5,7,9};
+
+      const auto set_idx = []( const par::Idx<3>& idx, int& v ){ v += 100*idx[0]+10*idx[1]+idx[2]; };
+
+      const par::Tiling<3> tiling{2,3,4};
+
+      for( const int p : {0,1,2,3,4} )
+     {
+         par::Array<int,3> a(shape,0);
+
+         if( p==0 ){ par::for_each_idx( par::execution::seq,          set_idx, a ); }
+         if( p==1 ){ par::for_each_idx( par::execution::omp,          set_idx, a ); }
+         if( p==2 ){ par::for_each_idx( par::execution::pool,         set_idx, a ); }
+         if( p==3 ){ par::for_each_idx( par::execution::seq,  tiling, set_idx, a ); }
+         if( p==4 ){ par::for_each_idx( par::execution::omp,  tiling, set_idx, a ); }
+
+         bool match=true;
+         par::for_each_idx( [&]( const par::Idx<3>& idx, const int v ){ match = match && v==100*int(idx[0])+10*int(idx[1])+int(idx[2]); }, a );
+         CPPUNIT_ASSERT( match );
+     }
+  }
+
+/*
+ * every interior face is visited exactly once, in the direction normal to it, by every policy and accumulation scheme,
+ * including arrays of a single element, a single line or plane of elements, and no elements
+ */
+   void Test_par_neighbour3d::test_for_each_face()
+  {
+      const std::vector<par::Shape<3>> shapes{ {6,5,7}, {1,1,1}, {1,5,1}, {2,1,3}, {4,3,1}, {0,4,3}, {3,0,2}, {2,3,0} };
+
+   // count faces by the element on their left, one counter per direction
+      const auto count = [&]( const auto policy, const auto scheme, const par::Shape<3>& shape )
+     {
+         par::Array<std::array<int,3>,3> n(shape,std::array<int,3>{0,0,0});
+
+         bool in_range=true;
+         par::for_each_face( policy, scheme,
+                             [&]( const par::Idx<3>& l, const par::Idx<3>& r, const int dim )
+                            {
+                                bool neighbours=true;
+                                for( int d=0; d<3; ++d ){ neighbours = neighbours && r[d]==l[d]+(d==dim ? 1 : 0) && r[d]<shape[d]; }
+                                if( neighbours ){ n(l)[dim] += 1; }
+                                else            { in_range = false; }
+                            },
+                             shape );
+
+         bool match=in_range;
+         par::for_each_idx( [&]( const par::Idx<3>& idx, const std::array<int,3>& v )
+                           {
+                               for( int d=0; d<3; ++d ){ match = match && v[d]==( idx[d]+1<shape[d] ? 1 : 0 ); }
+                           }, n );
+         return match;
+     };
+
+      for( const par::Shape<3>& shape : shapes )
+     {
+         CPPUNIT_ASSERT( count( par::execution::seq,      par::accumulation::colour, shape ) );
+         CPPUNIT_ASSERT( count( par::execution::simd,     par::accumulation::colour, shape ) );
+         CPPUNIT_ASSERT( count( par::execution::omp,      par::accumulation::colour, shape ) );
+         CPPUNIT_ASSERT( count( par::execution::omp_simd, par::accumulation::colour, shape ) );
+         CPPUNIT_ASSERT( count( par::execution::pool,     par::accumulation::colour, shape ) );
+         CPPUNIT_ASSERT( count( par::execution::seq,      par::Tiling<3>{2,3,4},     shape ) );
+         CPPUNIT_ASSERT( count( par::execution::omp,      par::Tiling<3>{4,2,3},     shape ) );
+         CPPUNIT_ASSERT( count( par::execution::pool,     par::Tiling<3>{3,3,3},     shape ) );
+     }
+  }
+
+/*
+ * accumulation over all three face directions matches serial execution, exactly for the face gather
+ */
+   void Test_par_neighbour3d::test_neighbour_accumulation()
+  {
+      const par::Shape<3> shape{6,8,5};
+
+      par::Array<double,3> q(shape);
+      par::generate_idx( q, []( const par::Idx<3>& idx ){ return 1./(1.+idx[0]) + 0.3*idx[1]*idx[1] - 0.01*idx[2]*idx[0]; } );
+
+      const auto diff = []( const double ql, const double qr ){ return qr-ql; };
+      const auto accl = []( const double r, const double f ){ return r+f; };
+      const auto accr = []( const double r, const double f ){ return r-f; };
+
+      par::Array<double,3> ref(shape,0.);
+      par::neighbour_accumulation( par::execution::seq, diff, accl, accr, ref, q );
+
+      for( const int p : {0,1,2,3,4,5,6} )
+     {
+         par::Array<double,3> r(shape,0.);
+
+         if( p==0 ){ par::neighbour_accumulation( par::execution::omp,      par::accumulation::gather, diff, accl, accr, r, q ); }
+         if( p==1 ){ par::neighbour_accumulation( par::execution::omp,      par::accumulation::colour, diff, accl, accr, r, q ); }
+         if( p==2 ){ par::neighbour_accumulation( par::execution::simd,     par::accumulation::colour, diff, accl, accr, r, q ); }
+         if( p==3 ){ par::neighbour_accumulation( par::execution::omp_simd, par::accumulation::colour, diff, accl, accr, r, q ); }
+         if( p==4 ){ par::neighbour_accumulation( par::execution::pool,     par::accumulation::colour, diff, accl, accr, r, q ); }
+         if( p==5 ){ par::neighbour_accumulation( par::execution::omp,      par::Tiling<3>{2,3,2},     diff, accl, accr, r, q ); }
+         if( p==6 ){ par::neighbour_accumulation( par::execution::pool,     par::Tiling<3>{3,4,5},     diff, accl, accr, r, q ); }
+
+         bool match=true;
+         par::for_each_idx( [&]( const par::Idx<3>& idx, const double v )
+                           {
+                               if( p==0 ){ match = match && v==ref(idx); }
+                               else      { match = match && std::abs( v-ref(idx) )<1e-12; }
+                           }, r );
+         CPPUNIT_ASSERT( match );
+     }
+  }
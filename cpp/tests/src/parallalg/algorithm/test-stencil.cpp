@@ -0,0 +1,154 @@
+
+# include <parallalg/algorithm/test-stencil.h>
+
+# include <vector>
+
+   namespace
+  {
+      const auto laplacian = []( const double c, const double w, const double e, const double s, const double n )
+     {
+         return w + e + s + n - 4.*c;
+     };
+
+      double quadratic( const par::Idx<2>& idx ){ return double(idx[0]*idx[0]) + 2.*double(idx[1]*idx[1]); }
+  }
+
+/*
+ * arrays without a halo are only updated away from their edges, arrays with a halo are updated everywhere
+ */
+   void Test_par_stencil::test_laplacian_bounds()
+  {
+      const par::Shape<2> shape{6,7};
+
+      par::Array<double,2> q(shape);
+      par::Array<double,2> r(shape,-1.);
+      par::generate_idx( q, quadratic );
+
+      par::stencil( par::stencils::laplacian5, laplacian, r, q );
+
+   // laplacian of i^2 + 2j^2 is 6
+      CPPUNIT_ASSERT_EQUAL( 6., r({1,1}) );
+      CPPUNIT_ASSERT_EQUAL( 6., r({4,5}) );
+      CPPUNIT_ASSERT_EQUAL( -1., r({0,3}) );
+      CPPUNIT_ASSERT_EQUAL( -1., r({5,3}) );
+      CPPUNIT_ASSERT_EQUAL( -1., r({2,6}) );
+
+   // fill the halo with the same function, then every element is updated
+      par::Array<double,2> qh(shape,par::halo_layout(1));
+      auto all = par::halo_view( qh );
+      par::generate_idx( all, []( const par::Idx<2>& idx ){ return quadratic( par::Idx<2>{idx[0]-1,idx[1]-1} ); } );
+
+      par::stencil( par::stencils::laplacian5, laplacian, r, qh );
+      CPPUNIT_ASSERT_EQUAL( 6., r({0,0}) );
+      CPPUNIT_ASSERT_EQUAL( 6., r({5,6}) );
+
+   // one-sided stencils along one dimension
+      const auto range = par::stencil_range( par::stencils::weno5<2,1>, shape, q );
+      CPPUNIT_ASSERT_EQUAL( size_t(0), range.first[0] );
+      CPPUNIT_ASSERT_EQUAL( size_t(2), range.first[1] );
+      CPPUNIT_ASSERT_EQUAL( size_t(6), range.second[0] );
+      CPPUNIT_ASSERT_EQUAL( size_t(5), range.second[1] );
+  }
+
+/*
+ * every policy, with and without tiling, gives the same result for sources with the same and with different storage
+ */
+   void Test_par_stencil::test_policies_and_storage()
+  {
+      const par::Shape<3> shape{5,6,7};
+
+      par::Array<double,3> a(shape);
+      par::Array<double,3> b(shape,par::padded);
+      par::generate_idx( a, []( const par::Idx<3>& idx ){ return idx[0] + 3.*idx[1]*idx[1] + 0.5*idx[2]; } );
+      par::copy( b, a );
+
+      const auto sum = []( const double a0, const double a1, const double a2, const double a3, const double a4, const double a5, const double a6,
+                           const double b0, const double b1, const double b2, const double b3, const double b4, const double b5, const double b6 )
+     {
+         return (a1 + a2 + a3 + a4 + a5 + a6 - 6.*a0) - (b1 + b2 + b3 + b4 + b5 + b6 - 6.*b0) + a0;
+     };
+
+      par::Array<double,3> ref(shape,0.);
+      par::stencil( par::stencils::laplacian7, sum, ref, a, a );
+
+      const par::Tiling<3> tiling{2,4,3};
+
+      for( const int p : {0,1,2,3,4,5} )
+     {
+         par::Array<double,3> r(shape,0.);
+
+         if( p==0 ){ par::stencil( par::execution::omp,          par::stencils::laplacian7, sum, r, a, b ); }
+         if( p==1 ){ par::stencil( par::execution::pool,         par::stencils::laplacian7, sum, r, a, b ); }
+         if( p==2 ){ par::stencil( par::execution::omp_simd,     par::stencils::laplacian7, sum, r, a, a ); }
+         if( p==3 ){ par::stencil( par::execution::seq,  tiling, par::stencils::laplacian7, sum, r, a, b ); }
+         if( p==4 ){ par::stencil( par::execution::omp,  tiling, par::stencils::laplacian7, sum, r, a, a ); }
+         if( p==5 ){ par::stencil( par::execution::pool, tiling, par::stencils::laplacian7, sum, r, par::view( a ), b ); }
+
+         bool match=true;
+         par::for_each_idx( [&]( const par::Idx<3>& idx, const double v ){ match = match && v==ref(idx); }, r );
+         CPPUNIT_ASSERT( match );
+     }
+
+      CPPUNIT_ASSERT_EQUAL( 0., ref({0,2,2}) );
+      CPPUNIT_ASSERT_EQUAL( a({2,3,4}), ref({2,3,4}) );
+  }
+
+/*
+ * destination on the dual grid, gathered from the nodes of each cell
+ */
+   void Test_par_stencil::test_dual_grid()
+  {
+      par::Array<double,2,par::Primal> nodes(par::Shape<2,par::Primal>{4,5});
+      par::Array<double,2,par::Dual>   cells(par::Shape<2,par::Dual>{3,4},0.);
+
+      par::generate_idx( nodes, []( const par::Idx<2,par::Primal>& idx ){ return 10.*idx[0]+idx[1]; } );
+
+      par::stencil( par::execution::omp, par::stencils::cell_nodes2,
+                    []( const double n0, const double n1, const double n2, const double n3 ){ return 0.25*(n0+n1+n2+n3); },
+                    cells, nodes );
+
+      CPPUNIT_ASSERT_EQUAL(  5.5, cells({0,0}) );
+      CPPUNIT_ASSERT_EQUAL( 28.5, cells({2,3}) );
+  }
+
+/*
+ * arrays narrower than the stencil, single element arrays and empty arrays, with and without a halo
+ *    no element is written when the stencil does not fit, and every element is written when the halo is as wide as the stencil
+ */
+   void Test_par_stencil::test_small_arrays()
+  {
+      const std::vector<par::Shape<2>> shapes{ {0,5}, {5,0}, {1,1}, {1,6}, {2,2}, {3,1} };
+
+      const par::Tiling<2> tiling{2,2};
+
+      for( const par::Shape<2>& shape : shapes )
+     {
+         par::Array<double,2> q(shape);
+         par::generate_idx( q, quadratic );
+
+         par::Array<double,2> qh(shape,par::halo_layout(1));
+         auto all = par::halo_view( qh );
+         par::generate_idx( all, []( const par::Idx<2>& idx ){ return quadratic( par::Idx<2>{idx[0]-1,idx[1]-1} ); } );
+
+         for( const int p : {0,1,2,3,4} )
+        {
+            par::Array<double,2> r(shape,-1.);
+            par::Array<double,2> rh(shape,-1.);
+
+            if( p==0 ){ par::stencil( par::execution::seq,              par::stencils::laplacian5, laplacian, r, q );
+                        par::stencil( par::execution::seq,              par::stencils::laplacian5, laplacian, rh, qh ); }
+            if( p==1 ){ par::stencil( par::execution::omp,              par::stencils::laplacian5, laplacian, r, q );
+                        par::stencil( par::execution::omp,              par::stencils::laplacian5, laplacian, rh, qh ); }
+            if( p==2 ){ par::stencil( par::execution::omp_simd,         par::stencils::laplacian5, laplacian, r, q );
+                        par::stencil( par::execution::omp_simd,         par::stencils::laplacian5, laplacian, rh, qh ); }
+            if( p==3 ){ par::stencil( par::execution::pool,             par::stencils::laplacian5, laplacian, r, q );
+                        par::stencil( par::execution::pool,             par::stencils::laplacian5, laplacian, rh, qh ); }
+            if( p==4 ){ par::stencil( par::execution::omp,      tiling, par::stencils::laplacian5, laplacian, r, q );
+                        par::stencil( par::execution::omp,      tiling, par::stencils::laplacian5, laplacian, rh, qh ); }
+
+            bool match=true;
+            par::for_each( [&]( const double v, const double vh ){ match = match && v==-1. && vh==6.; }, r, rh );
+            CPPUNIT_ASSERT( match );
+        }
+     }
+  }
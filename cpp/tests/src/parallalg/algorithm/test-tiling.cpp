@@ -0,0 +1,129 @@
+# include <parallalg/algorithm/test-tiling.h>
+
+/*
+ * visit every index of an array with tiles of the given shape, and check each index is visited exactly once
+ */
+   template<typename Policy,
+            int         NDIM>
+   bool tiles_visit_once( const Policy policy, const par::Tiling<NDIM>& tiling, const par::Shape<NDIM>& shape )
+  {
+      par::Array<int,NDIM> hits(shape,0);
+
+      par::for_each_idx( policy, tiling, []( const par::Idx<NDIM>&, int& h ){ h++; }, hits );
+
+      bool once=true;
+      par::for_each( [&]( const int h ){ once = once && h==1; }, hits );
+      return once;
+  }
+
+/*
+ * accumulate the difference across every face into the elements either side tile by tile, and compare with serial execution
+ *    the source values are integers, so every sum is exact and any lost or repeated update shows up as a mismatch
+ */
+   template<typename Policy,
+            int         NDIM>
+   bool tiles_match_serial( const Policy policy, const par::Tiling<NDIM>& tiling, const par::Shape<NDIM>& shape )
+  {
+      par::Array<double,NDIM> q(shape);
+      par::generate_idx( q, []( const par::Idx<NDIM>& idx )
+                           {
+                               double v=1.;
+                               for( int d=0; d<NDIM; ++d ){ v += (d+2)*double(idx[d]) + double(idx[d]*idx[d]%5); }
+                               return v;
+                           } );
+
+      const auto diff = []( const double ql, const double qr ){ return qr-ql; };
+      const auto accl = []( const double r, const double f ){ return r+f; };
+      const auto accr = []( const double r, const double f ){ return r-2.*f; };
+
+      par::Array<double,NDIM> ref(shape,0.);
+      par::neighbour_accumulation( par::execution::seq, diff, accl, accr, ref, q );
+
+      par::Array<double,NDIM> r(shape,0.);
+      par::neighbour_accumulation( policy, tiling, diff, accl, accr, r, q );
+
+      bool match=true;
+      par::for_each( [&]( const double v, const double vref ){ match = match && v==vref; }, r, ref );
+      return match;
+  }
+
+/*
+ * tiles which divide the array, which leave a truncated tile at the high end, which are larger than the array, and single elements,
+ * over arrays with a single element or none
+ */
+   void Test_par_tiling::test_every_index_once()
+  {
+      const std::vector<par::Shape<2>> shapes2{ {16,12}, {17,13}, {3,5}, {1,1}, {0,7} };
+      const std::vector<par::Tiling<2>> tiles2{ {4,4}, {5,3}, {32,32}, {1,1} };
+
+      for( const par::Shape<2>& shape : shapes2 )
+     {
+         for( const par::Tiling<2>& tiling : tiles2 )
+        {
+            CPPUNIT_ASSERT( tiles_visit_once( par::execution::seq,                 tiling, shape ) );
+            CPPUNIT_ASSERT( tiles_visit_once( par::execution::omp,                 tiling, shape ) );
+            CPPUNIT_ASSERT( tiles_visit_once( par::execution::omp.with_threads(3), tiling, shape ) );
+            CPPUNIT_ASSERT( tiles_visit_once( par::execution::pool,                tiling, shape ) );
+        }
+     }
+
+      const std::vector<par::Shape<3>> shapes3{ {8,6,4}, {9,7,5}, {1,1,1}, {4,0,3} };
+      const std::vector<par::Tiling<3>> tiles3{ {4,3,2}, {2,5,3}, {16,16,16}, {1,1,1} };
+
+      for( const par::Shape<3>& shape : shapes3 )
+     {
+         for( const par::Tiling<3>& tiling : tiles3 )
+        {
+            CPPUNIT_ASSERT( tiles_visit_once( par::execution::seq,                 tiling, shape ) );
+            CPPUNIT_ASSERT( tiles_visit_once( par::execution::omp,                 tiling, shape ) );
+            CPPUNIT_ASSERT( tiles_visit_once( par::execution::omp.with_threads(3), tiling, shape ) );
+            CPPUNIT_ASSERT( tiles_visit_once( par::execution::pool,                tiling, shape ) );
+        }
+     }
+  }
+
+/*
+ * as above, with tiles as the accumulation scheme of a neighbour accumulation, in 1D, 2D and 3D
+ *    faces on the boundary between two tiles are owned by the lower tile, so odd numbers of tiles in a dimension test the tile colouring
+ */
+   void Test_par_tiling::test_accumulation()
+  {
+      for( const size_t ni : {0,1,2,9,33} )
+     {
+         for( const size_t ti : {1,4,64} )
+        {
+            const par::Shape<1> shape{ni};
+            const par::Tiling<1> tiling{ti};
+
+            CPPUNIT_ASSERT( tiles_match_serial( par::execution::omp,                 tiling, shape ) );
+            CPPUNIT_ASSERT( tiles_match_serial( par::execution::omp.with_threads(3), tiling, shape ) );
+            CPPUNIT_ASSERT( tiles_match_serial( par::execution::pool,                tiling, shape ) );
+        }
+     }
+
+      const std::vector<par::Shape<2>> shapes2{ {16,12}, {17,13}, {3,5}, {1,1}, {0,7} };
+      const std::vector<par::Tiling<2>> tiles2{ {4,4}, {5,3}, {32,32}, {1,1} };
+
+      for( const par::Shape<2>& shape : shapes2 )
+     {
+         for( const par::Tiling<2>& tiling : tiles2 )
+        {
+            CPPUNIT_ASSERT( tiles_match_serial( par::execution::omp,                 tiling, shape ) );
+            CPPUNIT_ASSERT( tiles_match_serial( par::execution::omp.with_threads(3), tiling, shape ) );
+            CPPUNIT_ASSERT( tiles_match_serial( par::execution::pool,                tiling, shape ) );
+        }
+     }
+
+      const std::vector<par::Shape<3>> shapes3{ {8,6,4}, {9,7,5}, {1,1,1}, {4,0,3} };
+      const std::vector<par::Tiling<3>> tiles3{ {4,3,2}, {2,5,3}, {16,16,16}, {1,1,1} };
+
+      for( const par::Shape<3>& shape : shapes3 )
+     {
+         for( const par::Tiling<3>& tiling : tiles3 )
+        {
+            CPPUNIT_ASSERT( tiles_match_serial( par::execution::omp,                 tiling, shape ) );
+            CPPUNIT_ASSERT( tiles_match_serial( par::execution::omp.with_threads(3), tiling, shape ) );
+            CPPUNIT_ASSERT( tiles_match_serial( par::execution::pool,                tiling, shape ) );
+        }
+     }
+  }
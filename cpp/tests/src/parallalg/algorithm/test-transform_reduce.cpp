@@ -0,0 +1,210 @@
+
+# include <parallalg/algorithm/test-transform_reduce.h>
+
+# include <omp.h>
+
+   static const auto plus = []( const double l, const double r ){ return l+r; };
+   static const auto self = []( const double v ){ return v; };
+
+/*
+ * init is combined with the reduction exactly once, for any number of threads
+ */
+   void Test_par_transform_reduce::test_init_used_once()
+  {
+      const par::Array<double,1> a(par::Shape<1>{10000}, 1.);
+
+      const int nthreads = omp_get_max_threads();
+
+      for( int n=1; n<=4; ++n )
+     {
+         omp_set_num_threads(n);
+         CPPUNIT_ASSERT_EQUAL( 10010., par::transform_reduce( par::execution::omp, self, plus, 10., a ) );
+     }
+      omp_set_num_threads(nthreads);
+
+      CPPUNIT_ASSERT_EQUAL( 10010., par::transform_reduce( par::execution::seq, self, plus, 10., a ) );
+  }
+
+/*
+ * padding elements are not included in the reduction
+ */
+   void Test_par_transform_reduce::test_padded()
+  {
+      const par::Array<double,2> a(par::Shape<2>{300,37}, 1., par::padded);
+
+      CPPUNIT_ASSERT( !a.is_contiguous() );
+
+      CPPUNIT_ASSERT_EQUAL( 300.*37, par::transform_reduce( par::execution::omp, self, plus, 0., a ) );
+      CPPUNIT_ASSERT_EQUAL( 300.*37, par::transform_reduce( par::execution::seq, self, plus, 0., a ) );
+  }
+
+/*
+ * floating point sums are bitwise identical for serial execution and any number of threads
+ */
+   void Test_par_transform_reduce::test_deterministic()
+  {
+      par::Array<double,2> a(par::Shape<2>{257,129});
+
+      par::generate_idx( a, []( const par::Idx<2>& idx ){ return 1./(1.+idx[0]*129+idx[1]); } );
+
+      const double sum_seq = par::transform_reduce( par::execution::seq, self, plus, 0., a );
+
+      const int nthreads = omp_get_max_threads();
+
+      for( int n=1; n<=7; ++n )
+     {
+         omp_set_num_threads(n);
+         CPPUNIT_ASSERT_EQUAL( sum_seq, par::transform_reduce( par::execution::omp, self, plus, 0., a ) );
+     }
+      omp_set_num_threads(nthreads);
+  }
+
+/*
+ * empty and single element arrays, and lengths either side of a whole number of chunks, including odd numbers of chunks, which leave
+ * an unpaired partial at each level of the combination tree
+ *    results are bitwise identical for serial execution, any number of threads and the thread pool, and empty arrays reduce to init
+ */
+   void Test_par_transform_reduce::test_chunk_counts()
+  {
+      const size_t c = par::reduction_chunk_size;
+
+      const int nthreads = omp_get_max_threads();
+
+      for( const size_t n : { size_t{0}, size_t{1}, c-1, c, c+1, 3*c, 3*c+17, 5*c-1, 7*c+1 } )
+     {
+         par::Array<double,1> a(par::Shape<1>{n});
+         par::generate_idx( a, []( const par::Idx<1>& idx ){ return 1./(1.+idx[0]); } );
+
+         const double sum_seq = par::transform_reduce( par::execution::seq, self, plus, 10., a );
+
+         if( n==0 ){ CPPUNIT_ASSERT_EQUAL( 10., sum_seq ); }
+         if( n==1 ){ CPPUNIT_ASSERT_EQUAL( 11., sum_seq ); }
+
+         for( int t=1; t<=5; ++t )
+        {
+            omp_set_num_threads(t);
+            CPPUNIT_ASSERT_EQUAL( sum_seq, par::transform_reduce( par::execution::omp, self, plus, 10., a ) );
+        }
+         omp_set_num_threads(nthreads);
+
+         for( const unsigned int t : {1u,3u,4u} )
+        {
+            par::set_default_thread_pool_size(t);
+            CPPUNIT_ASSERT_EQUAL( sum_seq, par::transform_reduce( par::execution::pool, self, plus, 10., a ) );
+        }
+
+      // for_each_idx_reduce uses the same chunks
+         const auto update = []( const par::Idx<1>&, double& v ){ return v; };
+         CPPUNIT_ASSERT_EQUAL( sum_seq, par::for_each_idx_reduce( par::execution::omp,  update, plus, 10., a ) );
+         CPPUNIT_ASSERT_EQUAL( sum_seq, par::for_each_idx_reduce( par::execution::pool, update, plus, 10., a ) );
+     }
+  }
+
+/*
+ * vectorised sums are bitwise identical for serial execution and any number of threads
+ */
+   void Test_par_transform_reduce::test_simd_deterministic()
+  {
+      par::Array<double,2> a(par::Shape<2>{257,129}, par::padded);
+
+      par::generate_idx( a, []( const par::Idx<2>& idx ){ return 1./(1.+idx[0]*129+idx[1]); } );
+
+      const double sum_seq = par::transform_reduce( par::execution::seq,  self, plus, 0., a );
+      const double sum_vec = par::transform_reduce( par::execution::simd, self, plus, 0., a );
+
+      CPPUNIT_ASSERT_DOUBLES_EQUAL( sum_seq, sum_vec, 1e-12*sum_seq );
+
+      const int nthreads = omp_get_max_threads();
+
+      for( int n=1; n<=7; ++n )
+     {
+         omp_set_num_threads(n);
+         CPPUNIT_ASSERT_EQUAL( sum_vec, par::transform_reduce( par::execution::omp_simd, self, plus, 0., a ) );
+     }
+      omp_set_num_threads(nthreads);
+  }
+
+/*
+ * vectorised loops and reductions over lengths which are not a multiple of the vector width, including lengths shorter than one vector,
+ * a single element and none, in contiguous arrays and in padded rows
+ *    the values are integers, so vectorised sums are exact and must equal serial sums
+ */
+   void Test_par_transform_reduce::test_simd_lengths()
+  {
+      const size_t w = par::simd_lanes;
+
+      const auto check = []( const auto& a )
+     {
+         const auto twice = []( const double v ){ return 2.*v; };
+
+         const double sum_seq = par::transform_reduce( par::execution::seq, twice, plus, 1., a );
+
+         CPPUNIT_ASSERT_EQUAL( sum_seq, par::transform_reduce( par::execution::simd,     twice, plus, 1., a ) );
+         CPPUNIT_ASSERT_EQUAL( sum_seq, par::transform_reduce( par::execution::omp_simd, twice, plus, 1., a ) );
+
+         auto b = par::copy( a );
+         auto c = par::copy( a );
+         par::for_each( par::execution::simd,     []( double& v ){ v = 2.*v; }, b );
+         par::for_each( par::execution::omp_simd, []( double& v ){ v = 2.*v; }, c );
+
+         CPPUNIT_ASSERT_EQUAL( sum_seq, par::transform_reduce( par::execution::seq, self, plus, 1., b ) );
+         CPPUNIT_ASSERT_EQUAL( sum_seq, par::transform_reduce( par::execution::seq, self, plus, 1., c ) );
+     };
+
+      for( const size_t n : { size_t{0}, size_t{1}, w-1, w, w+1, 2*w+3, 3*w-1 } )
+     {
+         par::Array<double,1> a(par::Shape<1>{n});
+         par::generate_idx( a, []( const par::Idx<1>& idx ){ return double(idx[0]%7); } );
+         check( a );
+
+         for( const size_t ni : {1,3} )
+        {
+            par::Array<double,2> p(par::Shape<2>{ni,n}, par::padded);
+            par::generate_idx( p, []( const par::Idx<2>& idx ){ return double((idx[0]+idx[1])%7); } );
+            check( p );
+        }
+     }
+  }
+
+/*
+ * every destination element is updated once in the same sweep as the reduction, which matches transform_reduce for every policy
+ */
+   void Test_par_transform_reduce::test_for_each_idx_reduce()
+  {
+      const par::Shape<2> shape{131,67};
+
+      par::Array<double,2> a(shape, par::padded);
+      par::generate_idx( a, []( const par::Idx<2>& idx ){ return 1./(1.+idx[0]*67+idx[1]); } );
+
+      const double sum_ref = par::transform_reduce( par::execution::seq, []( const double v ){ return 2.*v; }, plus, 0., a );
+
+   // doubles each element of the destination and sums the new values, with a source which is not padded
+      const par::Array<double,2> scale(shape, 2.);
+      const auto update = []( const par::Idx<2>&, double& v, const double s ){ v*=s; return v; };
+
+      for( const int p : {0,1,2} )
+     {
+         par::Array<double,2> b(shape, par::padded);
+         par::copy( b, a );
+
+         double sum=0;
+         if( p==0 ){ sum = par::for_each_idx_reduce( par::execution::seq,  update, plus, 0., b, scale ); }
+         if( p==1 ){ sum = par::for_each_idx_reduce( par::execution::omp,  update, plus, 0., b, scale ); }
+         if( p==2 ){ sum = par::for_each_idx_reduce( par::execution::pool, update, plus, 0., b, scale ); }
+
+         CPPUNIT_ASSERT_EQUAL( sum_ref, sum );
+
+         bool match=true;
+         par::for_each_idx( [&]( const par::Idx<2>& idx, const double v ){ match = match && v==2.*a(idx); }, b );
+         CPPUNIT_ASSERT( match );
+     }
+
+   // the index is passed to the functor, so other arrays can be read at the same element
+      par::Array<double,2> c(shape, 0.);
+      const double maxidx = par::for_each_idx_reduce( par::execution::omp,
+                                                      [&]( const par::Idx<2>& idx, double& v ){ v = a(idx); return double(idx[0]+idx[1]); },
+                                                      []( const double l, const double r ){ return std::max( l,r ); },
+                                                      0., c );
+      CPPUNIT_ASSERT_EQUAL( 130.+66., maxidx );
+      CPPUNIT_ASSERT_EQUAL( a({7,3}), c({7,3}) );
+  }
@@ -0,0 +1,187 @@
+# include <parallalg/array/test-allocator.h>
+
+/*
+ * true if the address p is a multiple of alignment
+ */
+   bool is_aligned( const void* p, const size_t alignment )
+  {
+      return reinterpret_cast<std::uintptr_t>(p)%alignment == 0;
+  }
+
+/*
+ * allocate n elements of T and check that they start on a multiple of alignment
+ */
+   template<typename T>
+   bool allocation_aligned( par::aligned_allocator<T> alloc, const size_t n, const size_t alignment )
+  {
+      T* p = alloc.allocate( n );
+      const bool aligned = is_aligned( p, alignment );
+      alloc.deallocate( p, n );
+      return aligned;
+  }
+
+/*
+ * memory is aligned to a cache line, or to the alignment of the element type if that is stricter, or to a huge page for large
+ * allocations with huge pages requested
+ */
+   void Test_par_allocator::test_alignment()
+  {
+      struct alignas(128) Wide{ double v[3]; };
+
+      for( const size_t n : {1,3,17,1000} )
+     {
+         CPPUNIT_ASSERT( allocation_aligned( par::aligned_allocator<char>{},   n, par::cache_line_size ) );
+         CPPUNIT_ASSERT( allocation_aligned( par::aligned_allocator<double>{}, n, par::cache_line_size ) );
+         CPPUNIT_ASSERT( allocation_aligned( par::aligned_allocator<Wide>{},   n, 128 ) );
+
+      // allocations smaller than a huge page are only aligned to a cache line
+         CPPUNIT_ASSERT( allocation_aligned( par::aligned_allocator<double>(true), n, par::cache_line_size ) );
+     }
+
+      CPPUNIT_ASSERT( allocation_aligned( par::aligned_allocator<double>(true), par::huge_page_size/sizeof(double), par::huge_page_size ) );
+
+   // arrays without a halo start on a cache line
+      par::Array<double,2> a(par::Shape<2>{5,7});
+      par::Array<double,2> p(par::Shape<2>{5,7},par::padded);
+
+      CPPUNIT_ASSERT( is_aligned( a.data(), par::cache_line_size ) );
+      CPPUNIT_ASSERT( is_aligned( p.data(), par::cache_line_size ) );
+  }
+
+/*
+ * padded rows start on a cache line and are not a multiple of cache_alias_stride apart, and every element of a padded array
+ * is stored in its own place, so indexing gives the same results as an unpadded array
+ */
+   void Test_par_allocator::test_padded_strides()
+  {
+      const std::vector<par::Shape<2>> shapes{ {5,3}, {4,8}, {3,13}, {2,512}, {3,1}, {1,9} };
+
+      for( const par::Shape<2>& shape : shapes )
+     {
+         par::Array<double,2> p(shape,-1.,par::padded);
+
+         const size_t row_bytes = p.stride(0)*sizeof(double);
+
+         CPPUNIT_ASSERT_EQUAL( size_t(1), p.stride(1) );
+         CPPUNIT_ASSERT( p.stride(0)>=shape[1] );
+         CPPUNIT_ASSERT( row_bytes%par::cache_line_size    == 0 );
+         CPPUNIT_ASSERT( row_bytes%par::cache_alias_stride != 0 );
+
+         bool rows_aligned=true;
+         for( size_t i=0; i<shape[0]; ++i ){ rows_aligned = rows_aligned && is_aligned( &p(par::Idx<2>{i,0}), par::cache_line_size ); }
+         CPPUNIT_ASSERT( rows_aligned );
+
+      // write every element through its index, then check each is read back from where the strides say it is stored
+         const auto value = []( const par::Idx<2>& idx ){ return 1000.*idx[0]+idx[1]; };
+
+         par::generate_idx( par::execution::omp, p, value );
+
+         bool match=true;
+         par::for_each_idx( [&]( const par::Idx<2>& idx, const double v )
+                           {
+                               match = match && v==value(idx)
+                                             && p.flatten( idx[0]*p.stride(0)+idx[1] )==value(idx);
+                           }, p );
+         CPPUNIT_ASSERT( match );
+
+      // padding is left untouched by algorithms on the elements
+         bool padding=true;
+         for( size_t i=0; i<shape[0]; ++i )
+        {
+            for( size_t j=shape[1]; j<p.stride(0); ++j ){ padding = padding && p.flatten( i*p.stride(0)+j )==-1.; }
+        }
+         CPPUNIT_ASSERT( padding );
+
+      // elementwise algorithms give the same results for padded and unpadded arrays
+         par::Array<double,2> a(shape);
+         par::generate_idx( a, value );
+
+         const auto pt = par::transform( par::execution::omp, []( const double x ){ return 2.*x+1.; }, p );
+         const auto at = par::transform(                      []( const double x ){ return 2.*x+1.; }, a );
+
+         bool same=true;
+         par::for_each_idx( [&]( const par::Idx<2>& idx, const double v ){ same = same && v==at(idx); }, pt );
+         CPPUNIT_ASSERT( same );
+     }
+
+   // 3D arrays pad the fastest-varying dimension only
+      par::Array<float,3> p3(par::Shape<3>{3,4,5},par::padded);
+
+      CPPUNIT_ASSERT_EQUAL( size_t(1), p3.stride(2) );
+      CPPUNIT_ASSERT_EQUAL( par::cache_line_size/sizeof(float), p3.stride(1) );
+      CPPUNIT_ASSERT_EQUAL( 4*p3.stride(1), p3.stride(0) );
+
+      par::generate_idx( p3, []( const par::Idx<3>& idx ){ return float(100*idx[0]+10*idx[1]+idx[2]); } );
+
+      bool match3=true;
+      par::for_each_idx( [&]( const par::Idx<3>& idx, const float v )
+                        {
+                            match3 = match3 && v==float(100*idx[0]+10*idx[1]+idx[2])
+                                            && p3.flatten( idx[0]*p3.stride(0)+idx[1]*p3.stride(1)+idx[2] )==v;
+                        }, p3 );
+      CPPUNIT_ASSERT( match3 );
+  }
+
+/*
+ * arrays are value-initialised, including padding and halo, unless constructed uninitialised
+ */
+   void Test_par_allocator::test_initialisation()
+  {
+      const par::Shape<2> shape{6,5};
+      const par::MemoryLayout layout = par::halo_layout( 1, par::padded );
+
+      const auto all_equal = []( const par::Array<double,2>& a, const double v )
+     {
+         bool eq=true;
+         for( size_t i=0; i<a.flattened_length(); ++i ){ eq = eq && a.flatten(i)==v; }
+         return eq;
+     };
+
+      CPPUNIT_ASSERT( all_equal( par::Array<double,2>(                      shape, layout ), 0. ) );
+      CPPUNIT_ASSERT( all_equal( par::Array<double,2>( par::execution::omp,  shape, layout ), 0. ) );
+      CPPUNIT_ASSERT( all_equal( par::Array<double,2>( par::execution::pool, shape, layout ), 0. ) );
+
+   // uninitialised memory is written for the first time by the fill
+      par::Array<double,2> u( par::uninitialised, shape, layout );
+      par::fill( par::execution::omp, u, 3. );
+      CPPUNIT_ASSERT( all_equal( u, 3. ) );
+
+   // resizing value-initialises the new elements, even for arrays constructed uninitialised
+      par::Array<double,2,par::Primal,par::DynamicSize> d( par::uninitialised, shape );
+      par::fill( d, 3. );
+      d.resize( par::Shape<2>{8,9} );
+      bool resized=true;
+      for( size_t i=par::length( shape ); i<d.flattened_length(); ++i ){ resized = resized && d.flatten(i)==0.; }
+      CPPUNIT_ASSERT( resized );
+  }
+
+/*
+ * zero-length allocations succeed, and empty arrays can be constructed with any layout and policy
+ */
+   void Test_par_allocator::test_empty()
+  {
+      par::aligned_allocator<double> alloc;
+      double* p = alloc.allocate( 0 );
+      alloc.deallocate( p, 0 );
+
+      const std::vector<par::Shape<2>> shapes{ {0,0}, {0,5}, {4,0} };
+      const std::vector<par::MemoryLayout> layouts{ par::MemoryLayout{}, par::padded, par::halo_layout( 1, par::padded ) };
+
+      for( const par::Shape<2>& shape : shapes )
+     {
+         for( const par::MemoryLayout& layout : layouts )
+        {
+            const par::Array<double,2> a(                      shape, layout );
+            const par::Array<double,2> o( par::execution::omp,  shape, layout );
+            const par::Array<double,2> t( par::execution::pool, shape, layout );
+
+            CPPUNIT_ASSERT_EQUAL( size_t(0), par::length( a.shape() ) );
+            CPPUNIT_ASSERT_EQUAL( a.flattened_length(), o.flattened_length() );
+            CPPUNIT_ASSERT_EQUAL( a.flattened_length(), t.flattened_length() );
+            CPPUNIT_ASSERT_EQUAL( 0., par::transform_reduce( par::execution::omp,
+                                                             []( const double v ){ return v; },
+                                                             []( const double l, const double r ){ return l+r; },
+                                                             0., o ) );
+        }
+     }
+  }
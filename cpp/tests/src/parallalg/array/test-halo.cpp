@@ -0,0 +1,179 @@
+
+# include <parallalg/array/test-halo.h>
+
+# include <vector>
+
+/*
+ * halo elements are addressed with indices just outside the array, and do not move the elements of the array
+ */
+   void Test_par_halo::test_halo_indexing()
+  {
+      par::Array<double,2> a(par::Shape<2>{4,5},-1.,par::halo_layout(2,par::padded));
+      par::generate_idx( a, []( const par::Idx<2>& idx ){ return 10.*idx[0]+idx[1]; } );
+
+      CPPUNIT_ASSERT_EQUAL( size_t(2), a.halo() );
+      CPPUNIT_ASSERT( !a.is_contiguous() );
+      CPPUNIT_ASSERT_EQUAL( 34., a({3,4}) );
+
+   // halo elements before the first and after the last element of each dimension
+      a( par::Idx<2>{0,3} + par::Offset<2>{-2,0} ) = 100.;
+      a( par::Idx<2>{3,4} + par::Offset<2>{ 0,2} ) = 200.;
+      CPPUNIT_ASSERT_EQUAL( 100., a( par::Idx<2>{0,3} + par::Offset<2>{-2,0} ) );
+      CPPUNIT_ASSERT_EQUAL( 200., a( par::Idx<2>{3,4} + par::Offset<2>{ 0,2} ) );
+
+   // the view including the halo starts at the first halo element
+      const auto all = par::halo_view( a );
+      CPPUNIT_ASSERT_EQUAL( size_t(8), all.shape(0) );
+      CPPUNIT_ASSERT_EQUAL( size_t(9), all.shape(1) );
+      CPPUNIT_ASSERT_EQUAL( -1., all({0,0}) );
+      CPPUNIT_ASSERT_EQUAL( 100., all({0,5}) );
+      CPPUNIT_ASSERT_EQUAL( 34., all({5,6}) );
+
+   // views of the array exclude the halo
+      const auto inner = par::view( a );
+      CPPUNIT_ASSERT_EQUAL( 0., inner({0,0}) );
+
+   // 1D arrays
+      par::Array<double,1> b(par::Shape<1>{3},0.,par::halo_layout(1));
+      b( par::Idx<1>{0} + par::Offset<1>{-1} ) = 5.;
+      CPPUNIT_ASSERT_EQUAL( 5., par::halo_view( b )({0}) );
+      CPPUNIT_ASSERT_EQUAL( 0., b({0}) );
+  }
+
+/*
+ * flat algorithms on arrays with a halo only visit the elements of the array, while copy also copies the halo
+ * arrays with different halos or padding are traversed together by index
+ */
+   void Test_par_halo::test_flat_algorithms_skip_halo()
+  {
+      const auto sum = []( const double l, const double r ){ return l+r; };
+      const auto val = []( const double v ){ return v; };
+
+      for( const int p : {0,1,2,3} )
+     {
+         par::Array<double,3> a(par::Shape<3>{5,6,7},100.,par::halo_layout(1));
+         par::Array<double,3> b(par::Shape<3>{5,6,7},par::halo_layout(1));
+
+         par::fill( par::execution::seq, b, 0. );
+
+         const auto set_one = []( double& v ){ v=1.; };
+
+         if( p==0 ){ par::for_each( par::execution::seq,      set_one, a ); }
+         if( p==1 ){ par::for_each( par::execution::omp,      set_one, a ); }
+         if( p==2 ){ par::for_each( par::execution::omp_simd, set_one, a ); }
+         if( p==3 ){ par::for_each( par::execution::pool,     set_one, a ); }
+
+         CPPUNIT_ASSERT_EQUAL( 210., par::transform_reduce( par::execution::seq,  val, sum, 0., a ) );
+         CPPUNIT_ASSERT_EQUAL( 210., par::transform_reduce( par::execution::omp,  val, sum, 0., a ) );
+         CPPUNIT_ASSERT_EQUAL( 210., par::transform_reduce( par::execution::simd, val, sum, 0., a ) );
+
+      // the halo was not touched by for_each
+         CPPUNIT_ASSERT_EQUAL( 100., a( par::Idx<3>{4,5,6} + par::Offset<3>{1,0,0} ) );
+
+         par::transform( par::execution::omp, val, b, a );
+         CPPUNIT_ASSERT_EQUAL( 210., par::transform_reduce( par::execution::omp, val, sum, 0., b ) );
+         CPPUNIT_ASSERT_EQUAL(   0., b( par::Idx<3>{0,0,0} + par::Offset<3>{0,-1,0} ) );
+
+      // copy includes the halo
+         par::copy( par::execution::omp, b, a );
+         CPPUNIT_ASSERT_EQUAL( 100., b( par::Idx<3>{0,0,0} + par::Offset<3>{0,-1,0} ) );
+
+      // arrays with and without a halo can be mixed, and are traversed by index
+         par::Array<double,3> c(par::Shape<3>{5,6,7},2.);
+         par::transform( par::execution::omp, []( const double u, const double v ){ return u+v; }, b, a, c );
+         CPPUNIT_ASSERT_EQUAL( 630., par::transform_reduce( par::execution::omp_simd, val, sum, 0., b ) );
+         CPPUNIT_ASSERT_EQUAL( 420., par::transform_reduce( par::execution::pool,
+                                                            []( const double u, const double v ){ return u*v; }, sum, 0., a, c ) );
+         par::copy( par::execution::seq, c, b );
+         CPPUNIT_ASSERT_EQUAL( 3., c({4,5,6}) );
+     }
+  }
+
+/*
+ * halo layers beyond each face, and the edge layers next to them, can be filled in parallel, e.g. for periodic boundaries
+ */
+   void Test_par_halo::test_halo_layers()
+  {
+      const size_t ni=6, nj=5;
+
+      par::Array<double,2> a(par::Shape<2>{ni,nj},0.,par::halo_layout(1,par::padded));
+      par::generate_idx( a, []( const par::Idx<2>& idx ){ return 10.*idx[0]+idx[1]; } );
+
+      for( int dim : {0,1} )
+     {
+         for( int side : {0,1} )
+        {
+            auto halo = par::halo_layer( a, dim, side );
+            par::copy( par::execution::omp, halo, par::edge_layer( a, dim, 1-side ) );
+        }
+     }
+
+      for( size_t j=0; j<nj; ++j )
+     {
+         CPPUNIT_ASSERT_EQUAL( a({ni-1,j}), a( par::Idx<2>{0,   j} + par::Offset<2>{-1,0} ) );
+         CPPUNIT_ASSERT_EQUAL( a({0,   j}), a( par::Idx<2>{ni-1,j} + par::Offset<2>{ 1,0} ) );
+     }
+      for( size_t i=0; i<ni; ++i )
+     {
+         CPPUNIT_ASSERT_EQUAL( a({i,nj-1}), a( par::Idx<2>{i,0   } + par::Offset<2>{0,-1} ) );
+         CPPUNIT_ASSERT_EQUAL( a({i,0   }), a( par::Idx<2>{i,nj-1} + par::Offset<2>{0, 1} ) );
+     }
+
+   // corners of the halo are not part of any halo layer
+      CPPUNIT_ASSERT_EQUAL( 0., par::halo_view( a )({0,0}) );
+
+   // halo layers can be written directly through views
+      auto top = par::halo_layer( a, 1, 1 );
+      par::fill( par::execution::pool, top, -3. );
+      CPPUNIT_ASSERT_EQUAL( -3., a( par::Idx<2>{2,nj-1} + par::Offset<2>{0,1} ) );
+      CPPUNIT_ASSERT_EQUAL( size_t(ni), top.shape(0) );
+      CPPUNIT_ASSERT_EQUAL( size_t(1),  top.shape(1) );
+  }
+
+/*
+ * arrays with a halo and a single element or no elements in a dimension
+ *    flat algorithms visit no elements of an empty array, and the halo layers of a single element wide array are both copies of it
+ */
+   void Test_par_halo::test_edge_cases()
+  {
+      const auto sum = []( const double l, const double r ){ return l+r; };
+      const auto val = []( const double v ){ return v; };
+
+      for( const par::Shape<2>& shape : std::vector<par::Shape<2>>{ {0,3}, {3,0}, {0,0} } )
+     {
+         par::Array<double,2> a(shape,4.,par::halo_layout(1,par::padded));
+
+         CPPUNIT_ASSERT_EQUAL( shape[0]+2, par::halo_view( a ).shape(0) );
+         CPPUNIT_ASSERT_EQUAL( shape[1]+2, par::halo_view( a ).shape(1) );
+
+         par::for_each( par::execution::omp,      []( double& v ){ v=-1.; }, a );
+         par::for_each( par::execution::omp_simd, []( double& v ){ v=-1.; }, a );
+         par::for_each( par::execution::pool,     []( double& v ){ v=-1.; }, a );
+
+         CPPUNIT_ASSERT_EQUAL( 1., par::transform_reduce( par::execution::seq,  val, sum, 1., a ) );
+         CPPUNIT_ASSERT_EQUAL( 1., par::transform_reduce( par::execution::omp,  val, sum, 1., a ) );
+         CPPUNIT_ASSERT_EQUAL( 1., par::transform_reduce( par::execution::simd, val, sum, 1., a ) );
+         CPPUNIT_ASSERT_EQUAL( 1., par::transform_reduce( par::execution::pool, val, sum, 1., a ) );
+
+      // the halo is untouched
+         CPPUNIT_ASSERT_EQUAL( 4.*par::length( par::halo_view( a ).shape() ),
+                               par::transform_reduce( par::execution::seq, val, sum, 0., par::halo_view( a ) ) );
+     }
+
+   // a single column: both halo layers in dimension 1 are copies of the same edge layer
+      par::Array<double,2> b(par::Shape<2>{4,1},0.,par::halo_layout(1));
+      par::generate_idx( b, []( const par::Idx<2>& idx ){ return 1.+idx[0]; } );
+
+      for( int side : {0,1} )
+     {
+         auto halo = par::halo_layer( b, 1, side );
+         CPPUNIT_ASSERT_EQUAL( size_t(4), halo.shape(0) );
+         CPPUNIT_ASSERT_EQUAL( size_t(1), halo.shape(1) );
+         par::copy( par::execution::pool, halo, par::edge_layer( b, 1, 1-side ) );
+     }
+      for( size_t i=0; i<4; ++i )
+     {
+         CPPUNIT_ASSERT_EQUAL( 1.+i, b( par::Idx<2>{i,0} + par::Offset<2>{0,-1} ) );
+         CPPUNIT_ASSERT_EQUAL( 1.+i, b( par::Idx<2>{i,0} + par::Offset<2>{0, 1} ) );
+     }
+  }
@@ -0,0 +1,124 @@
+
+# include <parallalg/array/test-soa.h>
+
+# include <array>
+
+/*
+ * minimal element type with components
+ */
+   struct Vec3
+  {
+      using value_type = double;
+      constexpr static int N=3;
+
+      std::array<double,N> elems;
+
+            double& operator[]( const int i )       { return elems[i]; }
+      const double& operator[]( const int i ) const { return elems[i]; }
+
+      Vec3& operator+=( const Vec3& other ){ for( int i=0; i<N; ++i ){ elems[i]+=other[i]; } return *this; }
+      Vec3& operator-=( const Vec3& other ){ for( int i=0; i<N; ++i ){ elems[i]-=other[i]; } return *this; }
+  };
+
+/*
+ * each component is stored in its own contiguous stream
+ */
+   void Test_par_soa::test_component_layout()
+  {
+      par::SoAArray<Vec3,2> a(par::Shape<2>{3,4});
+
+      for( size_t i=0; i<3; ++i )
+     {
+         for( size_t j=0; j<4; ++j )
+        {
+            const double v = 4*i+j;
+            a({i,j}) = Vec3{{v,10+v,20+v}};
+        }
+     }
+
+      for( int c=0; c<3; ++c )
+     {
+         const double* stream = a.component(c);
+         for( size_t k=0; k<a.flattened_length(); ++k )
+        {
+            CPPUNIT_ASSERT_EQUAL( 10.*c+k, stream[k] );
+        }
+     }
+  }
+
+/*
+ * proxy gathers, scatters and modifies components in place
+ */
+   void Test_par_soa::test_proxy_arithmetic()
+  {
+      par::SoAArray<Vec3,1> a(par::Shape<1>{2}, Vec3{{1.,2.,3.}});
+
+      a({1}) += Vec3{{1.,1.,1.}};
+      a({1})[2] = 7.;
+      a({0}) = a({1});
+
+      const Vec3 v0 = static_cast<const par::SoAArray<Vec3,1>&>(a)({0});
+
+      CPPUNIT_ASSERT_EQUAL( 2., v0[0] );
+      CPPUNIT_ASSERT_EQUAL( 3., v0[1] );
+      CPPUNIT_ASSERT_EQUAL( 7., v0[2] );
+  }
+
+/*
+ * par algorithms accept Structure-of-Arrays Arrays
+ */
+   void Test_par_soa::test_algorithms()
+  {
+      const par::Shape<2> shape{5,7};
+
+      par::SoAArray<Vec3,2> a(shape);
+      par::SoAArray<Vec3,2> b(shape);
+
+      par::fill( par::execution::omp, a, Vec3{{1.,2.,3.}} );
+
+      par::transform( par::execution::omp,
+                      []( const Vec3& v ){ Vec3 w=v; w[1]*=2.; return w; },
+                      b, a );
+
+      par::for_each( par::execution::omp,
+                     []( auto&& v ){ v[2]+=1.; },
+                     b );
+
+      const auto c = par::copy( b );
+
+      const double sum = par::transform_reduce( par::execution::omp,
+                                                []( const Vec3& v ){ return v[0]+v[1]+v[2]; },
+                                                []( const double l, const double r ){ return l+r; },
+                                                0.,
+                                                c );
+
+      CPPUNIT_ASSERT_EQUAL( 9.*5*7, sum );
+  }
+
+/*
+ * resizing discards the contents, so no component reads the stream of another, whether the length grows or shrinks
+ */
+   void Test_par_soa::test_resize()
+  {
+      par::SoAArray<Vec3,1,par::Primal,par::DynamicSize> a(par::Shape<1>{4}, Vec3{{1.,2.,3.}});
+
+      for( const size_t n : { size_t{7}, size_t{2}, size_t{0}, size_t{3} } )
+     {
+         a.resize( par::Shape<1>{n} );
+
+         CPPUNIT_ASSERT_EQUAL( n, a.flattened_length() );
+         for( int c=0; c<3; ++c )
+        {
+            for( size_t i=0; i<n; ++i ){ CPPUNIT_ASSERT_EQUAL( 0., a.component(c)[i] ); }
+        }
+
+         par::fill( a, Vec3{{1.,2.,3.}} );
+         for( size_t i=0; i<n; ++i )
+        {
+            const Vec3 v = static_cast<const par::SoAArray<Vec3,1,par::Primal,par::DynamicSize>&>(a)({i});
+            CPPUNIT_ASSERT_EQUAL( 1., v[0] );
+            CPPUNIT_ASSERT_EQUAL( 2., v[1] );
+            CPPUNIT_ASSERT_EQUAL( 3., v[2] );
+        }
+     }
+  }
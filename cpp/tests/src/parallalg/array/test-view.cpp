@@ -0,0 +1,175 @@
+# include <parallalg/array/test-view.h>
+
+# include <vector>
+
+/*
+ * views refer to the elements of the viewed array, with their own origin, shape and strides
+ */
+   void Test_par_view::test_indexing()
+  {
+      par::Array<double,2> a(par::Shape<2>{6,7},par::padded);
+      par::generate_idx( a, []( const par::Idx<2>& idx ){ return 10.*idx[0]+idx[1]; } );
+
+      const auto block = par::subview( a, par::Idx<2>{1,2}, par::Shape<2>{3,4} );
+      CPPUNIT_ASSERT_EQUAL( 35., block({2,3}) );
+      CPPUNIT_ASSERT( !block.is_contiguous() );
+
+      const auto col = par::slice<1>( a, 4 );
+      CPPUNIT_ASSERT_EQUAL( size_t(6), col.shape(0) );
+      CPPUNIT_ASSERT_EQUAL( 54., col({5}) );
+
+      const auto even = par::strided_view( a, par::Idx<2>{0,1}, {2,3} );
+      CPPUNIT_ASSERT_EQUAL( size_t(3), even.shape(0) );
+      CPPUNIT_ASSERT_EQUAL( size_t(2), even.shape(1) );
+      CPPUNIT_ASSERT_EQUAL( 44., even({2,1}) );
+
+   // writing through a view modifies the viewed array
+      auto row = par::slice<0>( a, 3 );
+      row({6}) = -1.;
+      CPPUNIT_ASSERT_EQUAL( -1., a({3,6}) );
+
+   // views of const arrays have const elements
+      const par::Array<double,2>& ca = a;
+      const auto cview = par::view( ca );
+      static_assert( std::is_same_v<std::remove_const_t<decltype(cview)>::ElemType,const double> );
+      CPPUNIT_ASSERT_EQUAL( 12., cview({1,2}) );
+  }
+
+/*
+ * flat algorithms on views only touch the elements of the view, and views can be mixed with arrays of different strides
+ */
+   void Test_par_view::test_flat_algorithms()
+  {
+      for( const int p : {0,1,2} )
+     {
+         par::Array<double,2> a(par::Shape<2>{8,9},0.);
+
+         auto interior = par::subview( a, par::Idx<2>{1,1}, par::Shape<2>{6,7} );
+
+         if( p==0 ){ par::fill( par::execution::seq,  interior, 1. ); }
+         if( p==1 ){ par::fill( par::execution::omp,  interior, 1. ); }
+         if( p==2 ){ par::fill( par::execution::pool, interior, 1. ); }
+
+         const double total = par::transform_reduce( par::execution::omp,
+                                                     []( const double v ){ return v; },
+                                                     []( const double l, const double r ){ return l+r; },
+                                                     0., a );
+         CPPUNIT_ASSERT_EQUAL( 42., total );
+
+      // copy a column of a into a 1D array, and transform it back into a row
+         par::Array<double,1> c(par::Shape<1>{8});
+         par::copy( par::execution::omp, c, par::slice<1>( a, 1 ) );
+         CPPUNIT_ASSERT_EQUAL( 0., c({0}) );
+         CPPUNIT_ASSERT_EQUAL( 1., c({6}) );
+
+         auto row = par::slice<0>( a, 0 );
+         auto row8 = par::subview( row, par::Idx<1>{0}, par::Shape<1>{8} );
+         par::transform( par::execution::pool, []( const double v ){ return 2.*v; }, row8, c );
+         CPPUNIT_ASSERT_EQUAL( 2., a({0,6}) );
+         CPPUNIT_ASSERT_EQUAL( 0., a({0,8}) );
+
+      // reductions over views match the serial reduction over a copy
+         const auto even = par::strided_view( a, par::Idx<2>{0,0}, {2,2} );
+         const auto sq   = []( const double v ){ return v*v; };
+         const auto plus = []( const double l, const double r ){ return l+r; };
+
+         const auto copied = par::copy( par::execution::seq, even );
+         CPPUNIT_ASSERT_EQUAL( par::transform_reduce( par::execution::seq, sq, plus, 0., copied ),
+                               par::transform_reduce( par::execution::omp, sq, plus, 0., even ) );
+     }
+  }
+
+/*
+ * index algorithms and neighbour accumulations accept views
+ */
+   void Test_par_view::test_index_algorithms()
+  {
+      const par::Shape<2> shape{10,12};
+
+      par::Array<double,2> src(shape);
+      par::generate_idx( src, []( const par::Idx<2>& idx ){ return 1.+idx[0]*idx[0]+0.5*idx[1]; } );
+
+      const par::Idx<2>   first{2,3};
+      const par::Shape<2> inner{6,7};
+
+      const auto edge = []( const double l, const double r ){ return r-l; };
+      const auto accl = []( const double d, const double f ){ return d+f; };
+      const auto accr = []( const double d, const double f ){ return d-f; };
+
+   // accumulation over a sub-block matches accumulation over a copy of the sub-block
+      par::Array<double,2> expected(inner,0.);
+      par::neighbour_accumulation( par::execution::seq, edge, accl, accr, expected,
+                                   par::copy( par::execution::seq, par::subview( src, first, inner ) ) );
+
+      par::Array<double,2> dst(shape,0.);
+      auto dst_inner = par::subview( dst, first, inner );
+
+      par::neighbour_accumulation( par::execution::omp, edge, accl, accr,
+                                   dst_inner, par::subview( src, first, inner ) );
+
+      bool same=true;
+      par::for_each_idx( par::execution::pool,
+                         [&]( const par::Idx<2>& idx, const double e, const double d )
+                        {
+                            same = same && (e==d);
+                        }, expected, dst_inner );
+      CPPUNIT_ASSERT( same );
+
+      CPPUNIT_ASSERT_EQUAL( 0., dst({1,3}) );
+  }
+
+/*
+ * empty views, views of a single element and strided views which end at the last element of the array
+ *    algorithms over an empty view do nothing, and reductions over an empty view return init
+ */
+   void Test_par_view::test_edge_cases()
+  {
+      par::Array<double,2> a(par::Shape<2>{5,4},1.,par::padded);
+
+      const auto plus = []( const double l, const double r ){ return l+r; };
+      const auto self = []( const double v ){ return v; };
+
+      const auto edge = []( const double l, const double r ){ return r-l; };
+      const auto accl = []( const double d, const double f ){ return d+f; };
+      const auto accr = []( const double d, const double f ){ return d-f; };
+
+   // sub-blocks with no rows, no columns, and starting at the end of the array
+      for( const par::Shape<2>& s : std::vector<par::Shape<2>>{ {0,4}, {3,0}, {0,0} } )
+     {
+         auto empty = par::subview( a, par::Idx<2>{5-s[0],4-s[1]}, s );
+         CPPUNIT_ASSERT_EQUAL( size_t(0), par::length( empty.shape() ) );
+
+         par::fill( par::execution::seq,  empty, -1. );
+         par::fill( par::execution::omp,  empty, -1. );
+         par::fill( par::execution::pool, empty, -1. );
+
+         CPPUNIT_ASSERT_EQUAL( 7., par::transform_reduce( par::execution::seq,  self, plus, 7., empty ) );
+         CPPUNIT_ASSERT_EQUAL( 7., par::transform_reduce( par::execution::omp,  self, plus, 7., empty ) );
+         CPPUNIT_ASSERT_EQUAL( 7., par::transform_reduce( par::execution::pool, self, plus, 7., empty ) );
+
+         par::neighbour_accumulation( par::execution::omp, edge, accl, accr, empty, par::subview( a, par::Idx<2>{0,0}, s ) );
+     }
+
+      CPPUNIT_ASSERT_EQUAL( 20., par::transform_reduce( par::execution::seq, self, plus, 0., a ) );
+
+   // a strided view starting at the end of a dimension is empty
+      const auto past = par::strided_view( a, par::Idx<2>{5,0}, {2,2} );
+      CPPUNIT_ASSERT_EQUAL( size_t(0), past.shape(0) );
+
+   // a strided view whose step is larger than the remaining extent has a single element in that dimension
+      auto last = par::strided_view( a, par::Idx<2>{4,3}, {3,5} );
+      CPPUNIT_ASSERT_EQUAL( size_t(1), par::length( last.shape() ) );
+
+      par::fill( par::execution::omp, last, 5. );
+      CPPUNIT_ASSERT_EQUAL( 5., a({4,3}) );
+      CPPUNIT_ASSERT_EQUAL( 24., par::transform_reduce( par::execution::omp, self, plus, 0., a ) );
+
+   // slices of an array with a single row or column
+      par::Array<double,2> b(par::Shape<2>{1,6},2.);
+      const auto row = par::slice<0>( b, 0 );
+      const auto col = par::slice<1>( b, 5 );
+      CPPUNIT_ASSERT_EQUAL( size_t(6), row.shape(0) );
+      CPPUNIT_ASSERT_EQUAL( size_t(1), col.shape(0) );
+      CPPUNIT_ASSERT_EQUAL( 12., par::transform_reduce( par::execution::pool, self, plus, 0., row ) );
+      CPPUNIT_ASSERT_EQUAL(  2., par::transform_reduce( par::execution::pool, self, plus, 0., col ) );
+  }
@@ -0,0 +1,136 @@
+
+# include <parallalg/execution/test-schedule.h>
+
+# include <vector>
+
+/*
+ * explicit collapse depths are clamped to the loop dimension, otherwise outer dimensions are collapsed until every thread has enough iterations
+ */
+   void Test_par_schedule::test_collapse_depth()
+  {
+      using par::execution::omp;
+
+      const par::Idx<3> first{0,0,0};
+
+      CPPUNIT_ASSERT_EQUAL( 2, par::openmp_collapse_depth( omp.with_collapse(2), first, par::Idx<3>{100,100,100}, 16 ) );
+      CPPUNIT_ASSERT_EQUAL( 3, par::openmp_collapse_depth( omp.with_collapse(5), first, par::Idx<3>{100,100,100}, 16 ) );
+
+      CPPUNIT_ASSERT_EQUAL( 1, par::openmp_collapse_depth( omp, first, par::Idx<3>{128,64,1}, 16 ) );
+      CPPUNIT_ASSERT_EQUAL( 2, par::openmp_collapse_depth( omp, first, par::Idx<3>{ 32,64,1}, 16 ) );
+      CPPUNIT_ASSERT_EQUAL( 3, par::openmp_collapse_depth( omp, first, par::Idx<3>{  2, 2,4}, 16 ) );
+
+   // ranges which are too small or empty collapse every dimension
+      CPPUNIT_ASSERT_EQUAL( 3, par::openmp_collapse_depth( omp, first, par::Idx<3>{  1, 1,1}, 16 ) );
+      CPPUNIT_ASSERT_EQUAL( 3, par::openmp_collapse_depth( omp, first, par::Idx<3>{  0, 99,9}, 16 ) );
+  }
+
+/*
+ * every index is visited exactly once with every schedule, chunk size, collapse depth and thread count, including shapes with a single
+ * element, a single row or column, and no elements in the collapsed or the serial dimensions
+ */
+   void Test_par_schedule::test_every_index_once()
+  {
+      using par::execution::omp;
+      using par::execution::Schedule;
+
+      const std::vector<par::execution::openmp_policy> policies =
+     {
+         omp,
+         omp.with_schedule( Schedule::Dynamic, 3 ),
+         omp.with_schedule( Schedule::Guided ).with_collapse(1),
+         omp.with_schedule( Schedule::Auto ).with_collapse(2),
+         omp.with_schedule( Schedule::Static, 5 ).with_collapse(3).with_threads(2)
+     };
+
+      const std::vector<par::Shape<2>> shapes2{ {7,13}, {1,1}, {1,9}, {9,1}, {0,5}, {5,0} };
+      const std::vector<par::Shape<3>> shapes3{ {5,3,11}, {1,1,1}, {1,4,1}, {3,1,5}, {0,3,4}, {3,0,4}, {3,4,0} };
+
+      for( const par::execution::openmp_policy& policy : policies )
+     {
+         for( const par::Shape<2>& shape : shapes2 )
+        {
+            par::Array<int,2> a2(shape,0);
+            par::for_each_idx( policy, []( const par::Idx<2>&, int& h ){ h++; }, a2 );
+
+            bool all=true;
+            par::for_each( [&]( const int h ){ all = all && (h==1); }, a2 );
+            CPPUNIT_ASSERT( all );
+        }
+
+         for( const par::Shape<3>& shape : shapes3 )
+        {
+            par::Array<int,3> a3(shape,0);
+            par::for_each_idx( policy, []( const par::Idx<3>&, int& h ){ h++; }, a3 );
+
+            bool all=true;
+            par::for_each( [&]( const int h ){ all = all && (h==1); }, a3 );
+            CPPUNIT_ASSERT( all );
+        }
+     }
+  }
+
+/*
+ * neighbour accumulations with a non-default schedule give the same results as serial execution
+ */
+   void Test_par_schedule::test_neighbour_accumulation()
+  {
+      const par::Shape<2> shape{9,17};
+
+      par::Array<double,2> src(shape);
+      par::generate_idx( par::execution::omp.with_collapse(2), src,
+                         []( const par::Idx<2>& idx ){ return 1.+idx[0]*idx[0]+0.25*idx[1]; } );
+
+      const auto edge = []( const double l, const double r ){ return r-l; };
+      const auto accl = []( const double d, const double f ){ return d+f; };
+      const auto accr = []( const double d, const double f ){ return d-f; };
+
+      par::Array<double,2> serial(shape,0.);
+      par::neighbour_accumulation( par::execution::seq, edge, accl, accr, serial, src );
+
+      const auto policy = par::execution::omp.with_schedule( par::execution::Schedule::Dynamic, 2 )
+                                             .with_collapse(2);
+
+      par::Array<double,2> colour(shape,0.);
+      par::neighbour_accumulation( policy, par::accumulation::colour, edge, accl, accr, colour, src );
+
+      par::Array<double,2> gather(shape,0.);
+      par::neighbour_accumulation( policy, par::accumulation::gather, edge, accl, accr, gather, src );
+
+      bool same=true;
+      par::for_each( [&]( const double s, const double c, const double g ){ same = same && (s==c) && (s==g); },
+                     serial, colour, gather );
+      CPPUNIT_ASSERT( same );
+  }
+
+/*
+ * parallel index loops restore the schedule of schedule(runtime) loops set outside them
+ */
+   void Test_par_schedule::test_schedule_restored()
+  {
+      omp_sched_t kind0;
+      int chunk0;
+      omp_get_schedule( &kind0, &chunk0 );
+
+      omp_set_schedule( omp_sched_guided, 7 );
+
+      par::Array<int,2> a2(par::Shape<2>{7,13},0);
+      par::for_each_idx( par::execution::omp.with_schedule( par::execution::Schedule::Dynamic, 3 ),
+                         []( const par::Idx<2>&, int& h ){ h++; }, a2 );
+
+      par::Array<double,2> acc(par::Shape<2>{7,13},0.);
+      par::neighbour_accumulation( par::execution::omp.with_schedule( par::execution::Schedule::Static, 2 ),
+                                   par::accumulation::colour,
+                                   []( const double l, const double r ){ return r-l; },
+                                   []( const double d, const double f ){ return d+f; },
+                                   []( const double d, const double f ){ return d-f; },
+                                   acc, a2 );
+
+      omp_sched_t kind;
+      int chunk;
+      omp_get_schedule( &kind, &chunk );
+
+      omp_set_schedule( kind0, chunk0 );
+
+      CPPUNIT_ASSERT( kind==omp_sched_guided );
+      CPPUNIT_ASSERT_EQUAL( 7, chunk );
+  }
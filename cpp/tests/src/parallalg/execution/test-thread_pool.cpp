@@ -0,0 +1,126 @@
+
+# include <parallalg/execution/test-thread_pool.h>
+
+# include <atomic>
+# include <vector>
+
+/*
+ * every index of the range is visited exactly once and chunks do not overlap, for pools of one thread and of odd and even sizes, and for
+ * empty ranges, a single index, ranges shorter than the number of chunks and ranges which do not divide evenly between the chunks
+ */
+   void Test_par_thread_pool::test_every_index_once()
+  {
+      for( const unsigned int nthreads : {1u,3u,4u,5u} )
+     {
+         par::ThreadPool pool(nthreads);
+
+         for( const size_t n : {0ul, 1ul, 3ul, 7ul, 16ul, 17ul, 1000ul, 100003ul} )
+        {
+            std::vector<int> hits(n,0);
+            std::atomic<bool> in_range(true);
+
+            for( int rep=0; rep<10; ++rep )
+           {
+               pool.parallel_for( n, [&]( const size_t begin, const size_t end )
+                                    {
+                                       if( !(begin<end && end<=n) ){ in_range = false; return; }
+                                       for( size_t i=begin; i<end; ++i ){ hits[i]++; }
+                                    } );
+           }
+
+            bool all=true;
+            for( const int h : hits ){ all = all && (h==10); }
+            CPPUNIT_ASSERT( all );
+            CPPUNIT_ASSERT( in_range );
+        }
+     }
+  }
+
+/*
+ * loops started from inside a pool loop run in serial on the calling thread
+ */
+   void Test_par_thread_pool::test_nested()
+  {
+      par::ThreadPool pool(3);
+
+      std::vector<int> hits(64*64,0);
+
+      pool.parallel_for( 64, [&]( const size_t begin, const size_t end )
+                            {
+                               for( size_t i=begin; i<end; ++i )
+                              {
+                                  pool.parallel_for( 64, [&]( const size_t b, const size_t e )
+                                                        {
+                                                           for( size_t j=b; j<e; ++j ){ hits[64*i+j]++; }
+                                                        } );
+                              }
+                            } );
+
+      bool all=true;
+      for( const int h : hits ){ all = all && (h==1); }
+      CPPUNIT_ASSERT( all );
+  }
+
+/*
+ * pool algorithms called from inside a pool loop run in serial on the calling thread and give the same results
+ */
+   void Test_par_thread_pool::test_nested_algorithms()
+  {
+      par::set_default_thread_pool_size(3);
+
+      const par::Shape<1> shape{1000};
+      const auto plus = []( const double l, const double r ){ return l+r; };
+      const auto self = []( const double v ){ return v; };
+
+      std::vector<double> sums(7,0.);
+
+      par::default_thread_pool().parallel_for( sums.size(), [&]( const size_t begin, const size_t end )
+                                                          {
+                                                             for( size_t i=begin; i<end; ++i )
+                                                            {
+                                                                par::Array<double,1> a(shape);
+                                                                par::for_each_idx( par::execution::pool,
+                                                                                   [&]( const par::Idx<1>& idx, double& v ){ v = 1./(1.+i+idx[0]); },
+                                                                                   a );
+                                                                sums[i] = par::transform_reduce( par::execution::pool, self, plus, 0., a );
+                                                            }
+                                                          } );
+
+      for( size_t i=0; i<sums.size(); ++i )
+     {
+         par::Array<double,1> a(shape);
+         par::generate_idx( a, [&]( const par::Idx<1>& idx ){ return 1./(1.+i+idx[0]); } );
+         CPPUNIT_ASSERT_EQUAL( par::transform_reduce( par::execution::seq, self, plus, 0., a ), sums[i] );
+     }
+  }
+
+/*
+ * par algorithms with the pool policy give the same results as serial execution
+ */
+   void Test_par_thread_pool::test_algorithms()
+  {
+      par::set_default_thread_pool_size(4);
+
+      const par::Shape<2> shape{37,53};
+
+      par::Array<double,2> a(par::execution::pool, shape);
+      par::Array<double,2> b(shape);
+
+      par::for_each_idx( par::execution::pool,
+                         []( const par::Idx<2>& idx, double& v ){ v = idx[0]+0.5*idx[1]; },
+                         a );
+
+      par::transform( par::execution::pool,
+                      []( const double v ){ return 2.*v; },
+                      b, a );
+
+      const auto plus = []( const double l, const double r ){ return l+r; };
+      const auto self = []( const double v ){ return v; };
+
+      CPPUNIT_ASSERT_EQUAL( par::transform_reduce( par::execution::seq,  self, plus, 0., b ),
+                            par::transform_reduce( par::execution::pool, self, plus, 0., b ) );
+
+      const auto c = par::copy( par::execution::pool, b );
+
+      CPPUNIT_ASSERT_EQUAL( 2.*(36+0.5*52), c({36,52}) );
+  }
@@ -0,0 +1,157 @@
+# include <spatial/test-fused_residual.h>
+
+# include <omp.h>
+
+# include <cmath>
+
+   namespace
+  {
+      constexpr LawType Law = LawType::Euler;
+
+      using Real     = double;
+      using VarSet   = VariableSet<Law,2,EulerBases::Primitive,Real>;
+      using FluxRes  = fluxresult_t<VarSet>;
+      using Field    = SolutionField<VarSet,2>;
+      using ResArray = par::DualArray<FluxRes,2>;
+
+      const Species<Law,Real> species{.gamma=1.4, .minf=0.1, .lref=1, .nu=0, .pr=0.7, .dt=1, .R=287, .gamma1=2.5};
+
+   // a linear flux which also reads the least squares metrics of both cells, so the metrics of periodic neighbours are checked too
+      const auto hoflux = []( const auto&, const auto& face, const auto&, const auto&,
+                              const auto& ql, const auto& qr, const auto& xl, const auto& xr, const auto& ml, const auto& mr,
+                              const auto&... ) -> FluxRes
+     {
+         FluxRes f{};
+         for( int v=0; v<VarSet::N; ++v )
+        {
+            f.flux[v] = face.area*( 0.3*(ql[v]-qr[v]) + 0.01*(ml.q[2*v]-mr.q[2*v+1]) + 0.001*(xl(0)-xr(2))*ql[v] );
+        }
+         f.lambda = face.area;
+         return f;
+     };
+
+   // a stretched and skewed mesh
+      Mesh<2,Real> make_mesh( const par::DualShape<2> shape )
+     {
+         Mesh<2,Real> mesh(shape);
+         par::generate_idx( mesh.nodes, []( const par::PrimalIdx<2>& idx )
+                                       {
+                                           const Real x = idx[0]*( 1.+0.05*idx[0] );
+                                           const Real y = 0.7*idx[1] + 0.1*idx[0];
+                                           return geom::Point<2,Real>{{x,y}};
+                                       } );
+         updateGeometry( mesh );
+         return mesh;
+     }
+
+      Field make_field( const Mesh<2,Real>& mesh )
+     {
+         Field q(mesh.cells.shape());
+         par::generate_idx( q.interior, []( const par::DualIdx<2>& idx )
+                                       {
+                                           VarSet v;
+                                           v[0] = 1.+0.1*std::sin( 0.7*idx[0] + 0.3*idx[1] );
+                                           v[1] = 0.5*std::cos( 0.2*idx[0]*idx[1] );
+                                           v[2] = -0.3 + 0.02*idx[1]*idx[1];
+                                           v[3] = 1.+0.05*idx[0];
+                                           return v;
+                                       } );
+         for( auto& r : q.reference ){ par::fill( r, q.interior({0,0}) ); }
+         return q;
+     }
+
+      template<typename Policy, typename BCs>
+      ResArray fused( const Policy policy, const Mesh<2,Real>& mesh, const Field& q, const BCs& bcs )
+     {
+         const auto dxdx = xmetric_factors( policy, mesh.cells );
+         par::DualArray<lsq::QMetric<VarSet>,2> dqdx(mesh.cells.shape());
+         ResArray res(mesh.cells.shape());
+
+         fusedResidualCalc( policy, hoflux, bcs, species, mesh, q, NoStateCache{}, dxdx, dqdx, res );
+         return res;
+     }
+
+      template<typename BCs>
+      ResArray unfused( const Mesh<2,Real>& mesh, const Field& q, const BCs& bcs )
+     {
+         const auto dxdx = xmetric_factors( par::execution::seq, mesh.cells );
+         const auto dqdx = qmetrics( par::execution::seq, mesh.cells, q.interior );
+         ResArray res(mesh.cells.shape());
+
+         residualCalc( par::execution::seq, hoflux, bcs, species, mesh, q, dxdx, dqdx, res );
+         return res;
+     }
+
+      Real max_difference( const ResArray& a, const ResArray& b )
+     {
+         Real d=0;
+         par::for_each_idx( [&]( const par::DualIdx<2>& idx, const FluxRes& l )
+                           {
+                               const FluxRes& r = b(idx);
+                               for( int v=0; v<VarSet::N; ++v ){ d = std::max( d, std::abs( l.flux[v]-r.flux[v] ) ); }
+                               d = std::max( d, std::abs( l.lambda-r.lambda ) );
+                           }, a );
+         return d;
+     }
+  }
+
+/*
+ * the fused sweep gives the same residual as the separate passes, with periodic boundaries in one dimension and ghost cell boundaries
+ * in the other, for any policy and number of threads
+ */
+   void Test_spatial_fused_residual::test_matches_unfused()
+  {
+      const Mesh<2,Real> mesh = make_mesh( {13,7} );
+
+      Field q = make_field( mesh );
+      q.bcTypes = {EulerBCs::Fixed, EulerBCs::Fixed, EulerBCs::Periodic, EulerBCs::Periodic};
+
+      const std::tuple bcs{make_fixed_BCond<Law>(), make_periodic_BCond<Law>()};
+
+      boundaryUpdate( mesh, bcs, species, q );
+
+      const ResArray ref = unfused( mesh, q, bcs );
+
+      CPPUNIT_ASSERT( max_difference( ref, fused( par::execution::seq,  mesh, q, bcs ) ) < 1e-12 );
+      CPPUNIT_ASSERT( max_difference( ref, fused( par::execution::pool, mesh, q, bcs ) ) < 1e-12 );
+
+      for( const int n : {1,2,3,4} )
+     {
+         CPPUNIT_ASSERT( max_difference( ref, fused( par::execution::omp.with_threads(n), mesh, q, bcs ) ) < 1e-12 );
+     }
+
+   // and with the periodic and ghost cell boundaries swapped over, so periodic faces are at either end of the sweep
+      q.bcTypes = {EulerBCs::Periodic, EulerBCs::Periodic, EulerBCs::Fixed, EulerBCs::Fixed};
+      boundaryUpdate( mesh, bcs, species, q );
+
+      const ResArray ref2 = unfused( mesh, q, bcs );
+      for( const int n : {1,3} )
+     {
+         CPPUNIT_ASSERT( max_difference( ref2, fused( par::execution::omp.with_threads(n), mesh, q, bcs ) ) < 1e-12 );
+     }
+  }
+
+/*
+ * on a fully periodic domain the two sides of each periodic face are accumulated separately, but still cancel, so the residual sums to zero
+ */
+   void Test_spatial_fused_residual::test_periodic_conservative()
+  {
+      const Mesh<2,Real> mesh = make_mesh( {16,9} );
+
+      Field q = make_field( mesh );
+      for( auto& bc : q.bcTypes ){ bc = EulerBCs::Periodic; }
+
+      const std::tuple bcs{make_periodic_BCond<Law>()};
+
+      boundaryUpdate( mesh, bcs, species, q );
+
+      for( const int n : {1,4} )
+     {
+         const ResArray res = fused( par::execution::omp.with_threads(n), mesh, q, bcs );
+
+         std::array<Real,VarSet::N> sum{};
+         par::for_each_idx( [&]( const par::DualIdx<2>&, const FluxRes& r ){ for( int v=0; v<VarSet::N; ++v ){ sum[v]+=r.flux[v]; } }, res );
+
+         for( int v=0; v<VarSet::N; ++v ){ CPPUNIT_ASSERT_DOUBLES_EQUAL( 0., sum[v], 1e-12 ); }
+     }
+  }
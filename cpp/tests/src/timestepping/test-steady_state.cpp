@@ -0,0 +1,119 @@
+# include <timestepping/test-steady_state.h>
+
+# include <vector>
+# include <cmath>
+
+   namespace
+  {
+      constexpr LawType Law = LawType::Euler;
+
+      using Real   = double;
+      using VarSet = VariableSet<Law,2,EulerBases::Primitive,Real>;
+      using Field  = SolutionField<VarSet,2>;
+
+      const Species<Law,Real> species{.gamma=1.4, .minf=0.1, .lref=1, .nu=0, .pr=0.7, .dt=1, .R=287, .gamma1=2.5};
+
+   // a linear diffusive flux, with a constant spectral radius per unit face area, whose steady state on a periodic mesh is uniform
+      const auto hoflux = []( const auto&, const auto& face, const auto&, const auto&,
+                              const auto& ql, const auto& qr, const auto&... ) -> fluxresult_t<VarSet>
+     {
+         fluxresult_t<VarSet> f{};
+         for( int v=0; v<VarSet::N; ++v ){ f.flux[v] = 0.5*face.area*( ql[v]-qr[v] ); }
+         f.lambda = face.area;
+         return f;
+     };
+
+   // a small stretched, periodic mesh and a smooth solution field on it
+      Mesh<2,Real> make_mesh()
+     {
+         Mesh<2,Real> mesh(par::DualShape<2>{6,5});
+         par::generate_idx( mesh.nodes, []( const par::PrimalIdx<2>& idx )
+                                       {
+                                           return geom::Point<2,Real>{{idx[0]*( 1.+0.1*idx[0] ), 0.8*idx[1]+0.1*idx[0]}};
+                                       } );
+         updateGeometry( mesh );
+         return mesh;
+     }
+
+      Field make_field( const Mesh<2,Real>& mesh )
+     {
+         Field q(mesh.cells.shape());
+         par::generate_idx( q.interior, []( const par::DualIdx<2>& idx )
+                                       {
+                                           VarSet v;
+                                           v[0] = 0.1*std::sin( 0.9*idx[0] );
+                                           v[1] = 0.2*std::cos( 1.1*idx[1] );
+                                           v[2] = 1.+0.05*idx[0]*idx[1];
+                                           v[3] = 1.e5+10.*idx[0];
+                                           return v;
+                                       } );
+         for( auto& bc : q.bcTypes ){ bc = BoundaryType<Law>::Periodic; }
+         return q;
+     }
+
+      const auto bcs = std::tuple{make_periodic_BCond<Law>()};
+  }
+
+/*
+ * the residual norm drops by the requested ratio within the iteration limit, and iteration does not stop before it has
+ */
+   void Test_timestepping_steady_state::test_converges()
+  {
+      const Mesh<2,Real> mesh = make_mesh();
+
+      for( const auto& rk : {ODE::Explicit::ssp11<Real>(), ODE::Explicit::ssp34<Real>()} )
+     {
+         Field q = make_field( mesh );
+
+         auto stepper = makeSteadyStateStepper( par::execution::omp, Real(0.5), rk, hoflux, bcs, species, mesh, q );
+
+         CPPUNIT_ASSERT( stepper.converge( 2000, 1e-6 ) );
+         CPPUNIT_ASSERT( stepper.timesteps()>1 );
+         CPPUNIT_ASSERT( stepper.latestResidual()<=1e-6*stepper.initialResidual() );
+
+      // one iteration fewer had not converged
+         Field p = make_field( mesh );
+         auto partial = makeSteadyStateStepper( par::execution::omp, Real(0.5), rk, hoflux, bcs, species, mesh, p );
+         partial.step( stepper.timesteps()-1 );
+         CPPUNIT_ASSERT( !partial.converged( 1e-6 ) );
+     }
+
+   // the integrate wrapper takes the same number of iterations
+      Field q = make_field( mesh );
+      auto stepper = makeSteadyStateStepper( par::execution::omp, Real(0.5), ODE::Explicit::ssp11<Real>(), hoflux, bcs, species, mesh, q );
+      stepper.converge( 2000, 1e-6 );
+
+      Field p = make_field( mesh );
+      const SteadyTimeControls<Real> timeControls{.nTimesteps=2000, .cfl=0.5, .residual_drop=1e-6};
+      CPPUNIT_ASSERT( integrate( par::execution::omp, timeControls, ODE::Explicit::ssp11<Real>(), hoflux, bcs, species, mesh, p )
+                      == stepper.timesteps() );
+  }
+
+/*
+ * iterating in one call gives exactly the same result as iterating in several calls
+ */
+   void Test_timestepping_steady_state::test_chunked_steps()
+  {
+      const Mesh<2,Real> mesh = make_mesh();
+
+      Field q0 = make_field( mesh );
+      Field q1 = make_field( mesh );
+
+      auto stepper0 = makeSteadyStateStepper( par::execution::omp, Real(0.5), ODE::Explicit::ssp34<Real>(), hoflux, bcs, species, mesh, q0 );
+      auto stepper1 = makeSteadyStateStepper( par::execution::omp, Real(0.5), ODE::Explicit::ssp34<Real>(), hoflux, bcs, species, mesh, q1 );
+
+      stepper0.step( 10 );
+      stepper1.step( 3 );
+      stepper1.step( 7 );
+
+      CPPUNIT_ASSERT( stepper0.timesteps()==stepper1.timesteps() );
+      CPPUNIT_ASSERT( stepper0.initialResidual()==stepper1.initialResidual() );
+      CPPUNIT_ASSERT( stepper0.latestResidual()==stepper1.latestResidual() );
+
+      bool match=true;
+      par::for_each_idx( [&]( const par::DualIdx<2>& idx, const VarSet& v )
+                        {
+                            for( int k=0; k<VarSet::N; ++k ){ match = match && v[k]==q1.interior(idx)[k]; }
+                        }, q0.interior );
+      CPPUNIT_ASSERT( match );
+  }
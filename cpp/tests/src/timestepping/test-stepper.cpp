@@ -0,0 +1,115 @@
+# include <timestepping/test-stepper.h>
+
+# include <vector>
+# include <cmath>
+
+   namespace
+  {
+      constexpr LawType Law = LawType::Euler;
+
+      using Real   = double;
+      using VarSet = VariableSet<Law,2,EulerBases::Primitive,Real>;
+      using Field  = SolutionField<VarSet,2>;
+
+      const Species<Law,Real> species{.gamma=1.4, .minf=0.1, .lref=1, .nu=0, .pr=0.7, .dt=1, .R=287, .gamma1=2.5};
+
+   // a linear diffusive flux, with a constant spectral radius per unit face area
+      const auto hoflux = []( const auto&, const auto& face, const auto&, const auto&,
+                              const auto& ql, const auto& qr, const auto&... ) -> fluxresult_t<VarSet>
+     {
+         fluxresult_t<VarSet> f{};
+         for( int v=0; v<VarSet::N; ++v ){ f.flux[v] = 0.1*face.area*( ql[v]-qr[v] ); }
+         f.lambda = face.area;
+         return f;
+     };
+
+   // a skewed, periodic mesh and solution field
+      Mesh<2,Real> make_mesh()
+     {
+         Mesh<2,Real> mesh(par::DualShape<2>{12,7});
+         par::generate_idx( mesh.nodes, []( const par::PrimalIdx<2>& idx )
+                                       {
+                                           return geom::Point<2,Real>{{idx[0]+0.1*idx[1], 2.*idx[1]}};
+                                       } );
+         updateGeometry( mesh );
+         return mesh;
+     }
+
+      Field make_field( const Mesh<2,Real>& mesh )
+     {
+         Field q(mesh.cells.shape());
+         par::generate_idx( q.interior, []( const par::DualIdx<2>& idx )
+                                       {
+                                           VarSet v;
+                                           v[0] = 1.+idx[0];
+                                           v[1] = 0.5*idx[1];
+                                           v[2] = 1.2+0.01*idx[0]*idx[1];
+                                           v[3] = 1.e5+idx[0]*idx[1];
+                                           return v;
+                                       } );
+         for( auto& bc : q.bcTypes ){ bc = BoundaryType<Law>::Periodic; }
+         return q;
+     }
+
+   // integrate in chunks of the given numbers of timesteps, returning the solution field, number of timesteps and time elapsed
+      template<typename RungeKuttaT>
+      std::tuple<Field,size_t,Real> integrate_chunks( const RungeKuttaT& rk, const std::vector<size_t>& chunks )
+     {
+         const Mesh<2,Real> mesh = make_mesh();
+         Field q = make_field( mesh );
+
+         auto stepper = makeRungeKuttaStepper( par::execution::omp, Real(0.5), rk,
+                                               hoflux, std::tuple{make_periodic_BCond<Law>()},
+                                               species,
+                                               mesh, q );
+
+         for( const size_t n : chunks ){ stepper.step( n ); }
+
+         return {std::move(q), stepper.timesteps(), stepper.time()};
+     }
+
+   // the two integrations took the same number of timesteps, to the same time, and match to within tol
+      bool same_integration( const std::tuple<Field,size_t,Real>& a, const std::tuple<Field,size_t,Real>& b, const Real tol )
+     {
+         const auto& qb = std::get<0>(b).interior;
+
+         bool match = std::get<1>(a)==std::get<1>(b)
+                   && std::abs( std::get<2>(a)-std::get<2>(b) )<=tol*std::get<2>(a);
+
+         par::for_each_idx( [&]( const par::DualIdx<2>& idx, const VarSet& v )
+                           {
+                               for( int k=0; k<VarSet::N; ++k ){ match = match && std::abs( v[k]-qb(idx)[k] )<=tol*std::abs( v[k] ); }
+                           }, std::get<0>(a).interior );
+         return match;
+     }
+  }
+
+/*
+ * stepping n timesteps in one call gives exactly the same result as stepping in several calls, for classical and low-storage schemes
+ */
+   void Test_timestepping_stepper::test_chunked_steps()
+  {
+      CPPUNIT_ASSERT( same_integration( integrate_chunks( ODE::Explicit::ssp34<Real>(), {2} ),
+                                        integrate_chunks( ODE::Explicit::ssp34<Real>(), {1,1} ), 0. ) );
+
+      CPPUNIT_ASSERT( same_integration( integrate_chunks( ODE::Explicit::ssp34<Real>(), {10} ),
+                                        integrate_chunks( ODE::Explicit::ssp34<Real>(), {3,0,7} ), 0. ) );
+
+      CPPUNIT_ASSERT( same_integration( integrate_chunks( ODE::Explicit::LowStorage::ssp34<Real>(), {2} ),
+                                        integrate_chunks( ODE::Explicit::LowStorage::ssp34<Real>(), {1,1} ), 0. ) );
+
+      CPPUNIT_ASSERT( same_integration( integrate_chunks( ODE::Explicit::LowStorage::carpenterKennedy4<Real>(), {10} ),
+                                        integrate_chunks( ODE::Explicit::LowStorage::carpenterKennedy4<Real>(), {4,6} ), 0. ) );
+  }
+
+/*
+ * the low-storage and classical forms of the same scheme take the same timesteps and agree to round-off
+ */
+   void Test_timestepping_stepper::test_low_storage_matches_classical()
+  {
+      CPPUNIT_ASSERT( same_integration( integrate_chunks( ODE::Explicit::ssp11<Real>(),             {5} ),
+                                        integrate_chunks( ODE::Explicit::LowStorage::ssp11<Real>(), {5} ), 1e-14 ) );
+
+      CPPUNIT_ASSERT( same_integration( integrate_chunks( ODE::Explicit::ssp34<Real>(),             {5} ),
+                                        integrate_chunks( ODE::Explicit::LowStorage::ssp34<Real>(), {5} ), 1e-12 ) );
+  }